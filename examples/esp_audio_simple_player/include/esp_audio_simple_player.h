@@ -35,6 +35,7 @@ extern "C" {
 typedef enum {
     ESP_ASP_EVENT_TYPE_STATE = 1,        /*!< State change event, the payload is esp_asp_state_t */
     ESP_ASP_EVENT_TYPE_MUSIC_INFO  = 2,  /*!< Information event, the payload is esp_asp_music_info_t */
+    ESP_ASP_EVENT_TYPE_TRACK  = 3,       /*!< A queued track starts on the output, the payload is its URI string */
 } esp_asp_event_type_t;
 
 /**
@@ -170,6 +171,33 @@ esp_gmf_err_t esp_audio_simple_player_run(esp_asp_handle_t handle, const char *u
  */
 esp_gmf_err_t esp_audio_simple_player_run_to_end(esp_asp_handle_t handle, const char *uri, esp_asp_music_info_t *music_info);
 
+/**
+ * @brief  Append a URI to the play queue of the audio simple player. The queue is played back to back without any gap:
+ *         while one track is played, the next one is opened, probed and decoded ahead on a second pipeline, and its PCM
+ *         is spliced right after the last sample of the current track.
+ *         If the queue is idle, the playback starts from the given URI.
+ *
+ * @note  The URI format and the `music_info` usage are the same as `esp_audio_simple_player_run`
+ *        The queue plays on its own pipelines, `esp_audio_simple_player_run` can't be used until the queue is stopped or finished
+ *        `ESP_ASP_EVENT_TYPE_TRACK` is sent when a track reaches the output, `ESP_ASP_EVENT_TYPE_MUSIC_INFO` only when the output format changes
+ *        `esp_audio_simple_player_stop`, `esp_audio_simple_player_pause` and `esp_audio_simple_player_resume` apply to the whole queue,
+ *        stop drops the tracks which are not played yet
+ *        Don't call it from the player event callback when the queue is finished, wait for the state event to return first
+ *
+ * @param[in]  handle      Handle to audio simple player instance
+ * @param[in]  uri         URI of the audio resource
+ * @param[in]  music_info  Music information, it is applicable for raw encoded data, such as PCM, without an OGG header in Opus, otherwise it is ignored
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid argument
+ *       - ESP_GMF_ERR_INVALID_STATE  The player is running a URI by `esp_audio_simple_player_run`
+ *       - ESP_GMF_ERR_MEMORY_LACK    Memory allocation failure
+ *       - ESP_GMF_ERR_NOT_FOUND      No track of the queue can be loaded
+ *       - Others                     Failed to setup the pipeline of the first track, see `esp_audio_simple_player_run`
+ */
+esp_gmf_err_t esp_audio_simple_player_queue(esp_asp_handle_t handle, const char *uri, esp_asp_music_info_t *music_info);
+
 /**
  * @brief  Stop the audio simple player
  *
@@ -30,6 +30,8 @@
 #include "esp_gmf_obj.h"
 #include "esp_gmf_err.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_thread.h"
 #include "esp_gmf_element.h"
 
 #include "esp_audio_simple_player_private.h"
@@ -44,6 +46,18 @@
 #define ASP_PIPELINE_FINISHED_BIT BIT(1)
 #define ASP_PIPELINE_ERROR_BIT    BIT(2)
 
+#define ASP_SPLICE_RUN_BIT    BIT(0)
+#define ASP_SPLICE_EXIT_BIT   BIT(1)
+#define ASP_DECK_DONE_BIT(i)  BIT(2 + (i))
+
+#ifdef CONFIG_ESP_AUDIO_SIMPLE_PLAYER_PREFETCH_SIZE
+#define ASP_DECK_STASH_SIZE  (CONFIG_ESP_AUDIO_SIMPLE_PLAYER_PREFETCH_SIZE)
+#else
+#define ASP_DECK_STASH_SIZE  (16 * 1024)
+#endif  /* CONFIG_ESP_AUDIO_SIMPLE_PLAYER_PREFETCH_SIZE */
+#define ASP_SPLICE_CHUNK_SIZE  (2048)
+#define ASP_DECK_SETTLE_MS     (1000)
+
 static const char *TAG = "AUD_SIMP_PLAYER";
 static uint8_t esp_asp_decoder_ref_count = 0;
 
@@ -84,6 +98,34 @@ static inline void _get_asp_st(esp_gmf_event_state_t in, esp_asp_state_t *out)
     }
 }
 
+static void _notify_music_info(esp_audio_simple_player_t *player, esp_gmf_info_sound_t *esp_gmf_info)
+{
+    esp_asp_music_info_t info = {0};
+    info.sample_rate = esp_gmf_info->sample_rates;
+    info.bitrate = esp_gmf_info->bitrate;
+    info.channels = esp_gmf_info->channels;
+    info.bits = esp_gmf_info->bits;
+
+    esp_asp_event_pkt_t user_evt = {0};
+    user_evt.type = ESP_ASP_EVENT_TYPE_MUSIC_INFO;
+    user_evt.payload = &info;
+    user_evt.payload_size = sizeof(info);
+    player->event_cb(&user_evt, player->user_ctx);
+}
+
+static void _notify_queue_state(esp_audio_simple_player_t *player, esp_asp_state_t state)
+{
+    player->state = state;
+    if (player->event_cb == NULL) {
+        return;
+    }
+    esp_asp_event_pkt_t user_evt = {0};
+    user_evt.type = ESP_ASP_EVENT_TYPE_STATE;
+    user_evt.payload = &player->state;
+    user_evt.payload_size = sizeof(player->state);
+    player->event_cb(&user_evt, player->user_ctx);
+}
+
 static esp_err_t _pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
 {
     ESP_LOGD(TAG, "CB: RECV Pipeline EVT: el:%s-%p, type:%x, sub:%s, payload:%p, size:%d,%p",
@@ -112,16 +154,7 @@ static esp_err_t _pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
     } else if (event->type == ESP_GMF_EVT_TYPE_REPORT_INFO) {
         esp_gmf_info_sound_t esp_gmf_info = {0};
         memcpy(&esp_gmf_info, event->payload, event->payload_size);
-        esp_asp_music_info_t info = {0};
-        info.sample_rate = esp_gmf_info.sample_rates;
-        info.bitrate = esp_gmf_info.bitrate;
-        info.channels = esp_gmf_info.channels;
-        info.bits = esp_gmf_info.bits;
-
-        user_evt.type = ESP_ASP_EVENT_TYPE_MUSIC_INFO;
-        user_evt.payload = &info;
-        user_evt.payload_size = sizeof(info);
-        player->event_cb(&user_evt, player->user_ctx);
+        _notify_music_info(player, &esp_gmf_info);
     }
     return ESP_GMF_ERR_OK;
 }
@@ -167,7 +200,16 @@ static int asp_func_release_write(void *handle, esp_gmf_data_bus_block_t *blk, i
     return ret;
 }
 
-static int __setup_pipeline(esp_audio_simple_player_t *player, const char *uri, esp_asp_music_info_t *music_info)
+static esp_gmf_port_handle_t __new_out_port(esp_audio_simple_player_t *player, esp_gmf_db_handle_t stash)
+{
+    if (stash) {
+        return NEW_ESP_GMF_PORT_OUT_BYTE(esp_gmf_db_acquire_write, esp_gmf_db_release_write, NULL, stash, 2048, ESP_GMF_MAX_DELAY);
+    }
+    return NEW_ESP_GMF_PORT_OUT_BYTE(asp_func_acquire_write, asp_func_release_write, NULL, &player->cfg.out, 2048, ESP_GMF_MAX_DELAY);
+}
+
+static int __setup_pipeline(esp_audio_simple_player_t *player, esp_gmf_pipeline_handle_t *pipe, void *task, esp_gmf_db_handle_t stash,
+                            const char *uri, esp_asp_music_info_t *music_info)
 {
     esp_gmf_uri_t *uri_st = NULL;
     int ret = 0;
@@ -189,9 +231,9 @@ static int __setup_pipeline(esp_audio_simple_player_t *player, const char *uri,
         in_str = NULL;
     }
 
-    if (player->pipe == NULL) {
-        esp_gmf_pool_new_pipeline(player->pool, in_str, el_names, sizeof(el_names) / sizeof(char *), NULL, &player->pipe);
-        if (player->pipe == NULL) {
+    if (*pipe == NULL) {
+        esp_gmf_pool_new_pipeline(player->pool, in_str, el_names, sizeof(el_names) / sizeof(char *), NULL, pipe);
+        if (*pipe == NULL) {
             ESP_LOGE(TAG, "Failed to create an new pipeline");
             esp_gmf_uri_free(uri_st);
             return ESP_GMF_ERR_FAIL;
@@ -199,59 +241,59 @@ static int __setup_pipeline(esp_audio_simple_player_t *player, const char *uri,
         if (in_str == NULL) {
             esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BYTE(asp_func_acquire_read, asp_func_release_read, NULL, &player->cfg.in, 1024, ESP_GMF_MAX_DELAY);
             ESP_GMF_CHECK(TAG, in_port, goto __setup_pipe_err, "Failed to create in port");
-            ret = esp_gmf_pipeline_reg_el_port(player->pipe, OBJ_GET_TAG(player->pipe->head_el), ESP_GMF_IO_DIR_READER, in_port);
+            ret = esp_gmf_pipeline_reg_el_port(*pipe, OBJ_GET_TAG((*pipe)->head_el), ESP_GMF_IO_DIR_READER, in_port);
             ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "Failed to register in port for head element, ret:%x", ret);
         }
-        esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BYTE(asp_func_acquire_write, asp_func_release_write, NULL, &player->cfg.out, 2048, ESP_GMF_MAX_DELAY);
+        esp_gmf_port_handle_t out_port = __new_out_port(player, stash);
         ESP_GMF_CHECK(TAG, out_port, goto __setup_pipe_err, "Failed to create out port");
-        ret = esp_gmf_pipeline_reg_el_port(player->pipe, OBJ_GET_TAG(player->pipe->last_el), ESP_GMF_IO_DIR_WRITER, out_port);
+        ret = esp_gmf_pipeline_reg_el_port(*pipe, OBJ_GET_TAG((*pipe)->last_el), ESP_GMF_IO_DIR_WRITER, out_port);
         ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "Failed to register out port for tail element, ret:%x", ret);
     } else {
-        esp_gmf_pipeline_reset(player->pipe);
+        esp_gmf_pipeline_reset(*pipe);
         esp_gmf_io_handle_t out_io = NULL;
-        esp_gmf_pipeline_get_in(player->pipe, &out_io);
+        esp_gmf_pipeline_get_in(*pipe, &out_io);
         if (out_io == NULL) {
-            esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BYTE(asp_func_acquire_write, asp_func_release_write, NULL, &player->cfg.out, 2048, ESP_GMF_MAX_DELAY);
+            esp_gmf_port_handle_t out_port = __new_out_port(player, stash);
             ESP_GMF_CHECK(TAG, out_port, goto __setup_pipe_err, "Failed to create out port on exist pipeline");
-            ret = esp_gmf_pipeline_reg_el_port(player->pipe, OBJ_GET_TAG(player->pipe->last_el), ESP_GMF_IO_DIR_WRITER, out_port);
+            ret = esp_gmf_pipeline_reg_el_port(*pipe, OBJ_GET_TAG((*pipe)->last_el), ESP_GMF_IO_DIR_WRITER, out_port);
             ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "Failed to register out port for tail element, ret:%x", ret);
         }
 
         esp_gmf_io_handle_t in_io = NULL;
-        esp_gmf_pipeline_get_in(player->pipe, &in_io);
+        esp_gmf_pipeline_get_in(*pipe, &in_io);
         if ((in_io == NULL) || (strncasecmp(OBJ_GET_TAG(in_io), in_str, strlen(in_str)) != 0)) {
             esp_gmf_io_handle_t new_io = NULL;
 
             esp_gmf_pool_new_io(player->pool, in_str, ESP_GMF_IO_DIR_READER, &new_io);
             ESP_GMF_CHECK(TAG, new_io, goto __setup_pipe_err, "Failed to create IN IO instance");
-            esp_gmf_pipeline_replace_in(player->pipe, new_io);
+            esp_gmf_pipeline_replace_in(*pipe, new_io);
             if (in_io) {
                 esp_gmf_obj_delete(in_io);
-                esp_gmf_element_unregister_in_port(player->pipe->head_el, NULL);
+                esp_gmf_element_unregister_in_port((*pipe)->head_el, NULL);
             }
             esp_gmf_io_type_t io_type = 0;
             esp_gmf_io_get_type(new_io, &io_type);
             esp_gmf_port_handle_t in_port = NULL;
             if (io_type == ESP_GMF_IO_TYPE_BYTE) {
                 in_port = NEW_ESP_GMF_PORT_IN_BYTE(esp_gmf_io_acquire_read, esp_gmf_io_release_read, NULL, new_io,
-                                                   (ESP_GMF_ELEMENT_GET(player->pipe->head_el)->in_attr.size), ESP_GMF_MAX_DELAY);
+                                                   (ESP_GMF_ELEMENT_GET((*pipe)->head_el)->in_attr.size), ESP_GMF_MAX_DELAY);
             } else if (io_type == ESP_GMF_IO_TYPE_BLOCK) {
                 in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_io_acquire_read, esp_gmf_io_release_read, NULL, new_io,
-                                                    (ESP_GMF_ELEMENT_GET(player->pipe->head_el)->in_attr.size), ESP_GMF_MAX_DELAY);
+                                                    (ESP_GMF_ELEMENT_GET((*pipe)->head_el)->in_attr.size), ESP_GMF_MAX_DELAY);
             } else {
                 ESP_LOGE(TAG, "The IN type is incorrect,%d, [%p-%s]", io_type, new_io, OBJ_GET_TAG(new_io));
                 ret = ESP_GMF_ERR_NOT_SUPPORT;
                 goto __setup_pipe_err;
             }
             ESP_GMF_NULL_CHECK(TAG, in_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto __setup_pipe_err;});
-            ret = esp_gmf_element_register_in_port((esp_gmf_element_handle_t)player->pipe->head_el, in_port);
+            ret = esp_gmf_element_register_in_port((esp_gmf_element_handle_t)(*pipe)->head_el, in_port);
             ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "Failed to register in port for head element, ret:%x", ret);
             ESP_LOGD(TAG, "TO link IN port, [%p-%s],new:%p", new_io, OBJ_GET_TAG(new_io), in_port);
         }
     }
-    esp_gmf_pipeline_bind_task(player->pipe, player->work_task);
+    esp_gmf_pipeline_bind_task(*pipe, task);
     esp_gmf_element_handle_t dec_el = NULL;
-    ret = esp_gmf_pipeline_get_el_by_name(player->pipe, "aud_simp_dec", &dec_el);
+    ret = esp_gmf_pipeline_get_el_by_name(*pipe, "aud_simp_dec", &dec_el);
     ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "There is no decoder in pipeline");
     if (music_info) {
         esp_gmf_info_sound_t info ={
@@ -272,9 +314,9 @@ static int __setup_pipeline(esp_audio_simple_player_t *player, const char *uri,
         ret = esp_gmf_audio_helper_reconfig_dec_by_uri((char *)uri_st->path, &info, OBJ_GET_CFG(dec_el));
     }
     ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "The audio format does not support, ret:%x, path:%p", ret, uri_st->path);
-    ret = esp_gmf_pipeline_set_in_uri(player->pipe, uri);
+    ret = esp_gmf_pipeline_set_in_uri(*pipe, uri);
     ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "Failed set URI for in stream, ret:%x", ret);
-    ret = esp_gmf_pipeline_loading_jobs(player->pipe);
+    ret = esp_gmf_pipeline_loading_jobs(*pipe);
     ESP_GMF_RET_ON_ERROR(TAG, ret, goto __setup_pipe_err, "Failed loading jobs for pipeline, ret:%x", ret);
 
 __setup_pipe_err:
@@ -282,6 +324,277 @@ __setup_pipe_err:
     return ret;
 }
 
+static void __new_task(esp_asp_cfg_t *cfg, void **task)
+{
+    esp_gmf_task_cfg_t task_cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    task_cfg.ctx = NULL;
+    task_cfg.cb = NULL;
+    if (cfg->task_stack > 0) {
+        task_cfg.thread.stack = cfg->task_stack;
+    }
+    if (cfg->task_prio > 0) {
+        task_cfg.thread.prio = cfg->task_prio;
+    }
+    task_cfg.thread.core = cfg->task_core;
+    esp_gmf_task_init(&task_cfg, task);
+    if (*task) {
+        esp_gmf_task_set_timeout(*task, 3000);
+    }
+}
+
+static void asp_track_free(esp_asp_track_t *track)
+{
+    esp_gmf_oal_free(track->uri);
+    esp_gmf_oal_free(track);
+}
+
+static esp_err_t _deck_event(esp_gmf_event_pkt_t *event, void *ctx)
+{
+    esp_asp_deck_t *deck = (esp_asp_deck_t *)ctx;
+    esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)deck->parent;
+    if (event->type == ESP_GMF_EVT_TYPE_REPORT_INFO) {
+        int size = event->payload_size < sizeof(deck->info) ? event->payload_size : sizeof(deck->info);
+        memcpy(&deck->info, event->payload, size);
+    } else if ((event->type == ESP_GMF_EVT_TYPE_CHANGE_STATE)
+               && ((event->sub == ESP_GMF_EVENT_STATE_FINISHED) || (event->sub == ESP_GMF_EVENT_STATE_STOPPED)
+                   || (event->sub == ESP_GMF_EVENT_STATE_ERROR))) {
+        if (event->sub == ESP_GMF_EVENT_STATE_ERROR) {
+            ESP_LOGW(TAG, "Deck %d failed, play what is decoded and go on, uri:%s", deck->id, deck->uri);
+        }
+        // A failed or stopped deck never writes the last block, end its stash here so the splice is not stuck
+        esp_gmf_db_done_write(deck->stash);
+        xEventGroupSetBits((EventGroupHandle_t)player->splice_event, ASP_DECK_DONE_BIT(deck->id));
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t asp_deck_settle(esp_audio_simple_player_t *player, esp_asp_deck_t *deck)
+{
+    if (deck->pipe == NULL) {
+        return ESP_GMF_ERR_OK;
+    }
+    EventBits_t bits = xEventGroupWaitBits((EventGroupHandle_t)player->splice_event, ASP_DECK_DONE_BIT(deck->id),
+                                           pdFALSE, pdTRUE, pdMS_TO_TICKS(ASP_DECK_SETTLE_MS));
+    if (bits & ASP_DECK_DONE_BIT(deck->id)) {
+        return ESP_GMF_ERR_OK;
+    }
+    ESP_LOGW(TAG, "Deck %d is still running, stop it", deck->id);
+    esp_gmf_db_abort(deck->stash);
+    return esp_gmf_pipeline_stop(deck->pipe);
+}
+
+/**
+ * Load the first queued track on the deck and start decoding it into the deck stash.
+ * Opening the IO, probing the decoder and opening the converters all happen on the deck task,
+ * so they overlap with the playback of the live deck.
+ * The queue lock must be held by the caller.
+ */
+static esp_gmf_err_t asp_deck_load(esp_audio_simple_player_t *player, esp_asp_deck_t *deck)
+{
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_FOUND;
+    esp_asp_track_t *track = NULL;
+    while ((track = STAILQ_FIRST(&player->queue))) {
+        STAILQ_REMOVE_HEAD(&player->queue, next);
+        if (deck->task == NULL) {
+            __new_task(&player->cfg, &deck->task);
+        }
+        if ((deck->stash == NULL) && deck->task) {
+            esp_gmf_db_new_ringbuf(1, ASP_DECK_STASH_SIZE, &deck->stash);
+        }
+        if ((deck->task == NULL) || (deck->stash == NULL)) {
+            ESP_LOGE(TAG, "No memory for deck %d, task:%p, stash:%p", deck->id, deck->task, deck->stash);
+            asp_track_free(track);
+            return ESP_GMF_ERR_MEMORY_LACK;
+        }
+        ret = asp_deck_settle(player, deck);
+        if (ret == ESP_GMF_ERR_OK) {
+            esp_gmf_db_reset(deck->stash);
+            memset(&deck->info, 0, sizeof(deck->info));
+            ret = __setup_pipeline(player, &deck->pipe, deck->task, deck->stash, track->uri, track->has_info ? &track->info : NULL);
+        }
+        if (ret == ESP_GMF_ERR_OK) {
+            esp_gmf_pipeline_set_event(deck->pipe, _deck_event, deck);
+            xEventGroupClearBits((EventGroupHandle_t)player->splice_event, ASP_DECK_DONE_BIT(deck->id));
+            ret = esp_gmf_pipeline_run(deck->pipe);
+        }
+        if (ret == ESP_GMF_ERR_OK) {
+            esp_gmf_oal_free(deck->uri);
+            deck->uri = track->uri;
+            deck->loaded = true;
+            deck->announced = false;
+            esp_gmf_oal_free(track);
+            ESP_LOGI(TAG, "Deck %d prefetching %s", deck->id, deck->uri);
+            return ESP_GMF_ERR_OK;
+        }
+        ESP_LOGE(TAG, "Failed to load queued track, skip it, ret:%x, uri:%s", ret, track->uri);
+        asp_track_free(track);
+    }
+    return ret;
+}
+
+static void asp_splice_announce(esp_audio_simple_player_t *player, esp_asp_deck_t *deck)
+{
+    if (deck->announced) {
+        return;
+    }
+    deck->announced = true;
+    ESP_LOGI(TAG, "Splice to deck %d, %s", deck->id, deck->uri);
+    if (player->event_cb == NULL) {
+        return;
+    }
+    // The converter chain of every deck ends in the same format, only a real change is reported
+    if ((deck->info.sample_rates != player->out_info.sample_rates)
+        || (deck->info.channels != player->out_info.channels)
+        || (deck->info.bits != player->out_info.bits)) {
+        memcpy(&player->out_info, &deck->info, sizeof(player->out_info));
+        _notify_music_info(player, &deck->info);
+    }
+    esp_asp_event_pkt_t user_evt = {0};
+    user_evt.type = ESP_ASP_EVENT_TYPE_TRACK;
+    user_evt.payload = deck->uri;
+    user_evt.payload_size = strlen(deck->uri) + 1;
+    player->event_cb(&user_evt, player->user_ctx);
+}
+
+static void *asp_splice_detach(esp_audio_simple_player_t *player, esp_asp_state_t end_state)
+{
+    void *thread = player->splice_thread;
+    // Leave the running state first, so a queue call right after the detach starts a new queue
+    player->state = end_state;
+    player->splice_thread = NULL;
+    player->splice_running = false;
+    return thread;
+}
+
+/**
+ * Called by the splice thread once the live deck is drained.
+ * Hand the output to the other deck and prefetch the next queued track on the drained one.
+ * If nothing is prefetched the splice thread is detached and the queue is over.
+ */
+static esp_gmf_err_t asp_splice_next(esp_audio_simple_player_t *player, void **thread, esp_asp_state_t *end_state)
+{
+    esp_gmf_oal_mutex_lock(player->queue_lock);
+    esp_asp_deck_t *drained = &player->decks[player->live_deck];
+    esp_asp_deck_t *next = &player->decks[(player->live_deck + 1) % ESP_ASP_DECK_NUM];
+    drained->loaded = false;
+    if ((next->loaded == false) || player->splice_quit) {
+        *end_state = player->splice_quit ? ESP_ASP_STATE_STOPPED : ESP_ASP_STATE_FINISHED;
+        *thread = asp_splice_detach(player, *end_state);
+        esp_gmf_oal_mutex_unlock(player->queue_lock);
+        return ESP_GMF_ERR_NOT_FOUND;
+    }
+    player->live_deck = next->id;
+    if (STAILQ_EMPTY(&player->queue) == false) {
+        asp_deck_load(player, drained);
+    }
+    esp_gmf_oal_mutex_unlock(player->queue_lock);
+    return ESP_GMF_ERR_OK;
+}
+
+static void asp_splice_process(void *arg)
+{
+    esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)arg;
+    esp_asp_state_t end_state = ESP_ASP_STATE_FINISHED;
+    void *thread = NULL;
+    uint8_t *buf = esp_gmf_oal_malloc(ASP_SPLICE_CHUNK_SIZE);
+    if (buf == NULL) {
+        ESP_LOGE(TAG, "No memory for the splice buffer");
+        end_state = ESP_ASP_STATE_ERROR;
+    }
+    while (buf) {
+        xEventGroupWaitBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_RUN_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+        if (player->splice_quit) {
+            end_state = ESP_ASP_STATE_STOPPED;
+            break;
+        }
+        esp_asp_deck_t *deck = &player->decks[player->live_deck];
+        esp_gmf_data_bus_block_t blk = {0};
+        blk.buf = buf;
+        blk.buf_length = ASP_SPLICE_CHUNK_SIZE;
+        int ret = esp_gmf_db_acquire_read(deck->stash, &blk, ASP_SPLICE_CHUNK_SIZE, ESP_GMF_MAX_DELAY);
+        if ((ret < 0) && (blk.is_last == 0)) {
+            end_state = player->splice_quit ? ESP_ASP_STATE_STOPPED : ESP_ASP_STATE_ERROR;
+            break;
+        }
+        if (blk.valid_size > 0) {
+            asp_splice_announce(player, deck);
+            player->cfg.out.cb(buf, blk.valid_size, player->cfg.out.user_ctx);
+        }
+        esp_gmf_db_release_read(deck->stash, &blk, 0);
+        // The next deck is read right after the last byte of the drained one, there is no silence in between
+        if (blk.is_last && (asp_splice_next(player, &thread, &end_state) != ESP_GMF_ERR_OK)) {
+            break;
+        }
+    }
+    esp_gmf_oal_free(buf);
+    if (thread == NULL) {
+        esp_gmf_oal_mutex_lock(player->queue_lock);
+        thread = asp_splice_detach(player, end_state);
+        esp_gmf_oal_mutex_unlock(player->queue_lock);
+    }
+    ESP_LOGI(TAG, "Splice thread exit, %s", esp_audio_simple_player_state_to_str(end_state));
+    _notify_queue_state(player, end_state);
+    xEventGroupSetBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_EXIT_BIT);
+    esp_gmf_oal_thread_delete(thread);
+}
+
+static esp_gmf_err_t asp_queue_start(esp_audio_simple_player_t *player)
+{
+    // Wait for the thread of the previous queue to be gone
+    xEventGroupWaitBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_EXIT_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+    player->live_deck = 0;
+    esp_gmf_err_t ret = asp_deck_load(player, &player->decks[0]);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to load the first queued track, ret:%x", ret);
+    asp_deck_load(player, &player->decks[1]);
+
+    memset(&player->out_info, 0, sizeof(player->out_info));
+    player->splice_quit = false;
+    player->splice_running = true;
+    xEventGroupClearBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_EXIT_BIT);
+    xEventGroupSetBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_RUN_BIT);
+    _notify_queue_state(player, ESP_ASP_STATE_RUNNING);
+    int stack = player->cfg.task_stack > 0 ? player->cfg.task_stack : DEFAULT_ESP_GMF_STACK_SIZE;
+    int prio = player->cfg.task_prio > 0 ? player->cfg.task_prio : DEFAULT_ESP_GMF_TASK_PRIO;
+    ret = esp_gmf_oal_thread_create(&player->splice_thread, "asp_splice", asp_splice_process, player, stack, prio, false, player->cfg.task_core);
+    if (ret != ESP_GMF_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to create the splice thread, ret:%x", ret);
+        player->splice_quit = true;
+        player->splice_running = false;
+        xEventGroupSetBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_EXIT_BIT);
+        _notify_queue_state(player, ESP_ASP_STATE_ERROR);
+    }
+    return ret;
+}
+
+static esp_gmf_err_t asp_queue_stop(esp_audio_simple_player_t *player)
+{
+    player->splice_quit = true;
+    xEventGroupSetBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_RUN_BIT);
+    for (int i = 0; i < ESP_ASP_DECK_NUM; i++) {
+        if (player->decks[i].stash) {
+            esp_gmf_db_abort(player->decks[i].stash);
+        }
+    }
+    xEventGroupWaitBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_EXIT_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+    esp_gmf_oal_mutex_lock(player->queue_lock);
+    for (int i = 0; i < ESP_ASP_DECK_NUM; i++) {
+        esp_asp_deck_t *deck = &player->decks[i];
+        if (deck->pipe) {
+            // The splice may have loaded the deck again, so abort after it is gone
+            esp_gmf_db_abort(deck->stash);
+            esp_gmf_pipeline_stop(deck->pipe);
+        }
+        deck->loaded = false;
+    }
+    esp_asp_track_t *track = NULL;
+    while ((track = STAILQ_FIRST(&player->queue))) {
+        STAILQ_REMOVE_HEAD(&player->queue, next);
+        asp_track_free(track);
+    }
+    esp_gmf_oal_mutex_unlock(player->queue_lock);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_audio_simple_player_new(esp_asp_cfg_t *cfg, esp_asp_handle_t *handle)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, { return ESP_GMF_ERR_INVALID_ARG;});
@@ -304,24 +617,35 @@ esp_gmf_err_t esp_audio_simple_player_new(esp_asp_cfg_t *cfg, esp_asp_handle_t *
     asp_pool_register_audio(player);
     asp_pool_register_io(player);
     memcpy(&player->cfg, cfg, sizeof(player->cfg));
-    esp_gmf_task_cfg_t task_cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
-    task_cfg.ctx = NULL;
-    task_cfg.cb = NULL;
-    if (cfg->task_stack > 0) {
-        task_cfg.thread.stack = cfg->task_stack;
-    }
-    if (cfg->task_prio > 0) {
-        task_cfg.thread.prio = cfg->task_prio;
-    }
-    task_cfg.thread.core = cfg->task_core;
-    esp_gmf_task_init(&task_cfg, &player->work_task);
+    __new_task(cfg, &player->work_task);
     if (player->work_task == NULL) {
         ESP_LOGE(TAG, "Failed to create the pipeline task");
         esp_gmf_pool_deinit(player->pool);
         esp_gmf_oal_free(player);
         return ESP_GMF_ERR_MEMORY_LACK;
     }
-    esp_gmf_task_set_timeout(player->work_task, 3000);
+    STAILQ_INIT(&player->queue);
+    for (int i = 0; i < ESP_ASP_DECK_NUM; i++) {
+        player->decks[i].parent = player;
+        player->decks[i].id = i;
+    }
+    player->queue_lock = esp_gmf_oal_mutex_create();
+    player->splice_event = (void *)xEventGroupCreate();
+    if ((player->queue_lock == NULL) || (player->splice_event == NULL)) {
+        ESP_LOGE(TAG, "Failed to create the play queue resources");
+        if (player->queue_lock) {
+            esp_gmf_oal_mutex_destroy(player->queue_lock);
+        }
+        if (player->splice_event) {
+            vEventGroupDelete(player->splice_event);
+        }
+        esp_gmf_task_deinit(player->work_task);
+        esp_gmf_pool_deinit(player->pool);
+        esp_gmf_oal_free(player);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    // No splice thread is alive yet
+    xEventGroupSetBits(player->splice_event, ASP_SPLICE_EXIT_BIT);
     *handle = player;
     return ESP_GMF_ERR_OK;
 }
@@ -344,7 +668,7 @@ esp_gmf_err_t esp_audio_simple_player_run(esp_asp_handle_t handle, const char *u
         ESP_LOGE(TAG, "The player still running, call stop first, st:%d", player->state);
         return ESP_GMF_ERR_INVALID_STATE;
     }
-    int ret = __setup_pipeline(player, uri, music_info);
+    int ret = __setup_pipeline(player, &player->pipe, player->work_task, NULL, uri, music_info);
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to setup pipeline, ret:%x", ret);
     player->state = ESP_ASP_STATE_NONE;
     esp_gmf_pipeline_set_event(player->pipe, _pipeline_event, player);
@@ -365,7 +689,7 @@ esp_gmf_err_t esp_audio_simple_player_run_to_end(esp_asp_handle_t handle, const
         player->wait_event = (void *)xEventGroupCreate();
         ESP_GMF_NULL_CHECK(TAG, player->wait_event, return ESP_GMF_ERR_MEMORY_LACK);
     }
-    int ret = __setup_pipeline(player, uri, music_info);
+    int ret = __setup_pipeline(player, &player->pipe, player->work_task, NULL, uri, music_info);
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to setup pipeline on sync play, ret:%x", ret);
     esp_gmf_pipeline_set_event(player->pipe, _pipeline_event, player);
     xEventGroupClearBits(player->wait_event, ASP_PIPELINE_ERROR_BIT | ASP_PIPELINE_STOPPED_BIT | ASP_PIPELINE_FINISHED_BIT);
@@ -381,10 +705,57 @@ esp_gmf_err_t esp_audio_simple_player_run_to_end(esp_asp_handle_t handle, const
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_audio_simple_player_queue(esp_asp_handle_t handle, const char *uri, esp_asp_music_info_t *music_info)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
+    ESP_GMF_NULL_CHECK(TAG, uri, { return ESP_GMF_ERR_INVALID_ARG;});
+    esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)handle;
+    esp_asp_track_t *track = (esp_asp_track_t *)esp_gmf_oal_calloc(1, sizeof(esp_asp_track_t));
+    ESP_GMF_MEM_CHECK(TAG, track, return ESP_GMF_ERR_MEMORY_LACK);
+    track->uri = esp_gmf_oal_strdup(uri);
+    ESP_GMF_MEM_CHECK(TAG, track->uri, { esp_gmf_oal_free(track); return ESP_GMF_ERR_MEMORY_LACK;});
+    if (music_info) {
+        track->info = *music_info;
+        track->has_info = true;
+    }
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    esp_gmf_oal_mutex_lock(player->queue_lock);
+    if ((player->splice_running == false)
+        && ((player->state == ESP_ASP_STATE_RUNNING) || (player->state == ESP_ASP_STATE_PAUSED))) {
+        esp_gmf_oal_mutex_unlock(player->queue_lock);
+        ESP_LOGE(TAG, "The player is running a single URI, call stop first, st:%d", player->state);
+        asp_track_free(track);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    STAILQ_INSERT_TAIL(&player->queue, track, next);
+    if (player->splice_running) {
+        // Prefetch right away if the other deck is idle
+        esp_asp_deck_t *next = &player->decks[(player->live_deck + 1) % ESP_ASP_DECK_NUM];
+        if (next->loaded == false) {
+            asp_deck_load(player, next);
+        }
+    } else {
+        ret = asp_queue_start(player);
+    }
+    esp_gmf_oal_mutex_unlock(player->queue_lock);
+    return ret;
+}
+
 esp_gmf_err_t esp_audio_simple_player_stop(esp_asp_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
     esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)handle;
+    esp_gmf_oal_mutex_lock(player->queue_lock);
+    bool splice_running = player->splice_running;
+    esp_gmf_oal_mutex_unlock(player->queue_lock);
+    if (splice_running) {
+        return asp_queue_stop(player);
+    }
+    if (player->pipe == NULL) {
+        // A play queue that is already over, or nothing played yet
+        ESP_LOGW(TAG, "Nothing to stop, st:%s", esp_audio_simple_player_state_to_str(player->state));
+        return ESP_GMF_ERR_OK;
+    }
     return esp_gmf_pipeline_stop(player->pipe);
 }
 
@@ -392,6 +763,16 @@ esp_gmf_err_t esp_audio_simple_player_pause(esp_asp_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
     esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)handle;
+    esp_gmf_oal_mutex_lock(player->queue_lock);
+    if (player->splice_running) {
+        // The decks stall by themselves once their stashes are full
+        xEventGroupClearBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_RUN_BIT);
+        _notify_queue_state(player, ESP_ASP_STATE_PAUSED);
+        esp_gmf_oal_mutex_unlock(player->queue_lock);
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_unlock(player->queue_lock);
+    ESP_GMF_NULL_CHECK(TAG, player->pipe, return ESP_GMF_ERR_INVALID_STATE);
     return esp_gmf_pipeline_pause(player->pipe);
 }
 
@@ -399,6 +780,15 @@ esp_gmf_err_t esp_audio_simple_player_resume(esp_asp_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
     esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)handle;
+    esp_gmf_oal_mutex_lock(player->queue_lock);
+    if (player->splice_running) {
+        _notify_queue_state(player, ESP_ASP_STATE_RUNNING);
+        xEventGroupSetBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_RUN_BIT);
+        esp_gmf_oal_mutex_unlock(player->queue_lock);
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_unlock(player->queue_lock);
+    ESP_GMF_NULL_CHECK(TAG, player->pipe, return ESP_GMF_ERR_INVALID_STATE);
     return esp_gmf_pipeline_resume(player->pipe);
 }
 
@@ -423,7 +813,10 @@ esp_gmf_err_t esp_audio_simple_player_destroy(esp_asp_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
     esp_audio_simple_player_t *player = (esp_audio_simple_player_t *)handle;
-    if ((player->state == ESP_ASP_STATE_RUNNING) || (player->state == ESP_ASP_STATE_PAUSED)) {
+    if (player->splice_running) {
+        ESP_LOGW(TAG, "The play queue still running, stop it first");
+        asp_queue_stop(player);
+    } else if ((player->state == ESP_ASP_STATE_RUNNING) || (player->state == ESP_ASP_STATE_PAUSED)) {
         ESP_LOGW(TAG, "The player still running, call stop first, st: % d", player->state);
         xEventGroupClearBits(player->wait_event, ASP_PIPELINE_ERROR_BIT | ASP_PIPELINE_STOPPED_BIT | ASP_PIPELINE_FINISHED_BIT);
         esp_audio_simple_player_stop(handle);
@@ -440,6 +833,23 @@ esp_gmf_err_t esp_audio_simple_player_destroy(esp_asp_handle_t handle)
     esp_asp_decoder_ref_count--;
     esp_gmf_task_deinit(player->work_task);
     esp_gmf_pipeline_destroy(player->pipe);
+    // Wait for a finished splice thread to be gone before the decks are released
+    xEventGroupWaitBits((EventGroupHandle_t)player->splice_event, ASP_SPLICE_EXIT_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+    for (int i = 0; i < ESP_ASP_DECK_NUM; i++) {
+        esp_asp_deck_t *deck = &player->decks[i];
+        if (deck->task) {
+            esp_gmf_task_deinit(deck->task);
+        }
+        if (deck->pipe) {
+            esp_gmf_pipeline_destroy(deck->pipe);
+        }
+        if (deck->stash) {
+            esp_gmf_db_deinit(deck->stash);
+        }
+        esp_gmf_oal_free(deck->uri);
+    }
+    vEventGroupDelete(player->splice_event);
+    esp_gmf_oal_mutex_destroy(player->queue_lock);
     esp_gmf_pool_deinit(player->pool);
     esp_gmf_oal_free(player);
 
@@ -27,24 +27,65 @@
 #include "esp_gmf_pool.h"
 #include "esp_gmf_element.h"
 #include "esp_gmf_pipeline.h"
+#include "esp_gmf_data_bus.h"
+#include "sys/queue.h"
+#include "esp_gmf_info.h"
 #include "esp_audio_simple_player.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif  /* __cplusplus */
 
+#define ESP_ASP_DECK_NUM  (2)  /*!< One deck feeds the output while the other one prefetches the next track */
+
+/**
+ * @brief Track waiting in the play queue
+ */
+typedef struct esp_asp_track {
+    STAILQ_ENTRY(esp_asp_track)  next;      /*!< Link to the next queued track */
+    char                        *uri;       /*!< URI of the track */
+    esp_asp_music_info_t         info;      /*!< Music information for raw encoded data */
+    bool                         has_info;  /*!< Whether the music information is given */
+} esp_asp_track_t;
+
+typedef STAILQ_HEAD(esp_asp_track_list, esp_asp_track) esp_asp_track_list_t;  /*!< Play queue of the player */
+
+/**
+ * @brief Prefetch deck, decodes a queued track into its stash ahead of the output
+ */
+typedef struct {
+    void                      *parent;     /*!< Player owning the deck */
+    uint8_t                    id;         /*!< Index of the deck in the player */
+    esp_gmf_pipeline_handle_t  pipe;       /*!< Deck pipeline, IN IO, decoder and converters */
+    void                      *task;       /*!< Task running the deck pipeline */
+    esp_gmf_db_handle_t        stash;      /*!< Ring buffer holding the decoded PCM until the splice reaches it */
+    esp_gmf_info_sound_t       info;       /*!< Sound information reported by the deck output */
+    char                      *uri;        /*!< URI of the loaded track */
+    bool                       loaded;     /*!< The deck holds a track which is not drained yet */
+    bool                       announced;  /*!< The track change is reported to user */
+} esp_asp_deck_t;
+
 /**
  * @brief Structure representing the audio simple player instance
  */
 typedef struct {
-    esp_gmf_pool_handle_t      pool;        /*!< Handle to the element pool used for ASP */
-    esp_gmf_pipeline_handle_t  pipe;        /*!< Handle to the audio pipeline */
-    esp_asp_state_t            state;       /*!< Current state of the player (running, paused, stopped, etc.) */
-    void                      *work_task;   /*!< Pointer to the player's worker task */
-    esp_asp_cfg_t              cfg;         /*!< Configuration parameters for the player */
-    esp_asp_event_func         event_cb;    /*!< Callback function for player events */
-    void                      *user_ctx;    /*!< User context passed to event callbacks */
-    void                      *wait_event;  /*!< Event used for task synchronization */
+    esp_gmf_pool_handle_t      pool;                     /*!< Handle to the element pool used for ASP */
+    esp_gmf_pipeline_handle_t  pipe;                     /*!< Handle to the audio pipeline */
+    esp_asp_state_t            state;                    /*!< Current state of the player (running, paused, stopped, etc.) */
+    void                      *work_task;                /*!< Pointer to the player's worker task */
+    esp_asp_cfg_t              cfg;                      /*!< Configuration parameters for the player */
+    esp_asp_event_func         event_cb;                 /*!< Callback function for player events */
+    void                      *user_ctx;                 /*!< User context passed to event callbacks */
+    void                      *wait_event;               /*!< Event used for task synchronization */
+    esp_asp_track_list_t       queue;                    /*!< Tracks waiting for a free deck */
+    esp_asp_deck_t             decks[ESP_ASP_DECK_NUM];  /*!< Prefetch decks of the play queue */
+    uint8_t                    live_deck;                /*!< Index of the deck feeding the output */
+    esp_gmf_info_sound_t       out_info;                 /*!< Sound information last reported on the play queue */
+    void                      *queue_lock;               /*!< Lock of the play queue and the decks */
+    void                      *splice_thread;            /*!< Thread moving PCM from the live deck to the output */
+    void                      *splice_event;             /*!< Event group of the splice thread */
+    bool                       splice_running;           /*!< The splice thread is feeding the output */
+    bool                       splice_quit;              /*!< Request the splice thread to quit */
 } esp_audio_simple_player_t;
 
 #ifdef __cplusplus
@@ -17,6 +17,7 @@
 #include "esp_gmf_pipeline.h"
 #include "esp_gmf_pool.h"
 #include "esp_gmf_alc.h"
+#include "esp_gmf_oal_sys.h"
 
 #include "esp_audio_simple_player.h"
 #include "esp_audio_simple_player_advance.h"
@@ -28,6 +29,25 @@ static const char *TAG = "PLAYER_TEST";
 
 #define PIPELINE_BLOCK_BIT BIT(0)
 
+#define GAPLESS_TRACK_NUM     (3)
+#define GAPLESS_TRACK_SAMPLES (24000)
+#ifdef CONFIG_AUDIO_SIMPLE_PLAYER_RESAMPLE_DEST_RATE
+#define GAPLESS_SAMPLE_RATE (CONFIG_AUDIO_SIMPLE_PLAYER_RESAMPLE_DEST_RATE)
+#else
+#define GAPLESS_SAMPLE_RATE (48000)
+#endif  /* CONFIG_AUDIO_SIMPLE_PLAYER_RESAMPLE_DEST_RATE */
+
+typedef struct {
+    SemaphoreHandle_t  done;
+    int16_t            expect;
+    int                samples;
+    int                discontinuity;
+    int                tracks;
+    bool               boundary;
+    int64_t            last_us;
+    int64_t            max_gap_us;
+} gapless_sink_t;
+
 static const char *dec_file_path[] = {
     "file://sdcard/test.opus",
     "file://sdcard/test.m4a",
@@ -72,6 +92,81 @@ static int mock_event_callback(esp_asp_event_pkt_t *event, void *ctx)
     return 0;
 }
 
+static void gapless_write_wav(const char *path, int start, int samples)
+{
+    FILE *fp = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    uint32_t data_size = samples * sizeof(int16_t);
+    uint32_t riff_size = 36 + data_size;
+    uint32_t fmt_size = 16;
+    uint16_t fmt_tag = 1;
+    uint16_t channels = 1;
+    uint32_t rate = GAPLESS_SAMPLE_RATE;
+    uint32_t byte_rate = GAPLESS_SAMPLE_RATE * sizeof(int16_t);
+    uint16_t block_align = sizeof(int16_t);
+    uint16_t bits = 16;
+    fwrite("RIFF", 1, 4, fp);
+    fwrite(&riff_size, 1, 4, fp);
+    fwrite("WAVEfmt ", 1, 8, fp);
+    fwrite(&fmt_size, 1, 4, fp);
+    fwrite(&fmt_tag, 1, 2, fp);
+    fwrite(&channels, 1, 2, fp);
+    fwrite(&rate, 1, 4, fp);
+    fwrite(&byte_rate, 1, 4, fp);
+    fwrite(&block_align, 1, 2, fp);
+    fwrite(&bits, 1, 2, fp);
+    fwrite("data", 1, 4, fp);
+    fwrite(&data_size, 1, 4, fp);
+    // The ramp goes on across the tracks, any lost, repeated or inserted sample breaks it
+    for (int i = 0; i < samples; i++) {
+        int16_t v = (int16_t)(start + i);
+        fwrite(&v, 1, sizeof(v), fp);
+    }
+    fclose(fp);
+}
+
+static int gapless_out_callback(uint8_t *data, int data_size, void *ctx)
+{
+    gapless_sink_t *sink = (gapless_sink_t *)ctx;
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    if (sink->boundary && sink->samples) {
+        int64_t gap = now - sink->last_us;
+        if (gap > sink->max_gap_us) {
+            sink->max_gap_us = gap;
+        }
+    }
+    sink->boundary = false;
+    sink->last_us = now;
+    int16_t *pcm = (int16_t *)data;
+    for (int i = 0; i < data_size / sizeof(int16_t); i++) {
+        if (pcm[i] != sink->expect) {
+            sink->discontinuity++;
+        }
+        sink->expect = pcm[i] + 1;
+    }
+    sink->samples += data_size / sizeof(int16_t);
+    // Pace the output like a sink device does
+    vTaskDelay(1);
+    return 0;
+}
+
+static int gapless_event_callback(esp_asp_event_pkt_t *event, void *ctx)
+{
+    gapless_sink_t *sink = (gapless_sink_t *)ctx;
+    if (event->type == ESP_ASP_EVENT_TYPE_TRACK) {
+        ESP_LOGI(TAG, "Track on output, %s", (char *)event->payload);
+        sink->tracks++;
+        sink->boundary = true;
+    } else if (event->type == ESP_ASP_EVENT_TYPE_STATE) {
+        esp_asp_state_t st = 0;
+        memcpy(&st, event->payload, event->payload_size);
+        if ((st == ESP_ASP_STATE_STOPPED) || (st == ESP_ASP_STATE_FINISHED) || (st == ESP_ASP_STATE_ERROR)) {
+            xSemaphoreGive(sink->done);
+        }
+    }
+    return 0;
+}
+
 void task_audio_run_to_end(void *param)
 {
     const char *uri = "file://sdcard/test.mp3";
@@ -595,3 +690,73 @@ TEST_CASE("Play, Multiple-file Async Playing", "Simple_Player")
     vTaskDelay(1000 / portTICK_PERIOD_MS);
     ESP_GMF_MEM_SHOW(TAG);
 }
+
+TEST_CASE("Play, gapless queue versus run to end on WAV", "Simple_Player")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    void *card = NULL;
+    esp_gmf_setup_periph_sdmmc(&card);
+    char uri[GAPLESS_TRACK_NUM][48] = {0};
+    for (int i = 0; i < GAPLESS_TRACK_NUM; i++) {
+        char path[32] = {0};
+        snprintf(path, sizeof(path), "/sdcard/gapless_%d.wav", i);
+        snprintf(uri[i], sizeof(uri[i]), "file:/%s", path);
+        gapless_write_wav(path, i * GAPLESS_TRACK_SAMPLES, GAPLESS_TRACK_SAMPLES);
+    }
+    gapless_sink_t sink = {0};
+    sink.done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(sink.done);
+    esp_asp_cfg_t cfg = {
+        .in.cb = NULL,
+        .in.user_ctx = NULL,
+        .out.cb = gapless_out_callback,
+        .out.user_ctx = &sink,
+        .task_prio = 5,
+    };
+    esp_asp_handle_t handle = NULL;
+    esp_gmf_err_t err = esp_audio_simple_player_new(&cfg, &handle);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+    err = esp_audio_simple_player_set_event(handle, gapless_event_callback, &sink);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+
+    // Baseline, one pipeline setup per track
+    for (int i = 0; i < GAPLESS_TRACK_NUM; i++) {
+        sink.boundary = true;
+        err = esp_audio_simple_player_run_to_end(handle, uri[i], NULL);
+        TEST_ASSERT_EQUAL(ESP_OK, err);
+        xSemaphoreTake(sink.done, 0);
+    }
+    int64_t run_gap_us = sink.max_gap_us;
+    TEST_ASSERT_EQUAL(GAPLESS_TRACK_NUM * GAPLESS_TRACK_SAMPLES, sink.samples);
+
+    // Same tracks again through the play queue
+    sink = (gapless_sink_t) {
+        .done = sink.done,
+    };
+    for (int i = 0; i < GAPLESS_TRACK_NUM; i++) {
+        err = esp_audio_simple_player_queue(handle, uri[i], NULL);
+        TEST_ASSERT_EQUAL(ESP_OK, err);
+    }
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sink.done, pdMS_TO_TICKS(20000)));
+    esp_asp_state_t st = ESP_ASP_STATE_NONE;
+    esp_audio_simple_player_get_state(handle, &st);
+    TEST_ASSERT_EQUAL(ESP_ASP_STATE_FINISHED, st);
+    ESP_LOGI(TAG, "Inter-track gap, run to end:%lld us, queue:%lld us", run_gap_us, sink.max_gap_us);
+    TEST_ASSERT_EQUAL(GAPLESS_TRACK_NUM, sink.tracks);
+    TEST_ASSERT_EQUAL(GAPLESS_TRACK_NUM * GAPLESS_TRACK_SAMPLES, sink.samples);
+    TEST_ASSERT_EQUAL(0, sink.discontinuity);
+    TEST_ASSERT_LESS_THAN(run_gap_us, sink.max_gap_us);
+
+    err = esp_audio_simple_player_destroy(handle);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+    vSemaphoreDelete(sink.done);
+    for (int i = 0; i < GAPLESS_TRACK_NUM; i++) {
+        char path[32] = {0};
+        snprintf(path, sizeof(path), "/sdcard/gapless_%d.wav", i);
+        remove(path);
+    }
+    esp_gmf_teardown_periph_sdmmc(card);
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    ESP_GMF_MEM_SHOW(TAG);
+}
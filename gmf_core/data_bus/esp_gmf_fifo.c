@@ -43,17 +43,29 @@ typedef struct esp_esp_gmf_fifo_node {
     bool                          is_done;
 } esp_gmf_fifo_node_t;
 
+/**
+ * @brief  Singly linked list of FIFO nodes with both ends kept, so that push and pop are O(1)
+ */
+typedef struct {
+    esp_gmf_fifo_node_t *head;  /*!< First node, the next one to pop */
+    esp_gmf_fifo_node_t *tail;  /*!< Last node, new nodes are appended behind it */
+    uint32_t             cnt;   /*!< Number of nodes in the list */
+} esp_gmf_fifo_list_t;
+
 /**
  * @brief  Structure representing a FIFO (First-In-First-Out) buffer
  */
 typedef struct {
-    uint32_t             node_cnt;            /*!< Maximum number of buffer nodes in the FIFO */
-    uint32_t             capacity;            /*!< Current number of buffers in the FIFO */
+    uint32_t             node_cnt;            /*!< Current number of buffer nodes in the FIFO */
+    uint32_t             capacity;            /*!< Maximum number of buffer nodes in the FIFO */
+    uint32_t             block_size;          /*!< Buffer size of the preallocated nodes */
+    uint32_t             total_size;          /*!< Sum of the buffer length of all the nodes */
+    uint32_t             fill_size;           /*!< Sum of the buffer length of the filled nodes */
     SemaphoreHandle_t    can_read;            /*!< Semaphore for indicating available data for reading. It blocks reading operations when no data is available */
     SemaphoreHandle_t    can_write;           /*!< Semaphore for indicating available space for writing. It blocks writing operations when the FIFO is full */
     SemaphoreHandle_t    lock;                /*!< Semaphore for controlling exclusive access to the FIFO to ensure thread safety */
-    esp_gmf_fifo_node_t *empty_head;          /*!< Pointer to the head of the list of empty buffer nodes that can be used for writing */
-    esp_gmf_fifo_node_t *fill_head;           /*!< Pointer to the head of the list of filled buffer nodes that can be read */
+    esp_gmf_fifo_list_t  empty;               /*!< List of empty buffer nodes that can be used for writing */
+    esp_gmf_fifo_list_t  fill;                /*!< List of filled buffer nodes that can be read */
     uint8_t              _is_write_done : 1;  /*!< Flag indicating if all writing operations to the FIFO have been completed. Set to 1 when writing is finished */
     uint8_t              _is_abort      : 1;  /*!< Flag indicating if an abort operation has been requested. Set to 1 to signal that FIFO operations should be aborted */
 } esp_gmf_fifo_t;
@@ -85,16 +97,6 @@ static inline esp_gmf_fifo_node_t *esp_gmf_fifo_node_with_buf_create(size_t buf_
     return node;
 }
 
-static inline int esp_gmf_fifo_node_get_cnt(esp_gmf_fifo_node_t *node)
-{
-    int cnt = 0;
-    while (node) {
-        cnt++;
-        node = node->next;
-    }
-    return cnt;
-}
-
 static inline void esp_gmf_fifo_node_destroy(esp_gmf_fifo_node_t *node)
 {
     if (!node) {
@@ -107,18 +109,40 @@ static inline void esp_gmf_fifo_node_destroy(esp_gmf_fifo_node_t *node)
     esp_gmf_oal_free(node);
 }
 
+static inline void esp_gmf_fifo_list_push(esp_gmf_fifo_list_t *list, esp_gmf_fifo_node_t *node)
+{
+    node->next = NULL;
+    if (list->tail) {
+        list->tail->next = node;
+    } else {
+        list->head = node;
+    }
+    list->tail = node;
+    list->cnt++;
+}
+
+static inline esp_gmf_fifo_node_t *esp_gmf_fifo_list_pop(esp_gmf_fifo_list_t *list)
+{
+    esp_gmf_fifo_node_t *node = list->head;
+    if (node) {
+        list->head = node->next;
+        if (list->head == NULL) {
+            list->tail = NULL;
+        }
+        node->next = NULL;
+        list->cnt--;
+    }
+    return node;
+}
+
 static inline void _gmf_fifo_handle_free(esp_gmf_fifo_handle_t handle)
 {
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
-    while (fifo->empty_head) {
-        esp_gmf_fifo_node_t *node = fifo->empty_head;
-        fifo->empty_head = fifo->empty_head->next;
+    esp_gmf_fifo_node_t *node = NULL;
+    while ((node = esp_gmf_fifo_list_pop(&fifo->empty))) {
         esp_gmf_fifo_node_destroy(node);
     }
-
-    while (fifo->fill_head) {
-        esp_gmf_fifo_node_t *node = fifo->fill_head;
-        fifo->fill_head = fifo->fill_head->next;
+    while ((node = esp_gmf_fifo_list_pop(&fifo->fill))) {
         esp_gmf_fifo_node_destroy(node);
     }
 
@@ -151,6 +175,7 @@ esp_gmf_err_t esp_gmf_fifo_create(int block_cnt, int block_size, esp_gmf_fifo_ha
     ESP_GMF_MEM_CHECK(TAG, fifo->lock, goto esp_gmf_fifo_err;);
 
     fifo->capacity = block_cnt;
+    fifo->block_size = block_size > 0 ? block_size : 0;
     fifo->node_cnt = 0;
     fifo->_is_write_done = 0;
     *handle = fifo;
@@ -161,6 +186,28 @@ esp_gmf_fifo_err:
     return ESP_GMF_ERR_FAIL;
 }
 
+esp_gmf_err_t esp_gmf_fifo_prealloc(esp_gmf_fifo_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
+    if (fifo->block_size == 0) {
+        ESP_LOGE(TAG, "No block size to preallocate, hd:%p", handle);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    esp_gmf_oal_mutex_lock(fifo->lock);
+    while (fifo->node_cnt < fifo->capacity) {
+        esp_gmf_fifo_node_t *node = esp_gmf_fifo_node_with_buf_create(fifo->block_size);
+        ESP_GMF_MEM_CHECK(TAG, node, {ret = ESP_GMF_ERR_MEMORY_LACK; break;});
+        esp_gmf_fifo_list_push(&fifo->empty, node);
+        fifo->node_cnt++;
+        fifo->total_size += node->buf_length;
+    }
+    esp_gmf_oal_mutex_unlock(fifo->lock);
+    ESP_LOGD(TAG, "Preallocated, hd:%p, n:%ld, sz:%ld", handle, fifo->node_cnt, fifo->block_size);
+    return ret;
+}
+
 esp_gmf_err_t esp_gmf_fifo_destroy(esp_gmf_fifo_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -174,8 +221,8 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_read(esp_gmf_fifo_handle_t handle, esp_gmf
     ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
     ESP_LOGD(TAG, "RD_ACQ+, hd:%p, wanted:%ld, ticks:%d", handle, wanted_size, block_ticks);
-    if (fifo->fill_head == NULL) {
-        while (fifo->fill_head == NULL) {
+    if (fifo->fill.head == NULL) {
+        while (fifo->fill.head == NULL) {
             if (xSemaphoreTake(fifo->can_read, block_ticks) != pdTRUE) {
                 ESP_LOGE(TAG, "FIFO acquire read timeout");
                 return ESP_GMF_IO_TIMEOUT;
@@ -185,13 +232,13 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_read(esp_gmf_fifo_handle_t handle, esp_gmf
             }
         }
     }
-    esp_gmf_fifo_node_t *node = fifo->fill_head;
+    esp_gmf_fifo_node_t *node = fifo->fill.head;
     blk->buf = node->buffer;
     blk->buf_length = node->buf_length;
     blk->valid_size = node->valid_size;
     blk->is_last = node->is_done;
-    ESP_LOGD(TAG, "RD_ACQ-, hd:%p, b:%p, l:%d, valid:%d, n:%ld, e:%d, f:%d", handle, blk->buf, blk->buf_length, blk->valid_size, fifo->node_cnt,
-             esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+    ESP_LOGD(TAG, "RD_ACQ-, hd:%p, b:%p, l:%d, valid:%d, n:%ld, e:%ld, f:%ld", handle, blk->buf, blk->buf_length, blk->valid_size, fifo->node_cnt,
+             fifo->empty.cnt, fifo->fill.cnt);
     return blk->valid_size;
 }
 
@@ -203,30 +250,20 @@ esp_gmf_err_io_t esp_gmf_fifo_release_read(esp_gmf_fifo_handle_t handle, esp_gmf
 
     ESP_LOGD(TAG, "RD_RLS+, hd:%p, b:%p, l:%d", handle, blk->buf, blk->buf_length);
     esp_gmf_oal_mutex_lock(fifo->lock);
-    esp_gmf_fifo_node_t *node = fifo->fill_head;
-    fifo->fill_head = node->next;
-    if (node->buffer != blk->buf) {
+    if ((fifo->fill.head == NULL) || (fifo->fill.head->buffer != blk->buf)) {
         ESP_LOGE(TAG, "Release read error, buffer not match");
         esp_gmf_oal_mutex_unlock(fifo->lock);
         return ESP_GMF_IO_FAIL;
     }
-
+    esp_gmf_fifo_node_t *node = esp_gmf_fifo_list_pop(&fifo->fill);
+    fifo->fill_size -= node->buf_length;
     node->is_done = false;
     node->valid_size = 0;
-    node->next = NULL;
-    if (fifo->empty_head == NULL) {
-        fifo->empty_head = node;
-    } else {
-        esp_gmf_fifo_node_t *tmp = fifo->empty_head;
-        while (tmp->next != NULL) {
-            tmp = tmp->next;
-        }
-        tmp->next = node;
-    }
+    esp_gmf_fifo_list_push(&fifo->empty, node);
     xSemaphoreGive(fifo->can_write);
     esp_gmf_oal_mutex_unlock(fifo->lock);
-    ESP_LOGD(TAG, "RD_RLS-, hd:%p, b:%p, l:%d, n:%ld, e:%d, f:%d", handle, blk->buf, blk->buf_length, fifo->node_cnt,
-             esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+    ESP_LOGD(TAG, "RD_RLS-, hd:%p, b:%p, l:%d, n:%ld, e:%ld, f:%ld", handle, blk->buf, blk->buf_length, fifo->node_cnt,
+             fifo->empty.cnt, fifo->fill.cnt);
     return ESP_GMF_ERR_OK;
 }
 
@@ -239,17 +276,18 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gm
     ESP_LOGD(TAG, "WR_ACQ+, hd:%p, wanted:%ld, ticks:%d", handle, wanted_size, block_ticks);
     esp_gmf_fifo_node_t *node = NULL;
     esp_gmf_oal_mutex_lock(fifo->lock);
-    if (fifo->empty_head == NULL) {
+    if (fifo->empty.head == NULL) {
         if (fifo->node_cnt < fifo->capacity) {
             node = esp_gmf_fifo_node_with_buf_create(wanted_size);
             ESP_GMF_NULL_CHECK(TAG, node, {esp_gmf_oal_mutex_unlock(fifo->lock); return ESP_GMF_ERR_MEMORY_LACK;});
-            fifo->empty_head = node;
+            esp_gmf_fifo_list_push(&fifo->empty, node);
             fifo->node_cnt++;
-            ESP_LOGD(TAG, "New an empty node:%p, addr:%p, n:%ld, e:%d, f:%d", node, node->buffer, fifo->node_cnt,
-                     esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+            fifo->total_size += node->buf_length;
+            ESP_LOGD(TAG, "New an empty node:%p, addr:%p, n:%ld, e:%ld, f:%ld", node, node->buffer, fifo->node_cnt,
+                     fifo->empty.cnt, fifo->fill.cnt);
         } else {
             esp_gmf_oal_mutex_unlock(fifo->lock);
-            while (fifo->empty_head == NULL) {
+            while (fifo->empty.head == NULL) {
                 if (xSemaphoreTake(fifo->can_write, block_ticks) != pdTRUE) {
                     return ESP_GMF_IO_FAIL;
                 }
@@ -260,20 +298,23 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gm
             esp_gmf_oal_mutex_lock(fifo->lock);
         }
     }
-    node = fifo->empty_head;
+    node = fifo->empty.head;
     if (node->buf_length < wanted_size) {
         esp_gmf_oal_free(node->buffer);
+        fifo->total_size -= node->buf_length;
+        node->buf_length = 0;
         node->buffer = esp_gmf_oal_malloc(wanted_size);
         ESP_GMF_NULL_CHECK(TAG, node->buffer, {esp_gmf_oal_mutex_unlock(fifo->lock); return ESP_GMF_ERR_MEMORY_LACK;});
         node->buf_length = wanted_size;
+        fifo->total_size += wanted_size;
     }
 
     blk->buf = node->buffer;
     blk->buf_length = node->buf_length;
     blk->is_last = node->is_done;
     esp_gmf_oal_mutex_unlock(fifo->lock);
-    ESP_LOGD(TAG, "WR_ACQ-, hd:%p, b:%p, l:%d, n:%ld, e:%d, f:%d", handle, blk->buf, blk->buf_length, fifo->node_cnt,
-             esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+    ESP_LOGD(TAG, "WR_ACQ-, hd:%p, b:%p, l:%d, n:%ld, e:%ld, f:%ld", handle, blk->buf, blk->buf_length, fifo->node_cnt,
+             fifo->empty.cnt, fifo->fill.cnt);
     return blk->buf_length;
 }
 
@@ -282,36 +323,27 @@ esp_gmf_err_io_t esp_gmf_fifo_release_write(esp_gmf_fifo_handle_t handle, esp_gm
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
     ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
-    ESP_LOGD(TAG, "WR_RLS+, hd:%p, b:%p, l:%d, valid:%d, %d, %d", handle, blk->buf, blk->buf_length, blk->valid_size, esp_gmf_fifo_node_get_cnt(fifo->empty_head),
-             esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+    ESP_LOGD(TAG, "WR_RLS+, hd:%p, b:%p, l:%d, valid:%d, %ld, %ld", handle, blk->buf, blk->buf_length, blk->valid_size, fifo->empty.cnt,
+             fifo->fill.cnt);
     esp_gmf_oal_mutex_lock(fifo->lock);
-    esp_gmf_fifo_node_t *node = fifo->empty_head;
+    esp_gmf_fifo_node_t *node = esp_gmf_fifo_list_pop(&fifo->empty);
     if (node == NULL) {
-        ESP_LOGE(TAG, "%s,%d, empty_head is NULL", __func__, __LINE__);
+        ESP_LOGE(TAG, "%s,%d, no empty node to release", __func__, __LINE__);
         esp_gmf_oal_mutex_unlock(fifo->lock);
         return ESP_GMF_IO_FAIL;
     }
-    fifo->empty_head = node->next;
-
-    node->next = NULL;
-    if (fifo->fill_head == NULL) {
-        fifo->fill_head = node;
-    } else {
-        esp_gmf_fifo_node_t *tmp = fifo->fill_head;
-        while (tmp->next != NULL) {
-            tmp = tmp->next;
-        }
-        tmp->next = node;
-    }
+    fifo->total_size += blk->buf_length - node->buf_length;
     node->buffer = blk->buf;
     node->buf_length = blk->buf_length;
     node->valid_size = blk->valid_size;
     node->is_done = blk->is_last;
+    esp_gmf_fifo_list_push(&fifo->fill, node);
+    fifo->fill_size += node->buf_length;
 
     xSemaphoreGive(fifo->can_read);
     esp_gmf_oal_mutex_unlock(fifo->lock);
-    ESP_LOGD(TAG, "WR_RLS-, hd:%p, b:%p, l:%d, valid:%d, n:%ld, e:%d, f:%d", handle, blk->buf, blk->buf_length, blk->valid_size,
-             fifo->node_cnt, esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+    ESP_LOGD(TAG, "WR_RLS-, hd:%p, b:%p, l:%d, valid:%d, n:%ld, e:%ld, f:%ld", handle, blk->buf, blk->buf_length, blk->valid_size,
+             fifo->node_cnt, fifo->empty.cnt, fifo->fill.cnt);
     return ESP_GMF_ERR_OK;
 }
 
@@ -339,13 +371,13 @@ esp_gmf_err_t esp_gmf_fifo_reset(esp_gmf_fifo_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
-    esp_gmf_fifo_node_t *node = fifo->fill_head;
+    esp_gmf_fifo_node_t *node = fifo->fill.head;
     while (node) {
         node->is_done = 0;
         node->valid_size = 0;
         node = node->next;
     }
-    node = fifo->empty_head;
+    node = fifo->empty.head;
     while (node) {
         node->is_done = 0;
         node->valid_size = 0;
@@ -361,12 +393,7 @@ esp_gmf_err_t esp_gmf_fifo_get_free_size(esp_gmf_fifo_handle_t handle, uint32_t
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     ESP_GMF_NULL_CHECK(TAG, free_size, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
-    *free_size = 0;
-    esp_gmf_fifo_node_t *node = fifo->empty_head;
-    while (node) {
-        *free_size += node->buf_length;
-        node = node->next;
-    }
+    *free_size = fifo->total_size - fifo->fill_size;
     return ESP_GMF_ERR_OK;
 }
 
@@ -375,17 +402,7 @@ esp_gmf_err_t esp_gmf_fifo_get_total_size(esp_gmf_fifo_handle_t handle, uint32_t
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     ESP_GMF_NULL_CHECK(TAG, total_size, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
-    *total_size = 0;
-    esp_gmf_fifo_node_t *node = fifo->empty_head;
-    while (node) {
-        *total_size += node->buf_length;
-        node = node->next;
-    }
-    node = fifo->fill_head;
-    while (node) {
-        *total_size += node->buf_length;
-        node = node->next;
-    }
+    *total_size = fifo->total_size;
     return ESP_GMF_ERR_OK;
 }
 
@@ -394,11 +411,6 @@ esp_gmf_err_t esp_gmf_fifo_get_filled_size(esp_gmf_fifo_handle_t handle, uint32_
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     ESP_GMF_NULL_CHECK(TAG, filled_size, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
-    *filled_size = 0;
-    esp_gmf_fifo_node_t *node = fifo->fill_head;
-    while (node) {
-        *filled_size += node->buf_length;
-        node = node->next;
-    }
+    *filled_size = fifo->fill_size;
     return ESP_GMF_ERR_OK;
 }
@@ -30,9 +30,11 @@
 
 #include "esp_gmf_data_bus.h"
 #include "esp_gmf_ringbuffer.h"
+#include "esp_gmf_spsc_ring.h"
 #include "esp_gmf_block.h"
 #include "esp_gmf_pbuf.h"
 #include "esp_gmf_fifo.h"
+#include "esp_gmf_share.h"
 
 static const char *TAG = "NEW_DATA_BUS";
 
@@ -77,6 +79,88 @@ int esp_gmf_db_new_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h)
     return ESP_GMF_ERR_OK;
 }
 
+int esp_gmf_db_new_ringbuf_zero_copy(int num, int item_cnt, uint32_t max_chunk_size, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_rb_handle_t rb = NULL;
+    esp_gmf_rb_create_zero_copy(num, item_cnt, max_chunk_size, &rb);
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_db_config_t db_config = {
+        .name = "ringbuffer",
+        .type = DATA_BUS_TYPE_BLOCK,
+        .max_size = (item_cnt * num),
+        .max_item_num = num,
+        .child = rb,
+    };
+    esp_gmf_data_bus_t *db = NULL;
+    if (ESP_GMF_ERR_OK != esp_gmf_db_init(&db_config, (esp_gmf_db_handle_t)&db)) {
+        if (rb) {
+            esp_gmf_rb_destroy(rb);
+        }
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    if (db == NULL) {
+        ESP_LOGE(TAG, "DATA BUS is NULL");
+        return ESP_GMF_ERR_FAIL;
+    }
+    db->op.deinit = esp_gmf_rb_destroy;
+    db->op.acquire_read = esp_gmf_rb_acquire_read;
+    db->op.release_read = esp_gmf_rb_release_read;
+    db->op.acquire_write = esp_gmf_rb_acquire_write;
+    db->op.release_write = esp_gmf_rb_release_write;
+    db->op.done_write = esp_gmf_rb_done_write;
+    db->op.reset_done_write = esp_gmf_rb_reset_done_write;
+    db->op.reset = esp_gmf_rb_reset;
+    db->op.abort = esp_gmf_rb_abort;
+    db->op.get_total_size = esp_gmf_rb_get_size;
+    db->op.get_filled_size = esp_gmf_rb_bytes_filled;
+    db->op.get_available = esp_gmf_rb_bytes_available;
+    ESP_LOGI(TAG, "New zero-copy ringbuffer:%p, num:%d, item_cnt:%d, chunk:%ld, db:%p", rb, num, item_cnt, max_chunk_size, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
+int esp_gmf_db_new_spsc_ring(int num, int item_cnt, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_spsc_ring_handle_t rb = NULL;
+    esp_gmf_spsc_ring_create(num, item_cnt, &rb);
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_db_config_t db_config = {
+        .name = "spsc_ring",
+        .type = DATA_BUS_TYPE_BYTE,
+        .max_size = (item_cnt * num),
+        .max_item_num = num,
+        .child = rb,
+    };
+    esp_gmf_data_bus_t *db = NULL;
+    if (ESP_GMF_ERR_OK != esp_gmf_db_init(&db_config, (esp_gmf_db_handle_t)&db)) {
+        if (rb) {
+            esp_gmf_spsc_ring_destroy(rb);
+        }
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    if (db == NULL) {
+        ESP_LOGE(TAG, "DATA BUS is NULL");
+        return ESP_GMF_ERR_FAIL;
+    }
+    db->op.deinit = esp_gmf_spsc_ring_destroy;
+    db->op.acquire_read = esp_gmf_spsc_ring_acquire_read;
+    db->op.release_read = esp_gmf_spsc_ring_release_read;
+    db->op.acquire_write = esp_gmf_spsc_ring_acquire_write;
+    db->op.release_write = esp_gmf_spsc_ring_release_write;
+    db->op.done_write = esp_gmf_spsc_ring_done_write;
+    db->op.reset_done_write = esp_gmf_spsc_ring_reset_done_write;
+    db->op.reset = esp_gmf_spsc_ring_reset;
+    db->op.abort = esp_gmf_spsc_ring_abort;
+    db->op.get_total_size = esp_gmf_spsc_ring_get_size;
+    db->op.get_filled_size = esp_gmf_spsc_ring_bytes_filled;
+    db->op.get_available = esp_gmf_spsc_ring_bytes_available;
+    ESP_LOGI(TAG, "New SPSC ring:%p, num:%d, item_cnt:%d, db:%p", rb, num, item_cnt, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
 int esp_gmf_db_new_block(int num, int item_cnt, esp_gmf_db_handle_t *h)
 {
     ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
@@ -197,3 +281,77 @@ int esp_gmf_db_new_fifo(int num, int item_cnt, esp_gmf_db_handle_t *h)
     *h = db;
     return ESP_GMF_ERR_OK;
 }
+
+int esp_gmf_db_new_fifo_prealloc(int num, int item_cnt, esp_gmf_db_handle_t *h)
+{
+    int ret = esp_gmf_db_new_fifo(num, item_cnt, h);
+    if (ret != ESP_GMF_ERR_OK) {
+        return ret;
+    }
+    ret = esp_gmf_fifo_prealloc(((esp_gmf_data_bus_t *)*h)->child);
+    if (ret != ESP_GMF_ERR_OK) {
+        esp_gmf_db_deinit(*h);
+        *h = NULL;
+    }
+    return ret;
+}
+
+int esp_gmf_db_new_share(int num, int cow_size, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_handle_t handle = NULL;
+    esp_gmf_share_create(num, cow_size, &handle);
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_db_config_t db_config = {
+        .name = "share",
+        .type = DATA_BUS_TYPE_BLOCK,
+        .max_size = (1 * num),
+        .max_item_num = num,
+        .child = handle,
+    };
+    esp_gmf_data_bus_t *db = NULL;
+    if (ESP_GMF_ERR_OK != esp_gmf_db_init(&db_config, (esp_gmf_db_handle_t)&db)) {
+        if (handle) {
+            esp_gmf_share_destroy(handle);
+        }
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    if (db == NULL) {
+        ESP_LOGE(TAG, "DATA BUS is NULL");
+        return ESP_GMF_ERR_FAIL;
+    }
+    db->op.deinit = esp_gmf_share_destroy;
+    db->op.acquire_read = esp_gmf_share_acquire_read;
+    db->op.release_read = esp_gmf_share_release_read;
+    db->op.acquire_write = esp_gmf_share_acquire_write;
+    db->op.release_write = esp_gmf_share_release_write;
+    db->op.done_write = esp_gmf_share_done_write;
+    db->op.reset = esp_gmf_share_reset;
+    db->op.abort = esp_gmf_share_abort;
+    db->op.get_total_size = esp_gmf_share_get_total_size;
+    db->op.get_filled_size = esp_gmf_share_get_filled_size;
+    db->op.get_available = esp_gmf_share_get_free_size;
+    ESP_LOGI(TAG, "New share bus, num:%d, cow:%d, db:%p", num, cow_size, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
+int esp_gmf_db_share_set_release_cb(esp_gmf_db_handle_t h, esp_gmf_share_release_cb cb, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)h;
+    if (db->op.acquire_write != esp_gmf_share_acquire_write) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    return esp_gmf_share_set_release_cb(db->child, cb, ctx);
+}
+
+int esp_gmf_db_share_reclaim(esp_gmf_db_handle_t h, int *count)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)h;
+    if (db->op.acquire_write != esp_gmf_share_acquire_write) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    return esp_gmf_share_reclaim(db->child, count);
+}
@@ -42,6 +42,7 @@ struct esp_gmf_ringbuffer {
     char *volatile p_w;                   /*!< Write pointer */
     volatile uint32_t  fill_cnt;           /*!< Number of filled size */
     uint32_t           size;               /*!< Buffer size */
+    uint32_t           mirror_size;        /*!< Size of the mirrored area behind the buffer end, 0 for copy mode */
     SemaphoreHandle_t  can_read;           /*!< Semaphore to control reading */
     SemaphoreHandle_t  can_write;          /*!< Semaphore to control writing */
     SemaphoreHandle_t  lock;               /*!< Semaphore to protect critical sections */
@@ -50,13 +51,13 @@ struct esp_gmf_ringbuffer {
     uint8_t            is_done_write : 1;  /*!< Flag to signal completion of writing */
 };
 
-esp_gmf_err_t esp_gmf_rb_create(int block_size, int n_blocks, esp_gmf_rb_handle_t *handle)
+static esp_gmf_err_t rb_create(int block_size, int n_blocks, uint32_t mirror_size, esp_gmf_rb_handle_t *handle)
 {
     struct esp_gmf_ringbuffer *rb = NULL;
     *handle = NULL;
     bool _success = (
-                        (rb            = esp_gmf_oal_malloc(sizeof(struct esp_gmf_ringbuffer))) &&
-                        (rb->p_o       = esp_gmf_oal_calloc(n_blocks, block_size)) &&
+                        (rb            = esp_gmf_oal_calloc(1, sizeof(struct esp_gmf_ringbuffer))) &&
+                        (rb->p_o       = esp_gmf_oal_calloc(1, block_size * n_blocks + mirror_size)) &&
                         (rb->can_read  = xSemaphoreCreateBinary()) &&
                         (rb->lock      = xSemaphoreCreateMutex()) &&
                         (rb->can_write = xSemaphoreCreateBinary())
@@ -66,6 +67,7 @@ esp_gmf_err_t esp_gmf_rb_create(int block_size, int n_blocks, esp_gmf_rb_handle_
     rb->p_r = rb->p_w = rb->p_o;
     rb->fill_cnt = 0;
     rb->size = block_size * n_blocks;
+    rb->mirror_size = mirror_size;
     rb->is_done_write = 0;
     rb->abort_read = 0;
     rb->abort_write = 0;
@@ -76,6 +78,21 @@ _esp_gmf_rb_init_failed:
     return ESP_GMF_ERR_FAIL;
 }
 
+esp_gmf_err_t esp_gmf_rb_create(int block_size, int n_blocks, esp_gmf_rb_handle_t *handle)
+{
+    return rb_create(block_size, n_blocks, 0, handle);
+}
+
+esp_gmf_err_t esp_gmf_rb_create_zero_copy(int block_size, int n_blocks, uint32_t max_chunk_size, esp_gmf_rb_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    if ((max_chunk_size == 0) || (max_chunk_size > block_size * n_blocks)) {
+        ESP_LOGE(TAG, "Invalid chunk size %ld for ring size %d", max_chunk_size, block_size * n_blocks);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    return rb_create(block_size, n_blocks, max_chunk_size, handle);
+}
+
 esp_gmf_err_t esp_gmf_rb_destroy(esp_gmf_rb_handle_t handle)
 {
     struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
@@ -117,6 +134,147 @@ esp_gmf_err_t esp_gmf_rb_reset(esp_gmf_rb_handle_t handle)
     return ESP_GMF_ERR_OK;
 }
 
+static esp_gmf_err_io_t rb_zc_acquire_read(struct esp_gmf_ringbuffer *rb, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    uint32_t read_size = 0;
+    if (wanted_size > rb->mirror_size) {
+        wanted_size = rb->mirror_size;
+    }
+    blk->valid_size = 0;
+    ESP_LOGV(TAG, "ZC_ACQ_RD+:%p, s:%ld", rb, wanted_size);
+    while (1) {
+        if (xSemaphoreTake(rb->lock, portMAX_DELAY) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+        if (rb->fill_cnt >= wanted_size) {
+            read_size = wanted_size;
+            break;
+        }
+        if (rb->is_done_write) {
+            // Hand out the remaining data as it is, the same as the copy mode does on done
+            read_size = rb->fill_cnt;
+            blk->is_last = 1;
+            if (read_size == 0) {
+                xSemaphoreGive(rb->lock);
+                return ESP_GMF_IO_OK;
+            }
+            break;
+        }
+        if (rb->abort_read) {
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        xSemaphoreGive(rb->lock);
+        xSemaphoreGive(rb->can_write);
+        if (xSemaphoreTake(rb->can_read, ticks_to_wait) != pdTRUE) {
+            // Deliver what has arrived in multiple of 4 bytes, as the copy mode returns the partial data on timeout
+            xSemaphoreTake(rb->lock, portMAX_DELAY);
+            read_size = rb->fill_cnt & 0xfffffffc;
+            if (read_size == 0) {
+                xSemaphoreGive(rb->lock);
+                return ESP_GMF_IO_TIMEOUT;
+            }
+            break;
+        }
+    }
+    char *end = rb->p_o + rb->size;
+    if ((rb->p_r + read_size) > end) {
+        // Mirror the wrapped head behind the end to keep the region contiguous
+        memcpy(end, rb->p_o, rb->p_r + read_size - end);
+    }
+    blk->buf = (uint8_t *)rb->p_r;
+    blk->buf_length = read_size;
+    blk->valid_size = read_size;
+    xSemaphoreGive(rb->lock);
+    ESP_LOGV(TAG, "ZC_ACQ_RD-:%p, b:%p, ret:%ld", rb, blk->buf, read_size);
+    return read_size;
+}
+
+static esp_gmf_err_io_t rb_zc_release_read(struct esp_gmf_ringbuffer *rb, esp_gmf_data_bus_block_t *blk)
+{
+    xSemaphoreTake(rb->lock, portMAX_DELAY);
+    if ((blk->valid_size > rb->fill_cnt) || ((blk->valid_size > 0) && (blk->buf != (uint8_t *)rb->p_r))) {
+        ESP_LOGE(TAG, "Release read mismatch, rb:%p, b:%p, r:%p, vld:%d, fill:%ld", rb, blk->buf, rb->p_r, blk->valid_size, rb->fill_cnt);
+        xSemaphoreGive(rb->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    rb->p_r += blk->valid_size;
+    if (rb->p_r >= rb->p_o + rb->size) {
+        rb->p_r -= rb->size;
+    }
+    rb->fill_cnt -= blk->valid_size;
+    xSemaphoreGive(rb->lock);
+    if (blk->valid_size > 0) {
+        xSemaphoreGive(rb->can_write);
+    }
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t rb_zc_acquire_write(struct esp_gmf_ringbuffer *rb, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    if (wanted_size > rb->mirror_size) {
+        wanted_size = rb->mirror_size;
+    }
+    ESP_LOGV(TAG, "ZC_ACQ_WR+:%p, s:%ld", rb, wanted_size);
+    while (1) {
+        if (xSemaphoreTake(rb->lock, portMAX_DELAY) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+        if ((rb->size - rb->fill_cnt) >= wanted_size) {
+            break;
+        }
+        if (rb->is_done_write) {
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_OK;
+        }
+        if (rb->abort_write) {
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        xSemaphoreGive(rb->lock);
+        xSemaphoreGive(rb->can_read);
+        if (xSemaphoreTake(rb->can_write, ticks_to_wait) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+    }
+    // The part behind the end lands in the mirrored area and is folded back on release
+    blk->buf = (uint8_t *)rb->p_w;
+    blk->buf_length = wanted_size;
+    blk->valid_size = 0;
+    xSemaphoreGive(rb->lock);
+    ESP_LOGV(TAG, "ZC_ACQ_WR-:%p, b:%p, ret:%ld", rb, blk->buf, wanted_size);
+    return wanted_size;
+}
+
+static esp_gmf_err_io_t rb_zc_release_write(struct esp_gmf_ringbuffer *rb, esp_gmf_data_bus_block_t *blk)
+{
+    xSemaphoreTake(rb->lock, portMAX_DELAY);
+    uint32_t write_size = blk->valid_size;
+    if ((write_size > rb->size - rb->fill_cnt) || (write_size > rb->mirror_size)
+        || ((write_size > 0) && (blk->buf != (uint8_t *)rb->p_w))) {
+        ESP_LOGE(TAG, "Release write mismatch, rb:%p, b:%p, w:%p, vld:%ld, fill:%ld", rb, blk->buf, rb->p_w, write_size, rb->fill_cnt);
+        xSemaphoreGive(rb->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    char *end = rb->p_o + rb->size;
+    if ((rb->p_w + write_size) > end) {
+        memcpy(rb->p_o, end, rb->p_w + write_size - end);
+    }
+    rb->p_w += write_size;
+    if (rb->p_w >= end) {
+        rb->p_w -= rb->size;
+    }
+    rb->fill_cnt += write_size;
+    xSemaphoreGive(rb->lock);
+    if (write_size > 0) {
+        xSemaphoreGive(rb->can_read);
+    }
+    if (blk->is_last) {
+        esp_gmf_rb_done_write(rb);
+    }
+    return write_size;
+}
+
 esp_gmf_err_io_t esp_gmf_rb_acquire_read(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
 {
     struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
@@ -128,6 +286,9 @@ esp_gmf_err_io_t esp_gmf_rb_acquire_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
         ESP_LOGE(TAG, "Invalid parameters on acquire read, rb:%p, blk:%p", rb, blk);
         return ESP_GMF_IO_FAIL;
     }
+    if (rb->mirror_size) {
+        return rb_zc_acquire_read(rb, blk, wanted_size, ticks_to_wait);
+    }
     uint32_t buf_len = wanted_size;
     uint8_t *buf = blk->buf;
     ESP_LOGV(TAG, "ACQ_RD+:%p, b:%p, l:%d, s:%ld", rb, buf, blk->buf_length, wanted_size);
@@ -214,12 +375,20 @@ read_err:
 
 esp_gmf_err_io_t esp_gmf_rb_release_read(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
 {
-    // Do nothing
+    struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
+    if (rb && blk && rb->mirror_size) {
+        return rb_zc_release_read(rb, blk);
+    }
+    // Do nothing for copy mode
     return ESP_GMF_IO_OK;
 }
 
 esp_gmf_err_io_t esp_gmf_rb_acquire_write(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
 {
+    struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
+    if (rb && blk && rb->mirror_size) {
+        return rb_zc_acquire_write(rb, blk, wanted_size, ticks_to_wait);
+    }
     return wanted_size;
 }
 
@@ -233,6 +402,9 @@ esp_gmf_err_io_t esp_gmf_rb_release_write(esp_gmf_rb_handle_t handle, esp_gmf_da
         ESP_LOGE(TAG, "Invalid parameters on release write, rb:%p, blk:%p", rb, blk);
         return ESP_GMF_IO_FAIL;
     }
+    if (rb->mirror_size) {
+        return rb_zc_release_write(rb, blk);
+    }
     uint8_t *buf = blk->buf;
     int buf_len = blk->valid_size;
     esp_gmf_rb_bytes_available(rb, &write_size);
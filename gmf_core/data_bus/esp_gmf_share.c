@@ -0,0 +1,365 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_err.h"
+#include "esp_gmf_share.h"
+
+static const char *TAG = "ESP_GMF_SHARE";
+
+/**
+ * @brief  Structure representing a share bus, the references are kept in a ring of slots
+ */
+typedef struct {
+    esp_gmf_data_bus_block_t *slot;                /*!< Ring of the references to the buffers of the writer */
+    uint32_t                  capacity;            /*!< Number of slots */
+    uint32_t                  rd_idx;              /*!< Slot of the oldest reference */
+    uint32_t                  fill_cnt;            /*!< Number of references in the ring */
+    uint8_t                  *cow_buf;             /*!< Private buffer of the reader for the copy-on-write mode */
+    uint32_t                  cow_size;            /*!< Length of the copy-on-write buffer, 0 for read-only sharing */
+    esp_gmf_share_release_cb  release_cb;          /*!< Called when the reader no longer uses a buffer of the writer */
+    void                     *release_ctx;         /*!< User context of the release callback */
+    SemaphoreHandle_t         can_read;            /*!< Given when a reference is added */
+    SemaphoreHandle_t         can_write;           /*!< Given when a slot is freed */
+    void                     *lock;                /*!< Protects the ring */
+    uint8_t                   _is_reading    : 1;  /*!< The reader holds the oldest reference */
+    uint8_t                   _is_write_done : 1;  /*!< The writing is done */
+    uint8_t                   _is_abort      : 1;  /*!< An abort is requested */
+} esp_gmf_share_t;
+
+static inline void share_pop(esp_gmf_share_t *share)
+{
+    share->rd_idx = (share->rd_idx + 1) % share->capacity;
+    share->fill_cnt--;
+}
+
+static void share_drop(esp_gmf_share_t *share, bool keep_reading, int *count)
+{
+    int dropped = 0;
+    esp_gmf_oal_mutex_lock(share->lock);
+    uint32_t keep = (keep_reading && share->_is_reading) ? 1 : 0;
+    while (share->fill_cnt > keep) {
+        // Drop from the newest one, the reference held by the reader stays at rd_idx
+        uint32_t idx = (share->rd_idx + share->fill_cnt - 1) % share->capacity;
+        uint8_t *buf = share->slot[idx].buf;
+        memset(&share->slot[idx], 0, sizeof(esp_gmf_data_bus_block_t));
+        share->fill_cnt--;
+        dropped++;
+        esp_gmf_oal_mutex_unlock(share->lock);
+        if (share->release_cb) {
+            share->release_cb(buf, share->release_ctx);
+        }
+        esp_gmf_oal_mutex_lock(share->lock);
+    }
+    if (keep == 0) {
+        share->_is_reading = 0;
+    }
+    esp_gmf_oal_mutex_unlock(share->lock);
+    if (dropped) {
+        xSemaphoreGive(share->can_write);
+    }
+    if (count) {
+        *count = dropped;
+    }
+}
+
+static inline void share_handle_free(esp_gmf_share_t *share)
+{
+    if (share->can_read) {
+        vSemaphoreDelete(share->can_read);
+    }
+    if (share->can_write) {
+        vSemaphoreDelete(share->can_write);
+    }
+    if (share->lock) {
+        esp_gmf_oal_mutex_destroy(share->lock);
+    }
+    if (share->cow_buf) {
+        esp_gmf_oal_free(share->cow_buf);
+    }
+    if (share->slot) {
+        esp_gmf_oal_free(share->slot);
+    }
+    esp_gmf_oal_free(share);
+}
+
+esp_gmf_err_t esp_gmf_share_create(int capacity, int cow_size, esp_gmf_share_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    if ((capacity < 1) || (cow_size < 0)) {
+        ESP_LOGE(TAG, "Invalid capacity:%d or copy-on-write size:%d", capacity, cow_size);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    *handle = NULL;
+    esp_gmf_share_t *share = esp_gmf_oal_calloc(1, sizeof(esp_gmf_share_t));
+    ESP_GMF_MEM_CHECK(TAG, share, return ESP_GMF_ERR_MEMORY_LACK);
+    share->slot = esp_gmf_oal_calloc(capacity, sizeof(esp_gmf_data_bus_block_t));
+    ESP_GMF_MEM_CHECK(TAG, share->slot, goto __share_fail);
+    share->can_read = xSemaphoreCreateBinary();
+    ESP_GMF_MEM_CHECK(TAG, share->can_read, goto __share_fail);
+    share->can_write = xSemaphoreCreateBinary();
+    ESP_GMF_MEM_CHECK(TAG, share->can_write, goto __share_fail);
+    share->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, share->lock, goto __share_fail);
+    share->capacity = capacity;
+    share->cow_size = cow_size;
+    *handle = share;
+    ESP_LOGD(TAG, "Create, hd:%p, cap:%d, cow:%d", share, capacity, cow_size);
+    return ESP_GMF_ERR_OK;
+
+__share_fail:
+    share_handle_free(share);
+    return ESP_GMF_ERR_MEMORY_LACK;
+}
+
+esp_gmf_err_t esp_gmf_share_destroy(esp_gmf_share_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    share_drop(share, false, NULL);
+    share_handle_free(share);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_set_release_cb(esp_gmf_share_handle_t handle, esp_gmf_share_release_cb cb, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    esp_gmf_oal_mutex_lock(share->lock);
+    share->release_cb = cb;
+    share->release_ctx = ctx;
+    esp_gmf_oal_mutex_unlock(share->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_share_acquire_read(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    while (share->fill_cnt == 0) {
+        if (share->_is_abort) {
+            return ESP_GMF_IO_ABORT;
+        }
+        if (share->_is_write_done) {
+            blk->valid_size = 0;
+            blk->is_last = true;
+            return ESP_GMF_IO_OK;
+        }
+        if (xSemaphoreTake(share->can_read, block_ticks) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+    }
+    esp_gmf_oal_mutex_lock(share->lock);
+    esp_gmf_data_bus_block_t *ref = &share->slot[share->rd_idx];
+    if (share->cow_size == 0) {
+        *blk = *ref;
+        share->_is_reading = 1;
+        esp_gmf_oal_mutex_unlock(share->lock);
+        ESP_LOGD(TAG, "RD_ACQ, hd:%p, b:%p, vld:%d, last:%d, f:%ld", share, blk->buf, blk->valid_size, blk->is_last, share->fill_cnt);
+        return blk->valid_size;
+    }
+    // Copy on write, the reader works on the private buffer and the writer gets its buffer back at once
+    if (share->cow_buf == NULL || share->cow_size < ref->valid_size) {
+        esp_gmf_oal_free(share->cow_buf);
+        share->cow_size = share->cow_size < ref->valid_size ? ref->valid_size : share->cow_size;
+        share->cow_buf = esp_gmf_oal_malloc(share->cow_size);
+        ESP_GMF_MEM_CHECK(TAG, share->cow_buf, {esp_gmf_oal_mutex_unlock(share->lock); return ESP_GMF_IO_FAIL;});
+    }
+    memcpy(share->cow_buf, ref->buf, ref->valid_size);
+    uint8_t *src = ref->buf;
+    blk->buf = share->cow_buf;
+    blk->buf_length = share->cow_size;
+    blk->valid_size = ref->valid_size;
+    blk->is_last = ref->is_last;
+    memset(ref, 0, sizeof(esp_gmf_data_bus_block_t));
+    share_pop(share);
+    esp_gmf_share_release_cb cb = share->release_cb;
+    void *ctx = share->release_ctx;
+    esp_gmf_oal_mutex_unlock(share->lock);
+    xSemaphoreGive(share->can_write);
+    if (cb) {
+        cb(src, ctx);
+    }
+    ESP_LOGD(TAG, "RD_ACQ COW, hd:%p, src:%p, b:%p, vld:%d, last:%d", share, src, blk->buf, blk->valid_size, blk->is_last);
+    return blk->valid_size;
+}
+
+esp_gmf_err_io_t esp_gmf_share_release_read(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    if (share->cow_size) {
+        if (blk->buf != share->cow_buf) {
+            ESP_LOGE(TAG, "RD_RLS, the buffer is not the copy-on-write one, hd:%p, b:%p", share, blk->buf);
+            return ESP_GMF_IO_FAIL;
+        }
+        return ESP_GMF_IO_OK;
+    }
+    if (blk->buf == NULL && blk->is_last) {
+        // Nothing was acquired, it is the end of the stream
+        return ESP_GMF_IO_OK;
+    }
+    esp_gmf_oal_mutex_lock(share->lock);
+    if ((share->_is_reading == 0) || (share->slot[share->rd_idx].buf != blk->buf)) {
+        ESP_LOGE(TAG, "RD_RLS, the buffer is not the acquired one, hd:%p, b:%p", share, blk->buf);
+        esp_gmf_oal_mutex_unlock(share->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    memset(&share->slot[share->rd_idx], 0, sizeof(esp_gmf_data_bus_block_t));
+    share_pop(share);
+    share->_is_reading = 0;
+    esp_gmf_share_release_cb cb = share->release_cb;
+    void *ctx = share->release_ctx;
+    esp_gmf_oal_mutex_unlock(share->lock);
+    xSemaphoreGive(share->can_write);
+    if (cb) {
+        cb(blk->buf, ctx);
+    }
+    ESP_LOGD(TAG, "RD_RLS, hd:%p, b:%p, f:%ld", share, blk->buf, share->fill_cnt);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_share_acquire_write(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    if (blk->buf == NULL) {
+        ESP_LOGE(TAG, "WR_ACQ, the writer must provide the buffer, hd:%p", share);
+        return ESP_GMF_IO_FAIL;
+    }
+    if (share->_is_write_done) {
+        return ESP_GMF_IO_OK;
+    }
+    while (share->fill_cnt >= share->capacity) {
+        if (xSemaphoreTake(share->can_write, block_ticks) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+        if (share->_is_abort) {
+            return ESP_GMF_IO_ABORT;
+        }
+    }
+    ESP_LOGD(TAG, "WR_ACQ, hd:%p, b:%p, l:%d, f:%ld", share, blk->buf, blk->buf_length, share->fill_cnt);
+    return blk->buf_length;
+}
+
+esp_gmf_err_io_t esp_gmf_share_release_write(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    esp_gmf_oal_mutex_lock(share->lock);
+    if (share->fill_cnt >= share->capacity) {
+        ESP_LOGE(TAG, "WR_RLS, no free slot, hd:%p, b:%p", share, blk->buf);
+        esp_gmf_oal_mutex_unlock(share->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_data_bus_block_t *ref = &share->slot[(share->rd_idx + share->fill_cnt) % share->capacity];
+    ref->buf = blk->buf;
+    ref->buf_length = blk->buf_length;
+    ref->valid_size = blk->valid_size;
+    ref->is_last = blk->is_last;
+    share->fill_cnt++;
+    esp_gmf_oal_mutex_unlock(share->lock);
+    xSemaphoreGive(share->can_read);
+    ESP_LOGD(TAG, "WR_RLS, hd:%p, b:%p, vld:%d, last:%d, f:%ld", share, blk->buf, blk->valid_size, blk->is_last, share->fill_cnt);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_reclaim(esp_gmf_share_handle_t handle, int *count)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    share_drop((esp_gmf_share_t *)handle, true, count);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_done_write(esp_gmf_share_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    share->_is_write_done = 1;
+    xSemaphoreGive(share->can_read);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_abort(esp_gmf_share_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    share->_is_abort = 1;
+    share_drop(share, true, NULL);
+    xSemaphoreGive(share->can_read);
+    xSemaphoreGive(share->can_write);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_reset(esp_gmf_share_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    share_drop(share, false, NULL);
+    share->_is_write_done = 0;
+    share->_is_abort = 0;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_get_free_size(esp_gmf_share_handle_t handle, uint32_t *free_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, free_size, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    *free_size = share->capacity - share->fill_cnt;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_get_filled_size(esp_gmf_share_handle_t handle, uint32_t *filled_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, filled_size, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    uint32_t sz = 0;
+    esp_gmf_oal_mutex_lock(share->lock);
+    for (uint32_t i = 0; i < share->fill_cnt; i++) {
+        sz += share->slot[(share->rd_idx + i) % share->capacity].valid_size;
+    }
+    esp_gmf_oal_mutex_unlock(share->lock);
+    *filled_size = sz;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_share_get_total_size(esp_gmf_share_handle_t handle, uint32_t *total_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, total_size, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_share_t *share = (esp_gmf_share_t *)handle;
+    *total_size = share->capacity;
+    return ESP_GMF_ERR_OK;
+}
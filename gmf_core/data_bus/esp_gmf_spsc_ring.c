@@ -0,0 +1,354 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_spsc_ring.h"
+
+static const char *TAG = "ESP_GMF_SPSC";
+
+/**
+ * @brief  Structure representing a SPSC ring
+ *         The positions run in [0, 2 * size) so that a full ring can be told apart from an empty one
+ */
+struct esp_gmf_spsc_ring {
+    uint8_t           *buf;             /*!< Ring storage */
+    uint32_t           size;            /*!< Ring size */
+    atomic_uint        w_pos;           /*!< Write position, only advanced by the writer */
+    atomic_uint        r_pos;           /*!< Read position, only advanced by the reader */
+    atomic_bool        reader_waiting;  /*!< The reader is going to block on `can_read` */
+    atomic_bool        writer_waiting;  /*!< The writer is going to block on `can_write` */
+    atomic_bool        abort_read;      /*!< Flag to indicate read abort */
+    atomic_bool        abort_write;     /*!< Flag to indicate write abort */
+    atomic_bool        is_done_write;   /*!< Flag to signal completion of writing */
+    SemaphoreHandle_t  can_read;        /*!< Semaphore to wake up the reader */
+    SemaphoreHandle_t  can_write;       /*!< Semaphore to wake up the writer */
+};
+
+static inline uint32_t spsc_filled(struct esp_gmf_spsc_ring *rb, uint32_t w_pos, uint32_t r_pos)
+{
+    return w_pos >= r_pos ? w_pos - r_pos : w_pos + 2 * rb->size - r_pos;
+}
+
+static inline uint32_t spsc_advance(struct esp_gmf_spsc_ring *rb, uint32_t pos, uint32_t len)
+{
+    pos += len;
+    return pos >= 2 * rb->size ? pos - 2 * rb->size : pos;
+}
+
+static inline uint32_t spsc_offset(struct esp_gmf_spsc_ring *rb, uint32_t pos)
+{
+    return pos >= rb->size ? pos - rb->size : pos;
+}
+
+static inline void spsc_wake(atomic_bool *waiting, SemaphoreHandle_t sem)
+{
+    // Only touch the semaphore when the other side announced that it is going to block
+    if (atomic_load(waiting) && atomic_exchange(waiting, false)) {
+        xSemaphoreGive(sem);
+    }
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_create(int block_size, int n_blocks, esp_gmf_spsc_ring_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    *handle = NULL;
+    if ((block_size <= 0) || (n_blocks <= 0)) {
+        ESP_LOGE(TAG, "Invalid size, block_size:%d, n_blocks:%d", block_size, n_blocks);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    struct esp_gmf_spsc_ring *rb = esp_gmf_oal_calloc(1, sizeof(struct esp_gmf_spsc_ring));
+    ESP_GMF_MEM_CHECK(TAG, rb, return ESP_GMF_ERR_MEMORY_LACK);
+    bool _success = (
+                        (rb->buf       = esp_gmf_oal_calloc(n_blocks, block_size)) &&
+                        (rb->can_read  = xSemaphoreCreateBinary()) &&
+                        (rb->can_write = xSemaphoreCreateBinary())
+                    );
+    ESP_GMF_MEM_CHECK(TAG, _success, {
+        esp_gmf_spsc_ring_destroy(rb);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    });
+    rb->size = block_size * n_blocks;
+    atomic_init(&rb->w_pos, 0);
+    atomic_init(&rb->r_pos, 0);
+    atomic_init(&rb->reader_waiting, false);
+    atomic_init(&rb->writer_waiting, false);
+    atomic_init(&rb->abort_read, false);
+    atomic_init(&rb->abort_write, false);
+    atomic_init(&rb->is_done_write, false);
+    *handle = rb;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_destroy(esp_gmf_spsc_ring_handle_t handle)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    if (rb->buf) {
+        esp_gmf_oal_free(rb->buf);
+        rb->buf = NULL;
+    }
+    if (rb->can_read) {
+        vSemaphoreDelete(rb->can_read);
+        rb->can_read = NULL;
+    }
+    if (rb->can_write) {
+        vSemaphoreDelete(rb->can_write);
+        rb->can_write = NULL;
+    }
+    esp_gmf_oal_free(rb);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_reset(esp_gmf_spsc_ring_handle_t handle)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    atomic_store(&rb->w_pos, 0);
+    atomic_store(&rb->r_pos, 0);
+    atomic_store(&rb->reader_waiting, false);
+    atomic_store(&rb->writer_waiting, false);
+    atomic_store(&rb->abort_read, false);
+    atomic_store(&rb->abort_write, false);
+    atomic_store(&rb->is_done_write, false);
+    // Drop the wake-ups left by the previous run
+    xSemaphoreTake(rb->can_read, 0);
+    xSemaphoreTake(rb->can_write, 0);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_ring_acquire_read(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on acquire read, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    int total_read_size = 0;
+    int ret_val = ESP_GMF_IO_OK;
+    uint32_t buf_len = wanted_size;
+    uint8_t *buf = blk->buf;
+    ESP_LOGV(TAG, "ACQ_RD+:%p, b:%p, l:%d, s:%ld", rb, buf, blk->buf_length, wanted_size);
+    while (buf_len) {
+        uint32_t r_pos = atomic_load_explicit(&rb->r_pos, memory_order_relaxed);
+        uint32_t filled = spsc_filled(rb, atomic_load(&rb->w_pos), r_pos);
+        uint32_t read_size = buf_len;
+        if (filled < buf_len) {
+            // Keep the multiple of 4 bytes partial read of the GMF ringbuffer to avoid the I2S noise
+            read_size = filled & 0xfffffffc;
+            if ((read_size == 0) && atomic_load(&rb->is_done_write)) {
+                read_size = filled;
+            }
+        }
+        if (read_size == 0) {
+            if (atomic_load(&rb->is_done_write)) {
+                blk->is_last = 1;
+                break;
+            }
+            if (atomic_load(&rb->abort_read)) {
+                ret_val = ESP_GMF_IO_ABORT;
+                break;
+            }
+            if (atomic_load(&rb->reader_waiting) == false) {
+                // Announce the waiting first then check again, so the writer can't publish data without waking us up
+                atomic_store(&rb->reader_waiting, true);
+                continue;
+            }
+            if (xSemaphoreTake(rb->can_read, ticks_to_wait) != pdTRUE) {
+                atomic_store(&rb->reader_waiting, false);
+                ret_val = ESP_GMF_IO_TIMEOUT;
+                break;
+            }
+            continue;
+        }
+        uint32_t offset = spsc_offset(rb, r_pos);
+        if (buf) {
+            if (offset + read_size > rb->size) {
+                uint32_t rlen1 = rb->size - offset;
+                memcpy(buf, rb->buf + offset, rlen1);
+                memcpy(buf + rlen1, rb->buf, read_size - rlen1);
+            } else {
+                memcpy(buf, rb->buf + offset, read_size);
+            }
+            buf += read_size;
+        }
+        atomic_store(&rb->r_pos, spsc_advance(rb, r_pos, read_size));
+        spsc_wake(&rb->writer_waiting, rb->can_write);
+        buf_len -= read_size;
+        total_read_size += read_size;
+    }
+    if (atomic_load_explicit(&rb->reader_waiting, memory_order_relaxed)) {
+        atomic_store(&rb->reader_waiting, false);
+    }
+    if (ret_val == ESP_GMF_IO_ABORT) {
+        total_read_size = ret_val;
+    }
+    ESP_LOGV(TAG, "ACQ_RD-:%p, ret:%d", rb, total_read_size > 0 ? total_read_size : ret_val);
+    blk->valid_size = total_read_size > 0 ? total_read_size : 0;
+    return total_read_size > 0 ? total_read_size : ret_val;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_ring_release_read(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    // Do nothing
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_ring_acquire_write(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    return wanted_size;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_ring_release_write(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on release write, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    int total_write_size = 0;
+    int ret_val = ESP_GMF_IO_OK;
+    uint8_t *buf = blk->buf;
+    uint32_t buf_len = blk->valid_size;
+    ESP_LOGV(TAG, "RLS_WR+:%p, blk:%p, vld_sz:%d, time:%d", rb, blk, blk->valid_size, block_ticks);
+    while (buf_len) {
+        uint32_t w_pos = atomic_load_explicit(&rb->w_pos, memory_order_relaxed);
+        uint32_t write_size = rb->size - spsc_filled(rb, w_pos, atomic_load(&rb->r_pos));
+        if (buf_len < write_size) {
+            write_size = buf_len;
+        }
+        if (write_size == 0) {
+            if (atomic_load(&rb->is_done_write)) {
+                ESP_LOGD(TAG, "WR:%p, done", rb);
+                break;
+            }
+            if (atomic_load(&rb->abort_write)) {
+                ESP_LOGD(TAG, "WR:%p, abort", rb);
+                ret_val = ESP_GMF_IO_ABORT;
+                break;
+            }
+            if (atomic_load(&rb->writer_waiting) == false) {
+                // Announce the waiting first then check again, so the reader can't free space without waking us up
+                atomic_store(&rb->writer_waiting, true);
+                continue;
+            }
+            if (xSemaphoreTake(rb->can_write, block_ticks) != pdTRUE) {
+                atomic_store(&rb->writer_waiting, false);
+                ESP_LOGD(TAG, "WR:%p, timeout:%d", rb, block_ticks);
+                ret_val = ESP_GMF_IO_TIMEOUT;
+                break;
+            }
+            continue;
+        }
+        uint32_t offset = spsc_offset(rb, w_pos);
+        if (offset + write_size > rb->size) {
+            uint32_t wlen1 = rb->size - offset;
+            memcpy(rb->buf + offset, buf, wlen1);
+            memcpy(rb->buf, buf + wlen1, write_size - wlen1);
+        } else {
+            memcpy(rb->buf + offset, buf, write_size);
+        }
+        atomic_store(&rb->w_pos, spsc_advance(rb, w_pos, write_size));
+        spsc_wake(&rb->reader_waiting, rb->can_read);
+        buf += write_size;
+        buf_len -= write_size;
+        total_write_size += write_size;
+    }
+    if (atomic_load_explicit(&rb->writer_waiting, memory_order_relaxed)) {
+        atomic_store(&rb->writer_waiting, false);
+    }
+    ESP_LOGV(TAG, "RLS_WR-:%p, ret:%d, ws:%d", rb, ret_val, total_write_size);
+    if (ret_val == ESP_GMF_IO_ABORT) {
+        total_write_size = ret_val;
+    }
+    if (blk->is_last) {
+        esp_gmf_spsc_ring_done_write(rb);
+    }
+    return total_write_size > 0 ? total_write_size : ret_val;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_abort(esp_gmf_spsc_ring_handle_t handle)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_LOGD(TAG, "Abort, rb:%p", rb);
+    atomic_store(&rb->abort_read, true);
+    xSemaphoreGive(rb->can_read);
+    atomic_store(&rb->abort_write, true);
+    xSemaphoreGive(rb->can_write);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_done_write(esp_gmf_spsc_ring_handle_t handle)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    atomic_store(&rb->is_done_write, true);
+    ESP_LOGD(TAG, "Set done write, rb:%p", rb);
+    xSemaphoreGive(rb->can_read);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_reset_done_write(esp_gmf_spsc_ring_handle_t handle)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    atomic_store(&rb->is_done_write, false);
+    ESP_LOGD(TAG, "Reset done write, rb:%p", rb);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_bytes_available(esp_gmf_spsc_ring_handle_t handle, uint32_t *available_size)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    if (rb && available_size) {
+        *available_size = rb->size - spsc_filled(rb, atomic_load(&rb->w_pos), atomic_load(&rb->r_pos));
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_bytes_filled(esp_gmf_spsc_ring_handle_t handle, uint32_t *filled_size)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    if (rb && filled_size) {
+        *filled_size = spsc_filled(rb, atomic_load(&rb->w_pos), atomic_load(&rb->r_pos));
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
+
+esp_gmf_err_t esp_gmf_spsc_ring_get_size(esp_gmf_spsc_ring_handle_t handle, uint32_t *valid_size)
+{
+    struct esp_gmf_spsc_ring *rb = (struct esp_gmf_spsc_ring *)handle;
+    if (rb == NULL || valid_size == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    *valid_size = rb->size;
+    return ESP_GMF_ERR_OK;
+}
@@ -33,7 +33,9 @@ extern "C" {
 /**
  * @brief  The GMF FIFO Buffer is an interface designed for passing buffer addresses without generating any copies.
  *         It maintains a list whose maximum number of items is specified when creating the FIFO handle. The FIFO buffer
- *         is not allocated during initialization; instead, it is allocated when `esp_gmf_fifo_acquire_write` is called.
+ *         is not allocated during initialization; instead, it is allocated when `esp_gmf_fifo_acquire_write` is called,
+ *         unless all of them are preallocated by `esp_gmf_fifo_prealloc`. All the list operations are O(1), so the cost
+ *         per operation does not depend on the FIFO depth.
  *         This interface provides blocking operations, meaning that `esp_gmf_fifo_acquire_read` and `esp_gmf_fifo_acquire_write`
  *         will block until a buffer becomes available or the timeout occurs. The functions `esp_gmf_fifo_release_read` and
  *         `esp_gmf_fifo_release_write` must be used in pairs and cannot be invoked recursively. Additionally, the GMF FIFO
@@ -59,6 +61,19 @@ typedef void *esp_gmf_fifo_handle_t;
  */
 esp_gmf_err_t esp_gmf_fifo_create(int block_cnt, int block_size, esp_gmf_fifo_handle_t *handle);
 
+/**
+ * @brief  Preallocate all the blocks of the FIFO with `block_size` bytes each, so no memory is allocated on the data path
+ *         It is meant to be called right after `esp_gmf_fifo_create`, a larger `wanted_size` on acquire write still reallocates the block
+ *
+ * @param[in]  handle  FIFO handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle or the block size is 0
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_fifo_prealloc(esp_gmf_fifo_handle_t handle);
+
 /**
  * @brief  Destroy the FIFO buffer and release resources
  *
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "esp_gmf_data_bus.h"
+#include "esp_gmf_share.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,36 @@ extern "C" {
  */
 int esp_gmf_db_new_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h);
 
+/**
+ * @brief  Create a new zero-copy ring buffer with the specified item count and size
+ *         The acquire functions hand out regions of the ring storage, so the data bus type is block
+ *
+ * @param[in]   num             Size of each item
+ * @param[in]   item_cnt        Number of items
+ * @param[in]   max_chunk_size  Maximum size of one acquire
+ * @param[out]  h               Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_ringbuf_zero_copy(int num, int item_cnt, uint32_t max_chunk_size, esp_gmf_db_handle_t *h);
+
+/**
+ * @brief  Create a new lock-free single-producer/single-consumer ring with the specified item count and size
+ *         It behaves like the ring buffer, but the reader and the writer never contend on a lock,
+ *         so it must only be used by one reader task and one writer task
+ *
+ * @param[in]   num       Size of each item
+ * @param[in]   item_cnt  Number of items
+ * @param[out]  h         Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_spsc_ring(int num, int item_cnt, esp_gmf_db_handle_t *h);
+
 /**
  * @brief  Create a new block buffer with the specified item count and size
  *
@@ -82,6 +113,60 @@ int esp_gmf_db_new_pbuf(int num, int item_cnt, esp_gmf_db_handle_t *h);
  */
 int esp_gmf_db_new_fifo(int num, int item_cnt, esp_gmf_db_handle_t *h);
 
+/**
+ * @brief  Create a new FIFO buffer with all the items preallocated
+ *
+ * @param[in]   num       Maximum number of items
+ * @param[in]   item_cnt  Size of each preallocated item
+ * @param[out]  h         Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_fifo_prealloc(int num, int item_cnt, esp_gmf_db_handle_t *h);
+
+/**
+ * @brief  Create a new share bus, which passes the buffers of the writer to the reader by reference
+ *         The buffers are read-only for the reader, unless `cow_size` is set for a reader which modifies the data in place
+ *
+ * @param[in]   num       Maximum number of references
+ * @param[in]   cow_size  Size of the copy-on-write buffer, 0 to share the buffers read-only
+ * @param[out]  h         Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_share(int num, int cow_size, esp_gmf_db_handle_t *h);
+
+/**
+ * @brief  Set the callback telling the writer of a share bus that the reader released its buffer
+ *
+ * @param[in]  h    Handle of the GMF data bus
+ * @param[in]  cb   Release callback, NULL to disable it
+ * @param[in]  ctx  User context of the callback
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The data bus is not a share bus
+ */
+int esp_gmf_db_share_set_release_cb(esp_gmf_db_handle_t h, esp_gmf_share_release_cb cb, void *ctx);
+
+/**
+ * @brief  Drop the references of a share bus which are not acquired by the reader yet
+ *
+ * @param[in]   h      Handle of the GMF data bus
+ * @param[out]  count  Number of dropped references, can be NULL
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The data bus is not a share bus
+ */
+int esp_gmf_db_share_reclaim(esp_gmf_db_handle_t h, int *count);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -39,6 +39,11 @@ extern "C" {
  *         `esp_gmf_rb_release_read` and `esp_gmf_rb_acquire_write` have no practical significance.
  *
  *         The `esp_gmf_rb_release_write` and `esp_gmf_rb_acquire_read` have blocking functionality.
+ *
+ *         A ring buffer created by `esp_gmf_rb_create_zero_copy` works in zero-copy mode instead. The acquire functions
+ *         return a pointer straight into the ring storage and the release functions commit the consumed or produced size,
+ *         so each acquire must be paired with a release. A mirrored area of `max_chunk_size` bytes behind the storage end
+ *         keeps the region contiguous when it crosses the wrap point, only the wrapped part is copied.
  */
 
 /**
@@ -59,6 +64,24 @@ typedef void *esp_gmf_rb_handle_t;
  */
 esp_gmf_err_t esp_gmf_rb_create(int block_size, int n_blocks, esp_gmf_rb_handle_t *handle);
 
+/**
+ * @brief  Create a zero-copy ring buffer with total size = block_size * n_blocks
+ *
+ * @note  The size of a single acquire is limited to `max_chunk_size`, larger requests are clamped.
+ *        The read side keeps the multiple of 4 bytes behavior of the copy mode for partial reads
+ *
+ * @param[in]   block_size      Size of each block
+ * @param[in]   n_blocks        Number of blocks
+ * @param[in]   max_chunk_size  Maximum size of one acquire, it is also the size of the mirrored area
+ * @param[out]  handle          Pointer to store the handle to the created ringbufer buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_FAIL         No memory for the ring buffer
+ */
+esp_gmf_err_t esp_gmf_rb_create_zero_copy(int block_size, int n_blocks, uint32_t max_chunk_size, esp_gmf_rb_handle_t *handle);
+
 /**
  * @brief  Cleanup and free all memory allocated for the ring buffer
  *
@@ -84,6 +107,7 @@ esp_gmf_err_t esp_gmf_rb_reset(esp_gmf_rb_handle_t handle);
 /**
  * @brief  Copy valid data from ring buffer to the given buffer with specific handle
  *         When the ring buffer handle cannot provide enough size, it will block for the duration specified by block_ticks.
+ *         In zero-copy mode, `blk->buf` is set to the readable region in the ring instead of being filled
  *
  * @param[in]   handle         The Ringbuffer handle
  * @param[out]  blk            Pointer to the data block structure to be filled
@@ -102,7 +126,7 @@ esp_gmf_err_io_t esp_gmf_rb_acquire_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
 /**
  * @brief  Release the read operation
  *
- * @note  It's do nothing due to read acquire is a copy operation
+ * @note  It's do nothing due to read acquire is a copy operation, in zero-copy mode it frees `blk->valid_size` bytes
  *
  * @param[in]  handle       The Ringbuffer handle
  * @param[in]  blk          Pointer to the data block structure to release
@@ -116,7 +140,8 @@ esp_gmf_err_io_t esp_gmf_rb_release_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
 /**
  * @brief  Acquire space for write
  *
- * @note  It's do nothing due to write acquire is a copy operation
+ * @note  It's do nothing due to write acquire is a copy operation, in zero-copy mode `blk->buf` is set to the
+ *        writable region in the ring and it blocks until `wanted_size` bytes are free
  *
  * @param[in]   handle         The Ringbuffer handle
  * @param[out]  blk            Pointer to the data block structure to be filled
@@ -135,6 +160,7 @@ esp_gmf_err_io_t esp_gmf_rb_acquire_write(esp_gmf_rb_handle_t handle, esp_gmf_da
 /**
  * @brief  Copy the given buffer to the ring buffer with specific handle
  *         When the ring buffer handle cannot accommodate the given buffer size, it will block for the duration specified by block_ticks.
+ *         In zero-copy mode, it commits `blk->valid_size` bytes written to the region got from `esp_gmf_rb_acquire_write` without blocking
  *
  * @param[in]  handle       The Ringbuffer handle
  * @param[in]  blk          Pointer to the data block structure to release
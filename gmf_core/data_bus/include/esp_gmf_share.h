@@ -0,0 +1,238 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "esp_gmf_data_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  The GMF share bus passes buffers owned by the writer to the reader by reference, no data is copied and no buffer
+ *         is allocated for the data. The buffer given to `esp_gmf_share_release_write` is read-only for the reader and must stay
+ *         valid until the reader calls `esp_gmf_share_release_read`, the release callback tells the writer when that happens.
+ *         Readers which modify the data in place must use a copy-on-write share bus, then `esp_gmf_share_acquire_read` copies
+ *         the data into a buffer of the bus and hands the reference back to the writer at once.
+ *         The blocking, pairing and thread-safety rules are the same as the GMF FIFO.
+ */
+
+/**
+ * @brief  Handle for the GMF share bus
+ */
+typedef void *esp_gmf_share_handle_t;
+
+/**
+ * @brief  Callback invoked when the reader no longer uses a buffer of the writer
+ *
+ * @param[in]  buf  The buffer given by the writer
+ * @param[in]  ctx  User context set by `esp_gmf_share_set_release_cb`
+ */
+typedef void (*esp_gmf_share_release_cb)(uint8_t *buf, void *ctx);
+
+/**
+ * @brief  Create a share bus
+ *
+ * @param[in]   capacity  Maximum number of references held by the bus
+ * @param[in]   cow_size  Size of the copy-on-write buffer, 0 to share the buffers read-only
+ * @param[out]  handle    Pointer to the share bus handle to be created
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_share_create(int capacity, int cow_size, esp_gmf_share_handle_t *handle);
+
+/**
+ * @brief  Destroy the share bus, the references still held are released through the release callback
+ *
+ * @param[in]  handle  Share bus handle to be destroyed
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_share_destroy(esp_gmf_share_handle_t handle);
+
+/**
+ * @brief  Set the callback invoked when a buffer of the writer is released by the reader
+ *
+ * @param[in]  handle  Share bus handle
+ * @param[in]  cb      Release callback, NULL to disable it
+ * @param[in]  ctx     User context of the callback
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_share_set_release_cb(esp_gmf_share_handle_t handle, esp_gmf_share_release_cb cb, void *ctx);
+
+/**
+ * @brief  Acquire the oldest shared buffer for reading
+ *         The reader gets the buffer of the writer, or a copy of it for a copy-on-write share bus
+ *
+ * @param[in]   handle       Share bus handle
+ * @param[out]  blk          Pointer to the data bus block to store the buffer information
+ * @param[in]   wanted_size  Not used, the whole shared buffer is given
+ * @param[in]   block_ticks  Maximum number of ticks to wait for a buffer
+ *
+ * @return
+ *       - > 0                 Valid size of the buffer
+ *       - ESP_GMF_IO_OK       The write is done and there is no more buffer
+ *       - ESP_GMF_IO_FAIL     Invalid arguments or memory allocation failed
+ *       - ESP_GMF_IO_TIMEOUT  Timeout waiting for a buffer
+ *       - ESP_GMF_IO_ABORT    The share bus is aborted
+ */
+esp_gmf_err_io_t esp_gmf_share_acquire_read(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Release the buffer acquired by `esp_gmf_share_acquire_read`, the reference goes back to the writer
+ *
+ * @param[in]  handle       Share bus handle
+ * @param[in]  blk          Pointer to the data bus block to release
+ * @param[in]  block_ticks  Not used
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    Success
+ *       - ESP_GMF_IO_FAIL  Invalid arguments or the buffer is not the acquired one
+ */
+esp_gmf_err_io_t esp_gmf_share_release_read(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Wait for a free reference slot, the buffer of `blk` is provided by the writer and kept unchanged
+ *
+ * @param[in]   handle       Share bus handle
+ * @param[in]   blk          Pointer to the data bus block holding the buffer of the writer
+ * @param[in]   wanted_size  Not used
+ * @param[in]   block_ticks  Maximum number of ticks to wait for a free slot
+ *
+ * @return
+ *       - > 0                 Length of the buffer
+ *       - ESP_GMF_IO_OK       The write is done
+ *       - ESP_GMF_IO_FAIL     Invalid arguments or no buffer given
+ *       - ESP_GMF_IO_TIMEOUT  Timeout waiting for a free slot
+ *       - ESP_GMF_IO_ABORT    The share bus is aborted
+ */
+esp_gmf_err_io_t esp_gmf_share_acquire_write(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Pass the buffer of `blk` to the reader by reference
+ *
+ * @param[in]  handle       Share bus handle
+ * @param[in]  blk          Pointer to the data bus block holding the buffer of the writer
+ * @param[in]  block_ticks  Not used
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    Success
+ *       - ESP_GMF_IO_FAIL  Invalid arguments or no free slot
+ */
+esp_gmf_err_io_t esp_gmf_share_release_write(esp_gmf_share_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Drop the references not acquired by the reader yet, each of them is released through the release callback
+ *         The writer uses it to get its buffers back from a reader that stalls
+ *
+ * @param[in]   handle  Share bus handle
+ * @param[out]  count   Number of dropped references, can be NULL
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_share_reclaim(esp_gmf_share_handle_t handle, int *count);
+
+/**
+ * @brief  Indicate that the writing to the share bus is done
+ *
+ * @param[in]  handle  Share bus handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_share_done_write(esp_gmf_share_handle_t handle);
+
+/**
+ * @brief  Abort the waiting operations and drop the references not acquired by the reader yet
+ *
+ * @param[in]  handle  Share bus handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_share_abort(esp_gmf_share_handle_t handle);
+
+/**
+ * @brief  Reset the share bus, the done and abort states are cleared and the pending references are dropped
+ *
+ * @param[in]  handle  Share bus handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_share_reset(esp_gmf_share_handle_t handle);
+
+/**
+ * @brief  Get the number of free reference slots
+ *
+ * @param[in]   handle     Share bus handle
+ * @param[out]  free_size  Pointer to store the number of free slots
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_share_get_free_size(esp_gmf_share_handle_t handle, uint32_t *free_size);
+
+/**
+ * @brief  Get the valid size of the shared buffers in the bus
+ *
+ * @param[in]   handle       Share bus handle
+ * @param[out]  filled_size  Pointer to store the filled size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_share_get_filled_size(esp_gmf_share_handle_t handle, uint32_t *filled_size);
+
+/**
+ * @brief  Get the capacity of the share bus in reference slots
+ *
+ * @param[in]   handle      Share bus handle
+ * @param[out]  total_size  Pointer to store the capacity
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_share_get_total_size(esp_gmf_share_handle_t handle, uint32_t *total_size);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -0,0 +1,225 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "esp_gmf_data_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  GMF SPSC ring is a byte ring buffer for exactly one writer task and one reader task, the typical case
+ *         of a link between two pipeline elements. It has the same copy semantics as the GMF ringbuffer,
+ *         'esp_gmf_spsc_ring_acquire_read' and 'esp_gmf_spsc_ring_release_write' copy the data out and in,
+ *         `esp_gmf_spsc_ring_release_read` and `esp_gmf_spsc_ring_acquire_write` have no practical significance.
+ *
+ *         The read and write positions are atomic and each one is only advanced by its own side, so the data path
+ *         takes no lock. The semaphores are only used to block when the ring is empty or full, and only given
+ *         when the other side is actually waiting.
+ *
+ * @note  Concurrent readers or concurrent writers are not supported, use the GMF ringbuffer for that
+ */
+
+/**
+ * @brief  Handle to the SPSC ring
+ */
+typedef void *esp_gmf_spsc_ring_handle_t;
+
+/**
+ * @brief  Create a SPSC ring with total size = block_size * n_blocks
+ *
+ * @param[in]   block_size  Size of each block
+ * @param[in]   n_blocks    Number of blocks
+ * @param[out]  handle      Pointer to store the handle to the created SPSC ring
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_create(int block_size, int n_blocks, esp_gmf_spsc_ring_handle_t *handle);
+
+/**
+ * @brief  Cleanup and free all memory allocated for the SPSC ring
+ *
+ * @param[in]  handle  The SPSC ring handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_destroy(esp_gmf_spsc_ring_handle_t handle);
+
+/**
+ * @brief  Reset the SPSC ring, clearing all values to the initial state
+ *
+ * @note  It must not be called while the reader or the writer is accessing the ring
+ *
+ * @param[in]  handle  The SPSC ring handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_reset(esp_gmf_spsc_ring_handle_t handle);
+
+/**
+ * @brief  Copy valid data from the SPSC ring to the given buffer
+ *         When the ring cannot provide enough data, it will block for the duration specified by ticks_to_wait.
+ *         As the GMF ringbuffer, the partial reads are rounded down to a multiple of 4 bytes unless the writing is done
+ *
+ * @param[in]   handle         The SPSC ring handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Desired size to read
+ * @param[in]   ticks_to_wait  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - > 0                 The specific length of data being read
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_spsc_ring_acquire_read(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Release the read operation
+ *
+ * @note  It's do nothing due to read acquire is a copy operation
+ *
+ * @param[in]  handle       The SPSC ring handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK  Operation succeeded
+ */
+esp_gmf_err_io_t esp_gmf_spsc_ring_release_read(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Acquire space for write
+ *
+ * @note  It's do nothing due to write release is a copy operation
+ *
+ * @param[in]   handle         The SPSC ring handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Desired size to write
+ * @param[in]   ticks_to_wait  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - > 0  The specific length of space can be write
+ */
+esp_gmf_err_io_t esp_gmf_spsc_ring_acquire_write(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Copy the given buffer to the SPSC ring
+ *         When the ring cannot accommodate the given buffer size, it will block for the duration specified by block_ticks.
+ *
+ * @param[in]  handle       The SPSC ring handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - > 0                 The specific length of data being written
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_spsc_ring_release_write(esp_gmf_spsc_ring_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Abort any pending operations on the SPSC ring
+ *
+ * @param[in]  handle  The SPSC ring handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_abort(esp_gmf_spsc_ring_handle_t handle);
+
+/**
+ * @brief  Set the status of writing to the SPSC ring as done
+ *
+ * @param[in]  handle  The SPSC ring handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_done_write(esp_gmf_spsc_ring_handle_t handle);
+
+/**
+ * @brief  Reset the status of writing to the SPSC ring as not done
+ *
+ * @param[in]  handle  The SPSC ring handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_reset_done_write(esp_gmf_spsc_ring_handle_t handle);
+
+/**
+ * @brief  Get the number of bytes available for writing to the SPSC ring
+ *
+ * @param[in]   handle          The SPSC ring handle
+ * @param[out]  available_size  Pointer to store the available size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_bytes_available(esp_gmf_spsc_ring_handle_t handle, uint32_t *available_size);
+
+/**
+ * @brief  Get the number of bytes filled in the SPSC ring
+ *
+ * @param[in]   handle       The SPSC ring handle
+ * @param[out]  filled_size  Pointer to store the filled size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_bytes_filled(esp_gmf_spsc_ring_handle_t handle, uint32_t *filled_size);
+
+/**
+ * @brief  Get the total size of the SPSC ring
+ *
+ * @param[in]   handle      The SPSC ring handle
+ * @param[out]  valid_size  Pointer to store the total size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_ring_get_size(esp_gmf_spsc_ring_handle_t handle, uint32_t *valid_size);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
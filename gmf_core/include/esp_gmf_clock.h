@@ -0,0 +1,227 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_gmf_err.h"
+#include "esp_gmf_payload.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  The media clock gives several pipelines one notion of media time so that their outputs stay in step, for
+ *         example the audio and the video of a file, or one stream played on two devices. Each pipeline attaches a
+ *         sync stage to the clock, which is applied to the payloads leaving its last element, so the last element
+ *         must carry the PTS (in milliseconds) on its output payloads. At most one sync stage is the master: it passes
+ *         everything and, with `ESP_GMF_CLOCK_MASTER_PIPELINE`, its PTS drives the clock. The slaves compare the PTS of
+ *         each payload with the clock and, outside of the sync window, drop a late payload, or repeat (continuous
+ *         sinks) or hold (the others) an early one. Every sync stage keeps a report of its drift and latency.
+ */
+
+typedef void *esp_gmf_clock_handle_t;
+typedef void *esp_gmf_clock_sync_handle_t;
+
+/**
+ * @brief  Source of the media time
+ */
+typedef enum {
+    ESP_GMF_CLOCK_MASTER_SYSTEM   = 0,  /*!< The time elapsed since the clock started */
+    ESP_GMF_CLOCK_MASTER_PIPELINE = 1,  /*!< The last PTS of the master sync stage, extrapolated by the elapsed time */
+} esp_gmf_clock_master_t;
+
+/**
+ * @brief  Role of a sync stage
+ */
+typedef enum {
+    ESP_GMF_CLOCK_ROLE_SLAVE  = 0,  /*!< Follows the clock */
+    ESP_GMF_CLOCK_ROLE_MASTER = 1,  /*!< Never corrected, drives the clock with `ESP_GMF_CLOCK_MASTER_PIPELINE` */
+} esp_gmf_clock_role_t;
+
+/**
+ * @brief  Time base of the clock, can be replaced to run on a simulated time
+ */
+typedef struct {
+    int64_t (*now_ms)(void *ctx);                /*!< Get the current time in milliseconds */
+    void    (*sleep_ms)(void *ctx, int64_t ms);  /*!< Block the calling task for the given milliseconds */
+    void     *ctx;                               /*!< User context of the operations */
+} esp_gmf_clock_time_ops_t;
+
+/**
+ * @brief  Configuration of the media clock
+ */
+typedef struct {
+    esp_gmf_clock_master_t    master;          /*!< Source of the media time */
+    uint32_t                  sync_window_ms;  /*!< Drift tolerated without correction */
+    uint32_t                  max_wait_ms;     /*!< Longest hold of an early payload */
+    esp_gmf_clock_time_ops_t  time_ops;        /*!< Time base, the system time is used if `now_ms` is NULL */
+} esp_gmf_clock_cfg_t;
+
+#define DEFAULT_ESP_GMF_CLOCK_CONFIG() {         \
+    .master         = ESP_GMF_CLOCK_MASTER_SYSTEM, \
+    .sync_window_ms = 40,                          \
+    .max_wait_ms    = 100,                         \
+    .time_ops       = {0},                         \
+}
+
+/**
+ * @brief  Configuration of a sync stage
+ */
+typedef struct {
+    esp_gmf_clock_role_t  role;        /*!< Role of the sync stage */
+    bool                  continuous;  /*!< The sink consumes at its own rate (e.g. I2S), so an early payload is
+                                            repeated instead of held */
+} esp_gmf_clock_sync_cfg_t;
+
+/**
+ * @brief  Drift and latency report of a sync stage
+ *
+ *         The drift is the PTS of the last payload minus the clock, positive when the payload is early. The latency is
+ *         how far the clock is past the PTS of a payload when it is handed to the sink
+ */
+typedef struct {
+    int32_t   drift_ms;        /*!< Drift of the last payload */
+    int32_t   max_drift_ms;    /*!< Largest absolute drift seen, with its sign */
+    int32_t   latency_ms;      /*!< Latency of the last payload handed to the sink */
+    int32_t   max_latency_ms;  /*!< Largest latency seen */
+    uint32_t  passed;          /*!< Number of payloads passed as they are */
+    uint32_t  waited;          /*!< Number of payloads held before passing */
+    uint32_t  dropped;         /*!< Number of payloads dropped */
+    uint32_t  repeated;        /*!< Number of payloads repeated */
+} esp_gmf_clock_report_t;
+
+/**
+ * @brief  Create a media clock
+ *
+ * @param[in]   cfg     Configuration of the clock
+ * @param[out]  handle  Pointer to store the clock handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_clock_create(const esp_gmf_clock_cfg_t *cfg, esp_gmf_clock_handle_t *handle);
+
+/**
+ * @brief  Destroy a media clock, the sync stages must be detached first
+ *
+ * @param[in]  handle  Clock handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_clock_destroy(esp_gmf_clock_handle_t handle);
+
+/**
+ * @brief  Restart the clock and clear the reports of the sync stages
+ *
+ *         The clock starts from the PTS of the first payload synchronized afterwards, the first one of the master with
+ *         `ESP_GMF_CLOCK_MASTER_PIPELINE`. It also starts by itself that way after creation, so this is only needed to
+ *         restart it, for example after a seek
+ *
+ * @param[in]  handle  Clock handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_clock_start(esp_gmf_clock_handle_t handle);
+
+/**
+ * @brief  Get the media time
+ *
+ * @param[in]   handle   Clock handle
+ * @param[out]  time_ms  Pointer to store the media time in milliseconds
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_READY    The clock is not started yet
+ */
+esp_gmf_err_t esp_gmf_clock_get_time(esp_gmf_clock_handle_t handle, int64_t *time_ms);
+
+/**
+ * @brief  Attach a sync stage to the clock
+ *
+ * @param[in]   handle  Clock handle
+ * @param[in]   cfg     Configuration of the sync stage
+ * @param[out]  sync    Pointer to store the sync stage handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_INVALID_STATE  The clock has a master already
+ *       - ESP_GMF_ERR_MEMORY_LACK    Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_clock_attach(esp_gmf_clock_handle_t handle, const esp_gmf_clock_sync_cfg_t *cfg, esp_gmf_clock_sync_handle_t *sync);
+
+/**
+ * @brief  Detach a sync stage from its clock and free it
+ *
+ * @param[in]  sync  Sync stage handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_clock_detach(esp_gmf_clock_sync_handle_t sync);
+
+/**
+ * @brief  Run a payload through a sync stage
+ *
+ *         A master updates the clock and passes the payload. A slave may hold the calling task for up to
+ *         `max_wait_ms`. The caller hands the payload to the sink `times` times: 0 to drop it, 1 to pass it and
+ *         2 to repeat it. Payloads without data are always passed
+ *
+ * @param[in]   sync   Sync stage handle
+ * @param[in]   load   Payload about to be handed to the sink
+ * @param[out]  times  Pointer to store the number of times to hand the payload to the sink
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_clock_sync(esp_gmf_clock_sync_handle_t sync, esp_gmf_payload_t *load, uint8_t *times);
+
+/**
+ * @brief  Get the drift and latency report of a sync stage
+ *
+ * @param[in]   sync    Sync stage handle
+ * @param[out]  report  Pointer to store the report
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_clock_get_report(esp_gmf_clock_sync_handle_t sync, esp_gmf_clock_report_t *report);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -43,6 +43,19 @@ extern "C" {
 
 #define ESP_GMF_MAX_DELAY (0xFFFFFFFFUL)
 
+/**
+ * @brief  Set to 0 to compile out the per-element processing statistics
+ */
+#ifndef ESP_GMF_ELEMENT_STATS_ENABLE
+#define ESP_GMF_ELEMENT_STATS_ENABLE (1)
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
+
+/**
+ * @brief  Number of the latency histogram buckets, the bucket N counts the calls taking [2^N, 2^(N+1)) microseconds,
+ *         the last one also counts all the longer calls
+ */
+#define ESP_GMF_ELEMENT_STATS_BUCKET_NUM (24)
+
 #define ESP_GMF_ELEMENT_GET(x)            ((esp_gmf_element_t *)x)
 #define ESP_GMF_ELEMENT_GET_IN_PORT(x)    (((esp_gmf_element_t *)x)->in)
 #define ESP_GMF_ELEMENT_GET_OUT_PORT(x)   (((esp_gmf_element_t *)x)->out)
@@ -63,16 +76,18 @@ typedef void *esp_gmf_element_handle_t;
  */
 typedef enum {
     ESP_GMF_EL_PORT_CAP_SINGLE = 1,  /*!< Single port capability */
-    ESP_GMF_EL_PORT_CAP_MULTI  = 2   /*!< Multi-port capability */
+    ESP_GMF_EL_PORT_CAP_MULTI  = 2,  /*!< Multi-port capability */
+    ESP_GMF_EL_PORT_CAP_CHAIN  = 4,  /*!< The port accepts chained payload segments, OR it with the single or multi capability */
 } esp_gmf_element_port_cap_t;
 
 /**
  * @brief  Structure defining the attributes of an element's port
  */
 typedef struct {
-    esp_gmf_element_port_cap_t  cap;   /*!< Port capability */
-    esp_gmf_port_type_t         type;  /*!< Port type */
-    int                         size;  /*!< Port size */
+    esp_gmf_element_port_cap_t  cap;       /*!< Port capability */
+    esp_gmf_port_type_t         type;      /*!< Port type */
+    int                         size;      /*!< Port size */
+    int                         min_size;  /*!< Smallest port size the element still works with, 0 if the size can not shrink */
 } esp_gmf_element_port_attr_t;
 
 /**
@@ -85,6 +100,21 @@ typedef struct {
     esp_gmf_event_cb  event_receiver;  /*!< Event receiver function */
 } esp_gmf_element_ops_t;
 
+/**
+ * @brief  Processing statistics of an element
+ */
+typedef struct {
+    uint32_t  call_cnt;                                 /*!< Number of process calls */
+    uint32_t  frame_cnt;                                /*!< Number of payloads released to the output port */
+    uint64_t  in_bytes;                                 /*!< Bytes released from the input port */
+    uint64_t  out_bytes;                                /*!< Bytes released to the output port */
+    uint64_t  total_us;                                 /*!< Accumulated processing time in microseconds */
+    uint32_t  p50_us;                                   /*!< Median processing latency, rounded up to the histogram bucket */
+    uint32_t  p99_us;                                   /*!< 99th percentile processing latency, rounded up to the histogram bucket */
+    uint32_t  max_us;                                   /*!< Maximum processing latency */
+    uint32_t  hist[ESP_GMF_ELEMENT_STATS_BUCKET_NUM];  /*!< Log2 bucketed latency histogram */
+} esp_gmf_element_stats_t;
+
 /**
  * @brief  Structure representing a GMF element
  */
@@ -104,6 +134,9 @@ typedef struct esp_gmf_element {
     esp_gmf_event_state_t           cur_state;      /*!< Current state */
     esp_gmf_event_cb                event_func;     /*!< Event function */
     esp_gmf_method_t               *method;         /*!< It can access the data members and member functions of the objects */
+    esp_gmf_method_t              **method_tbl;     /*!< Methods indexed by `esp_gmf_method_id_t`, in registration order */
+    uint16_t                        method_cnt;     /*!< Number of the entries in `method_tbl` */
+    esp_gmf_element_stats_t        *stats;          /*!< Processing statistics, NULL if ESP_GMF_ELEMENT_STATS_ENABLE is 0 */
 
     /* Protect */
     void                           *ctx;            /*!< User Context */
@@ -432,10 +465,12 @@ esp_gmf_err_t esp_gmf_element_register_method(esp_gmf_element_handle_t handle, c
                                               esp_gmf_method_func func, esp_gmf_args_desc_t *args_desc);
 
 /**
- * @brief  Execute methods of GMF element by argument list
+ * @brief  Execute method of GMF element by argument list
+ *         The name is resolved on every call, hot paths should resolve it once by `esp_gmf_element_get_method_id`
+ *         and call `esp_gmf_element_exe_method_by_id` instead
  *
  * @param[in]  handle   Pointer to the handle of the GMF element
- * @param[in]  name     The name of the method to be executed
+ * @param[in]  name     The name of the method to be executed, case-insensitive
  * @param[in]  buf      Pointer to the buffer containing the arguments for the method
  * @param[in]  buf_len  The length of the buffer (`buf`)
  *
@@ -447,6 +482,39 @@ esp_gmf_err_t esp_gmf_element_register_method(esp_gmf_element_handle_t handle, c
 esp_gmf_err_t esp_gmf_element_exe_method(esp_gmf_element_handle_t handle, const char *name,
                                                   uint8_t *buf, int buf_len);
 
+/**
+ * @brief  Resolve the name of a method to its ID
+ *         The ID is the registration order of the method, so it stays valid for the life of the element and is the
+ *         same for all the instances of one element type
+ *
+ * @param[in]   handle  Pointer to the handle of the GMF element
+ * @param[in]   name    The name of the method, case-insensitive
+ * @param[out]  id      Pointer to store the method ID
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_NOT_FOUND    No method registered with the given name
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle or arguments
+ */
+esp_gmf_err_t esp_gmf_element_get_method_id(esp_gmf_element_handle_t handle, const char *name, esp_gmf_method_id_t *id);
+
+/**
+ * @brief  Execute method of GMF element by the ID resolved by `esp_gmf_element_get_method_id`
+ *
+ * @param[in]  handle   Pointer to the handle of the GMF element
+ * @param[in]  id       The ID of the method to be executed
+ * @param[in]  buf      Pointer to the buffer containing the arguments for the method
+ * @param[in]  buf_len  The length of the buffer (`buf`)
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_NOT_SUPPORT  No method registered with the given ID
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle or arguments
+ *       - Others                   Returned by the method
+ */
+esp_gmf_err_t esp_gmf_element_exe_method_by_id(esp_gmf_element_handle_t handle, esp_gmf_method_id_t id,
+                                               uint8_t *buf, int buf_len);
+
 /**
  * @brief  Retrieve the method structure associated with a given ESP-GMF element
  *
@@ -460,6 +528,43 @@ esp_gmf_err_t esp_gmf_element_exe_method(esp_gmf_element_handle_t handle, const
  */
 esp_gmf_err_t esp_gmf_element_get_method(esp_gmf_element_handle_t handle, esp_gmf_method_t **mthd);
 
+/**
+ * @brief  Get the processing statistics of the specific element
+ *
+ *         The statistics are updated by the thread running the element without lock,
+ *         so the snapshot may be slightly inconsistent while the element is running
+ *
+ * @param[in]   handle  GMF element handle
+ * @param[out]  stats   Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The statistics are compiled out
+ */
+esp_gmf_err_t esp_gmf_element_get_stats(esp_gmf_element_handle_t handle, esp_gmf_element_stats_t *stats);
+
+/**
+ * @brief  Clear the processing statistics of the specific element
+ *
+ * @param[in]  handle  GMF element handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The statistics are compiled out
+ */
+esp_gmf_err_t esp_gmf_element_reset_stats(esp_gmf_element_handle_t handle);
+
+/**
+ * @brief  Account the bytes released through a port of the specific element, it is called by the GMF port
+ *
+ * @param[in]  handle  GMF element handle
+ * @param[in]  dir     Direction of the port
+ * @param[in]  bytes   Number of bytes released
+ */
+void esp_gmf_element_stats_add_bytes(esp_gmf_element_handle_t handle, esp_gmf_port_dir_t dir, uint32_t bytes);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -34,9 +34,11 @@ extern "C" {
  * @brief  Type of events in GMF
  */
 typedef enum {
-    ESP_GMF_EVT_TYPE_LOADING_JOB  = 0x1000,  /*!< Loading job event */
-    ESP_GMF_EVT_TYPE_CHANGE_STATE = 0x2000,  /*!< State change event */
-    ESP_GMF_EVT_TYPE_REPORT_INFO  = 0x3000,  /*!< Information reporting event */
+    ESP_GMF_EVT_TYPE_LOADING_JOB   = 0x1000,  /*!< Loading job event */
+    ESP_GMF_EVT_TYPE_CHANGE_STATE  = 0x2000,  /*!< State change event */
+    ESP_GMF_EVT_TYPE_REPORT_INFO   = 0x3000,  /*!< Information reporting event */
+    ESP_GMF_EVT_TYPE_JOB_OVERRUN   = 0x4000,  /*!< Job timing overrun event, the payload is esp_gmf_job_overrun_t */
+    ESP_GMF_EVT_TYPE_DISCONTINUITY = 0x5000,  /*!< Stream discontinuity sent to each element on a running seek, the payload is the uint64_t seek position */
 } esp_gmf_event_type_t;
 
 /**
@@ -23,6 +23,7 @@
  */
 
 #pragma once
+#include <stdint.h>
 #include <string.h>
 
 #ifdef __cplusplus
@@ -62,6 +63,33 @@ typedef enum {
     ESP_GMF_JOB_ERR_FAIL     = ESP_FAIL  /*!< The job has failed to execute */
 } esp_gmf_job_err_t;
 
+/**
+ * @brief  This enumeration specifies the kind of timing overrun reported by a GMF job
+ */
+typedef enum {
+    ESP_GMF_JOB_OVERRUN_DEADLINE = 1,  /*!< The job completed after its deadline */
+    ESP_GMF_JOB_OVERRUN_BUDGET   = 2,  /*!< The job ran longer than its CPU budget */
+} esp_gmf_job_overrun_type_t;
+
+/**
+ * @brief  Timing constraints of a GMF job, all zero means the job has no timing constraint
+ */
+typedef struct {
+    uint32_t  period_us;    /*!< Release period of the job, 0 means the job is released again as soon as it completes */
+    uint32_t  deadline_us;  /*!< Deadline relative to the release, 0 means equal to the period */
+    uint32_t  budget_us;    /*!< CPU budget of one execution, 0 means unlimited */
+} esp_gmf_job_timing_t;
+
+/**
+ * @brief  Payload of the ESP_GMF_EVT_TYPE_JOB_OVERRUN event
+ */
+typedef struct {
+    const char  *label;    /*!< Label of the job */
+    void        *ctx;      /*!< Context of the job */
+    uint32_t     exec_us;  /*!< Execution time of the job */
+    int32_t      late_us;  /*!< Completion time relative to the deadline, positive means late */
+} esp_gmf_job_overrun_t;
+
 /**
  * @brief  Function pointer type for GMF job functions
  *
@@ -78,13 +106,17 @@ typedef esp_gmf_job_err_t (*esp_gmf_job_func)(void *self, void *para);
  *         A job encapsulates a function to be executed, along with its context and other properties
  */
 typedef struct _esp_gmf_job_t {
-    struct _esp_gmf_job_t *prev;   /*!< Pointer to the previous job in the linked list */
-    struct _esp_gmf_job_t *next;   /*!< Pointer to the next job in the linked list */
-    const char            *label;  /*!< Label identifying the job */
-    esp_gmf_job_func       func;   /*!< Function pointer to the job's function */
-    void                  *ctx;    /*!< Context pointer to be passed to the job's function */
-    esp_gmf_job_times_t    times;  /*!< Times the job should be executed */
-    esp_gmf_job_err_t      ret;    /*!< Return value of the job function */
+    struct _esp_gmf_job_t *prev;         /*!< Pointer to the previous job in the linked list */
+    struct _esp_gmf_job_t *next;         /*!< Pointer to the next job in the linked list */
+    const char            *label;        /*!< Label identifying the job */
+    esp_gmf_job_func       func;         /*!< Function pointer to the job's function */
+    void                  *ctx;          /*!< Context pointer to be passed to the job's function */
+    esp_gmf_job_times_t    times;        /*!< Times the job should be executed */
+    esp_gmf_job_err_t      ret;          /*!< Return value of the job function */
+    uint16_t               dep_id;       /*!< Dependency chain ID, jobs with the same ID run in registration order */
+    esp_gmf_job_timing_t   timing;       /*!< Timing constraints of the job */
+    int64_t                release_at;   /*!< Release time of the current period in microseconds */
+    int64_t                deadline_at;  /*!< Absolute deadline of the current period in microseconds */
 } esp_gmf_job_t;
 
 /**
@@ -0,0 +1,154 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_gmf_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  The memory governor hands out reservations against a fixed total budget, so a pipeline learns whether it fits
+ *         before any element is opened instead of failing halfway through. A reservation is described by items, each
+ *         one a number of equally sized buffers such as the payload of a port (depth 1) or the blocks of a data bus.
+ *         When the request does not fit, the governor first lowers the depths and then halves the sizes of the largest
+ *         items, never below their declared minimums, and refuses the request only if the minimums do not fit either.
+ *         The granted values are written back to the items. The governor only keeps the books, the owners allocate.
+ */
+
+typedef void *esp_gmf_mem_gov_handle_t;
+
+/**
+ * @brief  One kind of buffer of a reservation
+ */
+typedef struct {
+    const char  *name;       /*!< Name of the item for the log, can be NULL */
+    uint32_t     size;       /*!< Wanted size of one buffer, updated to the granted size */
+    uint32_t     min_size;   /*!< Smallest acceptable size, 0 if the size can not shrink */
+    uint16_t     depth;      /*!< Wanted number of buffers, updated to the granted number */
+    uint16_t     min_depth;  /*!< Smallest acceptable number of buffers, 0 if the depth can not shrink */
+} esp_gmf_mem_gov_item_t;
+
+/**
+ * @brief  Accounting of the memory governor
+ */
+typedef struct {
+    size_t    budget;      /*!< Total budget */
+    size_t    reserved;    /*!< Bytes currently reserved */
+    size_t    peak;        /*!< Peak of the reserved bytes */
+    uint16_t  resv_num;    /*!< Number of live reservations */
+    uint32_t  grant_cnt;   /*!< Number of requests granted in full */
+    uint32_t  shrink_cnt;  /*!< Number of requests granted after shrinking */
+    uint32_t  refuse_cnt;  /*!< Number of refused requests */
+} esp_gmf_mem_gov_info_t;
+
+/**
+ * @brief  Create a memory governor
+ *
+ * @param[in]   budget  Total budget in bytes
+ * @param[out]  handle  Pointer to store the governor handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_mem_gov_create(size_t budget, esp_gmf_mem_gov_handle_t *handle);
+
+/**
+ * @brief  Destroy a memory governor, the live reservations are dropped with it
+ *
+ * @param[in]  handle  Governor handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_mem_gov_destroy(esp_gmf_mem_gov_handle_t handle);
+
+/**
+ * @brief  Reserve memory for the given owner, shrinking the items down to their minimums if needed
+ *
+ * @note  An owner holds at most one reservation, a new request of the same owner replaces the previous one only if it
+ *        is granted
+ *
+ * @param[in]      handle  Governor handle
+ * @param[in]      owner   Owner of the reservation, e.g. a pipeline handle
+ * @param[in,out]  items   Items of the request, the granted sizes and depths are written back
+ * @param[in]      num     Number of items
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           The request is granted, maybe shrunk
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  The minimums do not fit in the budget left, the items are unchanged
+ */
+esp_gmf_err_t esp_gmf_mem_gov_reserve(esp_gmf_mem_gov_handle_t handle, void *owner, esp_gmf_mem_gov_item_t *items, int num);
+
+/**
+ * @brief  Release the reservation of the given owner
+ *
+ * @param[in]  handle  Governor handle
+ * @param[in]  owner   Owner of the reservation
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The owner holds no reservation
+ */
+esp_gmf_err_t esp_gmf_mem_gov_release(esp_gmf_mem_gov_handle_t handle, void *owner);
+
+/**
+ * @brief  Get the bytes reserved by the given owner
+ *
+ * @param[in]   handle  Governor handle
+ * @param[in]   owner   Owner of the reservation
+ * @param[out]  size    Pointer to store the reserved bytes
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The owner holds no reservation
+ */
+esp_gmf_err_t esp_gmf_mem_gov_get_reserved(esp_gmf_mem_gov_handle_t handle, void *owner, size_t *size);
+
+/**
+ * @brief  Get the accounting of the governor
+ *
+ * @param[in]   handle  Governor handle
+ * @param[out]  info    Pointer to store the accounting
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_mem_gov_get_info(esp_gmf_mem_gov_handle_t handle, esp_gmf_mem_gov_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
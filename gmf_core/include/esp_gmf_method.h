@@ -38,6 +38,13 @@ extern "C" {
  */
 typedef esp_gmf_err_t (*esp_gmf_method_func)(void *handle, esp_gmf_args_desc_t *arg_desc, uint8_t *buf, int buf_len);
 
+/**
+ * @brief  Identifier of a method inside an element, see `esp_gmf_element_get_method_id`
+ */
+typedef uint16_t esp_gmf_method_id_t;
+
+#define ESP_GMF_METHOD_ID_INVALID (0xFFFF)
+
 /**
  * @brief  Structure for GMF methods
  *         This structure defines a linked list node for storing GMF methods
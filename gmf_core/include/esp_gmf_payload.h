@@ -33,14 +33,20 @@ extern "C" {
 
 /**
  * @brief  Structure representing a payload in GMF
+ *
+ * @note  Payloads can be chained by `next` into a scatter-gather list, each segment carries its own buffer and valid size.
+ *        The segments are owned by the writer which builds the chain, it must rebuild or clear the chain on every frame.
+ *        Readers without `ESP_GMF_EL_PORT_CAP_CHAIN` on the input port get the chain flattened by the port
  */
-typedef struct {
+typedef struct esp_gmf_payload {
     uint8_t  *buf;             /*!< Pointer to the payload buffer */
     size_t    buf_length;      /*!< Length of the payload buffer */
     size_t    valid_size;      /*!< Size of valid data in the payload buffer */
     bool      is_done;         /*!< Flag indicating if this payload buffer marks the end of the stream */
     uint64_t  pts;             /*!< Presentation time stamp */
     uint8_t   needs_free : 1;  /*!< Flag indicating if the payload buffer needs to be freed by esp_gmf_payload_delete or not*/
+    void     *pool;            /*!< Payload pool the buffer is taken from and returned to, NULL to use the heap directly */
+    struct esp_gmf_payload *next;  /*!< Next segment of a scatter-gather chain, NULL for a single buffer */
 } esp_gmf_payload_t;
 
 /**
@@ -97,6 +103,7 @@ esp_gmf_err_t esp_gmf_payload_realloc_buf(esp_gmf_payload_t *instance, uint32_t
 /**
  * @brief  Reallocate the buffer of a payload instance to the specified length with specified byte alignment
  *         Behavior same as `esp_gmf_payload_realloc_buf` with an additional alignment request
+ *         If the payload has a pool, the buffer is taken from the pool and `buf_length` is set to the size of the pooled buffer
  *
  * @param[in]  instance    Payload instance to reallocate the buffer for
  * @param[in]  align       Byte alignment for the new payload buffer
@@ -109,6 +116,22 @@ esp_gmf_err_t esp_gmf_payload_realloc_buf(esp_gmf_payload_t *instance, uint32_t
  */
 esp_gmf_err_t esp_gmf_payload_realloc_aligned_buf(esp_gmf_payload_t *instance, uint8_t align, uint32_t new_length);
 
+/**
+ * @brief  Change the pool the buffer of a payload instance is taken from
+ *
+ *         A buffer owned by the payload is given back to the pool or the heap it came from first, so that it is
+ *         never returned to the wrong owner, and the next `esp_gmf_payload_realloc_buf` takes one from the new pool.
+ *         It must not be called while the buffer is in use
+ *
+ * @param[in]  instance  Payload instance
+ * @param[in]  pool      New payload pool, NULL to use the heap directly
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid instance
+ */
+esp_gmf_err_t esp_gmf_payload_set_pool(esp_gmf_payload_t *instance, void *pool);
+
 /**
  * @brief  Set the done flag for a payload instance
  *
@@ -131,6 +154,45 @@ esp_gmf_err_t esp_gmf_payload_set_done(esp_gmf_payload_t *instance);
  */
 esp_gmf_err_t esp_gmf_payload_clean_done(esp_gmf_payload_t *instance);
 
+/**
+ * @brief  Append a segment to the tail of a payload chain
+ *
+ * @param[in]  head  Head of the payload chain
+ * @param[in]  seg   Segment to append, it must not be in a chain already
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_payload_chain_append(esp_gmf_payload_t *head, esp_gmf_payload_t *seg);
+
+/**
+ * @brief  Get the total valid size of all the segments of a payload chain
+ *
+ * @param[in]   head  Head of the payload chain
+ * @param[out]  size  Pointer to store the total valid size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_payload_get_chain_size(const esp_gmf_payload_t *head, uint32_t *size);
+
+/**
+ * @brief  Gather a payload chain into one contiguous buffer
+ *         If `dest` is a different payload, its buffer grows as needed and receives the data, done flag and pts of the chain
+ *         If `dest` is the head itself, the segments are appended to the head buffer in place and the chain is cut
+ *
+ * @param[in]   head  Head of the payload chain
+ * @param[out]  dest  Payload to store the contiguous data
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Not enough memory for `dest`, or the head buffer is too small to flatten in place
+ */
+esp_gmf_err_t esp_gmf_payload_flatten(esp_gmf_payload_t *head, esp_gmf_payload_t *dest);
+
 /**
  * @brief  Delete a payload instance, if needs_free is set free associated resources
  *
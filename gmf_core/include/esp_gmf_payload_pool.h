@@ -0,0 +1,155 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_gmf_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  The payload pool keeps preallocated and aligned payload buffers in a few size classes, so that growing a payload
+ *         on the data path takes a free buffer from the smallest class that fits instead of a free and malloc pair.
+ *         A request that no class can serve falls back to the heap and is counted as a miss, the fallback buffer is
+ *         freed when it is put back. The pool is thread-safe and is normally shared by all the ports of one pipeline,
+ *         see `esp_gmf_pipeline_set_payload_pool`.
+ */
+
+#define ESP_GMF_PAYLOAD_POOL_MAX_CLASS (8)
+
+/**
+ * @brief  Default payload pool configuration
+ */
+#define ESP_GMF_PAYLOAD_POOL_CFG_DEFAULT() {  \
+    .classes = {                              \
+        {.size = 512,  .count = 4},           \
+        {.size = 2048, .count = 4},           \
+        {.size = 8192, .count = 2},           \
+    },                                        \
+    .align    = 16,                           \
+    .in_psram = true,                         \
+}
+
+typedef void *esp_gmf_payload_pool_handle_t;
+
+/**
+ * @brief  Size class of the payload pool
+ */
+typedef struct {
+    uint32_t  size;   /*!< Buffer size of the class, it is rounded up to the pool alignment */
+    uint16_t  count;  /*!< Number of buffers preallocated for the class */
+} esp_gmf_payload_pool_class_t;
+
+/**
+ * @brief  Configuration of the payload pool
+ */
+typedef struct {
+    esp_gmf_payload_pool_class_t  classes[ESP_GMF_PAYLOAD_POOL_MAX_CLASS];  /*!< Size classes in ascending size, the list ends at the first zero size */
+    uint8_t                       align;                                    /*!< Alignment of all the buffers, a power of 2, 0 for the default of 4 bytes */
+    bool                          in_psram;                                 /*!< Place the buffers in PSRAM if it is enabled, otherwise in internal memory */
+} esp_gmf_payload_pool_cfg_t;
+
+/**
+ * @brief  Statistics of the payload pool
+ */
+typedef struct {
+    uint32_t  hit_cnt;   /*!< Number of requests served by a pooled buffer */
+    uint32_t  miss_cnt;  /*!< Number of requests that fell back to the heap */
+    uint32_t  in_use;    /*!< Number of pooled buffers currently handed out */
+    uint32_t  peak_use;  /*!< Peak number of pooled buffers handed out at the same time */
+} esp_gmf_payload_pool_stats_t;
+
+/**
+ * @brief  Create a payload pool and preallocate all of its buffers
+ *
+ * @param[in]   cfg     Pointer to the pool configuration
+ * @param[out]  handle  Pointer to store the created pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid configuration
+ *       - ESP_GMF_ERR_MEMORY_LACK  Failed to allocate the pool buffers
+ */
+esp_gmf_err_t esp_gmf_payload_pool_create(const esp_gmf_payload_pool_cfg_t *cfg, esp_gmf_payload_pool_handle_t *handle);
+
+/**
+ * @brief  Destroy the payload pool
+ *
+ * @note  All the buffers must have been put back, so destroy the pipelines using the pool first
+ *
+ * @param[in]  handle  The payload pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_payload_pool_destroy(esp_gmf_payload_pool_handle_t handle);
+
+/**
+ * @brief  Get a buffer of at least `wanted_size` bytes from the pool
+ *
+ * @param[in]   handle       The payload pool handle
+ * @param[in]   align        Required alignment, 0 for no requirement
+ * @param[in]   wanted_size  Required size
+ * @param[out]  buf          Pointer to store the buffer
+ * @param[out]  buf_length   Pointer to store the actual buffer length, it can be larger than `wanted_size`
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_MEMORY_LACK  No pooled buffer fits and the heap fallback failed
+ */
+esp_gmf_err_t esp_gmf_payload_pool_get(esp_gmf_payload_pool_handle_t handle, uint8_t align, uint32_t wanted_size, uint8_t **buf, uint32_t *buf_length);
+
+/**
+ * @brief  Put a buffer back to the pool, a buffer that does not belong to the pool is freed to the heap
+ *
+ * @param[in]  handle  The payload pool handle
+ * @param[in]  buf     The buffer to put back
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_payload_pool_put(esp_gmf_payload_pool_handle_t handle, uint8_t *buf);
+
+/**
+ * @brief  Get the hit and miss statistics of the pool
+ *
+ * @param[in]   handle  The payload pool handle
+ * @param[out]  stats   Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_payload_pool_get_stats(esp_gmf_payload_pool_handle_t handle, esp_gmf_payload_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -28,6 +28,8 @@
 #include "esp_gmf_io.h"
 #include "esp_gmf_task.h"
 #include "esp_gmf_event.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_clock.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -66,6 +68,10 @@ typedef struct esp_gmf_pipeline {
     esp_gmf_pipeline_prev_stop  prev_stop;      /*!< A pointer to the previous stop callback */
     void                       *prev_stop_ctx;  /*!< The previous stop callback context */
     void                       *lock;           /*!< Lock for thread synchronization */
+    void                       *payload_pool;   /*!< Payload pool shared by the element ports, NULL to use the heap */
+    void                       *arena;          /*!< Memory arena holding the pipeline objects, NULL if they are on the heap */
+    void                       *mem_gov;        /*!< Memory governor reserved from before the elements open, NULL for none */
+    void                       *clock_sync;     /*!< Sync stage of the output on a media clock, NULL for none */
 } esp_gmf_pipeline_t;
 
 /**
@@ -161,12 +167,14 @@ esp_gmf_err_t esp_gmf_pipeline_bind_task(esp_gmf_pipeline_handle_t pipeline, esp
 
 /**
  * @brief  Load linked element jobs to the bind task on the specific pipeline
+ *         If a memory governor is set, the port payloads are reserved first, see `esp_gmf_pipeline_set_mem_gov`
  *
  * @param[in]  pipeline  GMF pipeline handle
  *
  * @return
  *       - ESP_GMF_ERR_OK           On success
  *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline or task handle is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  The memory governor refused the reservation, no job is loaded
  */
 esp_gmf_err_t esp_gmf_pipeline_loading_jobs(esp_gmf_pipeline_handle_t pipeline);
 
@@ -301,6 +309,86 @@ esp_gmf_err_t esp_gmf_pipeline_pause(esp_gmf_pipeline_handle_t pipeline);
  */
 esp_gmf_err_t esp_gmf_pipeline_resume(esp_gmf_pipeline_handle_t pipeline);
 
+/**
+ * @brief  Share a payload pool with all the element ports of the pipeline, so the payload buffers of the ports are
+ *         taken from the pool instead of being freed and allocated again when they grow
+ *
+ * @note  1. Call it after the elements and ports of the pipeline are linked, e.g. after `esp_gmf_pool_new_pipeline`
+ *        2. The pool is owned by the caller, it must outlive the pipeline and can be shared by several pipelines
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  pool      Handle of the payload pool, NULL to allocate from the heap again
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_payload_pool(esp_gmf_pipeline_handle_t pipeline, void *pool);
+
+/**
+ * @brief  Make the pipeline reserve its port payloads from a memory governor before its elements open
+ *
+ *         `esp_gmf_pipeline_loading_jobs` then reserves one item per element output and one for the input of the first
+ *         element, sized by the port attributes of the elements. A shrunk reservation is applied back to the element
+ *         port sizes, so elements declaring `min_size` in their port attributes may run with smaller payloads. The
+ *         reservation is kept until the pipeline is destroyed or the governor is changed
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  gov       Memory governor handle, NULL to stop reserving
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_mem_gov(esp_gmf_pipeline_handle_t pipeline, void *gov);
+
+/**
+ * @brief  Synchronize the output of the pipeline to a media clock shared with other pipelines, see `esp_gmf_clock.h`
+ *
+ *         The sync stage runs on the payloads the last element hands to the sink, so the last element must set the PTS
+ *         (in milliseconds) of its output payloads. Late payloads are dropped and early ones repeated or held according
+ *         to `cfg`. Set it while the pipeline is not running
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  clock     Media clock handle, NULL to detach the pipeline from its clock
+ * @param[in]  cfg       Configuration of the sync stage, ignored if `clock` is NULL
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_INVALID_STATE  A master is requested but the clock has one already
+ *       - ESP_GMF_ERR_MEMORY_LACK    Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_clock(esp_gmf_pipeline_handle_t pipeline, void *clock, const esp_gmf_clock_sync_cfg_t *cfg);
+
+/**
+ * @brief  Get the drift and latency report of the pipeline output against its media clock
+ *
+ * @param[in]   pipeline  GMF pipeline handle
+ * @param[out]  report    Pointer to store the report
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The pipeline has no clock
+ */
+esp_gmf_err_t esp_gmf_pipeline_get_clock_report(esp_gmf_pipeline_handle_t pipeline, esp_gmf_clock_report_t *report);
+
+/**
+ * @brief  Get the memory accounting of a pipeline created in an arena, see `esp_gmf_pool_set_pipeline_arena`
+ *
+ * @param[in]   pipeline  GMF pipeline handle
+ * @param[in]   tag       Name of an element or I/O as given to `esp_gmf_pool_new_pipeline`, NULL for the whole pipeline
+ * @param[out]  stats     Pointer to store the accounting
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The pipeline is not in an arena
+ *       - ESP_GMF_ERR_NOT_FOUND    No allocation was accounted to the tag
+ */
+esp_gmf_err_t esp_gmf_pipeline_get_mem_stats(esp_gmf_pipeline_handle_t pipeline, const char *tag, esp_gmf_oal_mem_stats_t *stats);
+
 /**
  * @brief  Reset the GMF pipeline to its initial state, including job lists, port states, and element states
  *         To run the pipeline again, `esp_gmf_pipeline_loading_jobs` must be called
@@ -317,13 +405,25 @@ esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline);
  * @brief  Seeking to a specific position in the pipeline calls `io_seek`, which means it only
  *         supports streaming audio formats like MP3, AAC, and TS, where each frame can be decoded independently
  *
+ * @note  The pipeline can be seek while it is paused, stopped or finished. It can also be seek while running,
+ *        without a stop and reset: between two job rounds, every element receives an `ESP_GMF_EVT_TYPE_DISCONTINUITY`
+ *        event to drop its buffered input and decoding state, pending payloads inside the pipeline are released,
+ *        and the in IO is repositioned with its data bus aborted and reset. Elements are not closed, so the decoder
+ *        keeps counting the PTS from the last output and the timeline stays continuous across the seek
+ *        The in IO is aborted before waiting for the round boundary, so a read stalled on the network does not hold
+ *        the seek off. If the seek still fails, e.g. on timeout or a stop meanwhile, the in IO is left aborted and the
+ *        pipeline is expected to be stopped
+ *        Data already written into the data bus of a connected pipeline is not flushed
+ *
  * @param[in]  pipeline  GMF pipeline handle
  * @param[in]  pos       Position to seek to
  *
  * @return
- *       - ESP_GMF_ERR_OK           On success
- *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
- *       - ESP_GMF_ERR_INVALID_STATE
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    If the pipeline handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The pipeline has no in IO
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline has not been started yet, or was stopped during the seek
+ *       - ESP_GMF_ERR_TIMEOUT        The running pipeline did not reach a round boundary in time
  */
 esp_gmf_err_t esp_gmf_pipeline_seek(esp_gmf_pipeline_handle_t pipeline, uint64_t pos);
 
@@ -398,6 +498,73 @@ esp_gmf_err_t esp_gmf_pipeline_replace_in(esp_gmf_pipeline_handle_t pipeline, es
  */
 esp_gmf_err_t esp_gmf_pipeline_replace_out(esp_gmf_pipeline_handle_t pipeline, esp_gmf_io_handle_t new_one);
 
+/**
+ * @brief  Replace an element of the GMF pipeline with a new one, also while the pipeline is running
+ *
+ *         The new element takes over the ports of the old one. On a running pipeline the swap is made by the task
+ *         between two rounds of jobs, when no frame is in the middle of the elements: the old element is closed and
+ *         its jobs are retired, the new one is opened on the next round and goes on with the stream. What is lost is
+ *         limited to the data buffered inside the old element, at most one frame
+ *         On a pipeline without jobs, e.g. before loading jobs or after reset, only the link is changed
+ *
+ * @note  1. The new element must be INITIALIZED and not linked to any port or pipeline
+ *        2. The old element is reset and unlinked afterwards, it's owned by the caller again, delete or reuse it
+ *        3. Do not call it from the element process or the event callback of the same pipeline
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  old_el    The element in the pipeline to be replaced
+ * @param[in]  new_el    The element to take its place
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments, or the old element is not in the pipeline
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The new element doesn't support the port type of the old one
+ *       - ESP_GMF_ERR_NOT_READY      The new element is not INITIALIZED
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline is closing
+ */
+esp_gmf_err_t esp_gmf_pipeline_replace_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t old_el, esp_gmf_element_handle_t new_el);
+
+/**
+ * @brief  Insert a new element into the GMF pipeline, also while the pipeline is running
+ *
+ *         The new element is linked after `prev_el` with a new block port pair, at the same point between two rounds
+ *         of jobs as `esp_gmf_pipeline_replace_el`, and opened on the next round
+ *
+ * @note  The same requirements as `esp_gmf_pipeline_replace_el` apply to the new element
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  prev_el   The element to insert after, NULL to insert in front of the head element
+ * @param[in]  new_el    The element to insert
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments, or the previous element is not in the pipeline
+ *       - ESP_GMF_ERR_MEMORY_LACK    Failed to allocate the ports
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The port types of the new element and its neighbours mismatched
+ *       - ESP_GMF_ERR_NOT_READY      The new element is not INITIALIZED
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline is closing
+ */
+esp_gmf_err_t esp_gmf_pipeline_insert_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t prev_el, esp_gmf_element_handle_t new_el);
+
+/**
+ * @brief  Remove an element from the GMF pipeline, also while the pipeline is running
+ *
+ *         Its neighbours are linked to each other at the same point between two rounds of jobs as
+ *         `esp_gmf_pipeline_replace_el`, the element is closed and its jobs are retired
+ *
+ * @note  The removed element is reset and unlinked afterwards, it's owned by the caller again, delete or reuse it
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  el        The element to remove
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments, the element is not in the pipeline or is the only one
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The neighbour doesn't support the port type to take over
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline is closing
+ */
+esp_gmf_err_t esp_gmf_pipeline_remove_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el);
+
 /**
  * @brief  Get the header GMF element in the pipeline
  *
@@ -33,6 +33,16 @@ extern "C" {
 #endif  /* __cplusplus */
 
 typedef struct esp_gmf_pool *esp_gmf_pool_handle_t;
+typedef struct esp_gmf_pool_tmpl *esp_gmf_pool_tmpl_handle_t;
+
+/**
+ * @brief  Usage statistics of a pipeline template
+ */
+typedef struct {
+    uint32_t  build_cnt;  /*!< Number of pipelines built from the template */
+    uint32_t  reuse_cnt;  /*!< Number of pipelines handed out from the recycled cache */
+    uint16_t  cached;     /*!< Number of pipelines currently waiting in the recycled cache */
+} esp_gmf_pool_tmpl_stats_t;
 
 /**
  * @brief  Initialize a GMF pool
@@ -59,6 +69,11 @@ esp_gmf_err_t esp_gmf_pool_deinit(esp_gmf_pool_handle_t handle);
 
 /**
  * @brief  Register a GMF element to specific pool
+ *         The element is indexed by its tag, so the lookup cost of the `esp_gmf_pool_new_*` does not grow with the
+ *         number of registered objects
+ *
+ * @note  The tag is case-insensitive and must not be changed after registration. If several elements share a tag,
+ *        the first registered one is used
  *
  * @param[in]  handle  GMF pool handle
  * @param[in]  el      GMF element handle to register
@@ -73,6 +88,7 @@ esp_gmf_err_t esp_gmf_pool_register_element(esp_gmf_pool_handle_t handle, esp_gm
 
 /**
  * @brief  Register a GMF I/O instance with a GMF pool
+ *         The I/O is indexed by its tag, the tag is case-insensitive and must not be changed after registration
  *
  * @param[in]  handle  GMF pool handle
  * @param[in]  port    GMF I/O handle to register
@@ -85,6 +101,22 @@ esp_gmf_err_t esp_gmf_pool_register_element(esp_gmf_pool_handle_t handle, esp_gm
  */
 esp_gmf_err_t esp_gmf_pool_register_io(esp_gmf_pool_handle_t handle, esp_gmf_io_handle_t port, const char *tag);
 
+/**
+ * @brief  Make the following `esp_gmf_pool_new_pipeline` calls build each pipeline in a memory arena of its own
+ *
+ *         The element instances, ports, I/O instances and the pipeline itself are then carved out of a few chunks,
+ *         accounted per element and I/O name, and the chunks are given back to the heap at once by
+ *         `esp_gmf_pipeline_destroy`. Buffers allocated later by the running elements still come from the heap
+ *
+ * @param[in]  handle      GMF pool handle
+ * @param[in]  chunk_size  Size of the arena chunks, 0 to build the pipelines on the heap
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_pool_set_pipeline_arena(esp_gmf_pool_handle_t handle, size_t chunk_size);
+
 /**
  * @brief  Create a new GMF pipeline from the specific pool
  *         It checks if the element is already registered. If so, it duplicates them, links them together
@@ -111,6 +143,89 @@ esp_gmf_err_t esp_gmf_pool_new_pipeline(esp_gmf_pool_handle_t handle, const char
                                         const char *out_name,
                                         esp_gmf_pipeline_handle_t *pipeline);
 
+/**
+ * @brief  Compile a pipeline description into a template
+ *         The element and I/O names are looked up once, the template keeps the registered instances, the I/O types
+ *         and the port sizes, so `esp_gmf_pool_template_new_pipeline` only duplicates and links them.
+ *         The names are copied, the arrays need not outlive the call
+ *
+ * @note  The pool must outlive the template, and the elements and I/Os configured on the pool after compiling are
+ *        picked up by the next built pipeline, but the port sizes are fixed at compile time
+ *
+ * @param[in]   handle          GMF pool handle
+ * @param[in]   in_name         Name of the input I/O, NULL for none
+ * @param[in]   el_name         Array of names for intermediate elements
+ * @param[in]   num_of_el_name  Number of elements in the el_name array
+ * @param[in]   out_name        Name of the output I/O, NULL for none
+ * @param[in]   cache_num       Number of recycled pipelines the template may keep, 0 to disable the cache
+ * @param[out]  tmpl            Pointer to store the template handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument or the number of names is incorrect
+ *       - ESP_GMF_ERR_NOT_SUPPORT  Not support port type
+ *       - ESP_GMF_ERR_NOT_FOUND    Not found the specific instance
+ */
+esp_gmf_err_t esp_gmf_pool_new_template(esp_gmf_pool_handle_t handle, const char *in_name,
+                                        const char *el_name[], int num_of_el_name, const char *out_name,
+                                        uint16_t cache_num, esp_gmf_pool_tmpl_handle_t *tmpl);
+
+/**
+ * @brief  Get a pipeline from a template, a recycled one is handed out first, otherwise a new one is built
+ *
+ * @note  A recycled pipeline keeps the element settings and I/O URIs left by its previous user
+ *
+ * @param[in]   tmpl      Template handle
+ * @param[out]  pipeline  Pointer to store the pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_pool_template_new_pipeline(esp_gmf_pool_tmpl_handle_t tmpl, esp_gmf_pipeline_handle_t *pipeline);
+
+/**
+ * @brief  Give a pipeline obtained from `esp_gmf_pool_template_new_pipeline` back to its template
+ *         The pipeline is reset, unbound from its task, event callbacks and memory governor, and kept for reuse,
+ *         it is destroyed when the cache is full
+ *
+ * @note  The pipeline must be stopped, and its task is left to the caller to deinitialize
+ *
+ * @param[in]  tmpl      Template handle
+ * @param[in]  pipeline  Pipeline handle, must not be used by the caller afterwards
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_pool_template_recycle(esp_gmf_pool_tmpl_handle_t tmpl, esp_gmf_pipeline_handle_t pipeline);
+
+/**
+ * @brief  Get the usage statistics of a template
+ *
+ * @param[in]   tmpl   Template handle
+ * @param[out]  stats  Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_pool_template_get_stats(esp_gmf_pool_tmpl_handle_t tmpl, esp_gmf_pool_tmpl_stats_t *stats);
+
+/**
+ * @brief  Delete a template and destroy the pipelines in its recycled cache
+ *         Pipelines still in use stay valid and are destroyed with `esp_gmf_pipeline_destroy`
+ *
+ * @param[in]  tmpl  Template handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_pool_delete_template(esp_gmf_pool_tmpl_handle_t tmpl);
+
 /**
  * @brief  Create a new I/O instance from the GMF pool by given name
  *
@@ -133,6 +133,9 @@ typedef struct esp_gmf_port_ {
     struct esp_gmf_port_  *ref_port;      /*!< Pointer to the reference port */
     int8_t                 ref_count;     /*!< Reference count indicating the number of active references */
     uint8_t                out_align;     /*!< Byte alignment of the payload */
+    void                  *payload_pool;  /*!< Payload pool for the self payload buffer, NULL to use the heap */
+    esp_gmf_payload_t     *chain_head;    /*!< Chained payload of the writer while the reader works on the flattened self payload */
+    void                  *clock_sync;    /*!< Clock sync stage applied to the payloads handed to the port IO, NULL for none */
 } esp_gmf_port_t;
 
 /**
@@ -253,6 +256,20 @@ esp_gmf_err_t esp_gmf_port_set_reader(esp_gmf_port_handle_t handle, void *reader
  */
 esp_gmf_err_t esp_gmf_port_set_writer(esp_gmf_port_handle_t handle, void *writer);
 
+/**
+ * @brief  Set the payload pool used by the self payload of the specific port
+ *
+ * @note  The pool is owned by the caller and must outlive the port
+ *
+ * @param[in]  handle  The handle of the port
+ * @param[in]  pool    Handle of the payload pool, NULL to allocate from the heap
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_port_set_payload_pool(esp_gmf_port_handle_t handle, void *pool);
+
 /**
  * @brief  Add a GMF port to the end of the list
  *
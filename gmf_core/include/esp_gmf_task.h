@@ -52,8 +52,24 @@ typedef struct esp_gmf_task_config {
     int         prio;              /*!< Priority of the task */
     uint32_t    core         : 4;  /*!< CPU core affinity for the task */
     uint32_t    stack_in_ext : 4;  /*!< Flag indicating if the stack is in external memory */
+    uint32_t    worker_num   : 4;  /*!< Number of executor workers including the task thread itself,
+                                        0 or 1 selects the single thread mode, limited to ESP_GMF_TASK_MAX_WORKER_NUM.
+                                        The jobs of a pipeline form one chain, so only independent chains gain from it */
 } esp_gmf_task_config_t;
 
+/**
+ * @brief  Scheduling policy of the jobs in a GMF task
+ */
+typedef enum {
+    ESP_GMF_TASK_SCHED_RR  = 0,  /*!< Round-robin over the job list */
+    ESP_GMF_TASK_SCHED_EDF = 1,  /*!< Released periodic jobs with the earliest deadline first, the others in round-robin */
+} esp_gmf_task_sched_t;
+
+/**
+ * @brief  Function run in the task context by `esp_gmf_task_call`
+ */
+typedef esp_gmf_err_t (*esp_gmf_task_call_func)(void *ctx);
+
 /**
  * @brief  GMF task structure
  *
@@ -66,6 +82,7 @@ typedef struct _esp_gmf_task {
     /* Properties */
     esp_gmf_event_cb        event_func;     /*!< Callback function for task events */
     esp_gmf_event_state_t   state;          /*!< Current state of the task */
+    esp_gmf_task_sched_t    sched;          /*!< Scheduling policy of the jobs */
 
     /* Protect */
     esp_gmf_task_config_t   thread;         /*!< Configuration settings for the task */
@@ -73,11 +90,20 @@ typedef struct _esp_gmf_task {
 
     /* Private */
     void                   *oal_thread;     /*!< Handle to the thread */
+    void                   *thread_handle;  /*!< FreeRTOS handle of the task thread, to tell calls made in the task context */
+    void                   *executor;       /*!< Work-stealing executor, NULL in single thread mode */
+    void                   *job_slab;       /*!< Preallocated jobs and interned job labels */
     void                   *lock;           /*!< Mutex lock for task synchronization */
     void                   *block_sem;      /*!< Semaphore for blocking tasks */
     void                   *wait_sem;       /*!< Semaphore for task waiting */
     void                   *api_sync_sem;   /*!< Semaphore for API synchronization */
     int                     api_sync_time;  /*!< Timeout for synchronization */
+    void                   *call_serial;    /*!< Mutex serializing the callers of `esp_gmf_task_call` */
+    void                   *call_lock;      /*!< Mutex protecting the pending call */
+    void                   *call_sem;       /*!< Semaphore given when the pending call is done */
+    esp_gmf_task_call_func  call_func;      /*!< Pending call to run between two rounds of jobs, NULL for none */
+    void                   *call_ctx;       /*!< Context of the pending call */
+    esp_gmf_err_t           call_ret;       /*!< Return value of the last call */
 
     uint8_t                 _task_run : 1;  /*!< Internal flag for task execution */
     uint8_t                 _running  : 1;  /*!< Internal flag for task running state */
@@ -93,15 +119,32 @@ typedef struct _esp_gmf_task {
  *         task name, user context, and callback function.
  */
 typedef struct {
-    esp_gmf_task_config_t  thread;  /*!< Configuration settings for the task thread */
-    const char            *name;    /*!< Name of the task */
-    void                  *ctx;     /*!< User context */
-    esp_gmf_event_cb       cb;      /*!< Callback function for task events */
+    esp_gmf_task_config_t  thread;   /*!< Configuration settings for the task thread */
+    const char            *name;     /*!< Name of the task */
+    void                  *ctx;      /*!< User context */
+    esp_gmf_event_cb       cb;       /*!< Callback function for task events */
+    uint16_t               job_num;  /*!< Number of jobs preallocated in the job slab, 0 means DEFAULT_ESP_GMF_TASK_JOB_NUM */
+    esp_gmf_task_sched_t   sched;    /*!< Scheduling policy of the jobs, EDF is applied in single thread mode only */
 } esp_gmf_task_cfg_t;
 
-#define DEFAULT_ESP_GMF_STACK_SIZE (4 * 1024)
-#define DEFAULT_ESP_GMF_TASK_PRIO  (5)
-#define DEFAULT_ESP_GMF_TASK_CORE  (0)
+/**
+ * @brief  Statistics of the task job slab
+ */
+typedef struct {
+    uint16_t  capacity;    /*!< Number of jobs preallocated in the slab */
+    uint16_t  in_use;      /*!< Number of slab jobs currently registered */
+    uint16_t  high_water;  /*!< Maximum number of slab jobs registered at the same time */
+    uint16_t  label_num;   /*!< Number of interned job labels */
+    uint32_t  overflow;    /*!< Times a job was allocated from heap because the slab was exhausted */
+    uint32_t  miss_cnt;    /*!< Number of job deadline misses */
+    uint32_t  over_cnt;    /*!< Number of job CPU budget overruns */
+} esp_gmf_task_job_stats_t;
+
+#define DEFAULT_ESP_GMF_STACK_SIZE   (4 * 1024)
+#define DEFAULT_ESP_GMF_TASK_PRIO    (5)
+#define DEFAULT_ESP_GMF_TASK_CORE    (0)
+#define ESP_GMF_TASK_MAX_WORKER_NUM  (4)
+#define DEFAULT_ESP_GMF_TASK_JOB_NUM (16)
 
 #define DEFAULT_ESP_GMF_TASK_CONFIG() {       \
     .name = NULL,                             \
@@ -110,6 +153,7 @@ typedef struct {
         .prio = DEFAULT_ESP_GMF_TASK_PRIO,    \
         .core = DEFAULT_ESP_GMF_TASK_CORE,    \
         .stack_in_ext = false,                \
+        .worker_num = 0,                      \
     },                                        \
 }
 
@@ -141,6 +185,9 @@ esp_gmf_err_t esp_gmf_task_deinit(esp_gmf_task_handle_t handle);
 /**
  * @brief  Register a ready job to the specific GMF task
  *
+ *         The job is taken from the preallocated job slab of the task and the label is interned, so once the labels
+ *         are known, registering jobs does not touch the heap. The heap is used only when the slab is exhausted
+ *
  * @param[in]  handle  GMF task handle
  * @param[in]  label   Label for the job
  * @param[in]  job     Job function to register
@@ -155,6 +202,98 @@ esp_gmf_err_t esp_gmf_task_deinit(esp_gmf_task_handle_t handle);
  */
 esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, esp_gmf_job_times_t times, void *ctx, bool done);
 
+/**
+ * @brief  Register a ready job with a dependency chain ID to the specific GMF task
+ *
+ *         Jobs sharing the same `dep_id` always run one after another in registration order. In executor mode
+ *         (`worker_num` > 1) jobs of different chains may run in parallel on different workers. Jobs registered by
+ *         `esp_gmf_task_register_ready_job` belong to chain 0, so by default the behavior equals the single thread mode
+ *
+ * @note  The element and IO jobs of a pipeline all stay in chain 0. Adjacent elements hand their payloads over
+ *        through the linked ports in place, so an element can not run while its upstream element fills the payload
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  label   Label for the job
+ * @param[in]  job     Job function to register
+ * @param[in]  times   Job execution times configuration
+ * @param[in]  ctx     Context to be passed to the job function
+ * @param[in]  dep_id  Dependency chain ID of the job
+ * @param[in]  done    Flag indicating whether the job is done
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory to perform the registration
+ */
+esp_gmf_err_t esp_gmf_task_register_ready_job_with_dep(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job,
+                                                       esp_gmf_job_times_t times, void *ctx, uint16_t dep_id, bool done);
+
+/**
+ * @brief  Register a ready job in front of the first job of another context
+ *
+ *         The job is appended when no job of `before_ctx` is registered, so registering the jobs of a chain of
+ *         contexts in order gives the same list as `esp_gmf_task_register_ready_job`
+ *
+ * @note  The job list must not be walked by the task meanwhile, so call it from the task context, e.g. through
+ *        `esp_gmf_task_call`, or while the task is not running
+ *
+ * @param[in]  handle      GMF task handle
+ * @param[in]  label       Label for the job
+ * @param[in]  job         Job function to register
+ * @param[in]  times       Job execution times configuration
+ * @param[in]  ctx         Context to be passed to the job function
+ * @param[in]  before_ctx  Context of the job to insert in front of, NULL to append
+ * @param[in]  done        Flag indicating whether the job is done
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory to perform the registration
+ */
+esp_gmf_err_t esp_gmf_task_insert_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job,
+                                            esp_gmf_job_times_t times, void *ctx, void *before_ctx, bool done);
+
+/**
+ * @brief  Retire the registered jobs of the specific context
+ *
+ *         The jobs are not unlinked at once, as the task may hold one of them, they turn into one-shot jobs doing
+ *         nothing and leave the list the next time they are visited. `ctx` is not referenced afterwards
+ *
+ * @note  Same calling context as `esp_gmf_task_insert_ready_job`
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  ctx     Context of the jobs to retire
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_task_retire_jobs(esp_gmf_task_handle_t handle, void *ctx);
+
+/**
+ * @brief  Run a function in the task context between two rounds of jobs
+ *
+ *         While the task is running, the call waits until the task has gone through its job list and is about to
+ *         start over, no job is in the middle of a frame then. Otherwise, e.g. the task is paused or idle, the
+ *         function runs in the caller context right away, holding off the other task APIs
+ *         Called from a job or the event callback of the same task, the function runs right away as well
+ *
+ * @note  The wait is bounded by the timeout set by `esp_gmf_task_set_timeout`, a job blocked in IO holds the call
+ *        off until then. The call not served yet is dropped on timeout or when the task is stopped, `func` is not
+ *        run later in that case
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  func    Function to run
+ * @param[in]  ctx     Context to be passed to the function
+ *
+ * @return
+ *       - ESP_GMF_ERR_INVALID_ARG    Indicating the handle or function is invalid
+ *       - ESP_GMF_ERR_TIMEOUT        Indicating the task did not reach a round boundary in time, `func` was not run
+ *       - ESP_GMF_ERR_INVALID_STATE  Indicating the task was stopped before serving the call, `func` was not run
+ *       - Others                     The return value of `func`
+ */
+esp_gmf_err_t esp_gmf_task_call(esp_gmf_task_handle_t handle, esp_gmf_task_call_func func, void *ctx);
+
 /**
  * @brief  Set the event callback function for a GMF task
  *
@@ -262,6 +401,39 @@ esp_gmf_err_t esp_gmf_task_set_timeout(esp_gmf_task_handle_t handle, int wait_ms
  */
 esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event_state_t *state);
 
+/**
+ * @brief  Set the timing constraints of the jobs with the specific label
+ *
+ *         The timing is kept with the interned label, so it applies to the registered jobs and to the jobs registered
+ *         with the same label later, e.g. after the pipeline restarts. Deadline misses and budget overruns are reported
+ *         by ESP_GMF_EVT_TYPE_JOB_OVERRUN events through the task event callback
+ *         The registered jobs are updated in the task context through `esp_gmf_task_call`
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  label   Label of the jobs
+ * @param[in]  timing  Timing constraints, NULL to clear them
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle or label is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory to intern the label
+ *       - ESP_GMF_ERR_TIMEOUT      The registered jobs were not updated in time, the later registered ones still get it
+ */
+esp_gmf_err_t esp_gmf_task_set_job_timing(esp_gmf_task_handle_t handle, const char *label, const esp_gmf_job_timing_t *timing);
+
+/**
+ * @brief  Get the job statistics of the specific task, including the slab high-water mark, the heap fallback count
+ *         and the timing overrun counters
+ *
+ * @param[in]   handle  GMF task handle
+ * @param[out]  stats   Pointer to store the job slab statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle or stats is invalid
+ */
+esp_gmf_err_t esp_gmf_task_get_job_stats(esp_gmf_task_handle_t handle, esp_gmf_task_job_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -26,6 +26,8 @@
 #include "string.h"
 #include "sdkconfig.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_heap_caps.h"
 #include "hal/efuse_hal.h"
@@ -45,8 +47,320 @@ void __attribute__((weak)) media_lib_remove_trace_mem(void *addr)
 }
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
 
+#define GMF_MEM_ARENA_ALIGN       (8)
+#define GMF_MEM_ARENA_ALIGN_UP(x) (((x) + GMF_MEM_ARENA_ALIGN - 1) & ~(GMF_MEM_ARENA_ALIGN - 1))
+#define GMF_MEM_ARENA_MAGIC       (0xA5E7)
+#define GMF_MEM_ARENA_MAP_STEP    (16)
+#define GMF_MEM_ARENA_CHUNK_HDR   GMF_MEM_ARENA_ALIGN_UP(sizeof(gmf_mem_arena_chunk_t))
+#define GMF_MEM_ARENA_BLOCK_HDR   GMF_MEM_ARENA_ALIGN_UP(sizeof(gmf_mem_arena_block_t))
+
+/**
+ * @brief  Chunk taken from the heap, the blocks are carved from `pos` upwards
+ */
+typedef struct gmf_mem_arena_chunk {
+    struct gmf_mem_arena_chunk    *next;   /*!< Next older chunk */
+    struct gmf_mem_arena_chunk    *prev;   /*!< Next newer chunk, NULL for the newest one */
+    struct esp_gmf_oal_mem_arena  *arena;  /*!< Arena the chunk belongs to */
+    uint8_t                       *pos;    /*!< First free byte */
+    uint8_t                       *end;    /*!< End of the chunk */
+    uint32_t                       live;   /*!< Number of allocated blocks in the chunk */
+} gmf_mem_arena_chunk_t;
+
+/**
+ * @brief  Header in front of each arena block
+ */
+typedef struct {
+    uint32_t  size;     /*!< Requested size, the block occupies the aligned size */
+    uint16_t  tag_idx;  /*!< Index of the tag the block is accounted to */
+    uint16_t  magic;    /*!< GMF_MEM_ARENA_MAGIC while the block is allocated */
+} gmf_mem_arena_block_t;
+
+typedef struct {
+    char                     name[ESP_GMF_OAL_MEM_ARENA_TAG_LEN];
+    esp_gmf_oal_mem_stats_t  stats;
+} gmf_mem_arena_tag_t;
+
+struct esp_gmf_oal_mem_arena {
+    struct esp_gmf_oal_mem_arena  *next;       /*!< Next arena in the global list */
+    gmf_mem_arena_chunk_t         *chunk;      /*!< Newest chunk, the only one blocks are carved from */
+    size_t                         chunk_size;
+    void                          *owner;      /*!< Task in the arena scope, NULL if none */
+    uint16_t                       cur_tag;
+    uint16_t                       tag_num;
+    esp_gmf_oal_mem_stats_t        total;
+    gmf_mem_arena_tag_t            tag[ESP_GMF_OAL_MEM_ARENA_MAX_TAG];  /*!< Tag 0 holds the untagged allocations */
+};
+
+static struct esp_gmf_oal_mem_arena *s_arena_list;
+static volatile int                  s_arena_scope_cnt;
+static portMUX_TYPE                  s_arena_lock = portMUX_INITIALIZER_UNLOCKED;
+// Live chunks of all the arenas sorted by address, a free looks its pointer up here under s_arena_lock
+static gmf_mem_arena_chunk_t       **s_chunk_map;
+static uint32_t                      s_chunk_num;
+static uint32_t                      s_chunk_cap;
+
+static inline void *arena_heap_malloc(size_t size)
+{
+#if CONFIG_SPIRAM_BOOT_INIT
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    return malloc(size);
+#endif  /* CONFIG_SPIRAM_BOOT_INIT */
+}
+
+static inline void arena_stats_add(esp_gmf_oal_mem_stats_t *stats, size_t size)
+{
+    stats->current += size;
+    stats->count++;
+    stats->alloc_cnt++;
+    if (stats->current > stats->peak) {
+        stats->peak = stats->current;
+    }
+}
+
+static inline void arena_stats_sub(esp_gmf_oal_mem_stats_t *stats, size_t size)
+{
+    stats->current -= size;
+    stats->count--;
+}
+
+static inline uint8_t *arena_chunk_data(gmf_mem_arena_chunk_t *chunk)
+{
+    return (uint8_t *)chunk + GMF_MEM_ARENA_CHUNK_HDR;
+}
+
+static inline gmf_mem_arena_block_t *arena_block_hdr(void *ptr)
+{
+    return (gmf_mem_arena_block_t *)((uint8_t *)ptr - GMF_MEM_ARENA_BLOCK_HDR);
+}
+
+static void *arena_bump(struct esp_gmf_oal_mem_arena *arena, gmf_mem_arena_chunk_t *chunk, size_t size)
+{
+    // Must be called with s_arena_lock held
+    // The heap only aligns the chunk to 4 bytes, so the block start is aligned by its address
+    if (chunk == NULL) {
+        return NULL;
+    }
+    uint8_t *data = (uint8_t *)GMF_MEM_ARENA_ALIGN_UP((uintptr_t)chunk->pos + GMF_MEM_ARENA_BLOCK_HDR);
+    if ((data > chunk->end) || ((size_t)(chunk->end - data) < GMF_MEM_ARENA_ALIGN_UP(size))) {
+        return NULL;
+    }
+    gmf_mem_arena_block_t *blk = (gmf_mem_arena_block_t *)(data - GMF_MEM_ARENA_BLOCK_HDR);
+    chunk->pos = data + GMF_MEM_ARENA_ALIGN_UP(size);
+    chunk->live++;
+    blk->size = size;
+    blk->tag_idx = arena->cur_tag;
+    blk->magic = GMF_MEM_ARENA_MAGIC;
+    arena_stats_add(&arena->total, size);
+    arena_stats_add(&arena->tag[blk->tag_idx].stats, size);
+    return data;
+}
+
+static uint32_t arena_map_index(void *ptr)
+{
+    // Must be called with s_arena_lock held, returns the number of chunks starting at or below `ptr`
+    uint32_t lo = 0, hi = s_chunk_num;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if ((uint8_t *)s_chunk_map[mid] <= (uint8_t *)ptr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static gmf_mem_arena_chunk_t *arena_map_find(void *ptr)
+{
+    // Must be called with s_arena_lock held
+    uint32_t idx = arena_map_index(ptr);
+    if (idx == 0) {
+        return NULL;
+    }
+    gmf_mem_arena_chunk_t *chunk = s_chunk_map[idx - 1];
+    if (((uint8_t *)ptr < arena_chunk_data(chunk) + GMF_MEM_ARENA_BLOCK_HDR) || ((uint8_t *)ptr >= chunk->end)) {
+        return NULL;
+    }
+    return chunk;
+}
+
+static void arena_map_remove(gmf_mem_arena_chunk_t *chunk)
+{
+    // Must be called with s_arena_lock held
+    uint32_t idx = arena_map_index(chunk);
+    if ((idx == 0) || (s_chunk_map[idx - 1] != chunk)) {
+        return;
+    }
+    memmove(&s_chunk_map[idx - 1], &s_chunk_map[idx], (s_chunk_num - idx) * sizeof(gmf_mem_arena_chunk_t *));
+    s_chunk_num--;
+}
+
+static bool arena_map_insert(gmf_mem_arena_chunk_t *chunk)
+{
+    // Enters s_arena_lock and keeps it held on success, the map is grown outside of the lock when it is full
+    while (true) {
+        portENTER_CRITICAL(&s_arena_lock);
+        if (s_chunk_num < s_chunk_cap) {
+            uint32_t idx = arena_map_index(chunk);
+            memmove(&s_chunk_map[idx + 1], &s_chunk_map[idx], (s_chunk_num - idx) * sizeof(gmf_mem_arena_chunk_t *));
+            s_chunk_map[idx] = chunk;
+            s_chunk_num++;
+            return true;
+        }
+        uint32_t cap = s_chunk_cap + GMF_MEM_ARENA_MAP_STEP;
+        portEXIT_CRITICAL(&s_arena_lock);
+        gmf_mem_arena_chunk_t **map = arena_heap_malloc(cap * sizeof(gmf_mem_arena_chunk_t *));
+        if (map == NULL) {
+            return false;
+        }
+        portENTER_CRITICAL(&s_arena_lock);
+        if (s_chunk_cap < cap) {
+            if (s_chunk_num) {
+                memcpy(map, s_chunk_map, s_chunk_num * sizeof(gmf_mem_arena_chunk_t *));
+            }
+            gmf_mem_arena_chunk_t **old = s_chunk_map;
+            s_chunk_map = map;
+            s_chunk_cap = cap;
+            map = old;
+        }
+        portEXIT_CRITICAL(&s_arena_lock);
+        free(map);
+    }
+}
+
+static void *arena_alloc(struct esp_gmf_oal_mem_arena *arena, size_t size)
+{
+    portENTER_CRITICAL(&s_arena_lock);
+    void *ptr = arena_bump(arena, arena->chunk, size);
+    portEXIT_CRITICAL(&s_arena_lock);
+    if (ptr) {
+        return ptr;
+    }
+    size_t chunk_size = GMF_MEM_ARENA_CHUNK_HDR + GMF_MEM_ARENA_ALIGN + GMF_MEM_ARENA_BLOCK_HDR + GMF_MEM_ARENA_ALIGN_UP(size);
+    bool oversize = chunk_size > arena->chunk_size;
+    if (oversize == false) {
+        chunk_size = arena->chunk_size;
+    }
+    gmf_mem_arena_chunk_t *chunk = arena_heap_malloc(chunk_size);
+    if (chunk == NULL) {
+        return NULL;
+    }
+#ifdef ENABLE_AUDIO_MEM_TRACE
+    media_lib_add_trace_mem("arena", chunk, chunk_size, 0);
+#endif  /* ENABLE_AUDIO_MEM_TRACE */
+    chunk->arena = arena;
+    chunk->pos = arena_chunk_data(chunk);
+    chunk->end = (uint8_t *)chunk + chunk_size;
+    chunk->live = 0;
+    if (arena_map_insert(chunk) == false) {
+#ifdef ENABLE_AUDIO_MEM_TRACE
+        media_lib_remove_trace_mem(chunk);
+#endif  /* ENABLE_AUDIO_MEM_TRACE */
+        free(chunk);
+        return NULL;
+    }
+    if (oversize && arena->chunk) {
+        // A dedicated chunk goes behind the newest one, which keeps serving the small blocks
+        chunk->prev = arena->chunk;
+        chunk->next = arena->chunk->next;
+        arena->chunk->next = chunk;
+    } else {
+        // The newest chunk is full, the space left in it is given up
+        chunk->prev = NULL;
+        chunk->next = arena->chunk;
+        arena->chunk = chunk;
+    }
+    if (chunk->next) {
+        chunk->next->prev = chunk;
+    }
+    arena->total.reserved += chunk_size;
+    ptr = arena_bump(arena, chunk, size);
+    portEXIT_CRITICAL(&s_arena_lock);
+    return ptr;
+}
+
+static bool arena_release(void *ptr)
+{
+    gmf_mem_arena_chunk_t *drop = NULL;
+    portENTER_CRITICAL(&s_arena_lock);
+    gmf_mem_arena_chunk_t *chunk = arena_map_find(ptr);
+    if (chunk == NULL) {
+        portEXIT_CRITICAL(&s_arena_lock);
+        return false;
+    }
+    gmf_mem_arena_block_t *blk = arena_block_hdr(ptr);
+    if ((((uintptr_t)ptr & (GMF_MEM_ARENA_ALIGN - 1)) != 0) || (blk->magic != GMF_MEM_ARENA_MAGIC)) {
+        portEXIT_CRITICAL(&s_arena_lock);
+        ESP_LOGE("ESP_GMF_MEM", "Invalid or double free of arena block %p", ptr);
+        return true;
+    }
+    struct esp_gmf_oal_mem_arena *arena = chunk->arena;
+    blk->magic = 0;
+    arena_stats_sub(&arena->total, blk->size);
+    arena_stats_sub(&arena->tag[blk->tag_idx].stats, blk->size);
+    // Give back the space of the last block, so a grow by realloc does not leave a hole
+    if ((uint8_t *)ptr + GMF_MEM_ARENA_ALIGN_UP(blk->size) == chunk->pos) {
+        chunk->pos = (uint8_t *)blk;
+    }
+    if (--chunk->live == 0) {
+        if (chunk == arena->chunk) {
+            chunk->pos = arena_chunk_data(chunk);
+        } else {
+            // Older chunks receive no more blocks, return them to the heap as soon as they are empty
+            chunk->prev->next = chunk->next;
+            if (chunk->next) {
+                chunk->next->prev = chunk->prev;
+            }
+            arena_map_remove(chunk);
+            arena->total.reserved -= chunk->end - (uint8_t *)chunk;
+            drop = chunk;
+        }
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    if (drop) {
+#ifdef ENABLE_AUDIO_MEM_TRACE
+        media_lib_remove_trace_mem(drop);
+#endif  /* ENABLE_AUDIO_MEM_TRACE */
+        free(drop);
+    }
+    return true;
+}
+
+static bool arena_block_size(void *ptr, size_t *size)
+{
+    portENTER_CRITICAL(&s_arena_lock);
+    gmf_mem_arena_chunk_t *chunk = arena_map_find(ptr);
+    if (chunk) {
+        *size = arena_block_hdr(ptr)->size;
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    return chunk != NULL;
+}
+
+static inline struct esp_gmf_oal_mem_arena *arena_scope_get(void)
+{
+    if (s_arena_scope_cnt == 0) {
+        return NULL;
+    }
+    void *task = xTaskGetCurrentTaskHandle();
+    struct esp_gmf_oal_mem_arena *arena = NULL;
+    portENTER_CRITICAL(&s_arena_lock);
+    for (arena = s_arena_list; arena; arena = arena->next) {
+        if (arena->owner == task) {
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    return arena;
+}
+
 void *esp_gmf_oal_malloc(size_t size)
 {
+    struct esp_gmf_oal_mem_arena *arena = arena_scope_get();
+    if (arena) {
+        return arena_alloc(arena, size);
+    }
     void *data = NULL;
 #if CONFIG_SPIRAM_BOOT_INIT
     data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
@@ -62,6 +376,10 @@ void *esp_gmf_oal_malloc(size_t size)
 
 void *esp_gmf_oal_malloc_align(uint8_t align, size_t size)
 {
+    struct esp_gmf_oal_mem_arena *arena = align <= GMF_MEM_ARENA_ALIGN ? arena_scope_get() : NULL;
+    if (arena) {
+        return arena_alloc(arena, size);
+    }
     void *data = NULL;
 #if CONFIG_SPIRAM_BOOT_INIT
     if (align <= 1) {
@@ -83,8 +401,25 @@ void *esp_gmf_oal_malloc_align(uint8_t align, size_t size)
     return data;
 }
 
+void *esp_gmf_oal_malloc_align_inner(uint8_t align, size_t size)
+{
+    void *data = NULL;
+    if (align <= 1) {
+        data = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    } else {
+        data = heap_caps_aligned_alloc(align, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+#ifdef ENABLE_AUDIO_MEM_TRACE
+    media_lib_add_trace_mem(NULL, data, size, 0);
+#endif  /* ENABLE_AUDIO_MEM_TRACE */
+    return data;
+}
+
 void esp_gmf_oal_free(void *ptr)
 {
+    if (ptr && s_arena_list && arena_release(ptr)) {
+        return;
+    }
 #ifdef ENABLE_AUDIO_MEM_TRACE
     media_lib_remove_trace_mem(ptr);
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
@@ -95,6 +430,14 @@ void esp_gmf_oal_free(void *ptr)
 
 void *esp_gmf_oal_calloc(size_t nmemb, size_t size)
 {
+    struct esp_gmf_oal_mem_arena *arena = arena_scope_get();
+    if (arena) {
+        void *data = arena_alloc(arena, nmemb * size);
+        if (data) {
+            memset(data, 0, nmemb * size);
+        }
+        return data;
+    }
     void *data = NULL;
 #if CONFIG_SPIRAM_BOOT_INIT
     data = heap_caps_malloc(nmemb * size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
@@ -114,6 +457,22 @@ void *esp_gmf_oal_calloc(size_t nmemb, size_t size)
 
 void *esp_gmf_oal_realloc(void *ptr, size_t size)
 {
+    size_t old_size = 0;
+    if (ptr && s_arena_list && arena_block_size(ptr, &old_size)) {
+        // Arena blocks can not be resized in place, move the data to a block from the current scope or the heap
+        void *p = esp_gmf_oal_malloc(size);
+        if (p) {
+            memcpy(p, ptr, old_size < size ? old_size : size);
+            esp_gmf_oal_free(ptr);
+        }
+        return p;
+    }
+    if (ptr == NULL) {
+        struct esp_gmf_oal_mem_arena *arena = arena_scope_get();
+        if (arena) {
+            return arena_alloc(arena, size);
+        }
+    }
     void *p = NULL;
 #ifdef ENABLE_AUDIO_MEM_TRACE
     media_lib_remove_trace_mem(ptr);
@@ -135,6 +494,14 @@ void *esp_gmf_oal_realloc(void *ptr, size_t size)
 char *esp_gmf_oal_strdup(const char *str)
 {
     int size = strlen(str) + 1;
+    struct esp_gmf_oal_mem_arena *arena = arena_scope_get();
+    if (arena) {
+        char *copy = arena_alloc(arena, size);
+        if (copy) {
+            strcpy(copy, str);
+        }
+        return copy;
+    }
 #if CONFIG_SPIRAM_BOOT_INIT
     char *copy = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
 #else
@@ -194,3 +561,163 @@ bool esp_gmf_oal_mem_spiram_stack_is_enabled(void)
     return false;
 #endif  /* defined(CONFIG_SPIRAM_BOOT_INIT) && (CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY) */
 }
+
+static uint16_t arena_tag_index(struct esp_gmf_oal_mem_arena *arena, const char *tag)
+{
+    if (tag == NULL) {
+        return 0;
+    }
+    for (uint16_t i = 1; i < arena->tag_num; i++) {
+        if (strncmp(arena->tag[i].name, tag, ESP_GMF_OAL_MEM_ARENA_TAG_LEN - 1) == 0) {
+            return i;
+        }
+    }
+    if (arena->tag_num >= ESP_GMF_OAL_MEM_ARENA_MAX_TAG) {
+        ESP_LOGW("ESP_GMF_MEM", "No more arena tag, account %s as untagged", tag);
+        return 0;
+    }
+    strncpy(arena->tag[arena->tag_num].name, tag, ESP_GMF_OAL_MEM_ARENA_TAG_LEN - 1);
+    return arena->tag_num++;
+}
+
+esp_gmf_err_t esp_gmf_oal_mem_arena_create(size_t chunk_size, esp_gmf_oal_mem_arena_handle_t *arena)
+{
+    if ((arena == NULL) || (chunk_size <= GMF_MEM_ARENA_CHUNK_HDR + GMF_MEM_ARENA_BLOCK_HDR)) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    // The arena itself comes from the heap even in the scope of another arena
+    struct esp_gmf_oal_mem_arena *new_arena = arena_heap_malloc(sizeof(struct esp_gmf_oal_mem_arena));
+    if (new_arena == NULL) {
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    memset(new_arena, 0, sizeof(struct esp_gmf_oal_mem_arena));
+    new_arena->chunk_size = chunk_size;
+    new_arena->tag_num = 1;
+    strcpy(new_arena->tag[0].name, "-");
+    portENTER_CRITICAL(&s_arena_lock);
+    new_arena->next = s_arena_list;
+    s_arena_list = new_arena;
+    portEXIT_CRITICAL(&s_arena_lock);
+    *arena = new_arena;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_oal_mem_arena_destroy(esp_gmf_oal_mem_arena_handle_t arena)
+{
+    if (arena == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    if (arena->total.count) {
+        ESP_LOGW("ESP_GMF_MEM", "Arena %p destroyed with %d blocks, %d bytes still allocated", arena,
+                 (int)arena->total.count, (int)arena->total.current);
+        esp_gmf_oal_mem_arena_show(arena, "ESP_GMF_MEM");
+    }
+    portENTER_CRITICAL(&s_arena_lock);
+    for (struct esp_gmf_oal_mem_arena **pos = &s_arena_list; *pos; pos = &(*pos)->next) {
+        if (*pos == arena) {
+            *pos = arena->next;
+            break;
+        }
+    }
+    if (arena->owner) {
+        s_arena_scope_cnt--;
+    }
+    for (gmf_mem_arena_chunk_t *chunk = arena->chunk; chunk; chunk = chunk->next) {
+        arena_map_remove(chunk);
+    }
+    gmf_mem_arena_chunk_t **map = NULL;
+    if (s_arena_list == NULL) {
+        map = s_chunk_map;
+        s_chunk_map = NULL;
+        s_chunk_num = 0;
+        s_chunk_cap = 0;
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    free(map);
+    gmf_mem_arena_chunk_t *chunk = arena->chunk;
+    while (chunk) {
+        gmf_mem_arena_chunk_t *next = chunk->next;
+#ifdef ENABLE_AUDIO_MEM_TRACE
+        media_lib_remove_trace_mem(chunk);
+#endif  /* ENABLE_AUDIO_MEM_TRACE */
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_oal_mem_arena_enter(esp_gmf_oal_mem_arena_handle_t arena, const char *tag)
+{
+    if (arena == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    void *task = xTaskGetCurrentTaskHandle();
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    portENTER_CRITICAL(&s_arena_lock);
+    if (arena->owner == NULL) {
+        arena->owner = task;
+        s_arena_scope_cnt++;
+    } else if (arena->owner != task) {
+        ret = ESP_GMF_ERR_INVALID_STATE;
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    if (ret == ESP_GMF_ERR_OK) {
+        // Only the task in the scope adds tags
+        arena->cur_tag = arena_tag_index(arena, tag);
+    }
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_oal_mem_arena_leave(esp_gmf_oal_mem_arena_handle_t arena)
+{
+    if (arena == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_arena_lock);
+    if (arena->owner == xTaskGetCurrentTaskHandle()) {
+        arena->owner = NULL;
+        arena->cur_tag = 0;
+        s_arena_scope_cnt--;
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_oal_mem_arena_get_stats(esp_gmf_oal_mem_arena_handle_t arena, const char *tag, esp_gmf_oal_mem_stats_t *stats)
+{
+    if ((arena == NULL) || (stats == NULL)) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_arena_lock);
+    if (tag == NULL) {
+        *stats = arena->total;
+        ret = ESP_GMF_ERR_OK;
+    } else {
+        for (uint16_t i = 1; i < arena->tag_num; i++) {
+            if (strncmp(arena->tag[i].name, tag, ESP_GMF_OAL_MEM_ARENA_TAG_LEN - 1) == 0) {
+                *stats = arena->tag[i].stats;
+                ret = ESP_GMF_ERR_OK;
+                break;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&s_arena_lock);
+    return ret;
+}
+
+void esp_gmf_oal_mem_arena_show(esp_gmf_oal_mem_arena_handle_t arena, const char *tag)
+{
+    if (arena == NULL) {
+        return;
+    }
+    esp_gmf_oal_mem_stats_t total = arena->total;
+    ESP_LOGI(tag, "Arena %p, current:%d, peak:%d, count:%d, allocs:%d, reserved:%d", arena, (int)total.current,
+             (int)total.peak, (int)total.count, (int)total.alloc_cnt, (int)total.reserved);
+    for (uint16_t i = 0; i < arena->tag_num; i++) {
+        esp_gmf_oal_mem_stats_t stats = arena->tag[i].stats;
+        ESP_LOGI(tag, "  %-16s current:%d, peak:%d, count:%d, allocs:%d", arena->tag[i].name, (int)stats.current,
+                 (int)stats.peak, (int)stats.count, (int)stats.alloc_cnt);
+    }
+}
@@ -27,6 +27,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_oal_sys.h"
 
@@ -61,6 +62,11 @@ int64_t esp_gmf_oal_sys_get_time_ms(void)
     return milliseconds;
 }
 
+int64_t esp_gmf_oal_sys_get_time_us(void)
+{
+    return esp_timer_get_time();
+}
+
 esp_gmf_err_t esp_gmf_oal_sys_get_real_time_stats(int elapsed_time_ms)
 {
 #if (CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
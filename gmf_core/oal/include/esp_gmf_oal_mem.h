@@ -25,11 +25,35 @@
 #pragma once
 
 #include <esp_types.h>
+#include "esp_gmf_err.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif  /* __cplusplus */
 
+#define ESP_GMF_OAL_MEM_ARENA_MAX_TAG  (16)  /*!< Maximum number of tags accounted separately by an arena */
+#define ESP_GMF_OAL_MEM_ARENA_TAG_LEN  (16)  /*!< Maximum length of an arena tag, including the terminator */
+
+/**
+ * @brief  Handle of a memory arena
+ *
+ *         An arena carves the allocations made in its scope out of a few large chunks, so the objects of one pipeline
+ *         are kept together instead of being spread over the heap, and all the chunks go back to the heap at once
+ *         when the arena is destroyed
+ */
+typedef struct esp_gmf_oal_mem_arena *esp_gmf_oal_mem_arena_handle_t;
+
+/**
+ * @brief  Memory accounting of an arena or of one of its tags
+ */
+typedef struct {
+    size_t    current;    /*!< Bytes currently allocated */
+    size_t    peak;       /*!< Highest value reached by `current` */
+    uint32_t  count;      /*!< Number of live allocations */
+    uint32_t  alloc_cnt;  /*!< Number of allocations since the arena was created */
+    size_t    reserved;   /*!< Bytes of the chunks taken from the heap, only filled for the whole arena */
+} esp_gmf_oal_mem_stats_t;
+
 /**
  * @brief  Allocate memory of a specified size
  *
@@ -53,6 +77,18 @@ void *esp_gmf_oal_malloc(size_t size);
  */
 void *esp_gmf_oal_malloc_align(uint8_t align, size_t size);
 
+/**
+ * @brief  Allocate memory with specified alignment from internal RAM only
+ *
+ * @param[in]  align  Memory alignment in bytes (must be a power of 2 or 0)
+ * @param[in]  size   Size of memory to allocate, in bytes
+ *
+ * @return
+ *       - Pointer  to aligned memory on success
+ *       - NULL     if an error occurs
+ */
+void *esp_gmf_oal_malloc_align_inner(uint8_t align, size_t size);
+
 /**
  * @brief  Free allocated memory
  *
@@ -136,6 +172,87 @@ bool esp_gmf_oal_mem_spiram_is_enabled(void);
  */
 bool esp_gmf_oal_mem_spiram_stack_is_enabled(void);
 
+/**
+ * @brief  Create a memory arena
+ *
+ * @note  The arena serves nothing until a task enters it with `esp_gmf_oal_mem_arena_enter`
+ *
+ * @param[in]   chunk_size  Size of the chunks taken from the heap, larger allocations get a chunk of their own
+ * @param[out]  arena       Pointer to store the arena handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_oal_mem_arena_create(size_t chunk_size, esp_gmf_oal_mem_arena_handle_t *arena);
+
+/**
+ * @brief  Destroy a memory arena and give all its chunks back to the heap
+ *
+ * @note  Blocks still allocated from the arena are released as well and reported as leaks
+ *
+ * @param[in]  arena  Arena handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_oal_mem_arena_destroy(esp_gmf_oal_mem_arena_handle_t arena);
+
+/**
+ * @brief  Route the allocations of the calling task to the arena and account them to the given tag
+ *
+ *         While the scope is active `esp_gmf_oal_malloc`, `esp_gmf_oal_calloc`, `esp_gmf_oal_strdup`,
+ *         `esp_gmf_oal_realloc` and `esp_gmf_oal_malloc_align` with an alignment up to 8 bytes are served by the arena.
+ *         Allocations of other tasks and the internal RAM variants keep using the heap. `esp_gmf_oal_free` recognizes
+ *         arena blocks from any task. Calling it again from the same task only switches the tag
+ *
+ * @note  Objects allocated in the scope must not outlive the arena
+ *
+ * @param[in]  arena  Arena handle
+ * @param[in]  tag    Tag to account the allocations to, NULL for the untagged bucket
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_INVALID_STATE  The arena is in the scope of another task
+ */
+esp_gmf_err_t esp_gmf_oal_mem_arena_enter(esp_gmf_oal_mem_arena_handle_t arena, const char *tag);
+
+/**
+ * @brief  Leave the arena scope, the following allocations of the calling task go to the heap again
+ *
+ * @param[in]  arena  Arena handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_oal_mem_arena_leave(esp_gmf_oal_mem_arena_handle_t arena);
+
+/**
+ * @brief  Get the memory accounting of an arena
+ *
+ * @param[in]   arena  Arena handle
+ * @param[in]   tag    Tag to query, NULL for the whole arena
+ * @param[out]  stats  Pointer to store the accounting
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    No allocation was accounted to the tag
+ */
+esp_gmf_err_t esp_gmf_oal_mem_arena_get_stats(esp_gmf_oal_mem_arena_handle_t arena, const char *tag, esp_gmf_oal_mem_stats_t *stats);
+
+/**
+ * @brief  Print the memory accounting of an arena, one line per tag
+ *
+ * @param[in]  arena  Arena handle
+ * @param[in]  tag    Log tag identifier
+ */
+void esp_gmf_oal_mem_arena_show(esp_gmf_oal_mem_arena_handle_t arena, const char *tag);
+
 #define ESP_GMF_MEM_SHOW(x) esp_gmf_oal_mem_print(x, __LINE__, __func__)
 
 #ifdef __cplusplus
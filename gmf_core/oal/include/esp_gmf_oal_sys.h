@@ -54,6 +54,14 @@ int esp_gmf_oal_sys_get_tick_by_time_ms(int ms);
  */
 int64_t esp_gmf_oal_sys_get_time_ms(void);
 
+/**
+ * @brief  Retrieve the monotonic time since boot in microseconds, it is cheap enough to be used for profiling
+ *
+ * @return
+ *       - The  time since boot in microseconds
+ */
+int64_t esp_gmf_oal_sys_get_time_us(void);
+
 /**
  * @brief  Print CPU usage statistics of tasks over a specified time period
  *
@@ -0,0 +1,289 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_clock.h"
+
+static const char *TAG = "ESP_GMF_CLOCK";
+
+typedef struct esp_gmf_clock esp_gmf_clock_t;
+
+typedef struct esp_gmf_clock_sync {
+    struct esp_gmf_clock_sync  *next;    /*!< Next sync stage of the clock */
+    esp_gmf_clock_t            *clock;   /*!< Clock the stage is attached to */
+    esp_gmf_clock_sync_cfg_t    cfg;     /*!< Configuration of the stage */
+    esp_gmf_clock_report_t      report;  /*!< Drift and latency report */
+} esp_gmf_clock_sync_t;
+
+struct esp_gmf_clock {
+    esp_gmf_clock_cfg_t    cfg;        /*!< Configuration of the clock */
+    void                  *lock;       /*!< Lock of the time reference and the reports */
+    esp_gmf_clock_sync_t  *syncs;      /*!< Attached sync stages */
+    esp_gmf_clock_sync_t  *master;     /*!< Master sync stage, NULL for none */
+    bool                   started;    /*!< The time reference is set */
+    int64_t                base_time;  /*!< Time base reading at the reference point */
+    int64_t                base_pts;   /*!< Media time at the reference point */
+};
+
+static int64_t clock_sys_now_ms(void *ctx)
+{
+    return esp_gmf_oal_sys_get_time_ms();
+}
+
+static void clock_sys_sleep_ms(void *ctx, int64_t ms)
+{
+    vTaskDelay(esp_gmf_oal_sys_get_tick_by_time_ms((int)ms));
+}
+
+static inline int64_t clock_media_time(esp_gmf_clock_t *clk)
+{
+    return clk->base_pts + clk->cfg.time_ops.now_ms(clk->cfg.time_ops.ctx) - clk->base_time;
+}
+
+static inline void clock_set_reference(esp_gmf_clock_t *clk, int64_t pts)
+{
+    clk->base_time = clk->cfg.time_ops.now_ms(clk->cfg.time_ops.ctx);
+    clk->base_pts = pts;
+    clk->started = true;
+}
+
+static inline void clock_report_drift(esp_gmf_clock_report_t *report, int64_t drift)
+{
+    report->drift_ms = (int32_t)drift;
+    int32_t abs_drift = drift < 0 ? -drift : drift;
+    int32_t abs_max = report->max_drift_ms < 0 ? -report->max_drift_ms : report->max_drift_ms;
+    if (abs_drift > abs_max) {
+        report->max_drift_ms = (int32_t)drift;
+    }
+}
+
+static inline void clock_report_latency(esp_gmf_clock_report_t *report, int64_t latency)
+{
+    report->latency_ms = (int32_t)latency;
+    if (report->latency_ms > report->max_latency_ms) {
+        report->max_latency_ms = report->latency_ms;
+    }
+}
+
+esp_gmf_err_t esp_gmf_clock_create(const esp_gmf_clock_cfg_t *cfg, esp_gmf_clock_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    *handle = NULL;
+    if ((cfg->time_ops.now_ms == NULL) != (cfg->time_ops.sleep_ms == NULL)) {
+        ESP_LOGE(TAG, "Both time operations must be set or none of them");
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_clock_t *clk = esp_gmf_oal_calloc(1, sizeof(esp_gmf_clock_t));
+    ESP_GMF_MEM_CHECK(TAG, clk, return ESP_GMF_ERR_MEMORY_LACK);
+    clk->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, clk->lock, {esp_gmf_oal_free(clk); return ESP_GMF_ERR_MEMORY_LACK;});
+    clk->cfg = *cfg;
+    if (clk->cfg.time_ops.now_ms == NULL) {
+        clk->cfg.time_ops.now_ms = clock_sys_now_ms;
+        clk->cfg.time_ops.sleep_ms = clock_sys_sleep_ms;
+    }
+    *handle = clk;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_clock_destroy(esp_gmf_clock_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_t *clk = (esp_gmf_clock_t *)handle;
+    esp_gmf_clock_sync_t *sync = clk->syncs;
+    if (sync) {
+        ESP_LOGW(TAG, "Destroy with sync stages still attached");
+    }
+    while (sync) {
+        esp_gmf_clock_sync_t *next = sync->next;
+        esp_gmf_oal_free(sync);
+        sync = next;
+    }
+    esp_gmf_oal_mutex_destroy(clk->lock);
+    esp_gmf_oal_free(clk);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_clock_start(esp_gmf_clock_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_t *clk = (esp_gmf_clock_t *)handle;
+    esp_gmf_oal_mutex_lock(clk->lock);
+    clk->started = false;
+    for (esp_gmf_clock_sync_t *sync = clk->syncs; sync; sync = sync->next) {
+        memset(&sync->report, 0, sizeof(sync->report));
+    }
+    esp_gmf_oal_mutex_unlock(clk->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_clock_get_time(esp_gmf_clock_handle_t handle, int64_t *time_ms)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, time_ms, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_t *clk = (esp_gmf_clock_t *)handle;
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_READY;
+    esp_gmf_oal_mutex_lock(clk->lock);
+    if (clk->started) {
+        *time_ms = clock_media_time(clk);
+        ret = ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_unlock(clk->lock);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_clock_attach(esp_gmf_clock_handle_t handle, const esp_gmf_clock_sync_cfg_t *cfg, esp_gmf_clock_sync_handle_t *sync)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, sync, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_t *clk = (esp_gmf_clock_t *)handle;
+    *sync = NULL;
+    esp_gmf_clock_sync_t *stage = esp_gmf_oal_calloc(1, sizeof(esp_gmf_clock_sync_t));
+    ESP_GMF_MEM_CHECK(TAG, stage, return ESP_GMF_ERR_MEMORY_LACK);
+    stage->clock = clk;
+    stage->cfg = *cfg;
+    esp_gmf_oal_mutex_lock(clk->lock);
+    if (cfg->role == ESP_GMF_CLOCK_ROLE_MASTER) {
+        if (clk->master) {
+            esp_gmf_oal_mutex_unlock(clk->lock);
+            esp_gmf_oal_free(stage);
+            ESP_LOGE(TAG, "The clock has a master already, %p", clk->master);
+            return ESP_GMF_ERR_INVALID_STATE;
+        }
+        clk->master = stage;
+    }
+    stage->next = clk->syncs;
+    clk->syncs = stage;
+    esp_gmf_oal_mutex_unlock(clk->lock);
+    ESP_LOGD(TAG, "Attach %s %p to clock %p", cfg->role == ESP_GMF_CLOCK_ROLE_MASTER ? "master" : "slave", stage, clk);
+    *sync = stage;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_clock_detach(esp_gmf_clock_sync_handle_t sync)
+{
+    ESP_GMF_NULL_CHECK(TAG, sync, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_sync_t *stage = (esp_gmf_clock_sync_t *)sync;
+    esp_gmf_clock_t *clk = stage->clock;
+    esp_gmf_oal_mutex_lock(clk->lock);
+    esp_gmf_clock_sync_t **pp = &clk->syncs;
+    while (*pp && (*pp != stage)) {
+        pp = &(*pp)->next;
+    }
+    if (*pp) {
+        *pp = stage->next;
+    }
+    if (clk->master == stage) {
+        clk->master = NULL;
+    }
+    esp_gmf_oal_mutex_unlock(clk->lock);
+    ESP_LOGD(TAG, "Detach %p from clock %p, passed:%d, waited:%d, dropped:%d, repeated:%d", stage, clk,
+             (int)stage->report.passed, (int)stage->report.waited, (int)stage->report.dropped, (int)stage->report.repeated);
+    esp_gmf_oal_free(stage);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_clock_sync(esp_gmf_clock_sync_handle_t sync, esp_gmf_payload_t *load, uint8_t *times)
+{
+    ESP_GMF_NULL_CHECK(TAG, sync, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, times, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_sync_t *stage = (esp_gmf_clock_sync_t *)sync;
+    esp_gmf_clock_t *clk = stage->clock;
+    esp_gmf_clock_report_t *report = &stage->report;
+    int64_t pts = (int64_t)load->pts;
+    *times = 1;
+    if (load->valid_size == 0) {
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_lock(clk->lock);
+    if ((clk->started == false)
+        && ((clk->cfg.master == ESP_GMF_CLOCK_MASTER_SYSTEM) || (stage->cfg.role == ESP_GMF_CLOCK_ROLE_MASTER))) {
+        clock_set_reference(clk, pts);
+    }
+    if (clk->started == false) {
+        // Nothing to follow before the master pipeline delivers its first payload
+        report->passed++;
+        esp_gmf_oal_mutex_unlock(clk->lock);
+        return ESP_GMF_ERR_OK;
+    }
+    if (stage->cfg.role == ESP_GMF_CLOCK_ROLE_MASTER) {
+        if (clk->cfg.master == ESP_GMF_CLOCK_MASTER_PIPELINE) {
+            clock_set_reference(clk, pts);
+        }
+        int64_t now = clock_media_time(clk);
+        clock_report_drift(report, pts - now);
+        clock_report_latency(report, now - pts);
+        report->passed++;
+        esp_gmf_oal_mutex_unlock(clk->lock);
+        return ESP_GMF_ERR_OK;
+    }
+    int64_t window = clk->cfg.sync_window_ms;
+    int64_t drift = pts - clock_media_time(clk);
+    clock_report_drift(report, drift);
+    if (drift < -window) {
+        ESP_LOGD(TAG, "Drop late payload, sync:%p, pts:%lld, drift:%lld", stage, pts, drift);
+        report->dropped++;
+        *times = 0;
+        esp_gmf_oal_mutex_unlock(clk->lock);
+        return ESP_GMF_ERR_OK;
+    }
+    if (drift <= window) {
+        report->passed++;
+    } else if (stage->cfg.continuous) {
+        ESP_LOGD(TAG, "Repeat early payload, sync:%p, pts:%lld, drift:%lld", stage, pts, drift);
+        report->repeated++;
+        *times = 2;
+    } else {
+        int64_t wait_ms = drift < clk->cfg.max_wait_ms ? drift : clk->cfg.max_wait_ms;
+        ESP_LOGD(TAG, "Hold early payload, sync:%p, pts:%lld, drift:%lld, wait:%lld", stage, pts, drift, wait_ms);
+        report->waited++;
+        esp_gmf_oal_mutex_unlock(clk->lock);
+        clk->cfg.time_ops.sleep_ms(clk->cfg.time_ops.ctx, wait_ms);
+        esp_gmf_oal_mutex_lock(clk->lock);
+    }
+    clock_report_latency(report, clock_media_time(clk) - pts);
+    esp_gmf_oal_mutex_unlock(clk->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_clock_get_report(esp_gmf_clock_sync_handle_t sync, esp_gmf_clock_report_t *report)
+{
+    ESP_GMF_NULL_CHECK(TAG, sync, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, report, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_clock_sync_t *stage = (esp_gmf_clock_sync_t *)sync;
+    esp_gmf_oal_mutex_lock(stage->clock->lock);
+    *report = stage->report;
+    esp_gmf_oal_mutex_unlock(stage->clock->lock);
+    return ESP_GMF_ERR_OK;
+}
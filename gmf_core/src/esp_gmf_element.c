@@ -30,10 +30,49 @@
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_oal_thread.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_node.h"
 
 static const char *TAG = "ESP_GMF_ELEMENT";
 
+#if ESP_GMF_ELEMENT_STATS_ENABLE
+static inline void esp_gmf_element_stats_add_latency(esp_gmf_element_stats_t *stats, uint32_t us)
+{
+    // Bucket N holds [2^N, 2^(N+1)), the zero and one microsecond calls both fall into the bucket 0
+    int idx = 31 - __builtin_clz(us | 1);
+    if (idx >= ESP_GMF_ELEMENT_STATS_BUCKET_NUM) {
+        idx = ESP_GMF_ELEMENT_STATS_BUCKET_NUM - 1;
+    }
+    stats->hist[idx]++;
+    stats->call_cnt++;
+    stats->total_us += us;
+    if (us > stats->max_us) {
+        stats->max_us = us;
+    }
+}
+
+static uint32_t esp_gmf_element_stats_percentile(const esp_gmf_element_stats_t *stats, uint32_t percent)
+{
+    uint32_t total = 0;
+    for (int i = 0; i < ESP_GMF_ELEMENT_STATS_BUCKET_NUM; i++) {
+        total += stats->hist[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t wanted = ((uint64_t)total * percent + 99) / 100;
+    uint32_t cnt = 0;
+    for (int i = 0; i < ESP_GMF_ELEMENT_STATS_BUCKET_NUM; i++) {
+        cnt += stats->hist[i];
+        if (cnt >= wanted) {
+            uint32_t upper = (i == ESP_GMF_ELEMENT_STATS_BUCKET_NUM - 1) ? UINT32_MAX : (2UL << i) - 1;
+            return upper < stats->max_us ? upper : stats->max_us;
+        }
+    }
+    return stats->max_us;
+}
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
+
 static inline int _get_port_cnt(esp_gmf_port_handle_t port)
 {
     int k = 0;
@@ -90,9 +129,17 @@ esp_gmf_err_t esp_gmf_element_init(esp_gmf_element_handle_t handle, esp_gmf_elem
     el->out_attr.type = config->out_attr.type == 0 ? ESP_GMF_PORT_TYPE_BYTE : config->out_attr.type;
     el->in_attr.size = config->in_attr.size == 0 ? ESP_GMF_ELEMENT_PORT_SIZE_DEFAULT : config->in_attr.size;
     el->out_attr.size = config->out_attr.size == 0 ? ESP_GMF_ELEMENT_PORT_SIZE_DEFAULT : config->out_attr.size;
+    el->in_attr.min_size = config->in_attr.min_size;
+    el->out_attr.min_size = config->out_attr.min_size;
 
     el->ctx = config->ctx;
     el->job_mask = 0;
+#if ESP_GMF_ELEMENT_STATS_ENABLE
+    if (el->stats == NULL) {
+        el->stats = esp_gmf_oal_calloc(1, sizeof(esp_gmf_element_stats_t));
+        ESP_GMF_MEM_CHECK(TAG, el->stats, return ESP_GMF_ERR_MEMORY_LACK);
+    }
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
     return ESP_GMF_ERR_OK;
 }
 
@@ -101,6 +148,15 @@ esp_gmf_err_t esp_gmf_element_deinit(esp_gmf_element_handle_t handle)
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
     esp_gmf_method_destroy(el->method);
+    if (el->method_tbl) {
+        esp_gmf_oal_free(el->method_tbl);
+        el->method_tbl = NULL;
+        el->method_cnt = 0;
+    }
+    if (el->stats) {
+        esp_gmf_oal_free(el->stats);
+        el->stats = NULL;
+    }
     esp_gmf_port_handle_t port = el->in;
     while (port) {
         esp_gmf_port_handle_t tmp = port->next;
@@ -282,6 +338,14 @@ esp_gmf_job_err_t esp_gmf_element_process_running(esp_gmf_element_handle_t handl
         ESP_LOGE(TAG, "There is no process function [%p-%s]", handle, OBJ_GET_TAG(handle));
         return ESP_GMF_ERR_FAIL;
     }
+#if ESP_GMF_ELEMENT_STATS_ENABLE
+    if (el->stats) {
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        esp_gmf_job_err_t ret = el->ops.process(el, NULL);
+        esp_gmf_element_stats_add_latency(el->stats, (uint32_t)(esp_gmf_oal_sys_get_time_us() - start));
+        return ret;
+    }
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
     return el->ops.process(el, NULL);
 }
 
@@ -424,8 +488,53 @@ esp_gmf_err_t esp_gmf_element_register_method(esp_gmf_element_handle_t handle, c
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     ESP_GMF_NULL_CHECK(TAG, func, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
-    int ret = esp_gmf_method_append(&el->method, name, func, args_desc);
-    return ret;
+    if (el->method_cnt >= ESP_GMF_METHOD_ID_INVALID) {
+        ESP_LOGE(TAG, "Too many methods, [%p-%s]", el, OBJ_GET_TAG(el));
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_method_t **tbl = esp_gmf_oal_realloc(el->method_tbl, (el->method_cnt + 1) * sizeof(esp_gmf_method_t *));
+    ESP_GMF_MEM_CHECK(TAG, tbl, return ESP_GMF_ERR_MEMORY_LACK);
+    el->method_tbl = tbl;
+    esp_gmf_method_t *mthd = NULL;
+    int ret = esp_gmf_method_create(name, func, args_desc, &mthd);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to create method %s, [%p-%s]", name, el, OBJ_GET_TAG(el));
+    // Append to the list as well, it is still exposed by `esp_gmf_element_get_method`
+    if (el->method_cnt) {
+        el->method_tbl[el->method_cnt - 1]->next = mthd;
+    } else {
+        el->method = mthd;
+    }
+    el->method_tbl[el->method_cnt++] = mthd;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_element_get_method_id(esp_gmf_element_handle_t handle, const char *name, esp_gmf_method_id_t *id)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, id, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    for (uint16_t i = 0; i < el->method_cnt; i++) {
+        if (el->method_tbl[i]->name && (strcasecmp(el->method_tbl[i]->name, name) == 0)) {
+            *id = i;
+            return ESP_GMF_ERR_OK;
+        }
+    }
+    *id = ESP_GMF_METHOD_ID_INVALID;
+    return ESP_GMF_ERR_NOT_FOUND;
+}
+
+esp_gmf_err_t esp_gmf_element_exe_method_by_id(esp_gmf_element_handle_t handle, esp_gmf_method_id_t id, uint8_t *buf, int buf_len)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, buf, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    if (id >= el->method_cnt) {
+        ESP_LOGE(TAG, "No method with ID %d, [%p-%s]", id, el, OBJ_GET_TAG(el));
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_method_t *mthd = el->method_tbl[id];
+    return mthd->func(handle, mthd->args_desc, buf, buf_len);
 }
 
 esp_gmf_err_t esp_gmf_element_exe_method(esp_gmf_element_handle_t handle, const char *name, uint8_t *buf, int buf_len)
@@ -434,20 +543,16 @@ esp_gmf_err_t esp_gmf_element_exe_method(esp_gmf_element_handle_t handle, const
     ESP_GMF_NULL_CHECK(TAG, name, return ESP_GMF_ERR_INVALID_ARG);
     ESP_GMF_NULL_CHECK(TAG, buf, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
-    esp_gmf_method_t *mthd = el->method;
-    if (mthd == NULL) {
+    if (el->method_cnt == 0) {
         ESP_LOGE(TAG, "There are no executable methods, [%p-%s]", el, OBJ_GET_TAG(el));
         return ESP_GMF_ERR_NOT_SUPPORT;
     }
-    int ret = 0;
-    while (mthd) {
-        if (strcasecmp(mthd->name, name) == 0) {
-            ret = mthd->func(handle, mthd->args_desc, buf, buf_len);
-        }
-        ESP_LOGD(TAG, "Method[%p-%s], ret:%x, [%p-%s]\r\n", mthd, mthd->name, ret, el, OBJ_GET_TAG(el));
-        mthd = mthd->next;
+    esp_gmf_method_id_t id = ESP_GMF_METHOD_ID_INVALID;
+    if (esp_gmf_element_get_method_id(handle, name, &id) != ESP_GMF_ERR_OK) {
+        ESP_LOGD(TAG, "Method %s not found, [%p-%s]", name, el, OBJ_GET_TAG(el));
+        return ESP_GMF_ERR_OK;
     }
-    return ret;
+    return esp_gmf_element_exe_method_by_id(handle, id, buf, buf_len);
 }
 
 esp_gmf_err_t esp_gmf_element_get_method(esp_gmf_element_handle_t handle, esp_gmf_method_t **mthd)
@@ -458,3 +563,46 @@ esp_gmf_err_t esp_gmf_element_get_method(esp_gmf_element_handle_t handle, esp_gm
     *mthd = el->method;
     return ESP_GMF_ERR_OK;
 }
+
+esp_gmf_err_t esp_gmf_element_get_stats(esp_gmf_element_handle_t handle, esp_gmf_element_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    if (el->stats == NULL) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+#if ESP_GMF_ELEMENT_STATS_ENABLE
+    memcpy(stats, el->stats, sizeof(esp_gmf_element_stats_t));
+    stats->p50_us = esp_gmf_element_stats_percentile(stats, 50);
+    stats->p99_us = esp_gmf_element_stats_percentile(stats, 99);
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_element_reset_stats(esp_gmf_element_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    if (el->stats == NULL) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    memset(el->stats, 0, sizeof(esp_gmf_element_stats_t));
+    return ESP_GMF_ERR_OK;
+}
+
+void esp_gmf_element_stats_add_bytes(esp_gmf_element_handle_t handle, esp_gmf_port_dir_t dir, uint32_t bytes)
+{
+#if ESP_GMF_ELEMENT_STATS_ENABLE
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    if ((el == NULL) || (el->stats == NULL)) {
+        return;
+    }
+    if (dir == ESP_GMF_PORT_DIR_IN) {
+        el->stats->in_bytes += bytes;
+    } else {
+        el->stats->out_bytes += bytes;
+        el->stats->frame_cnt++;
+    }
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
+}
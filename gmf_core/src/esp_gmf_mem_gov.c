@@ -0,0 +1,255 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_mem_gov.h"
+
+static const char *TAG = "ESP_GMF_MEM_GOV";
+
+typedef struct esp_gmf_mem_gov_resv {
+    struct esp_gmf_mem_gov_resv  *next;
+    void                         *owner;
+    size_t                        size;
+} esp_gmf_mem_gov_resv_t;
+
+typedef struct {
+    esp_gmf_mem_gov_resv_t  *resv;
+    void                    *lock;
+    esp_gmf_mem_gov_info_t   info;
+} esp_gmf_mem_gov_t;
+
+static inline size_t mem_gov_items_size(const esp_gmf_mem_gov_item_t *items, int num)
+{
+    size_t size = 0;
+    for (int i = 0; i < num; i++) {
+        size += (size_t)items[i].size * items[i].depth;
+    }
+    return size;
+}
+
+static inline bool mem_gov_can_shrink(const esp_gmf_mem_gov_item_t *item, bool depth)
+{
+    if (depth) {
+        return item->min_depth && (item->depth > item->min_depth);
+    }
+    return item->min_size && (item->size > item->min_size);
+}
+
+static bool mem_gov_shrink_one(esp_gmf_mem_gov_item_t *items, int num, bool depth)
+{
+    // Shrink the largest item first, it gives back the most memory for the smallest loss in relative terms
+    int pick = -1;
+    size_t pick_size = 0;
+    for (int i = 0; i < num; i++) {
+        size_t size = (size_t)items[i].size * items[i].depth;
+        if (mem_gov_can_shrink(&items[i], depth) && (size > pick_size)) {
+            pick = i;
+            pick_size = size;
+        }
+    }
+    if (pick < 0) {
+        return false;
+    }
+    esp_gmf_mem_gov_item_t *item = &items[pick];
+    if (depth) {
+        item->depth--;
+    } else {
+        item->size = item->size / 2 > item->min_size ? item->size / 2 : item->min_size;
+    }
+    return true;
+}
+
+static inline esp_gmf_mem_gov_resv_t *mem_gov_find(esp_gmf_mem_gov_t *gov, void *owner)
+{
+    esp_gmf_mem_gov_resv_t *resv = gov->resv;
+    while (resv && (resv->owner != owner)) {
+        resv = resv->next;
+    }
+    return resv;
+}
+
+esp_gmf_err_t esp_gmf_mem_gov_create(size_t budget, esp_gmf_mem_gov_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    *handle = NULL;
+    esp_gmf_mem_gov_t *gov = esp_gmf_oal_calloc(1, sizeof(esp_gmf_mem_gov_t));
+    ESP_GMF_MEM_CHECK(TAG, gov, return ESP_GMF_ERR_MEMORY_LACK);
+    gov->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, gov->lock, {esp_gmf_oal_free(gov); return ESP_GMF_ERR_MEMORY_LACK;});
+    gov->info.budget = budget;
+    *handle = gov;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_mem_gov_destroy(esp_gmf_mem_gov_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_mem_gov_t *gov = (esp_gmf_mem_gov_t *)handle;
+    if (gov->resv) {
+        ESP_LOGW(TAG, "Destroy with %d reservations, %d bytes", gov->info.resv_num, (int)gov->info.reserved);
+    }
+    esp_gmf_mem_gov_resv_t *resv = gov->resv;
+    while (resv) {
+        esp_gmf_mem_gov_resv_t *next = resv->next;
+        esp_gmf_oal_free(resv);
+        resv = next;
+    }
+    esp_gmf_oal_mutex_destroy(gov->lock);
+    esp_gmf_oal_free(gov);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_mem_gov_reserve(esp_gmf_mem_gov_handle_t handle, void *owner, esp_gmf_mem_gov_item_t *items, int num)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, owner, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, items, return ESP_GMF_ERR_INVALID_ARG);
+    if (num <= 0) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_mem_gov_t *gov = (esp_gmf_mem_gov_t *)handle;
+    // Work on a copy so that a refused request leaves the items untouched
+    esp_gmf_mem_gov_item_t *work = esp_gmf_oal_malloc(num * sizeof(esp_gmf_mem_gov_item_t));
+    ESP_GMF_MEM_CHECK(TAG, work, return ESP_GMF_ERR_MEMORY_LACK);
+    memcpy(work, items, num * sizeof(esp_gmf_mem_gov_item_t));
+    for (int i = 0; i < num; i++) {
+        if (work[i].min_size > work[i].size) {
+            work[i].min_size = work[i].size;
+        }
+        if (work[i].min_depth > work[i].depth) {
+            work[i].min_depth = work[i].depth;
+        }
+    }
+    esp_gmf_mem_gov_resv_t *resv_new = esp_gmf_oal_calloc(1, sizeof(esp_gmf_mem_gov_resv_t));
+    ESP_GMF_MEM_CHECK(TAG, resv_new, {esp_gmf_oal_free(work); return ESP_GMF_ERR_MEMORY_LACK;});
+
+    esp_gmf_oal_mutex_lock(gov->lock);
+    esp_gmf_mem_gov_resv_t *resv = mem_gov_find(gov, owner);
+    size_t available = gov->info.budget > gov->info.reserved ? gov->info.budget - gov->info.reserved : 0;
+    if (resv) {
+        available += resv->size;
+    }
+    size_t wanted = mem_gov_items_size(work, num);
+    size_t need = wanted;
+    while (need > available) {
+        if ((mem_gov_shrink_one(work, num, true) == false) && (mem_gov_shrink_one(work, num, false) == false)) {
+            break;
+        }
+        need = mem_gov_items_size(work, num);
+    }
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    if (need > available) {
+        gov->info.refuse_cnt++;
+        ret = ESP_GMF_ERR_MEMORY_LACK;
+        ESP_LOGW(TAG, "Refuse %p, wanted:%d, minimum:%d, available:%d", owner, (int)wanted, (int)need, (int)available);
+    } else {
+        if (need < wanted) {
+            gov->info.shrink_cnt++;
+            ESP_LOGI(TAG, "Shrink %p from %d to %d bytes, available:%d", owner, (int)wanted, (int)need, (int)available);
+            for (int i = 0; i < num; i++) {
+                if ((work[i].size != items[i].size) || (work[i].depth != items[i].depth)) {
+                    ESP_LOGD(TAG, "  %s, size:%d->%d, depth:%d->%d", work[i].name ? work[i].name : "-", (int)items[i].size,
+                             (int)work[i].size, items[i].depth, work[i].depth);
+                }
+                items[i].size = work[i].size;
+                items[i].depth = work[i].depth;
+            }
+        } else {
+            gov->info.grant_cnt++;
+        }
+        if (resv) {
+            gov->info.reserved -= resv->size;
+        } else {
+            resv = resv_new;
+            resv_new = NULL;
+            resv->owner = owner;
+            resv->next = gov->resv;
+            gov->resv = resv;
+            gov->info.resv_num++;
+        }
+        resv->size = need;
+        gov->info.reserved += need;
+        if (gov->info.reserved > gov->info.peak) {
+            gov->info.peak = gov->info.reserved;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(gov->lock);
+    if (resv_new) {
+        esp_gmf_oal_free(resv_new);
+    }
+    esp_gmf_oal_free(work);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_mem_gov_release(esp_gmf_mem_gov_handle_t handle, void *owner)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_mem_gov_t *gov = (esp_gmf_mem_gov_t *)handle;
+    esp_gmf_mem_gov_resv_t *found = NULL;
+    esp_gmf_oal_mutex_lock(gov->lock);
+    for (esp_gmf_mem_gov_resv_t **pos = &gov->resv; *pos; pos = &(*pos)->next) {
+        if ((*pos)->owner == owner) {
+            found = *pos;
+            *pos = found->next;
+            gov->info.reserved -= found->size;
+            gov->info.resv_num--;
+            break;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(gov->lock);
+    if (found == NULL) {
+        return ESP_GMF_ERR_NOT_FOUND;
+    }
+    esp_gmf_oal_free(found);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_mem_gov_get_reserved(esp_gmf_mem_gov_handle_t handle, void *owner, size_t *size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, size, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_mem_gov_t *gov = (esp_gmf_mem_gov_t *)handle;
+    esp_gmf_oal_mutex_lock(gov->lock);
+    esp_gmf_mem_gov_resv_t *resv = mem_gov_find(gov, owner);
+    if (resv) {
+        *size = resv->size;
+    }
+    esp_gmf_oal_mutex_unlock(gov->lock);
+    return resv ? ESP_GMF_ERR_OK : ESP_GMF_ERR_NOT_FOUND;
+}
+
+esp_gmf_err_t esp_gmf_mem_gov_get_info(esp_gmf_mem_gov_handle_t handle, esp_gmf_mem_gov_info_t *info)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, info, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_mem_gov_t *gov = (esp_gmf_mem_gov_t *)handle;
+    esp_gmf_oal_mutex_lock(gov->lock);
+    *info = gov->info;
+    esp_gmf_oal_mutex_unlock(gov->lock);
+    return ESP_GMF_ERR_OK;
+}
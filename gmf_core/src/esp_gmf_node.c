@@ -113,6 +113,11 @@ void esp_gmf_node_del_at(esp_gmf_node_t **root, esp_gmf_node_t *del)
     }
     if (*root == del) {
         *root = del->next;
+        if (*root) {
+            (*root)->prev = NULL;
+        }
+        del->next = NULL;
+        del->prev = NULL;
         return;
     }
     if (del->next) {
@@ -25,11 +25,21 @@
 #include "stdlib.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_payload.h"
+#include "esp_gmf_payload_pool.h"
 #include "esp_log.h"
 #include "string.h"
 
 static const char *TAG = "ESP_GMF_PAYLOAD";
 
+static inline void payload_free_buf(esp_gmf_payload_t *instance)
+{
+    if (instance->pool) {
+        esp_gmf_payload_pool_put(instance->pool, instance->buf);
+    } else {
+        esp_gmf_oal_free(instance->buf);
+    }
+}
+
 esp_gmf_err_t esp_gmf_payload_new(esp_gmf_payload_t **instance)
 {
     if (instance == NULL) {
@@ -89,12 +99,20 @@ esp_gmf_err_t esp_gmf_payload_realloc_aligned_buf(esp_gmf_payload_t *instance, u
         if (instance->buf) {
             ESP_LOGD(TAG, "Free payload:%p, buf:%p-%d, needs_free:%d", instance, instance->buf, instance->buf_length, instance->needs_free);
             instance->buf_length = 0;
-            esp_gmf_oal_free(instance->buf);
+            payload_free_buf(instance);
             instance->buf = NULL;
         } else {
             instance->needs_free = 1;
         }
-        instance->buf = esp_gmf_oal_malloc_align(align, new_length);
+        if (instance->pool) {
+            uint32_t buf_length = 0;
+            esp_gmf_err_t ret = esp_gmf_payload_pool_get(instance->pool, align, new_length, &instance->buf, &buf_length);
+            ESP_GMF_RET_ON_NOT_OK(TAG, ret, {instance->buf = NULL; instance->needs_free = 0; return ESP_GMF_ERR_MEMORY_LACK;},
+                                  "Failed to get a buffer from the payload pool");
+            new_length = buf_length;
+        } else {
+            instance->buf = esp_gmf_oal_malloc_align(align, new_length);
+        }
         ESP_GMF_NULL_CHECK(TAG, instance->buf, {instance->needs_free = 0; return ESP_GMF_ERR_MEMORY_LACK;});
         instance->buf_length = new_length;
         // Do not set instance->needs_free, `buf` may allocate by others.
@@ -108,6 +126,24 @@ esp_gmf_err_t esp_gmf_payload_realloc_buf(esp_gmf_payload_t *instance, uint32_t
     return esp_gmf_payload_realloc_aligned_buf(instance, 0, new_length);
 }
 
+esp_gmf_err_t esp_gmf_payload_set_pool(esp_gmf_payload_t *instance, void *pool)
+{
+    ESP_GMF_NULL_CHECK(TAG, instance, return ESP_GMF_ERR_INVALID_ARG);
+    if (instance->pool == pool) {
+        return ESP_GMF_ERR_OK;
+    }
+    if (instance->buf && instance->needs_free) {
+        // Returned to the owner it was taken from, the new pool can not tell a buffer of another slab from a heap one
+        payload_free_buf(instance);
+        instance->buf = NULL;
+        instance->buf_length = 0;
+        instance->valid_size = 0;
+        instance->needs_free = 0;
+    }
+    instance->pool = pool;
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_payload_set_done(esp_gmf_payload_t *instance)
 {
     ESP_GMF_NULL_CHECK(TAG, instance, return ESP_GMF_ERR_INVALID_ARG);
@@ -122,13 +158,78 @@ esp_gmf_err_t esp_gmf_payload_clean_done(esp_gmf_payload_t *instance)
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_payload_chain_append(esp_gmf_payload_t *head, esp_gmf_payload_t *seg)
+{
+    ESP_GMF_NULL_CHECK(TAG, head, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, seg, return ESP_GMF_ERR_INVALID_ARG);
+    if (head == seg) {
+        ESP_LOGE(TAG, "Can't chain the payload to itself, h:%p", head);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    while (head->next) {
+        head = head->next;
+    }
+    head->next = seg;
+    seg->next = NULL;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_get_chain_size(const esp_gmf_payload_t *head, uint32_t *size)
+{
+    ESP_GMF_NULL_CHECK(TAG, head, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, size, return ESP_GMF_ERR_INVALID_ARG);
+    uint32_t total = 0;
+    for (; head; head = head->next) {
+        total += head->valid_size;
+    }
+    *size = total;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_flatten(esp_gmf_payload_t *head, esp_gmf_payload_t *dest)
+{
+    ESP_GMF_NULL_CHECK(TAG, head, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, dest, return ESP_GMF_ERR_INVALID_ARG);
+    uint32_t total = 0;
+    esp_gmf_payload_get_chain_size(head, &total);
+    esp_gmf_payload_t *seg = head;
+    if (dest == head) {
+        if (total > head->buf_length) {
+            ESP_LOGE(TAG, "No room to flatten in place, h:%p, l:%d, total:%ld", head, head->buf_length, total);
+            return ESP_GMF_ERR_MEMORY_LACK;
+        }
+        seg = head->next;
+    } else {
+        if ((total > dest->buf_length) || (dest->buf == NULL)) {
+            int ret = esp_gmf_payload_realloc_buf(dest, total ? total : 1);
+            ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to grow payload for flatten, h:%p, total:%ld", head, total);
+        }
+        dest->valid_size = 0;
+        dest->is_done = false;
+        dest->pts = head->pts;
+    }
+    for (; seg; seg = seg->next) {
+        if (seg->valid_size) {
+            memcpy(dest->buf + dest->valid_size, seg->buf, seg->valid_size);
+            dest->valid_size += seg->valid_size;
+        }
+        dest->is_done |= seg->is_done;
+    }
+    if (dest == head) {
+        head->next = NULL;
+    }
+    dest->next = NULL;
+    ESP_LOGD(TAG, "Flatten payload chain, h:%p, dest:%p, total:%ld", head, dest, total);
+    return ESP_GMF_ERR_OK;
+}
+
 void esp_gmf_payload_delete(esp_gmf_payload_t *instance)
 {
     ESP_LOGD(TAG, "Delete a payload, h:%p, needs_free:%d, buf:%p, l:%d", instance, instance != NULL ? instance->needs_free : -1,
              instance != NULL ? instance->buf : NULL, instance != NULL ? instance->buf_length : -1);
     if (instance) {
         if (instance->needs_free) {
-            esp_gmf_oal_free(instance->buf);
+            payload_free_buf(instance);
             instance->needs_free = 0;
         }
         instance->buf = NULL;
@@ -0,0 +1,191 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_payload_pool.h"
+
+#define PAYLOAD_POOL_DEFAULT_ALIGN (4)
+
+static const char *TAG = "ESP_GMF_PLD_POOL";
+
+/**
+ * @brief  Buffers of one size class, they are carved from a single slab so the owner class of a buffer is found by address
+ */
+typedef struct {
+    uint8_t   *slab;      /*!< Memory of all the buffers of the class */
+    uint32_t   size;      /*!< Aligned buffer size */
+    uint16_t   count;     /*!< Number of buffers */
+    uint16_t   free_cnt;  /*!< Number of free buffers in `free_idx` */
+    uint16_t  *free_idx;  /*!< Stack of the free buffer indexes */
+} esp_gmf_payload_pool_class_inst_t;
+
+typedef struct {
+    esp_gmf_payload_pool_class_inst_t  cls[ESP_GMF_PAYLOAD_POOL_MAX_CLASS];
+    uint8_t                            cls_num;
+    uint8_t                            align;
+    bool                               in_psram;
+    void                              *lock;
+    esp_gmf_payload_pool_stats_t       stats;
+} esp_gmf_payload_pool_t;
+
+static inline void *payload_pool_malloc(esp_gmf_payload_pool_t *pool, uint8_t align, size_t size)
+{
+    return pool->in_psram ? esp_gmf_oal_malloc_align(align, size) : esp_gmf_oal_malloc_align_inner(align, size);
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_create(const esp_gmf_payload_pool_cfg_t *cfg, esp_gmf_payload_pool_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    *handle = NULL;
+    uint8_t align = cfg->align ? cfg->align : PAYLOAD_POOL_DEFAULT_ALIGN;
+    if (align & (align - 1)) {
+        ESP_LOGE(TAG, "The alignment %d is not a power of 2", align);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_payload_pool_t *pool = esp_gmf_oal_calloc(1, sizeof(esp_gmf_payload_pool_t));
+    ESP_GMF_MEM_CHECK(TAG, pool, return ESP_GMF_ERR_MEMORY_LACK);
+    pool->align = align;
+    pool->in_psram = cfg->in_psram;
+    pool->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, pool->lock, goto _pool_create_fail);
+    for (int i = 0; (i < ESP_GMF_PAYLOAD_POOL_MAX_CLASS) && cfg->classes[i].size; i++) {
+        esp_gmf_payload_pool_class_inst_t *cls = &pool->cls[i];
+        cls->size = (cfg->classes[i].size + align - 1) & ~(uint32_t)(align - 1);
+        cls->count = cfg->classes[i].count;
+        if ((cls->count == 0) || ((i > 0) && (cls->size <= pool->cls[i - 1].size))) {
+            ESP_LOGE(TAG, "Invalid class %d, size:%ld, count:%d, sizes must be ascending", i, cfg->classes[i].size, cls->count);
+            esp_gmf_payload_pool_destroy(pool);
+            return ESP_GMF_ERR_INVALID_ARG;
+        }
+        pool->cls_num++;
+        cls->slab = payload_pool_malloc(pool, align, cls->size * cls->count);
+        ESP_GMF_MEM_CHECK(TAG, cls->slab, goto _pool_create_fail);
+        cls->free_idx = esp_gmf_oal_calloc(cls->count, sizeof(uint16_t));
+        ESP_GMF_MEM_CHECK(TAG, cls->free_idx, goto _pool_create_fail);
+        for (int j = 0; j < cls->count; j++) {
+            cls->free_idx[j] = cls->count - 1 - j;
+        }
+        cls->free_cnt = cls->count;
+    }
+    *handle = pool;
+    ESP_LOGD(TAG, "Create payload pool:%p, classes:%d, align:%d, psram:%d", pool, pool->cls_num, align, pool->in_psram);
+    return ESP_GMF_ERR_OK;
+
+_pool_create_fail:
+    esp_gmf_payload_pool_destroy(pool);
+    return ESP_GMF_ERR_MEMORY_LACK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_destroy(esp_gmf_payload_pool_handle_t handle)
+{
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    if (pool->stats.in_use) {
+        ESP_LOGW(TAG, "Destroy payload pool:%p with %ld buffers in use", pool, pool->stats.in_use);
+    }
+    for (int i = 0; i < pool->cls_num; i++) {
+        if (pool->cls[i].slab) {
+            esp_gmf_oal_free(pool->cls[i].slab);
+        }
+        if (pool->cls[i].free_idx) {
+            esp_gmf_oal_free(pool->cls[i].free_idx);
+        }
+    }
+    if (pool->lock) {
+        esp_gmf_oal_mutex_destroy(pool->lock);
+    }
+    esp_gmf_oal_free(pool);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_get(esp_gmf_payload_pool_handle_t handle, uint8_t align, uint32_t wanted_size, uint8_t **buf, uint32_t *buf_length)
+{
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, buf, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, buf_length, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_oal_mutex_lock(pool->lock);
+    if (align <= pool->align) {
+        // Take the smallest class that fits and still has a free buffer
+        for (int i = 0; i < pool->cls_num; i++) {
+            esp_gmf_payload_pool_class_inst_t *cls = &pool->cls[i];
+            if ((cls->size < wanted_size) || (cls->free_cnt == 0)) {
+                continue;
+            }
+            uint16_t idx = cls->free_idx[--cls->free_cnt];
+            *buf = cls->slab + idx * cls->size;
+            *buf_length = cls->size;
+            pool->stats.hit_cnt++;
+            if (++pool->stats.in_use > pool->stats.peak_use) {
+                pool->stats.peak_use = pool->stats.in_use;
+            }
+            esp_gmf_oal_mutex_unlock(pool->lock);
+            return ESP_GMF_ERR_OK;
+        }
+    }
+    pool->stats.miss_cnt++;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    ESP_LOGD(TAG, "Miss on pool:%p, align:%d, size:%ld", pool, align, wanted_size);
+    *buf = payload_pool_malloc(pool, align > pool->align ? align : pool->align, wanted_size);
+    ESP_GMF_MEM_CHECK(TAG, *buf, {*buf_length = 0; return ESP_GMF_ERR_MEMORY_LACK;});
+    *buf_length = wanted_size;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_put(esp_gmf_payload_pool_handle_t handle, uint8_t *buf)
+{
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    if (buf == NULL) {
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_lock(pool->lock);
+    for (int i = 0; i < pool->cls_num; i++) {
+        esp_gmf_payload_pool_class_inst_t *cls = &pool->cls[i];
+        if ((buf >= cls->slab) && (buf < cls->slab + cls->size * cls->count)) {
+            cls->free_idx[cls->free_cnt++] = (buf - cls->slab) / cls->size;
+            pool->stats.in_use--;
+            esp_gmf_oal_mutex_unlock(pool->lock);
+            return ESP_GMF_ERR_OK;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    esp_gmf_oal_free(buf);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_get_stats(esp_gmf_payload_pool_handle_t handle, esp_gmf_payload_pool_stats_t *stats)
+{
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_oal_mutex_lock(pool->lock);
+    *stats = pool->stats;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    return ESP_GMF_ERR_OK;
+}
@@ -29,6 +29,8 @@
 #include "esp_gmf_element.h"
 #include "esp_gmf_pipeline.h"
 #include "esp_gmf_node.h"
+#include "esp_gmf_mem_gov.h"
+#include "esp_gmf_clock.h"
 
 static const char *TAG = "ESP_GMF_PIPELINE";
 
@@ -67,11 +69,14 @@ static inline esp_gmf_err_t register_working_jobs_to_task(esp_gmf_pipeline_handl
         ESP_LOGD(TAG, "Add open and process jobs, p:%p, tsk:%p, [el:%s-%p]", pipeline, pipeline->thread, OBJ_GET_TAG(el), el);
         esp_gmf_element_change_job_mask(el, ESP_GMF_ELEMENT_JOB_OPEN);
         esp_gmf_element_change_job_mask(el, ESP_GMF_ELEMENT_JOB_PROCESS);
+        // Keep the jobs in the element order, an element inserted at runtime goes in front of its successor
+        // All element jobs share one dependency chain, the linked ports pass the payload to the next element in place
+        void *next_el = esp_gmf_node_for_next((esp_gmf_node_t *)el);
         char name[ESP_GMF_JOB_LABLE_MAX_LEN] = "";
         esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(el), ESP_GMF_JOB_STR_OPEN, strlen(ESP_GMF_JOB_STR_OPEN));
-        esp_gmf_task_register_ready_job(pipeline->thread, name, esp_gmf_element_process_open, ESP_GMF_JOB_TIMES_ONCE, el, false);
+        esp_gmf_task_insert_ready_job(pipeline->thread, name, esp_gmf_element_process_open, ESP_GMF_JOB_TIMES_ONCE, el, next_el, false);
         esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(el), ESP_GMF_JOB_STR_PROCESS, strlen(ESP_GMF_JOB_STR_PROCESS));
-        esp_gmf_task_register_ready_job(pipeline->thread, name, esp_gmf_element_process_running, ESP_GMF_JOB_TIMES_INFINITE, el, true);
+        esp_gmf_task_insert_ready_job(pipeline->thread, name, esp_gmf_element_process_running, ESP_GMF_JOB_TIMES_INFINITE, el, next_el, true);
     }
     esp_gmf_oal_mutex_unlock(pipeline->lock);
     return ESP_GMF_ERR_OK;
@@ -162,6 +167,11 @@ static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
             default:
                 break;
         }
+    } else if (evt->type == ESP_GMF_EVT_TYPE_JOB_OVERRUN) {
+        if (pipeline->user_cb) {
+            evt->from = pipeline;
+            pipeline->user_cb(evt, pipeline->user_ctx);
+        }
     } else {
         ESP_LOGW(TAG, "Not supported event type(%d), [p:%p, tsk:%s-%p]", evt->type, pipeline, OBJ_GET_TAG(tsk), tsk);
     }
@@ -261,6 +271,391 @@ static esp_gmf_err_t pipeline_element_events(esp_gmf_event_pkt_t *evt, void *ctx
     return ESP_GMF_ERR_OK;
 }
 
+static inline void pipeline_apply_clock(esp_gmf_pipeline_handle_t pipeline)
+{
+    // The sync stage sits on the port handing the payloads of the last element to the sink
+    if (pipeline->last_el && ESP_GMF_ELEMENT_GET(pipeline->last_el)->out) {
+        ESP_GMF_ELEMENT_GET(pipeline->last_el)->out->clock_sync = pipeline->clock_sync;
+    }
+}
+
+static esp_gmf_err_t pipeline_reserve_mem(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline->head_el, return ESP_GMF_ERR_INVALID_ARG);
+    size_t reserved = 0;
+    if (esp_gmf_mem_gov_get_reserved(pipeline->mem_gov, pipeline, &reserved) == ESP_GMF_ERR_OK) {
+        // Granted already, keep the sizes until the pipeline is destroyed
+        return ESP_GMF_ERR_OK;
+    }
+    int el_num = 1;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    while ((el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el))) {
+        el_num++;
+    }
+    // One item for the input of the first element and one per element output
+    esp_gmf_mem_gov_item_t *items = esp_gmf_oal_calloc(el_num + 1, sizeof(esp_gmf_mem_gov_item_t));
+    ESP_GMF_MEM_CHECK(TAG, items, return ESP_GMF_ERR_MEMORY_LACK);
+    esp_gmf_element_t *head = ESP_GMF_ELEMENT_GET(pipeline->head_el);
+    items[0].name = OBJ_GET_TAG(head);
+    items[0].size = head->in_attr.size;
+    items[0].min_size = head->in_attr.min_size;
+    items[0].depth = 1;
+    el = pipeline->head_el;
+    for (int i = 1; el; i++) {
+        esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+        items[i].name = OBJ_GET_TAG(elem);
+        items[i].size = elem->out_attr.size;
+        items[i].min_size = elem->out_attr.min_size;
+        items[i].depth = 1;
+        el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+    }
+    esp_gmf_err_t ret = esp_gmf_mem_gov_reserve(pipeline->mem_gov, pipeline, items, el_num + 1);
+    if (ret == ESP_GMF_ERR_OK) {
+        head->in_attr.size = items[0].size;
+        if (head->in) {
+            head->in->user_buf_len = items[0].size;
+        }
+        el = pipeline->head_el;
+        for (int i = 1; el; i++) {
+            esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+            elem->out_attr.size = items[i].size;
+            if (elem->out) {
+                elem->out->user_buf_len = items[i].size;
+            }
+            el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+            if (el && (items[i].size < ESP_GMF_ELEMENT_GET(el)->in_attr.size)) {
+                // The next element reads what this one writes
+                ESP_GMF_ELEMENT_GET(el)->in_attr.size = items[i].size;
+                if (ESP_GMF_ELEMENT_GET(el)->in) {
+                    ESP_GMF_ELEMENT_GET(el)->in->user_buf_len = items[i].size;
+                }
+            }
+        }
+    }
+    esp_gmf_oal_free(items);
+    return ret;
+}
+
+typedef enum {
+    PIPELINE_EDIT_REPLACE = 0,
+    PIPELINE_EDIT_INSERT  = 1,
+    PIPELINE_EDIT_REMOVE  = 2,
+} pipeline_edit_type_t;
+
+typedef struct {
+    esp_gmf_pipeline_handle_t  pipeline;    /*!< Pipeline to edit */
+    pipeline_edit_type_t       type;        /*!< Kind of the edit */
+    esp_gmf_element_handle_t   el;          /*!< The replaced or removed element, the previous one for insert */
+    esp_gmf_element_handle_t   new_el;      /*!< The element to take place, NULL for remove */
+    esp_gmf_port_handle_t      link_out;    /*!< New out port of the link made by insert, cleared once taken */
+    esp_gmf_port_handle_t      link_in;     /*!< New in port of the link made by insert, cleared once taken */
+    esp_gmf_port_handle_t      dropped[2];  /*!< Port lists left out of the pipeline, freed by the caller */
+} pipeline_edit_t;
+
+typedef struct {
+    esp_gmf_pipeline_handle_t  pipeline;  /*!< The pipeline to seek */
+    uint64_t                   pos;       /*!< The byte position to seek to */
+} pipeline_seek_t;
+
+static bool pipeline_has_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    esp_gmf_element_handle_t tmp = pipeline->head_el;
+    while (tmp && (tmp != el)) {
+        tmp = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)tmp);
+    }
+    return tmp != NULL;
+}
+
+static esp_gmf_port_t *pipeline_swap_first_port(esp_gmf_port_t **list, esp_gmf_port_t *port)
+{
+    esp_gmf_port_t *first = *list;
+    esp_gmf_port_t *rest = first ? first->next : NULL;
+    if (first) {
+        first->next = NULL;
+    }
+    if (port) {
+        port->next = rest;
+        *list = port;
+    } else {
+        *list = rest;
+    }
+    return first;
+}
+
+static void pipeline_flush_in_ports(esp_gmf_port_t *ports)
+{
+    for (esp_gmf_port_t *port = ports; port; port = port->next) {
+        if ((port->dir == ESP_GMF_PORT_DIR_IN) && port->writer && port->payload) {
+            // Handed over but not read yet, give the reference back to the origin port
+            esp_gmf_port_release_in(port, port->payload, 0);
+        }
+    }
+}
+
+static void pipeline_drop_ports(pipeline_edit_t *edit, esp_gmf_port_t *ports)
+{
+    if (ports == NULL) {
+        return;
+    }
+    pipeline_flush_in_ports(ports);
+    edit->dropped[edit->dropped[0] ? 1 : 0] = ports;
+}
+
+static void pipeline_forget_dropped(pipeline_edit_t *edit, esp_gmf_port_t *port)
+{
+    for (int i = 0; i < 2; i++) {
+        for (esp_gmf_port_t *tmp = edit->dropped[i]; tmp; tmp = tmp->next) {
+            if (port->ref_port == tmp) {
+                port->ref_port = NULL;
+            }
+            if (tmp->self_payload && (port->payload == tmp->self_payload)) {
+                port->payload = NULL;
+            }
+        }
+    }
+}
+
+static void pipeline_relink_ports(pipeline_edit_t *edit)
+{
+    esp_gmf_element_t *prev = NULL;
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(edit->pipeline->head_el);
+    while (el) {
+        for (esp_gmf_port_t *port = el->in; port; port = port->next) {
+            esp_gmf_port_set_reader(port, el);
+            pipeline_forget_dropped(edit, port);
+        }
+        for (esp_gmf_port_t *port = el->out; port; port = port->next) {
+            esp_gmf_port_set_writer(port, el);
+            pipeline_forget_dropped(edit, port);
+        }
+        if (prev) {
+            if (prev->out) {
+                esp_gmf_port_set_reader(prev->out, el);
+            }
+            if (el->in) {
+                esp_gmf_port_set_writer(el->in, prev);
+            }
+        }
+        prev = el;
+        el = (esp_gmf_element_t *)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+    }
+}
+
+static esp_gmf_err_t pipeline_check_edit(pipeline_edit_t *edit, esp_gmf_element_t **prev_el, esp_gmf_element_t **next_el)
+{
+    esp_gmf_pipeline_handle_t pipeline = edit->pipeline;
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(edit->el);
+    esp_gmf_element_t *new_el = ESP_GMF_ELEMENT_GET(edit->new_el);
+    if (el && (pipeline_has_el(pipeline, el) == false)) {
+        ESP_LOGE(TAG, "The element is not in the pipeline, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(el), el);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    if (new_el && (pipeline_has_el(pipeline, new_el) || new_el->in || new_el->out)) {
+        ESP_LOGE(TAG, "The new element is linked already, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(new_el), new_el);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_element_t *prev = NULL;
+    esp_gmf_element_t *next = NULL;
+    if (edit->type == PIPELINE_EDIT_INSERT) {
+        prev = el;
+        next = prev ? (esp_gmf_element_t *)esp_gmf_node_for_next((esp_gmf_node_t *)prev) : ESP_GMF_ELEMENT_GET(pipeline->head_el);
+        if ((prev == NULL) && (next == NULL)) {
+            ESP_LOGE(TAG, "Nothing to insert between, register the element instead, p:%p", pipeline);
+            return ESP_GMF_ERR_INVALID_ARG;
+        }
+    } else {
+        prev = (esp_gmf_element_t *)esp_gmf_node_for_prev((esp_gmf_node_t *)el);
+        next = (esp_gmf_element_t *)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+    }
+    bool supported = true;
+    switch (edit->type) {
+        case PIPELINE_EDIT_REPLACE:
+            supported = ((el->in == NULL) || (new_el->in_attr.type & el->in->type))
+                        && ((el->out == NULL) || (new_el->out_attr.type & el->out->type));
+            break;
+        case PIPELINE_EDIT_INSERT:
+            // The new link between two elements is a block one, as the links made by the pool
+            if (next) {
+                supported = ((next->in == NULL) || (new_el->in_attr.type & next->in->type))
+                            && (new_el->out_attr.type & ESP_GMF_PORT_TYPE_BLOCK) && (next->in_attr.type & ESP_GMF_PORT_TYPE_BLOCK);
+            } else {
+                supported = ((prev->out == NULL) || (new_el->out_attr.type & prev->out->type))
+                            && (new_el->in_attr.type & ESP_GMF_PORT_TYPE_BLOCK) && (prev->out_attr.type & ESP_GMF_PORT_TYPE_BLOCK);
+            }
+            break;
+        case PIPELINE_EDIT_REMOVE:
+            if ((prev == NULL) && (next == NULL)) {
+                ESP_LOGE(TAG, "Can't remove the only element, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(el), el);
+                return ESP_GMF_ERR_INVALID_ARG;
+            }
+            if (next) {
+                supported = (el->in == NULL) || (next->in_attr.type & el->in->type);
+            } else {
+                supported = (el->out == NULL) || (prev->out_attr.type & el->out->type);
+            }
+            break;
+    }
+    if (supported == false) {
+        ESP_LOGE(TAG, "The port type mismatched, p:%p, edit:%d, [el:%s-%p]", pipeline, edit->type, OBJ_GET_TAG(el), el);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    *prev_el = prev;
+    *next_el = next;
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t pipeline_apply_edit(void *ctx)
+{
+    pipeline_edit_t *edit = (pipeline_edit_t *)ctx;
+    esp_gmf_pipeline_handle_t pipeline = edit->pipeline;
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(edit->el);
+    esp_gmf_element_t *new_el = ESP_GMF_ELEMENT_GET(edit->new_el);
+    esp_gmf_element_t *prev = NULL;
+    esp_gmf_element_t *next = NULL;
+    int ret = pipeline_check_edit(edit, &prev, &next);
+    if (ret != ESP_GMF_ERR_OK) {
+        return ret;
+    }
+    // The jobs of the element taken out, or of the neighbour for insert, tell whether the pipeline is loaded
+    esp_gmf_element_t *ref = (edit->type == PIPELINE_EDIT_INSERT) ? (next ? next : prev) : el;
+    uint16_t job_mask = 0;
+    esp_gmf_element_get_job_mask(ref, &job_mask);
+    if (job_mask & ESP_GMF_ELEMENT_JOB_CLOSE) {
+        ESP_LOGE(TAG, "The pipeline is closing, can't be edited, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(ref), ref);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    bool add_jobs = new_el && pipeline->thread && (job_mask & ESP_GMF_ELEMENT_JOB_PROCESS);
+    if (add_jobs && (new_el->cur_state != ESP_GMF_EVENT_STATE_INITIALIZED)) {
+        ESP_LOGE(TAG, "The new element is not INITIALIZED, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(new_el), new_el);
+        return ESP_GMF_ERR_NOT_READY;
+    }
+    if (edit->type != PIPELINE_EDIT_INSERT) {
+        // Close it while it still owns the ports, so that the input it holds goes back to the writer
+        if (el->cur_state == ESP_GMF_EVENT_STATE_RUNNING) {
+            esp_gmf_element_process_close(el, NULL);
+        }
+        if (pipeline->thread) {
+            esp_gmf_task_retire_jobs(pipeline->thread, el);
+        }
+        esp_gmf_element_reset_state(el);
+        esp_gmf_element_set_job_mask(el, 0);
+        esp_gmf_element_set_event_func(el, NULL, NULL);
+    }
+
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    switch (edit->type) {
+        case PIPELINE_EDIT_REPLACE:
+            esp_gmf_node_insert_after((esp_gmf_node_t *)el, (esp_gmf_node_t *)new_el);
+            esp_gmf_node_del_at((esp_gmf_node_t **)&pipeline->head_el, (esp_gmf_node_t *)el);
+            if (pipeline->last_el == el) {
+                pipeline->last_el = new_el;
+            }
+            new_el->in = el->in;
+            new_el->out = el->out;
+            el->in = NULL;
+            el->out = NULL;
+            break;
+        case PIPELINE_EDIT_INSERT:
+            if (prev) {
+                esp_gmf_node_insert_after((esp_gmf_node_t *)prev, (esp_gmf_node_t *)new_el);
+            } else {
+                ((esp_gmf_node_t *)new_el)->prev = NULL;
+                ((esp_gmf_node_t *)new_el)->next = (esp_gmf_node_t *)next;
+                ((esp_gmf_node_t *)next)->prev = (esp_gmf_node_t *)new_el;
+                pipeline->head_el = new_el;
+            }
+            if (next) {
+                new_el->in = pipeline_swap_first_port(&next->in, edit->link_in);
+                new_el->out = edit->link_out;
+            } else {
+                new_el->out = pipeline_swap_first_port(&prev->out, edit->link_out);
+                new_el->in = edit->link_in;
+                pipeline->last_el = new_el;
+            }
+            edit->link_in = NULL;
+            edit->link_out = NULL;
+            break;
+        case PIPELINE_EDIT_REMOVE:
+            if (next) {
+                esp_gmf_port_t *in = pipeline_swap_first_port(&el->in, NULL);
+                pipeline_drop_ports(edit, pipeline_swap_first_port(&next->in, in));
+                pipeline_drop_ports(edit, el->out);
+                el->out = NULL;
+            } else {
+                esp_gmf_port_t *out = pipeline_swap_first_port(&el->out, NULL);
+                pipeline_drop_ports(edit, pipeline_swap_first_port(&prev->out, out));
+                pipeline_drop_ports(edit, el->in);
+                el->in = NULL;
+                pipeline->last_el = prev;
+            }
+            esp_gmf_node_del_at((esp_gmf_node_t **)&pipeline->head_el, (esp_gmf_node_t *)el);
+            break;
+    }
+    pipeline_relink_ports(edit);
+    if (new_el) {
+        esp_gmf_element_set_event_func(new_el, pipeline_element_events, pipeline);
+    }
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    ESP_LOGD(TAG, "Edited, p:%p, edit:%d, el:%s-%p, new:%s-%p, add jobs:%d", pipeline, edit->type,
+             OBJ_GET_TAG(el), el, OBJ_GET_TAG(new_el), new_el, add_jobs);
+    if (add_jobs) {
+        ret = register_working_jobs_to_task(pipeline, new_el);
+    }
+    return ret;
+}
+
+static esp_gmf_err_t pipeline_run_edit(pipeline_edit_t *edit)
+{
+    esp_gmf_pipeline_handle_t pipeline = edit->pipeline;
+    int ret = ESP_GMF_ERR_OK;
+    if (pipeline->thread) {
+        ret = esp_gmf_task_call(pipeline->thread, pipeline_apply_edit, edit);
+    } else {
+        ret = pipeline_apply_edit(edit);
+    }
+    // The task is past the edit, nothing refers to the ports left out anymore
+    for (int i = 0; i < 2; i++) {
+        esp_gmf_port_t *port = edit->dropped[i];
+        while (port) {
+            esp_gmf_port_t *tmp = port->next;
+            esp_gmf_port_deinit(port);
+            port = tmp;
+        }
+    }
+    if (edit->link_in) {
+        esp_gmf_port_deinit(edit->link_in);
+    }
+    if (edit->link_out) {
+        esp_gmf_port_deinit(edit->link_out);
+    }
+    return ret;
+}
+
+static esp_gmf_err_t pipeline_apply_seek(void *ctx)
+{
+    pipeline_seek_t *seek = (pipeline_seek_t *)ctx;
+    esp_gmf_pipeline_handle_t pipeline = seek->pipeline;
+    esp_gmf_event_pkt_t evt = {
+        .from = pipeline,
+        .type = ESP_GMF_EVT_TYPE_DISCONTINUITY,
+        .payload = &seek->pos,
+        .payload_size = sizeof(seek->pos),
+    };
+    // Let the elements drop what they hold from the old position first, as the in IO
+    // must have every read released before its data bus gets reset by the seek
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    while (el) {
+        int ret = esp_gmf_element_receive_event(el, &evt, pipeline);
+        if (ret != ESP_GMF_ERR_OK) {
+            ESP_LOGE(TAG, "Failed to notify discontinuity, ret:%d, el:%s-%p", ret, OBJ_GET_TAG(el), el);
+            return ret;
+        }
+        pipeline_flush_in_ports(ESP_GMF_ELEMENT_GET(el)->in);
+        el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+    }
+    return esp_gmf_io_seek(pipeline->in, seek->pos);
+}
+
 esp_gmf_err_t esp_gmf_pipeline_create(esp_gmf_pipeline_handle_t *pipeline)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
@@ -296,7 +691,18 @@ esp_gmf_err_t esp_gmf_pipeline_destroy(esp_gmf_pipeline_handle_t pipeline)
     esp_gmf_node_clear((esp_gmf_node_t **)&pipeline->head_el, (void *)esp_gmf_obj_delete);
     esp_gmf_oal_mutex_unlock(pipeline->lock);
     esp_gmf_oal_mutex_destroy(pipeline->lock);
+    if (pipeline->mem_gov) {
+        esp_gmf_mem_gov_release(pipeline->mem_gov, pipeline);
+    }
+    if (pipeline->clock_sync) {
+        esp_gmf_clock_detach(pipeline->clock_sync);
+    }
+    esp_gmf_oal_mem_arena_handle_t arena = pipeline->arena;
     esp_gmf_oal_free(pipeline);
+    if (arena) {
+        // Whatever was not freed above goes back to the heap with the arena chunks
+        esp_gmf_oal_mem_arena_destroy(arena);
+    }
     return ESP_GMF_ERR_OK;
 }
 
@@ -365,6 +771,16 @@ esp_gmf_err_t esp_gmf_pipeline_loading_jobs(esp_gmf_pipeline_handle_t pipeline)
         ESP_LOGE(TAG, "No task for pipeline, %p", pipeline);
         return ESP_GMF_ERR_INVALID_ARG;
     }
+    if (pipeline->mem_gov) {
+        int ret = pipeline_reserve_mem(pipeline);
+        if (ret != ESP_GMF_ERR_OK) {
+            ESP_LOGE(TAG, "Failed to reserve memory, %p, ret:0x%x", pipeline, ret);
+            return ret;
+        }
+    }
+    if (pipeline->clock_sync) {
+        pipeline_apply_clock(pipeline);
+    }
     esp_gmf_node_t *node = (esp_gmf_node_t *)pipeline->head_el;
     esp_gmf_element_handle_t el = pipeline->head_el;
     do {
@@ -458,6 +874,88 @@ esp_gmf_err_t esp_gmf_pipeline_set_prev_stop_cb(esp_gmf_pipeline_handle_t pipeli
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_pipeline_set_payload_pool(esp_gmf_pipeline_handle_t pipeline, void *pool)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_LOGD(TAG, "Set payload pool, %p, pool:%p", pipeline, pool);
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    pipeline->payload_pool = pool;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    while (el) {
+        esp_gmf_port_t *port = ESP_GMF_ELEMENT_GET(el)->in;
+        while (port) {
+            esp_gmf_port_set_payload_pool(port, pool);
+            port = port->next;
+        }
+        port = ESP_GMF_ELEMENT_GET(el)->out;
+        while (port) {
+            esp_gmf_port_set_payload_pool(port, pool);
+            port = port->next;
+        }
+        el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+    }
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_mem_gov(esp_gmf_pipeline_handle_t pipeline, void *gov)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_LOGD(TAG, "Set memory governor, %p, gov:%p", pipeline, gov);
+    if (pipeline->mem_gov && (pipeline->mem_gov != gov)) {
+        esp_gmf_mem_gov_release(pipeline->mem_gov, pipeline);
+    }
+    pipeline->mem_gov = gov;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_clock(esp_gmf_pipeline_handle_t pipeline, void *clock, const esp_gmf_clock_sync_cfg_t *cfg)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    if (clock) {
+        ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
+    }
+    ESP_LOGD(TAG, "Set clock, %p, clock:%p", pipeline, clock);
+    esp_gmf_clock_sync_handle_t sync = NULL;
+    if (clock) {
+        int ret = esp_gmf_clock_attach(clock, cfg, &sync);
+        ESP_GMF_RET_ON_NOT_OK(TAG, ret, return ret, "Failed to attach to the clock");
+    }
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    esp_gmf_clock_sync_handle_t old = pipeline->clock_sync;
+    pipeline->clock_sync = sync;
+    pipeline_apply_clock(pipeline);
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    if (old) {
+        esp_gmf_clock_detach(old);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_get_clock_report(esp_gmf_pipeline_handle_t pipeline, esp_gmf_clock_report_t *report)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, report, return ESP_GMF_ERR_INVALID_ARG);
+    // The lock keeps `esp_gmf_pipeline_set_clock` from detaching the sync stage meanwhile
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_SUPPORT;
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    if (pipeline->clock_sync) {
+        ret = esp_gmf_clock_get_report(pipeline->clock_sync, report);
+    }
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_get_mem_stats(esp_gmf_pipeline_handle_t pipeline, const char *tag, esp_gmf_oal_mem_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    if (pipeline->arena == NULL) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    return esp_gmf_oal_mem_arena_get_stats(pipeline->arena, tag, stats);
+}
+
 esp_gmf_err_t esp_gmf_pipeline_run(esp_gmf_pipeline_handle_t pipeline)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
@@ -511,7 +1009,9 @@ esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline)
 esp_gmf_err_t esp_gmf_pipeline_seek(esp_gmf_pipeline_handle_t pipeline, uint64_t pos)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    if ((pipeline->state != ESP_GMF_EVENT_STATE_PAUSED)
+    bool running = (pipeline->state == ESP_GMF_EVENT_STATE_OPENING) || (pipeline->state == ESP_GMF_EVENT_STATE_RUNNING);
+    if ((running == false)
+        && (pipeline->state != ESP_GMF_EVENT_STATE_PAUSED)
         && (pipeline->state != ESP_GMF_EVENT_STATE_STOPPED)
         && (pipeline->state != ESP_GMF_EVENT_STATE_FINISHED)) {
         ESP_LOGE(TAG, "The pipeline status is %s, can't be seek.", esp_gmf_event_get_state_str(pipeline->state));
@@ -522,7 +1022,25 @@ esp_gmf_err_t esp_gmf_pipeline_seek(esp_gmf_pipeline_handle_t pipeline, uint64_t
         return ESP_GMF_ERR_NOT_SUPPORT;
     }
     int ret = ESP_GMF_ERR_OK;
-    ret = esp_gmf_io_seek(pipeline->in, pos);
+    if (running && pipeline->thread) {
+        // A job blocked on the in IO, e.g. a stalled network read, would hold the round off for good.
+        // Abort the in-flight read first as `esp_gmf_io_seek` does, the seek resets the data bus afterwards
+        esp_gmf_io_t *in = (esp_gmf_io_t *)pipeline->in;
+        if (in->prev_close) {
+            in->prev_close(in);
+        }
+        // Seek between two job rounds, so no element is in the middle of a process
+        pipeline_seek_t seek = {
+            .pipeline = pipeline,
+            .pos = pos,
+        };
+        ret = esp_gmf_task_call(pipeline->thread, pipeline_apply_seek, &seek);
+        if (ret != ESP_GMF_ERR_OK) {
+            ESP_LOGE(TAG, "Failed to seek the running pipeline, the in IO is left aborted, p:%p, ret:%d", pipeline, ret);
+        }
+    } else {
+        ret = esp_gmf_io_seek(pipeline->in, pos);
+    }
     ESP_LOGD(TAG, "Seek to %lld, ret:%d", pos, ret);
     return ret;
 }
@@ -585,6 +1103,56 @@ esp_gmf_err_t esp_gmf_pipeline_replace_out(esp_gmf_pipeline_handle_t pipeline, e
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_pipeline_replace_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t old_el, esp_gmf_element_handle_t new_el)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, old_el, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, new_el, return ESP_GMF_ERR_INVALID_ARG);
+    pipeline_edit_t edit = {
+        .pipeline = pipeline,
+        .type = PIPELINE_EDIT_REPLACE,
+        .el = old_el,
+        .new_el = new_el,
+    };
+    return pipeline_run_edit(&edit);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_insert_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t prev_el, esp_gmf_element_handle_t new_el)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, new_el, return ESP_GMF_ERR_INVALID_ARG);
+    pipeline_edit_t edit = {
+        .pipeline = pipeline,
+        .type = PIPELINE_EDIT_INSERT,
+        .el = prev_el,
+        .new_el = new_el,
+    };
+    // The link is sized by its writer, the new element unless it goes to the tail
+    esp_gmf_element_t *writer = ESP_GMF_ELEMENT_GET(new_el);
+    if (prev_el && (esp_gmf_node_for_next((esp_gmf_node_t *)prev_el) == NULL)) {
+        writer = ESP_GMF_ELEMENT_GET(prev_el);
+    }
+    edit.link_out = NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, writer->out_attr.size, ESP_GMF_MAX_DELAY);
+    ESP_GMF_MEM_CHECK(TAG, edit.link_out, return ESP_GMF_ERR_MEMORY_LACK);
+    edit.link_in = NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, writer->out_attr.size, ESP_GMF_MAX_DELAY);
+    ESP_GMF_MEM_CHECK(TAG, edit.link_in, {esp_gmf_port_deinit(edit.link_out); return ESP_GMF_ERR_MEMORY_LACK;});
+    esp_gmf_port_set_payload_pool(edit.link_out, pipeline->payload_pool);
+    esp_gmf_port_set_payload_pool(edit.link_in, pipeline->payload_pool);
+    return pipeline_run_edit(&edit);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_remove_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el, return ESP_GMF_ERR_INVALID_ARG);
+    pipeline_edit_t edit = {
+        .pipeline = pipeline,
+        .type = PIPELINE_EDIT_REMOVE,
+        .el = el,
+    };
+    return pipeline_run_edit(&edit);
+}
+
 esp_gmf_err_t esp_gmf_pipeline_get_head_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t *head)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
@@ -23,6 +23,7 @@
  */
 
 #include <string.h>
+#include <ctype.h>
 #include "sys/queue.h"
 #include "esp_log.h"
 #include "esp_gmf_element.h"
@@ -32,31 +33,142 @@
 #include "esp_gmf_pool.h"
 #include "esp_gmf_io.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_err.h"
 
 static const char *TAG = "ESP_GMF_POOL";
 
+#define GMF_POOL_HASH_INIT_BUCKETS (16)
+#define GMF_POOL_HASH_MAX_LOAD     (2)
+
+/**
+ * @brief  Node of the tag index, it is the first member of the pool items so a node can be cast back to its item
+ */
+typedef struct esp_gmf_pool_hash_node {
+    struct esp_gmf_pool_hash_node  *next;  /*!< Next node in the same bucket, in registration order */
+    uint32_t                        hash;  /*!< Case-insensitive hash of the tag */
+} esp_gmf_pool_hash_node_t;
+
+/**
+ * @brief  Chained hash table indexing the registered objects by tag
+ */
+typedef struct {
+    esp_gmf_pool_hash_node_t  **bucket;      /*!< Bucket array, the count is a power of 2 */
+    uint32_t                    bucket_num;  /*!< Number of buckets */
+    uint32_t                    node_num;    /*!< Number of indexed nodes */
+} esp_gmf_pool_hash_t;
+
 typedef struct gmp_pool_io_item {
+    esp_gmf_pool_hash_node_t        hnode;
     STAILQ_ENTRY(gmp_pool_io_item)  next;
     esp_gmf_io_handle_t             instance;
 } esp_gmf_io_item_t;
 typedef STAILQ_HEAD(gmp_io_list, gmp_pool_io_item) gmp_io_list_t;
 
 typedef struct esp_gmf_element_item {
+    esp_gmf_pool_hash_node_t            hnode;
     STAILQ_ENTRY(esp_gmf_element_item)  next;
     esp_gmf_element_handle_t            instance;
 } esp_gmf_element_item_t;
 typedef STAILQ_HEAD(esp_gmf_element_list, esp_gmf_element_item) esp_gmf_element_list_t;
 
+/**
+ * @brief  Resolved description of a pipeline, the registered objects are duplicated to build an instance
+ */
+typedef struct {
+    esp_gmf_obj_handle_t  *el;        /*!< Registered elements in link order */
+    const char           **el_name;   /*!< Names of the elements, used as arena tags */
+    int                    el_num;    /*!< Number of elements */
+    esp_gmf_obj_handle_t   in;        /*!< Registered reader I/O, NULL for none */
+    esp_gmf_obj_handle_t   out;       /*!< Registered writer I/O, NULL for none */
+    esp_gmf_io_type_t      in_type;   /*!< Type of the reader I/O */
+    esp_gmf_io_type_t      out_type;  /*!< Type of the writer I/O */
+    const char            *in_name;   /*!< Name of the reader I/O */
+    const char            *out_name;  /*!< Name of the writer I/O */
+    int                    in_size;   /*!< Size of the input port and of the ports between the elements */
+    int                    out_size;  /*!< Size of the output port */
+} esp_gmf_pool_pipe_desc_t;
+
+struct esp_gmf_pool_tmpl {
+    esp_gmf_pool_handle_t       pool;
+    esp_gmf_pool_pipe_desc_t    desc;
+    esp_gmf_pipeline_handle_t  *cache;      /*!< Recycled pipelines, `stats.cached` of them are valid */
+    uint16_t                    cache_num;  /*!< Capacity of the cache */
+    void                       *lock;
+    esp_gmf_pool_tmpl_stats_t   stats;
+};
+
 struct esp_gmf_pool {
     esp_gmf_element_list_t  el_list;
     gmp_io_list_t           io_list;
+    esp_gmf_pool_hash_t     el_index;
+    esp_gmf_pool_hash_t     io_index;
+    size_t                  arena_size;
 } esp_gmf_pool_t;
 
+static inline uint32_t pool_tag_hash(const char *tag)
+{
+    // FNV-1a over the lower case tag, lookups are case-insensitive
+    uint32_t hash = 2166136261u;
+    while (*tag) {
+        hash ^= (uint8_t)tolower((unsigned char)*tag++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline esp_gmf_pool_hash_node_t *pool_hash_first(esp_gmf_pool_hash_t *index, uint32_t hash)
+{
+    if (index->bucket == NULL) {
+        return NULL;
+    }
+    return index->bucket[hash & (index->bucket_num - 1)];
+}
+
+static void pool_hash_link(esp_gmf_pool_hash_t *index, esp_gmf_pool_hash_node_t *node)
+{
+    // Append to keep the registration order, the first registered object wins on duplicated tags
+    esp_gmf_pool_hash_node_t **pos = &index->bucket[node->hash & (index->bucket_num - 1)];
+    while (*pos) {
+        pos = &(*pos)->next;
+    }
+    node->next = NULL;
+    *pos = node;
+}
+
+static esp_gmf_err_t pool_hash_alloc(esp_gmf_pool_hash_t *index, uint32_t bucket_num)
+{
+    // Callers relink all the nodes after a successful allocation
+    esp_gmf_pool_hash_node_t **bucket = esp_gmf_oal_calloc(bucket_num, sizeof(esp_gmf_pool_hash_node_t *));
+    ESP_GMF_MEM_CHECK(TAG, bucket, return ESP_GMF_ERR_MEMORY_LACK);
+    if (index->bucket) {
+        esp_gmf_oal_free(index->bucket);
+    }
+    index->bucket = bucket;
+    index->bucket_num = bucket_num;
+    return ESP_GMF_ERR_OK;
+}
+
+static inline bool pool_hash_need_grow(esp_gmf_pool_hash_t *index)
+{
+    return (index->node_num + 1) > (index->bucket_num * GMF_POOL_HASH_MAX_LOAD);
+}
+
+static inline const char *pool_obj_tag(esp_gmf_obj_handle_t obj)
+{
+    char *tag = NULL;
+    esp_gmf_obj_get_tag(obj, &tag);
+    return tag ? tag : "";
+}
+
 static inline esp_gmf_element_item_t *__get_element_item_by_tag(esp_gmf_pool_handle_t handle, const char *tag)
 {
-    esp_gmf_element_item_t *item, *tmp;
-    STAILQ_FOREACH_SAFE(item, &handle->el_list, next, tmp) {
+    uint32_t hash = pool_tag_hash(tag);
+    for (esp_gmf_pool_hash_node_t *node = pool_hash_first(&handle->el_index, hash); node; node = node->next) {
+        if (node->hash != hash) {
+            continue;
+        }
+        esp_gmf_element_item_t *item = (esp_gmf_element_item_t *)node;
         char *el_tag = (char *)"NULL";
         esp_gmf_obj_get_tag((esp_gmf_obj_handle_t)item->instance, &el_tag);
         ESP_LOGD(TAG, "Get EL items:%p-%s", item->instance, el_tag);
@@ -69,8 +181,12 @@ static inline esp_gmf_element_item_t *__get_element_item_by_tag(esp_gmf_pool_han
 
 static inline esp_gmf_io_item_t *_get_io_item_by_tag(esp_gmf_pool_handle_t handle, const char *tag, esp_gmf_io_dir_t dir)
 {
-    esp_gmf_io_item_t *item, *tmp;
-    STAILQ_FOREACH_SAFE(item, &handle->io_list, next, tmp) {
+    uint32_t hash = pool_tag_hash(tag);
+    for (esp_gmf_pool_hash_node_t *node = pool_hash_first(&handle->io_index, hash); node; node = node->next) {
+        if (node->hash != hash) {
+            continue;
+        }
+        esp_gmf_io_item_t *item = (esp_gmf_io_item_t *)node;
         char *io_tag = (char *)"NULL";
         esp_gmf_obj_get_tag((esp_gmf_obj_handle_t)item->instance, &io_tag);
         ESP_LOGD(TAG, "Get IO items: %p-%s, dir:%d", item->instance, io_tag, ((esp_gmf_io_t *)item->instance)->dir);
@@ -88,6 +204,12 @@ esp_gmf_err_t esp_gmf_pool_init(esp_gmf_pool_handle_t *handle)
     ESP_GMF_MEM_CHECK(TAG, ph, return ESP_GMF_ERR_MEMORY_LACK);
     STAILQ_INIT(&ph->el_list);
     STAILQ_INIT(&ph->io_list);
+    if ((pool_hash_alloc(&ph->el_index, GMF_POOL_HASH_INIT_BUCKETS) != ESP_GMF_ERR_OK)
+        || (pool_hash_alloc(&ph->io_index, GMF_POOL_HASH_INIT_BUCKETS) != ESP_GMF_ERR_OK)) {
+        esp_gmf_oal_free(ph->el_index.bucket);
+        esp_gmf_oal_free(ph);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
     *handle = ph;
     return ESP_GMF_ERR_OK;
 }
@@ -110,6 +232,8 @@ esp_gmf_err_t esp_gmf_pool_deinit(esp_gmf_pool_handle_t handle)
         esp_gmf_obj_delete(io_item->instance);
         esp_gmf_oal_free(io_item);
     }
+    esp_gmf_oal_free(handle->el_index.bucket);
+    esp_gmf_oal_free(handle->io_index.bucket);
     esp_gmf_oal_free(handle);
     return ESP_GMF_ERR_OK;
 }
@@ -125,7 +249,18 @@ esp_gmf_err_t esp_gmf_pool_register_element(esp_gmf_pool_handle_t handle, esp_gm
         ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Set EL tag failed, obj:%p, tag:%s", el, OBJ_GET_TAG((esp_gmf_obj_t *)el));
     }
     el_item->instance = el;
+    el_item->hnode.hash = pool_tag_hash(pool_obj_tag(el));
     STAILQ_INSERT_TAIL(&handle->el_list, el_item, next);
+    if (pool_hash_need_grow(&handle->el_index)
+        && (pool_hash_alloc(&handle->el_index, handle->el_index.bucket_num * 2) == ESP_GMF_ERR_OK)) {
+        esp_gmf_element_item_t *item = NULL;
+        STAILQ_FOREACH(item, &handle->el_list, next) {
+            pool_hash_link(&handle->el_index, &item->hnode);
+        }
+    } else {
+        pool_hash_link(&handle->el_index, &el_item->hnode);
+    }
+    handle->el_index.node_num++;
     ESP_LOGD(TAG, "REG el:[%p-%s], item:%p", el, OBJ_GET_TAG(el), el_item);
     return ESP_GMF_ERR_OK;
 }
@@ -141,7 +276,18 @@ esp_gmf_err_t esp_gmf_pool_register_io(esp_gmf_pool_handle_t handle, esp_gmf_io_
         ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Set IO tag failed, IO:%p, tag:%s", io, OBJ_GET_TAG((esp_gmf_obj_t *)io));
     }
     io_item->instance = io;
+    io_item->hnode.hash = pool_tag_hash(pool_obj_tag(io));
     STAILQ_INSERT_TAIL(&handle->io_list, io_item, next);
+    if (pool_hash_need_grow(&handle->io_index)
+        && (pool_hash_alloc(&handle->io_index, handle->io_index.bucket_num * 2) == ESP_GMF_ERR_OK)) {
+        esp_gmf_io_item_t *item = NULL;
+        STAILQ_FOREACH(item, &handle->io_list, next) {
+            pool_hash_link(&handle->io_index, &item->hnode);
+        }
+    } else {
+        pool_hash_link(&handle->io_index, &io_item->hnode);
+    }
+    handle->io_index.node_num++;
     ESP_LOGD(TAG, "REG IO:[%p-%s], item:%p, pool:%p", io, OBJ_GET_TAG(io), io_item, handle);
     return ESP_GMF_ERR_OK;
 }
@@ -185,119 +331,311 @@ esp_gmf_err_t esp_gmf_pool_new_element(esp_gmf_pool_handle_t handle, const char
     return ESP_GMF_ERR_OK;
 }
 
-esp_gmf_err_t esp_gmf_pool_new_pipeline(esp_gmf_pool_handle_t handle, const char *in_name,
-                                        const char *el_name[], int num_of_el_name,
-                                        const char *out_name, esp_gmf_pipeline_handle_t *pipeline)
+esp_gmf_err_t esp_gmf_pool_set_pipeline_arena(esp_gmf_pool_handle_t handle, size_t chunk_size)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
-    ESP_GMF_NULL_CHECK(TAG, el_name, return ESP_GMF_ERR_INVALID_ARG);
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    if (num_of_el_name < 1) {
-        ESP_LOGE(TAG, "The number of name is too short, %d", num_of_el_name);
-        return ESP_GMF_ERR_INVALID_ARG;
+    handle->arena_size = chunk_size;
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t pool_resolve_pipeline(esp_gmf_pool_handle_t handle, const char *in_name, const char *el_name[],
+                                           int num_of_el_name, const char *out_name, esp_gmf_pool_pipe_desc_t *desc)
+{
+    // The caller provides `desc->el` with room for `num_of_el_name` entries
+    for (int i = 0; i < num_of_el_name; ++i) {
+        ESP_GMF_NULL_CHECK(TAG, el_name[i], return ESP_GMF_ERR_INVALID_ARG);
+        esp_gmf_element_item_t *el_item = __get_element_item_by_tag(handle, el_name[i]);
+        if (el_item == NULL) {
+            ESP_LOGE(TAG, "Can't found the element[%s]", el_name[i]);
+            return ESP_GMF_ERR_NOT_FOUND;
+        }
+        desc->el[i] = el_item->instance;
+    }
+    desc->el_name = el_name;
+    desc->el_num = num_of_el_name;
+    desc->in_size = ESP_GMF_ELEMENT_GET(desc->el[0])->in_attr.size;
+    desc->out_size = ESP_GMF_ELEMENT_GET(desc->el[num_of_el_name - 1])->out_attr.size;
+    const char *io_name[] = {in_name, out_name};
+    for (int dir = ESP_GMF_IO_DIR_READER; dir <= ESP_GMF_IO_DIR_WRITER; dir++) {
+        const char *name = io_name[dir - ESP_GMF_IO_DIR_READER];
+        if (name == NULL) {
+            continue;
+        }
+        esp_gmf_io_item_t *io_item = _get_io_item_by_tag(handle, name, dir);
+        if (io_item == NULL) {
+            ESP_LOGE(TAG, "Not found %s port, name:%s, pool:%p", dir > ESP_GMF_IO_DIR_READER ? "WRITER" : "READER", name, handle);
+            return ESP_GMF_ERR_NOT_FOUND;
+        }
+        esp_gmf_io_type_t io_type = 0;
+        esp_gmf_io_get_type(io_item->instance, &io_type);
+        if ((io_type != ESP_GMF_IO_TYPE_BYTE) && (io_type != ESP_GMF_IO_TYPE_BLOCK)) {
+            ESP_LOGE(TAG, "The %s type is incorrect, %d, [%p-%s]", dir > ESP_GMF_IO_DIR_READER ? "OUT" : "IN", io_type,
+                     io_item->instance, OBJ_GET_TAG(io_item->instance));
+            return ESP_GMF_ERR_NOT_SUPPORT;
+        }
+        if (dir == ESP_GMF_IO_DIR_READER) {
+            desc->in = io_item->instance;
+            desc->in_type = io_type;
+            desc->in_name = name;
+        } else {
+            desc->out = io_item->instance;
+            desc->out_type = io_type;
+            desc->out_name = name;
+        }
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t pool_build_pipeline(esp_gmf_pool_handle_t handle, const esp_gmf_pool_pipe_desc_t *desc, esp_gmf_pipeline_handle_t *pipeline)
+{
+    esp_gmf_oal_mem_arena_handle_t arena = NULL;
+    if (handle->arena_size) {
+        esp_gmf_oal_mem_arena_create(handle->arena_size, &arena);
+        ESP_GMF_MEM_CHECK(TAG, arena, return ESP_GMF_ERR_MEMORY_LACK);
+        esp_gmf_oal_mem_arena_enter(arena, NULL);
     }
     esp_gmf_pipeline_t *pl = NULL;
     esp_gmf_pipeline_create(&pl);
-    ESP_GMF_MEM_CHECK(TAG, pl, return ESP_GMF_ERR_MEMORY_LACK);
+    ESP_GMF_MEM_CHECK(TAG, pl, {
+        if (arena) {
+            esp_gmf_oal_mem_arena_destroy(arena);
+        }
+        return ESP_GMF_ERR_MEMORY_LACK;
+    });
+    pl->arena = arena;
     *pipeline = pl;
-    int el_cnt = 0;
     esp_gmf_obj_handle_t new_last_el_obj = NULL;
     esp_gmf_obj_handle_t new_prev_el_obj = NULL;
     esp_gmf_obj_handle_t new_first_el_obj = NULL;
     int ret = ESP_GMF_ERR_OK;
     // Link the elements
-    for (int i = 0; i < num_of_el_name; ++i) {
-        esp_gmf_element_handle_t new_el = NULL;
-        ret = esp_gmf_pool_new_element(handle, el_name[i], &new_el);
-        if (ret != ESP_GMF_ERR_OK) {
-            goto NEW_PIPE_FAIL;
+    for (int i = 0; i < desc->el_num; ++i) {
+        esp_gmf_obj_handle_t new_el = NULL;
+        if (arena) {
+            esp_gmf_oal_mem_arena_enter(arena, desc->el_name[i]);
         }
+        ret = esp_gmf_obj_dupl(desc->el[i], (void *)&new_el);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;},
+                             "Failed to create element object, [%p-%s]", desc->el[i], OBJ_GET_TAG(desc->el[i]));
         ESP_LOGD(TAG, "TO link elments, [%p-%s]", new_el, OBJ_GET_TAG(new_el));
-        el_cnt++;
-        if (el_cnt == 1) {
+        if (i == 0) {
             new_first_el_obj = new_el;
-            new_prev_el_obj = new_el;
-            new_last_el_obj = new_el;
-        }
-        if ((num_of_el_name > 1) && (el_cnt > 1)) {
+        } else {
             esp_gmf_port_handle_t out_port = NULL;
             esp_gmf_port_handle_t in_port = NULL;
-            out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, (ESP_GMF_ELEMENT_GET(new_first_el_obj)->in_attr.size), ESP_GMF_MAX_DELAY);
+            out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, desc->in_size, ESP_GMF_MAX_DELAY);
             ESP_GMF_NULL_CHECK(TAG, out_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;});
-            in_port = NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, (ESP_GMF_ELEMENT_GET(new_first_el_obj)->in_attr.size), ESP_GMF_MAX_DELAY);
-            ESP_GMF_NULL_CHECK(TAG, in_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;});
+            in_port = NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, desc->in_size, ESP_GMF_MAX_DELAY);
+            ESP_GMF_NULL_CHECK(TAG, in_port, {esp_gmf_port_deinit(out_port); ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;});
             esp_gmf_element_register_out_port((esp_gmf_element_handle_t)new_prev_el_obj, out_port);
             esp_gmf_element_register_in_port(new_el, in_port);
-            new_prev_el_obj = new_el;
-            new_last_el_obj = new_el;
         }
+        new_prev_el_obj = new_el;
+        new_last_el_obj = new_el;
         esp_gmf_pipeline_register_el(pl, new_el);
     }
-    // Found the input io if already registered
-    if (in_name) {
+    // Duplicate the input io if any
+    if (desc->in) {
         esp_gmf_io_handle_t new_in = NULL;
-        ret = esp_gmf_pool_new_io(handle, in_name, ESP_GMF_IO_DIR_READER, &new_in);
-        if (ret != ESP_GMF_ERR_OK) {
-            goto NEW_PIPE_FAIL;
+        if (arena) {
+            esp_gmf_oal_mem_arena_enter(arena, desc->in_name);
         }
+        ret = esp_gmf_obj_dupl(desc->in, (void *)&new_in);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;},
+                             "Failed to create READER IO object, name:%s, [%p-%s]", desc->in_name, desc->in, OBJ_GET_TAG(desc->in));
         esp_gmf_pipeline_set_io(pl, new_in, ESP_GMF_IO_DIR_READER);
-
-        esp_gmf_io_type_t io_type = 0;
-        esp_gmf_io_get_type(new_in, &io_type);
         esp_gmf_port_handle_t in_port = NULL;
-
-        if (io_type == ESP_GMF_IO_TYPE_BYTE) {
+        if (desc->in_type == ESP_GMF_IO_TYPE_BYTE) {
             in_port = NEW_ESP_GMF_PORT_IN_BYTE(esp_gmf_io_acquire_read, esp_gmf_io_release_read, NULL, new_in,
-                                               (ESP_GMF_ELEMENT_GET(new_first_el_obj)->in_attr.size), ESP_GMF_MAX_DELAY);
-        } else if (io_type == ESP_GMF_IO_TYPE_BLOCK) {
-            in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_io_acquire_read, esp_gmf_io_release_read, NULL, new_in,
-                                                (ESP_GMF_ELEMENT_GET(new_first_el_obj)->in_attr.size), ESP_GMF_MAX_DELAY);
+                                               desc->in_size, ESP_GMF_MAX_DELAY);
         } else {
-            ESP_LOGE(TAG, "The IN type is incorrect,%d, [%p-%s]", io_type, new_in, OBJ_GET_TAG(new_in));
-            ret = ESP_GMF_ERR_NOT_SUPPORT;
-            goto NEW_PIPE_FAIL;
+            in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_io_acquire_read, esp_gmf_io_release_read, NULL, new_in,
+                                                desc->in_size, ESP_GMF_MAX_DELAY);
         }
         ESP_GMF_NULL_CHECK(TAG, in_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;});
         esp_gmf_element_register_in_port((esp_gmf_element_handle_t)new_first_el_obj, in_port);
         ESP_LOGD(TAG, "TO link IN port, [%p-%s],new:%p", new_in, OBJ_GET_TAG(new_in), in_port);
     }
-
-    // Found the output io if already registered
-    if (out_name) {
+    // Duplicate the output io if any
+    if (desc->out) {
         esp_gmf_io_handle_t new_out = NULL;
-        ret = esp_gmf_pool_new_io(handle, out_name, ESP_GMF_IO_DIR_WRITER, &new_out);
-        if (ret != ESP_GMF_ERR_OK) {
-            goto NEW_PIPE_FAIL;
+        if (arena) {
+            esp_gmf_oal_mem_arena_enter(arena, desc->out_name);
         }
+        ret = esp_gmf_obj_dupl(desc->out, (void *)&new_out);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;},
+                             "Failed to create WRITER IO object, name:%s, [%p-%s]", desc->out_name, desc->out, OBJ_GET_TAG(desc->out));
         esp_gmf_pipeline_set_io(pl, new_out, ESP_GMF_IO_DIR_WRITER);
-
-        esp_gmf_io_type_t io_type = 0;
-        esp_gmf_io_get_type(new_out, &io_type);
         esp_gmf_port_handle_t out_port = NULL;
-
-        if (io_type == ESP_GMF_IO_TYPE_BYTE) {
+        if (desc->out_type == ESP_GMF_IO_TYPE_BYTE) {
             out_port = NEW_ESP_GMF_PORT_OUT_BYTE(esp_gmf_io_acquire_write, esp_gmf_io_release_write, NULL, new_out,
-                                                 (ESP_GMF_ELEMENT_GET(new_last_el_obj)->out_attr.size), ESP_GMF_MAX_DELAY);
-        } else if (io_type == ESP_GMF_IO_TYPE_BLOCK) {
-            out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(esp_gmf_io_acquire_write, esp_gmf_io_release_write, NULL, new_out,
-                                                  (ESP_GMF_ELEMENT_GET(new_last_el_obj)->out_attr.size), ESP_GMF_MAX_DELAY);
+                                                 desc->out_size, ESP_GMF_MAX_DELAY);
         } else {
-            ESP_LOGE(TAG, "The OUT type is incorrect, %d, [%p-%s]", io_type, new_out, OBJ_GET_TAG(new_out));
-            ret = ESP_GMF_ERR_NOT_SUPPORT;
-            goto NEW_PIPE_FAIL;
+            out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(esp_gmf_io_acquire_write, esp_gmf_io_release_write, NULL, new_out,
+                                                  desc->out_size, ESP_GMF_MAX_DELAY);
         }
         ESP_GMF_NULL_CHECK(TAG, out_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto NEW_PIPE_FAIL;});
         esp_gmf_element_register_out_port((esp_gmf_element_handle_t)new_last_el_obj, out_port);
-        ESP_LOGD(TAG, "TO link OUT port, [%p-%s], new:%p, sz:%d", new_out, OBJ_GET_TAG(new_out), out_port, (ESP_GMF_ELEMENT_GET(new_last_el_obj)->out_attr.size));
+        ESP_LOGD(TAG, "TO link OUT port, [%p-%s], new:%p, sz:%d", new_out, OBJ_GET_TAG(new_out), out_port, desc->out_size);
+    }
+    if (arena) {
+        esp_gmf_oal_mem_arena_leave(arena);
     }
     return ESP_GMF_ERR_OK;
 
 NEW_PIPE_FAIL:
+    if (arena) {
+        esp_gmf_oal_mem_arena_leave(arena);
+    }
     esp_gmf_pipeline_destroy(pl);
     *pipeline = NULL;
     return ret;
 }
 
+esp_gmf_err_t esp_gmf_pool_new_pipeline(esp_gmf_pool_handle_t handle, const char *in_name,
+                                        const char *el_name[], int num_of_el_name,
+                                        const char *out_name, esp_gmf_pipeline_handle_t *pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    if (num_of_el_name < 1) {
+        ESP_LOGE(TAG, "The number of name is too short, %d", num_of_el_name);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_pool_pipe_desc_t desc = {0};
+    desc.el = esp_gmf_oal_calloc(num_of_el_name, sizeof(esp_gmf_obj_handle_t));
+    ESP_GMF_MEM_CHECK(TAG, desc.el, return ESP_GMF_ERR_MEMORY_LACK);
+    int ret = pool_resolve_pipeline(handle, in_name, el_name, num_of_el_name, out_name, &desc);
+    if (ret == ESP_GMF_ERR_OK) {
+        ret = pool_build_pipeline(handle, &desc, pipeline);
+    }
+    esp_gmf_oal_free(desc.el);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_pool_new_template(esp_gmf_pool_handle_t handle, const char *in_name,
+                                        const char *el_name[], int num_of_el_name, const char *out_name,
+                                        uint16_t cache_num, esp_gmf_pool_tmpl_handle_t *tmpl)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, tmpl, return ESP_GMF_ERR_INVALID_ARG);
+    if (num_of_el_name < 1) {
+        ESP_LOGE(TAG, "The number of name is too short, %d", num_of_el_name);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    *tmpl = NULL;
+    // The names are copied right behind the template, together with the element and cache arrays
+    size_t name_len = (in_name ? strlen(in_name) + 1 : 0) + (out_name ? strlen(out_name) + 1 : 0);
+    for (int i = 0; i < num_of_el_name; i++) {
+        ESP_GMF_NULL_CHECK(TAG, el_name[i], return ESP_GMF_ERR_INVALID_ARG);
+        name_len += strlen(el_name[i]) + 1;
+    }
+    size_t size = sizeof(struct esp_gmf_pool_tmpl) + num_of_el_name * (sizeof(esp_gmf_obj_handle_t) + sizeof(char *))
+                  + cache_num * sizeof(esp_gmf_pipeline_handle_t) + name_len;
+    struct esp_gmf_pool_tmpl *t = esp_gmf_oal_calloc(1, size);
+    ESP_GMF_MEM_CHECK(TAG, t, return ESP_GMF_ERR_MEMORY_LACK);
+    t->desc.el = (esp_gmf_obj_handle_t *)(t + 1);
+    const char **names = (const char **)(t->desc.el + num_of_el_name);
+    t->cache = (esp_gmf_pipeline_handle_t *)(names + num_of_el_name);
+    char *str = (char *)(t->cache + cache_num);
+    for (int i = 0; i < num_of_el_name; i++) {
+        names[i] = strcpy(str, el_name[i]);
+        str += strlen(str) + 1;
+    }
+    if (in_name) {
+        in_name = strcpy(str, in_name);
+        str += strlen(str) + 1;
+    }
+    if (out_name) {
+        out_name = strcpy(str, out_name);
+    }
+    int ret = pool_resolve_pipeline(handle, in_name, names, num_of_el_name, out_name, &t->desc);
+    if (ret != ESP_GMF_ERR_OK) {
+        esp_gmf_oal_free(t);
+        return ret;
+    }
+    t->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, t->lock, {esp_gmf_oal_free(t); return ESP_GMF_ERR_MEMORY_LACK;});
+    t->pool = handle;
+    t->cache_num = cache_num;
+    *tmpl = t;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pool_template_new_pipeline(esp_gmf_pool_tmpl_handle_t tmpl, esp_gmf_pipeline_handle_t *pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, tmpl, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_oal_mutex_lock(tmpl->lock);
+    if (tmpl->stats.cached) {
+        *pipeline = tmpl->cache[--tmpl->stats.cached];
+        tmpl->stats.reuse_cnt++;
+        esp_gmf_oal_mutex_unlock(tmpl->lock);
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_unlock(tmpl->lock);
+    int ret = pool_build_pipeline(tmpl->pool, &tmpl->desc, pipeline);
+    if (ret == ESP_GMF_ERR_OK) {
+        esp_gmf_oal_mutex_lock(tmpl->lock);
+        tmpl->stats.build_cnt++;
+        esp_gmf_oal_mutex_unlock(tmpl->lock);
+    }
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_pool_template_recycle(esp_gmf_pool_tmpl_handle_t tmpl, esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, tmpl, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    if (tmpl->cache_num == 0) {
+        return esp_gmf_pipeline_destroy(pipeline);
+    }
+    // Bring the pipeline back to the state right after it was built, a pipeline never bound to a task has not run
+    if (pipeline->thread) {
+        esp_gmf_pipeline_reset(pipeline);
+        esp_gmf_pipeline_bind_task(pipeline, NULL);
+    }
+    esp_gmf_pipeline_set_event(pipeline, NULL, NULL);
+    esp_gmf_pipeline_set_prev_stop_cb(pipeline, NULL, NULL);
+    esp_gmf_pipeline_set_mem_gov(pipeline, NULL);
+    // The payload pool and the clock belong to the previous owner and may be destroyed before the pipeline is reused
+    esp_gmf_pipeline_set_payload_pool(pipeline, NULL);
+    esp_gmf_pipeline_set_clock(pipeline, NULL, NULL);
+    esp_gmf_oal_mutex_lock(tmpl->lock);
+    bool keep = tmpl->stats.cached < tmpl->cache_num;
+    if (keep) {
+        tmpl->cache[tmpl->stats.cached++] = pipeline;
+    }
+    esp_gmf_oal_mutex_unlock(tmpl->lock);
+    if (keep == false) {
+        return esp_gmf_pipeline_destroy(pipeline);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pool_template_get_stats(esp_gmf_pool_tmpl_handle_t tmpl, esp_gmf_pool_tmpl_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, tmpl, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_oal_mutex_lock(tmpl->lock);
+    *stats = tmpl->stats;
+    esp_gmf_oal_mutex_unlock(tmpl->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pool_delete_template(esp_gmf_pool_tmpl_handle_t tmpl)
+{
+    ESP_GMF_NULL_CHECK(TAG, tmpl, return ESP_GMF_ERR_INVALID_ARG);
+    for (int i = 0; i < tmpl->stats.cached; i++) {
+        esp_gmf_pipeline_destroy(tmpl->cache[i]);
+    }
+    esp_gmf_oal_mutex_destroy(tmpl->lock);
+    esp_gmf_oal_free(tmpl);
+    return ESP_GMF_ERR_OK;
+}
+
 void esp_gmf_pool_show_lists(esp_gmf_pool_handle_t handle, int line, const char *func)
 {
     esp_gmf_io_item_t *item, *tmp;
@@ -29,6 +29,7 @@
 #include "esp_gmf_port.h"
 #include "esp_gmf_element.h"
 #include "esp_gmf_node.h"
+#include "esp_gmf_clock.h"
 
 static const char *TAG = "ESP_GMF_PORT";
 
@@ -46,6 +47,72 @@ static inline esp_gmf_err_io_t esp_gmf_port_dec_ref(esp_gmf_port_handle_t port,
     return ESP_GMF_ERR_OK;
 }
 
+static esp_gmf_err_io_t port_release_chain(esp_gmf_port_t *port, esp_gmf_payload_t *load, int wait_ticks)
+{
+    if (port->type == ESP_GMF_PORT_TYPE_BLOCK) {
+        // The block buffer belongs to the IO, so the segments must fit in it
+        int ret = esp_gmf_payload_flatten(load, load);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ESP_GMF_IO_FAIL, "REL OUT, chain does not fit the block, p:%p", port);
+        return port->ops.release(port->ctx, load, wait_ticks);
+    }
+    // Write the segments one by one, the end of stream is reported with the last segment only
+    bool is_done = load->is_done;
+    esp_gmf_payload_t *seg = load;
+    int ret = ESP_GMF_IO_OK;
+    while (seg) {
+        esp_gmf_payload_t *next = seg->next;
+        bool seg_done = seg->is_done;
+        seg->is_done = (next == NULL) ? (is_done || seg_done) : false;
+        if (seg != load) {
+            ret = port->ops.acquire(port->ctx, seg, seg->valid_size, wait_ticks);
+        }
+        if (ret >= 0) {
+            ret = port->ops.release(port->ctx, seg, wait_ticks);
+        }
+        seg->is_done = seg_done;
+        if (ret < 0) {
+            ESP_LOGE(TAG, "REL OUT, write chain segment failed, ret:%d, p:%p, seg:%p", ret, port, seg);
+            break;
+        }
+        seg = next;
+    }
+    load->is_done = is_done;
+    return ret;
+}
+
+static esp_gmf_err_io_t port_release_synced(esp_gmf_port_t *port, esp_gmf_payload_t *load, int wait_ticks)
+{
+    uint8_t times = 1;
+    esp_gmf_clock_sync(port->clock_sync, load, &times);
+    int ret = ESP_GMF_IO_OK;
+    if (times == 0) {
+        // Hand over an empty payload, the sink still pairs its acquire and sees the end of stream
+        int valid_size = load->valid_size;
+        load->valid_size = 0;
+        ret = port->ops.release(port->ctx, load, wait_ticks);
+        load->valid_size = valid_size;
+        return ret;
+    }
+    if ((times > 1) && ((port->type == ESP_GMF_PORT_TYPE_BLOCK) || load->next)) {
+        // The block buffer belongs to the IO and a chain is written segment by segment, neither can be written twice
+        times = 1;
+    }
+    if (times == 1) {
+        return load->next ? port_release_chain(port, load, wait_ticks) : port->ops.release(port->ctx, load, wait_ticks);
+    }
+    bool is_done = load->is_done;
+    load->is_done = false;
+    ret = port->ops.release(port->ctx, load, wait_ticks);
+    load->is_done = is_done;
+    if (ret >= 0) {
+        ret = port->ops.acquire(port->ctx, load, load->valid_size, wait_ticks);
+    }
+    if (ret >= 0) {
+        ret = port->ops.release(port->ctx, load, wait_ticks);
+    }
+    return ret;
+}
+
 esp_gmf_err_t esp_gmf_port_init(esp_gmf_port_config_t *cfg, esp_gmf_port_handle_t *out_result)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
@@ -118,6 +185,7 @@ esp_gmf_err_t esp_gmf_port_reset(esp_gmf_port_handle_t handle)
     esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
     ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
     port->payload = NULL;
+    port->chain_head = NULL;
     if (port->self_payload) {
         esp_gmf_payload_clean_done(port->self_payload);
         port->self_payload->valid_size = 0;
@@ -150,6 +218,17 @@ esp_gmf_err_t esp_gmf_port_set_writer(esp_gmf_port_handle_t handle, void *writer
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_port_set_payload_pool(esp_gmf_port_handle_t handle, void *pool)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->payload_pool = pool;
+    if (port->self_payload) {
+        esp_gmf_payload_set_pool(port->self_payload, pool);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_port_add_last(esp_gmf_port_handle_t head, esp_gmf_port_handle_t io_inst)
 {
     ESP_GMF_NULL_CHECK(TAG, head, return ESP_GMF_ERR_INVALID_ARG);
@@ -200,10 +279,26 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
         ESP_LOGD(TAG, "ACQ IN, GET, port:%p-%d, el:%p-%s, PLD[h:%p, b:%p, v:%d]",
                  port, port->type, el, OBJ_GET_TAG(el), port->payload, port->payload ? port->payload->buf : NULL, port->payload ? port->payload->valid_size : 0);
         if (port->payload) {
+            if (port->payload->next && ((ESP_GMF_ELEMENT_GET(el)->in_attr.cap & ESP_GMF_EL_PORT_CAP_CHAIN) == 0)) {
+                // The reader can't handle a chain, gather it into the self payload
+                if (port->self_payload == NULL) {
+                    esp_gmf_payload_new(&port->self_payload);
+                    ESP_GMF_MEM_CHECK(TAG, port->self_payload, return ESP_GMF_IO_FAIL);
+                    port->self_payload->pool = port->payload_pool;
+                }
+                ret = esp_gmf_payload_flatten(port->payload, port->self_payload);
+                ESP_GMF_RET_ON_ERROR(TAG, ret, return ESP_GMF_IO_FAIL, "ACQ IN, flatten payload chain failed, p:%p, el:%p-%s", port, el, OBJ_GET_TAG(el));
+                port->chain_head = port->payload;
+                port->payload = port->self_payload;
+            }
             *load = port->payload;
-            ret = port->payload->valid_size;
+            uint32_t valid_size = 0;
+            esp_gmf_payload_get_chain_size(port->payload, &valid_size);
+            ret = valid_size;
             if (ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)) {
-                if ((port->payload->needs_free) && (port->is_shared) && ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out) {
+                // A chain is not shared to the output for in-place processing, the segments belong to the writer
+                if ((port->payload->needs_free) && (port->is_shared) && (port->payload->next == NULL)
+                    && ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out) {
                     ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out->payload = port->payload;
                 }
             }
@@ -216,6 +311,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
             if (port->self_payload == NULL) {
                 esp_gmf_payload_new(&port->self_payload);
                 ESP_GMF_MEM_CHECK(TAG, port->self_payload, return ESP_GMF_IO_FAIL);
+                port->self_payload->pool = port->payload_pool;
                 ESP_LOGI(TAG, "ACQ IN, new self payload:%p, port:%p, el:%p-%s", port->self_payload, port, el, OBJ_GET_TAG(el));
             }
             port->payload = port->self_payload;
@@ -258,7 +354,13 @@ esp_gmf_err_io_t esp_gmf_port_release_in(esp_gmf_port_handle_t handle, esp_gmf_p
     int ret = ESP_GMF_ERR_OK;
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->reader;
     ESP_LOGD(TAG, "%s, p:%p, el:%s, PLD[p:%p, h:%p, b:%p, l:%d]", __func__, port, OBJ_GET_TAG(el), port->payload, load, load->buf, load->buf_length);
+    esp_gmf_element_stats_add_bytes(el, ESP_GMF_PORT_DIR_IN, load->valid_size);
     if (el && port->writer) {
+        if (port->chain_head && (load == port->self_payload)) {
+            // Hand the original chain back to the reference port instead of the flattened copy
+            load = port->chain_head;
+            port->chain_head = NULL;
+        }
         if (port->ref_port) {
             ret = esp_gmf_port_dec_ref(port->ref_port, load, wait_ticks);
         }
@@ -324,6 +426,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_aligned_out(esp_gmf_port_handle_t handle,
                 if (port->self_payload == NULL) {
                     esp_gmf_payload_new(&port->self_payload);
                     ESP_GMF_MEM_CHECK(TAG, port->self_payload, return ESP_GMF_IO_FAIL);
+                    port->self_payload->pool = port->payload_pool;
                     ESP_LOGI(TAG, "ACQ OUT SET, new self payload:%p, p:%p, el:%p-%s", port->self_payload, port, el, OBJ_GET_TAG(el));
                 }
                 port->payload = port->self_payload;
@@ -345,6 +448,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_aligned_out(esp_gmf_port_handle_t handle,
                 if (port->self_payload == NULL) {
                     esp_gmf_payload_new(&port->self_payload);
                     ESP_GMF_MEM_CHECK(TAG, port->self_payload, return ESP_GMF_IO_FAIL);
+                    port->self_payload->pool = port->payload_pool;
                     ESP_LOGI(TAG, "ACQ OUT, new self payload:%p, port:%p, el:%p-%s", port->self_payload, port, el, OBJ_GET_TAG(el));
                 }
                 port->payload = port->self_payload;
@@ -390,8 +494,13 @@ esp_gmf_err_io_t esp_gmf_port_release_out(esp_gmf_port_handle_t handle, esp_gmf_
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->writer;
     int ret = ESP_GMF_ERR_OK;
     ESP_LOGD(TAG, "%s, p:%p, el:%s,reader:%p, PLD[h:%p, b:%p, l:%d]", __func__, port, OBJ_GET_TAG(el), port->reader, load, load->buf, load->buf_length);
+    esp_gmf_element_stats_add_bytes(el, ESP_GMF_PORT_DIR_OUT, load->valid_size);
     if (el && port->reader) {
         port->payload = NULL;
+    } else if (port->clock_sync) {
+        ret = port_release_synced(port, load, wait_ticks);
+    } else if (load->next) {
+        ret = port_release_chain(port, load, wait_ticks);
     } else {
         ret = port->ops.release(port->ctx, load, wait_ticks);
     }
@@ -26,6 +26,8 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <stdatomic.h>
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "sys/queue.h"
@@ -33,6 +35,7 @@
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_oal_thread.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_node.h"
 #include "esp_gmf_task.h"
 #include "esp_log.h"
@@ -41,6 +44,83 @@ static const char *TAG = "ESP_GMF_TASK";
 
 #define DEFAULT_TASK_OPT_MAX_TIME_MS (2000 / portTICK_PERIOD_MS)
 
+struct esp_gmf_task_executor;
+
+/**
+ * @brief  Job chain queue of one executor worker
+ *         The owner pops from the tail while the other workers steal from the head
+ */
+typedef struct {
+    esp_gmf_job_t **items;  /*!< Head jobs of the queued dependency chains */
+    int             cap;    /*!< Capacity of the items */
+    int             head;   /*!< Steal side index */
+    int             tail;   /*!< Owner side index */
+    void           *lock;   /*!< Mutex protecting the queue */
+} esp_gmf_task_deque_t;
+
+/**
+ * @brief  Executor worker, worker 0 is the task thread itself and the others are helper threads
+ */
+typedef struct {
+    struct esp_gmf_task_executor *exec;       /*!< Executor the worker belongs to */
+    esp_gmf_oal_thread_t          thread;     /*!< Helper thread handle, NULL for worker 0 */
+    void                         *handle;     /*!< FreeRTOS handle of the helper thread, NULL for worker 0 */
+    SemaphoreHandle_t             start_sem;  /*!< Semaphore to wake up the helper thread */
+    esp_gmf_task_deque_t          dq;         /*!< Queue of the dependency chains */
+    uint8_t                       id;         /*!< Worker index */
+} esp_gmf_task_worker_t;
+
+/**
+ * @brief  Work-stealing executor
+ *         Each round dispatches one head job per dependency chain, the chains are spread over the workers
+ *         and idle workers steal from the busy ones. The task thread applies the job results after all chains are done
+ */
+typedef struct esp_gmf_task_executor {
+    esp_gmf_task_worker_t  workers[ESP_GMF_TASK_MAX_WORKER_NUM];  /*!< Workers of the executor */
+    uint8_t                worker_num;                            /*!< Number of valid workers */
+    esp_gmf_job_t         *last;                                  /*!< Last job of the current round */
+    atomic_int             remaining;                             /*!< Chains not finished in the current round */
+    SemaphoreHandle_t      done_sem;                              /*!< Given when all chains of the round are done */
+    SemaphoreHandle_t      exit_sem;                              /*!< Given by helper threads on exit */
+    volatile uint8_t       _exit;                                 /*!< Flag to let the helper threads exit */
+} esp_gmf_task_executor_t;
+
+/**
+ * @brief  Interned job label with the timing constraints of the jobs using it
+ */
+typedef struct {
+    char                  *str;     /*!< Label string */
+    esp_gmf_job_timing_t   timing;  /*!< Timing constraints of the jobs with this label */
+} esp_gmf_task_label_t;
+
+/**
+ * @brief  Timing update of the registered jobs, applied in the task context
+ */
+typedef struct {
+    esp_gmf_task_t        *tsk;     /*!< Task of the jobs */
+    const char            *label;   /*!< Interned label of the jobs */
+    esp_gmf_job_timing_t   timing;  /*!< New timing constraints */
+} esp_gmf_task_timing_update_t;
+
+/**
+ * @brief  Job slab of the task
+ *         The jobs are preallocated and recycled by a free list, the labels are interned and kept until the task is deinitialized
+ */
+typedef struct {
+    esp_gmf_job_t         *jobs;        /*!< Preallocated jobs */
+    esp_gmf_job_t         *free_list;   /*!< Free jobs linked by `next` */
+    esp_gmf_task_label_t  *labels;      /*!< Interned job labels */
+    uint16_t               label_num;   /*!< Number of interned labels */
+    uint16_t               label_cap;   /*!< Capacity of the labels */
+    uint16_t               capacity;    /*!< Number of preallocated jobs */
+    uint16_t               in_use;      /*!< Number of slab jobs in use */
+    uint16_t               high_water;  /*!< Maximum number of slab jobs in use */
+    uint32_t               overflow;    /*!< Jobs allocated from heap because the slab was exhausted */
+    uint32_t               miss_cnt;    /*!< Number of job deadline misses */
+    uint32_t               over_cnt;    /*!< Number of job CPU budget overruns */
+    void                  *lock;        /*!< Mutex protecting the slab */
+} esp_gmf_task_job_slab_t;
+
 static inline esp_gmf_err_t esp_gmf_event_state_notify(esp_gmf_task_handle_t handle, esp_gmf_event_type_t type, esp_gmf_event_state_t st)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
@@ -112,9 +192,14 @@ static int get_jobs_num(esp_gmf_job_t *job)
     return k;
 }
 
+static void esp_gmf_task_executor_destroy(esp_gmf_task_t *tsk);
+static void esp_gmf_task_job_slab_destroy(esp_gmf_task_t *tsk);
+
 static inline void __esp_gmf_task_free(esp_gmf_task_handle_t handle)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_task_executor_destroy(tsk);
+    esp_gmf_task_job_slab_destroy(tsk);
     if (tsk->lock) {
         esp_gmf_oal_mutex_destroy(tsk->lock);
     }
@@ -127,21 +212,266 @@ static inline void __esp_gmf_task_free(esp_gmf_task_handle_t handle)
     if (tsk->api_sync_sem) {
         vSemaphoreDelete(tsk->api_sync_sem);
     }
+    if (tsk->call_sem) {
+        vSemaphoreDelete(tsk->call_sem);
+    }
+    if (tsk->call_lock) {
+        esp_gmf_oal_mutex_destroy(tsk->call_lock);
+    }
+    if (tsk->call_serial) {
+        esp_gmf_oal_mutex_destroy(tsk->call_serial);
+    }
     esp_gmf_oal_free(tsk);
 }
 
-int esp_gmf_job_item_free(void *ptr)
+static esp_gmf_err_t esp_gmf_task_job_slab_create(esp_gmf_task_t *tsk, uint16_t capacity)
 {
-    esp_gmf_job_t *job = (esp_gmf_job_t *)ptr;
-    esp_gmf_oal_free((void *)job->label);
-    esp_gmf_oal_free(job);
+    esp_gmf_task_job_slab_t *slab = esp_gmf_oal_calloc(1, sizeof(esp_gmf_task_job_slab_t));
+    ESP_GMF_MEM_CHECK(TAG, slab, return ESP_GMF_ERR_MEMORY_LACK);
+    tsk->job_slab = slab;
+    slab->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, slab->lock, return ESP_GMF_ERR_MEMORY_LACK);
+    slab->jobs = esp_gmf_oal_calloc(capacity, sizeof(esp_gmf_job_t));
+    ESP_GMF_MEM_CHECK(TAG, slab->jobs, return ESP_GMF_ERR_MEMORY_LACK);
+    slab->capacity = capacity;
+    for (int i = capacity - 1; i >= 0; i--) {
+        slab->jobs[i].next = slab->free_list;
+        slab->free_list = &slab->jobs[i];
+    }
     return ESP_GMF_ERR_OK;
 }
 
+static void esp_gmf_task_job_slab_destroy(esp_gmf_task_t *tsk)
+{
+    esp_gmf_task_job_slab_t *slab = (esp_gmf_task_job_slab_t *)tsk->job_slab;
+    if (slab == NULL) {
+        return;
+    }
+    for (int i = 0; i < slab->label_num; i++) {
+        esp_gmf_oal_free(slab->labels[i].str);
+    }
+    esp_gmf_oal_free(slab->labels);
+    esp_gmf_oal_free(slab->jobs);
+    if (slab->lock) {
+        esp_gmf_oal_mutex_destroy(slab->lock);
+    }
+    esp_gmf_oal_free(slab);
+    tsk->job_slab = NULL;
+}
+
+static esp_gmf_task_label_t *esp_gmf_task_intern_label(esp_gmf_task_job_slab_t *slab, const char *label)
+{
+    for (int i = 0; i < slab->label_num; i++) {
+        if (strcmp(slab->labels[i].str, label) == 0) {
+            return &slab->labels[i];
+        }
+    }
+    if (slab->label_num >= slab->label_cap) {
+        esp_gmf_task_label_t *labels = esp_gmf_oal_realloc(slab->labels, (slab->label_cap + 8) * sizeof(esp_gmf_task_label_t));
+        ESP_GMF_MEM_CHECK(TAG, labels, return NULL);
+        slab->labels = labels;
+        slab->label_cap += 8;
+    }
+    char *new_label = esp_gmf_oal_strdup(label);
+    ESP_GMF_MEM_CHECK(TAG, new_label, return NULL);
+    esp_gmf_task_label_t *item = &slab->labels[slab->label_num++];
+    memset(item, 0, sizeof(esp_gmf_task_label_t));
+    item->str = new_label;
+    return item;
+}
+
+static inline bool esp_gmf_job_has_timing(esp_gmf_job_t *job)
+{
+    return job->timing.period_us || job->timing.deadline_us || job->timing.budget_us;
+}
+
+static inline void esp_gmf_job_release(esp_gmf_job_t *job, int64_t release_at)
+{
+    job->release_at = release_at;
+    job->deadline_at = release_at + (job->timing.deadline_us ? job->timing.deadline_us : job->timing.period_us);
+}
+
+static esp_gmf_job_t *esp_gmf_task_job_alloc(esp_gmf_task_t *tsk, const char *label)
+{
+    esp_gmf_task_job_slab_t *slab = (esp_gmf_task_job_slab_t *)tsk->job_slab;
+    esp_gmf_oal_mutex_lock(slab->lock);
+    esp_gmf_task_label_t *interned = esp_gmf_task_intern_label(slab, label == NULL ? "NULL" : label);
+    if (interned == NULL) {
+        esp_gmf_oal_mutex_unlock(slab->lock);
+        return NULL;
+    }
+    esp_gmf_job_t *job = slab->free_list;
+    if (job) {
+        slab->free_list = job->next;
+        slab->in_use++;
+        if (slab->in_use > slab->high_water) {
+            slab->high_water = slab->in_use;
+        }
+    } else {
+        slab->overflow++;
+    }
+    esp_gmf_oal_mutex_unlock(slab->lock);
+    if (job) {
+        memset(job, 0, sizeof(esp_gmf_job_t));
+    } else {
+        ESP_LOGW(TAG, "Job slab exhausted, allocate from heap, [%s-%p], cap:%d", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, slab->capacity);
+        job = esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_t));
+        ESP_GMF_MEM_CHECK(TAG, job, return NULL);
+    }
+    job->label = interned->str;
+    job->timing = interned->timing;
+    esp_gmf_job_release(job, esp_gmf_oal_sys_get_time_us());
+    return job;
+}
+
+static void esp_gmf_task_job_free(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    esp_gmf_task_job_slab_t *slab = (esp_gmf_task_job_slab_t *)tsk->job_slab;
+    if ((job >= slab->jobs) && (job < slab->jobs + slab->capacity)) {
+        esp_gmf_oal_mutex_lock(slab->lock);
+        job->next = slab->free_list;
+        slab->free_list = job;
+        slab->in_use--;
+        esp_gmf_oal_mutex_unlock(slab->lock);
+    } else {
+        esp_gmf_oal_free(job);
+    }
+}
+
 static inline void __esp_gmf_task_delete_jobs(esp_gmf_task_handle_t handle)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
-    esp_gmf_node_clear((esp_gmf_node_t **)&tsk->working, esp_gmf_job_item_free);
+    esp_gmf_job_t *job = tsk->working;
+    tsk->working = NULL;
+    while (job) {
+        esp_gmf_job_t *next = job->next;
+        esp_gmf_task_job_free(tsk, job);
+        job = next;
+    }
+}
+
+static esp_gmf_job_err_t esp_gmf_task_retired_job(void *self, void *para)
+{
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static void esp_gmf_task_serve_call(esp_gmf_task_t *tsk, bool exiting)
+{
+    esp_gmf_oal_mutex_lock(tsk->call_lock);
+    if (tsk->call_func) {
+        ESP_LOGD(TAG, "Serve call, [tsk:%s-%p, func:%p, ctx:%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, tsk->call_func, tsk->call_ctx);
+        tsk->call_ret = tsk->call_func(tsk->call_ctx);
+        tsk->call_func = NULL;
+        xSemaphoreGive(tsk->call_sem);
+    }
+    // Cleared under the lock so that a new call either is served above or runs in the caller context
+    if (exiting) {
+        tsk->_running = 0;
+    }
+    esp_gmf_oal_mutex_unlock(tsk->call_lock);
+}
+
+static void esp_gmf_task_cancel_call(esp_gmf_task_t *tsk)
+{
+    esp_gmf_oal_mutex_lock(tsk->call_lock);
+    if (tsk->call_func) {
+        ESP_LOGW(TAG, "Drop the pending call, [tsk:%s-%p, func:%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, tsk->call_func);
+        tsk->call_func = NULL;
+        tsk->call_ret = ESP_GMF_ERR_INVALID_STATE;
+        xSemaphoreGive(tsk->call_sem);
+    }
+    esp_gmf_oal_mutex_unlock(tsk->call_lock);
+}
+
+static bool esp_gmf_task_in_context(esp_gmf_task_t *tsk)
+{
+    void *cur = xTaskGetCurrentTaskHandle();
+    if (cur == tsk->thread_handle) {
+        return true;
+    }
+    esp_gmf_task_executor_t *exec = (esp_gmf_task_executor_t *)tsk->executor;
+    for (int i = 1; exec && (i < exec->worker_num); i++) {
+        if (cur == exec->workers[i].handle) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void esp_gmf_task_job_timing_reset(esp_gmf_task_t *tsk)
+{
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_job_t *job = tsk->working;
+    while (job) {
+        esp_gmf_job_release(job, now);
+        job = job->next;
+    }
+}
+
+static void esp_gmf_task_job_overrun_notify(esp_gmf_task_t *tsk, esp_gmf_job_t *job, esp_gmf_job_overrun_type_t type, uint32_t exec_us, int64_t now)
+{
+    ESP_LOGD(TAG, "Job overrun %d, [tsk:%s-%p, job:%p-%s], exec:%ld us", type, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, job->ctx, job->label, (long)exec_us);
+    if (tsk->event_func == NULL) {
+        return;
+    }
+    esp_gmf_job_overrun_t info = {
+        .label = job->label,
+        .ctx = job->ctx,
+        .exec_us = exec_us,
+        .late_us = (int32_t)(now - job->deadline_at),
+    };
+    esp_gmf_event_pkt_t evt = {
+        .from = tsk,
+        .type = ESP_GMF_EVT_TYPE_JOB_OVERRUN,
+        .sub = type,
+        .payload = &info,
+        .payload_size = sizeof(info),
+    };
+    tsk->event_func(&evt, tsk->ctx);
+}
+
+static void esp_gmf_task_job_account(esp_gmf_task_t *tsk, esp_gmf_job_t *job, int64_t start_us)
+{
+    // The runs before the release are not accounted, they happen when the jobs are visited in round-robin
+    if (start_us < job->release_at) {
+        return;
+    }
+    esp_gmf_task_job_slab_t *slab = (esp_gmf_task_job_slab_t *)tsk->job_slab;
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    uint32_t exec_us = (uint32_t)(now - start_us);
+    if (job->timing.budget_us && (exec_us > job->timing.budget_us)) {
+        slab->over_cnt++;
+        esp_gmf_task_job_overrun_notify(tsk, job, ESP_GMF_JOB_OVERRUN_BUDGET, exec_us, now);
+    }
+    if ((job->timing.period_us || job->timing.deadline_us) && (now > job->deadline_at)) {
+        slab->miss_cnt++;
+        esp_gmf_task_job_overrun_notify(tsk, job, ESP_GMF_JOB_OVERRUN_DEADLINE, exec_us, now);
+    }
+    int64_t release_at = now;
+    if (job->timing.period_us) {
+        release_at = job->release_at + job->timing.period_us;
+        // Drop the whole periods already missed instead of catching up with them in a burst
+        if (release_at + job->timing.period_us <= now) {
+            release_at = now;
+        }
+    }
+    esp_gmf_job_release(job, release_at);
+}
+
+static esp_gmf_job_t *esp_gmf_task_pick_edf(esp_gmf_task_t *tsk)
+{
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_job_t *picked = NULL;
+    esp_gmf_job_t *job = tsk->working;
+    while (job) {
+        // Only the periodic jobs are released by time, the others keep running in round-robin
+        if (job->timing.period_us && (job->release_at <= now)
+            && ((picked == NULL) || (job->deadline_at < picked->deadline_at))) {
+            picked = job;
+        }
+        job = job->next;
+    }
+    return picked;
 }
 
 static inline int process_func(esp_gmf_task_handle_t handle, void *para)
@@ -154,10 +484,26 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
     }
     int result = ESP_GMF_ERR_OK;
     uint8_t is_stop = 0;
+    // The round-robin successor to resume after a job picked by deadline
+    esp_gmf_job_t *resume = NULL;
+    esp_gmf_task_job_timing_reset(tsk);
     while (worker && worker->func) {
+        if ((worker == tsk->working) && tsk->call_func) {
+            // About to start over the job list, the call may have inserted jobs in front
+            esp_gmf_task_serve_call(tsk, false);
+            worker = tsk->working;
+        }
         ESP_LOGD(TAG, "Running, job:%p, ctx:%p", worker->func, worker->ctx);
+        bool timed = esp_gmf_job_has_timing(worker);
+        int64_t start_us = timed ? esp_gmf_oal_sys_get_time_us() : 0;
         worker->ret = worker->func(worker->ctx, NULL);
         ESP_LOGV(TAG, "Job ret:%d, [tsk:%s-%p:%p-%p-%s]", worker->ret, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+        if (timed && ((worker->ret == ESP_GMF_JOB_ERR_OK) || (worker->ret == ESP_GMF_JOB_ERR_DONE))) {
+            esp_gmf_task_job_account(tsk, worker, start_us);
+        }
+        if (worker->ret != ESP_GMF_JOB_ERR_OK) {
+            resume = NULL;
+        }
         if (worker->ret == ESP_GMF_JOB_ERR_CONTINUE) {
             // The means need more loops
             worker = tsk->working;
@@ -166,7 +512,7 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
             ESP_LOGI(TAG, "Job is done, [tsk:%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
             esp_gmf_job_t *tmp = worker->next;
             esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)worker);
-            esp_gmf_job_item_free(worker);
+            esp_gmf_task_job_free(tsk, worker);
             worker = tmp;
             if (worker == NULL) {
                 ESP_LOGD(TAG, "All jobs are finished, [tsk:%s-%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
@@ -198,6 +544,8 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
         if (tsk->_pause) {
             ESP_LOGI(TAG, "Pause job, [%s-%p, wk:%p, job:%p-%s],st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
                      esp_gmf_event_get_state_str(tsk->state));
+            // A call posted before the pause would otherwise wait until resume, a paused task is as safe for it
+            esp_gmf_task_serve_call(tsk, false);
             if (tsk->state != ESP_GMF_EVENT_STATE_ERROR) {
                 esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_PAUSED);
                 xSemaphoreGive(tsk->api_sync_sem);
@@ -216,6 +564,7 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
             worker = tsk->working;
             tsk->_stop = 0;
             is_stop = 1;
+            resume = NULL;
             if (worker == NULL) {
                 ESP_LOGV(TAG, "No more jobs after stopped, [%s-%p, new job:%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker);
                 continue;
@@ -226,17 +575,25 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
 
         ESP_LOGD(TAG, "Find next job to process, [%s-%p, cur:%p-%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
 
-        esp_gmf_job_t *tmp = worker->next;
+        esp_gmf_job_t *tmp = resume ? resume : worker->next;
+        resume = NULL;
         if (worker->times == ESP_GMF_JOB_TIMES_ONCE) {
             ESP_LOGI(TAG, "One times job is complete, del[wk:%p,ctx:%p, label:%s]", worker, worker->ctx, worker->label);
             esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)worker);
-            esp_gmf_job_item_free(worker);
+            esp_gmf_task_job_free(tsk, worker);
             worker = NULL;
         }
         worker = tmp;
         if (tmp == NULL && tsk->working) {
             worker = tsk->working;
         }
+        if ((tsk->sched == ESP_GMF_TASK_SCHED_EDF) && worker) {
+            esp_gmf_job_t *edf = esp_gmf_task_pick_edf(tsk);
+            if (edf && (edf != worker)) {
+                resume = worker;
+                worker = edf;
+            }
+        }
         ESP_LOGD(TAG, "Found next job[%p] to process", worker);
     }
     ESP_LOGV(TAG, "Worker exit, [%p-%s], st:%s, stop:%s", tsk, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), esp_gmf_event_get_state_str(tsk->state), is_stop == 0 ? "NO" : "YES");
@@ -248,9 +605,281 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
     return result;
 }
 
+static esp_gmf_job_t *esp_gmf_task_deque_pop(esp_gmf_task_deque_t *dq, bool steal)
+{
+    esp_gmf_job_t *job = NULL;
+    esp_gmf_oal_mutex_lock(dq->lock);
+    if (dq->head < dq->tail) {
+        job = steal ? dq->items[dq->head++] : dq->items[--dq->tail];
+    }
+    esp_gmf_oal_mutex_unlock(dq->lock);
+    return job;
+}
+
+static void esp_gmf_task_exec_chain(esp_gmf_job_t *first, esp_gmf_job_t *last)
+{
+    esp_gmf_job_t *job = first;
+    while (job) {
+        if (job->dep_id == first->dep_id) {
+            job->ret = job->func(job->ctx, NULL);
+            // The rest of the chain depends on this job, so wait for the next round as the single thread mode does
+            if ((job->ret == ESP_GMF_JOB_ERR_CONTINUE) || (job->ret == ESP_GMF_JOB_ERR_FAIL)) {
+                break;
+            }
+        }
+        if (job == last) {
+            break;
+        }
+        job = job->next;
+    }
+}
+
+static void esp_gmf_task_exec_drain(esp_gmf_task_executor_t *exec, uint8_t id)
+{
+    while (1) {
+        esp_gmf_job_t *job = esp_gmf_task_deque_pop(&exec->workers[id].dq, false);
+        for (int i = 1; (job == NULL) && (i < exec->worker_num); i++) {
+            job = esp_gmf_task_deque_pop(&exec->workers[(id + i) % exec->worker_num].dq, true);
+        }
+        if (job == NULL) {
+            break;
+        }
+        esp_gmf_task_exec_chain(job, exec->last);
+        if (atomic_fetch_sub(&exec->remaining, 1) == 1) {
+            xSemaphoreGive(exec->done_sem);
+        }
+    }
+}
+
+static void esp_gmf_task_worker_fun(void *pv)
+{
+    esp_gmf_task_worker_t *worker = (esp_gmf_task_worker_t *)pv;
+    esp_gmf_task_executor_t *exec = worker->exec;
+    worker->handle = xTaskGetCurrentTaskHandle();
+    while (1) {
+        xSemaphoreTake(worker->start_sem, portMAX_DELAY);
+        if (exec->_exit) {
+            break;
+        }
+        esp_gmf_task_exec_drain(exec, worker->id);
+    }
+    // The worker may be freed once exit_sem is given, keep the thread handle on stack
+    esp_gmf_oal_thread_t thread = worker->thread;
+    xSemaphoreGive(exec->exit_sem);
+    esp_gmf_oal_thread_delete(thread);
+}
+
+static inline bool esp_gmf_task_is_chain_head(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    for (esp_gmf_job_t *prev = tsk->working; prev != job; prev = prev->next) {
+        if (prev->dep_id == job->dep_id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static esp_gmf_err_t esp_gmf_task_exec_round(esp_gmf_task_t *tsk, esp_gmf_job_t *last)
+{
+    esp_gmf_task_executor_t *exec = (esp_gmf_task_executor_t *)tsk->executor;
+    int chain_cnt = 0;
+    // Jobs registered after `last` are left to the next round
+    for (esp_gmf_job_t *job = tsk->working; job; job = (job == last) ? NULL : job->next) {
+        job->ret = ESP_GMF_JOB_ERR_CONTINUE;
+        if (esp_gmf_task_is_chain_head(tsk, job)) {
+            chain_cnt++;
+        }
+    }
+    int per_worker = (chain_cnt + exec->worker_num - 1) / exec->worker_num;
+    for (int i = 0; i < exec->worker_num; i++) {
+        esp_gmf_task_deque_t *dq = &exec->workers[i].dq;
+        esp_gmf_oal_mutex_lock(dq->lock);
+        dq->head = dq->tail = 0;
+        if (dq->cap < per_worker) {
+            esp_gmf_job_t **items = esp_gmf_oal_realloc(dq->items, per_worker * sizeof(esp_gmf_job_t *));
+            if (items == NULL) {
+                esp_gmf_oal_mutex_unlock(dq->lock);
+                ESP_LOGE(TAG, "No memory for executor queue, [%s-%p], chains:%d", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, chain_cnt);
+                return ESP_GMF_ERR_MEMORY_LACK;
+            }
+            dq->items = items;
+            dq->cap = per_worker;
+        }
+        esp_gmf_oal_mutex_unlock(dq->lock);
+    }
+    // Publish the round before any chain is visible, a helper may still be scanning the queues
+    exec->last = last;
+    atomic_store(&exec->remaining, chain_cnt);
+    int idx = 0;
+    for (esp_gmf_job_t *job = tsk->working; job; job = (job == last) ? NULL : job->next) {
+        if (esp_gmf_task_is_chain_head(tsk, job) == false) {
+            continue;
+        }
+        esp_gmf_task_deque_t *dq = &exec->workers[idx++ % exec->worker_num].dq;
+        esp_gmf_oal_mutex_lock(dq->lock);
+        dq->items[dq->tail++] = job;
+        esp_gmf_oal_mutex_unlock(dq->lock);
+    }
+    for (int i = 1; (i < chain_cnt) && (i < exec->worker_num); i++) {
+        xSemaphoreGive(exec->workers[i].start_sem);
+    }
+    esp_gmf_task_exec_drain(exec, 0);
+    xSemaphoreTake(exec->done_sem, portMAX_DELAY);
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t esp_gmf_task_executor_create(esp_gmf_task_t *tsk, uint8_t worker_num)
+{
+    esp_gmf_task_executor_t *exec = esp_gmf_oal_calloc(1, sizeof(esp_gmf_task_executor_t));
+    ESP_GMF_MEM_CHECK(TAG, exec, return ESP_GMF_ERR_MEMORY_LACK);
+    tsk->executor = exec;
+    exec->done_sem = xSemaphoreCreateBinary();
+    ESP_GMF_MEM_CHECK(TAG, exec->done_sem, return ESP_GMF_ERR_MEMORY_LACK);
+    exec->exit_sem = xSemaphoreCreateCounting(ESP_GMF_TASK_MAX_WORKER_NUM, 0);
+    ESP_GMF_MEM_CHECK(TAG, exec->exit_sem, return ESP_GMF_ERR_MEMORY_LACK);
+    char name[ESP_GMF_TAG_MAX_LEN] = {0};
+    for (int i = 0; i < worker_num; i++) {
+        esp_gmf_task_worker_t *worker = &exec->workers[i];
+        worker->exec = exec;
+        worker->id = i;
+        worker->dq.lock = esp_gmf_oal_mutex_create();
+        ESP_GMF_MEM_CHECK(TAG, worker->dq.lock, return ESP_GMF_ERR_MEMORY_LACK);
+        exec->worker_num++;
+        if (i == 0) {
+            continue;
+        }
+        worker->start_sem = xSemaphoreCreateBinary();
+        ESP_GMF_MEM_CHECK(TAG, worker->start_sem, return ESP_GMF_ERR_MEMORY_LACK);
+        snprintf(name, ESP_GMF_TAG_MAX_LEN, "%s_w%d", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), i);
+        int ret = esp_gmf_oal_thread_create(&worker->thread, name, esp_gmf_task_worker_fun, worker, tsk->thread.stack,
+                                            tsk->thread.prio, tsk->thread.stack_in_ext, (tsk->thread.core + i) % portNUM_PROCESSORS);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ESP_GMF_ERR_FAIL, "Create executor worker failed, [%s]", name);
+    }
+    ESP_LOGI(TAG, "Executor created, [%s-%p], workers:%d", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, exec->worker_num);
+    return ESP_GMF_ERR_OK;
+}
+
+static void esp_gmf_task_executor_destroy(esp_gmf_task_t *tsk)
+{
+    esp_gmf_task_executor_t *exec = (esp_gmf_task_executor_t *)tsk->executor;
+    if (exec == NULL) {
+        return;
+    }
+    exec->_exit = 1;
+    for (int i = 1; i < exec->worker_num; i++) {
+        if (exec->workers[i].thread) {
+            xSemaphoreGive(exec->workers[i].start_sem);
+            xSemaphoreTake(exec->exit_sem, portMAX_DELAY);
+        }
+    }
+    for (int i = 0; i < exec->worker_num; i++) {
+        esp_gmf_task_worker_t *worker = &exec->workers[i];
+        if (worker->start_sem) {
+            vSemaphoreDelete(worker->start_sem);
+        }
+        if (worker->dq.lock) {
+            esp_gmf_oal_mutex_destroy(worker->dq.lock);
+        }
+        esp_gmf_oal_free(worker->dq.items);
+    }
+    if (exec->done_sem) {
+        vSemaphoreDelete(exec->done_sem);
+    }
+    if (exec->exit_sem) {
+        vSemaphoreDelete(exec->exit_sem);
+    }
+    esp_gmf_oal_free(exec);
+    tsk->executor = NULL;
+}
+
+static inline int process_exec_func(esp_gmf_task_handle_t handle, void *para)
+{
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    if ((tsk->working == NULL) || (tsk->working->func == NULL)) {
+        ESP_LOGE(TAG, "Jobs list are invalid[%p, %p]", tsk, tsk->working);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    int result = ESP_GMF_ERR_OK;
+    uint8_t is_stop = 0;
+    while (tsk->working) {
+        esp_gmf_job_t *last = (esp_gmf_job_t *)esp_gmf_node_get_tail((esp_gmf_node_t *)tsk->working);
+        result = esp_gmf_task_exec_round(tsk, last);
+        if (result != ESP_GMF_ERR_OK) {
+            __esp_gmf_task_delete_jobs(tsk);
+            esp_gmf_task_event_loading_job(tsk, ESP_GMF_EVENT_STATE_ERROR);
+            is_stop = 1;
+            continue;
+        }
+        // Apply the results in registration order with the same rules as the single thread mode
+        uint8_t is_finished = 0;
+        esp_gmf_job_t *failed = NULL;
+        esp_gmf_job_t *worker = tsk->working;
+        while (worker) {
+            esp_gmf_job_t *tmp = (worker == last) ? NULL : worker->next;
+            if ((worker->ret == ESP_GMF_JOB_ERR_FAIL) && (tsk->state != ESP_GMF_EVENT_STATE_STOPPED)) {
+                failed = worker;
+                break;
+            }
+            if ((worker->ret == ESP_GMF_JOB_ERR_DONE)
+                || ((worker->ret != ESP_GMF_JOB_ERR_CONTINUE) && (worker->times == ESP_GMF_JOB_TIMES_ONCE))) {
+                ESP_LOGD(TAG, "Job is complete, del[wk:%p,ctx:%p, label:%s, ret:%d]", worker, worker->ctx, worker->label, worker->ret);
+                if ((worker->ret == ESP_GMF_JOB_ERR_DONE) && (worker->next == NULL)) {
+                    is_finished = 1;
+                }
+                esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)worker);
+                esp_gmf_task_job_free(tsk, worker);
+            }
+            worker = tmp;
+        }
+        if (failed) {
+            ESP_LOGE(TAG, "Job failed[tsk:%s-%p:%p-%p-%s], ret:%d, st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, failed, failed->ctx, failed->label, failed->ret,
+                     esp_gmf_event_get_state_str(tsk->state));
+            __esp_gmf_task_delete_jobs(tsk);
+            esp_gmf_task_event_loading_job(tsk, ESP_GMF_EVENT_STATE_ERROR);
+            is_stop = 1;
+            continue;
+        }
+        if (is_finished) {
+            ESP_LOGD(TAG, "All jobs are finished, [tsk:%s-%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
+            esp_gmf_task_event_loading_job(tsk, ESP_GMF_EVENT_STATE_FINISHED);
+        }
+        if (tsk->call_func) {
+            esp_gmf_task_serve_call(tsk, false);
+        }
+        if (tsk->_pause) {
+            ESP_LOGI(TAG, "Pause executor, [%s-%p], st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, esp_gmf_event_get_state_str(tsk->state));
+            if (tsk->state != ESP_GMF_EVENT_STATE_ERROR) {
+                esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_PAUSED);
+                xSemaphoreGive(tsk->api_sync_sem);
+
+                esp_gmf_task_acquire_singal(tsk, portMAX_DELAY);
+                ESP_LOGI(TAG, "Resume executor, [%s-%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
+                esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_RUNNING);
+            }
+            tsk->_pause = 0;
+            xSemaphoreGive(tsk->api_sync_sem);
+        }
+        if (tsk->_stop && (tsk->state != ESP_GMF_EVENT_STATE_ERROR)) {
+            ESP_LOGV(TAG, "Stop executor, [%s-%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
+            __esp_gmf_task_delete_jobs(tsk);
+            esp_gmf_task_event_loading_job(tsk, ESP_GMF_EVENT_STATE_STOPPED);
+            tsk->_stop = 0;
+            is_stop = 1;
+        }
+    }
+    ESP_LOGV(TAG, "Executor exit, [%p-%s], st:%s, stop:%s", tsk, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), esp_gmf_event_get_state_str(tsk->state), is_stop == 0 ? "NO" : "YES");
+    esp_gmf_event_state_notify(tsk, ESP_GMF_EVT_TYPE_CHANGE_STATE, tsk->state);
+    if (is_stop) {
+        is_stop = 0;
+        xSemaphoreGive(tsk->api_sync_sem);
+    }
+    return result;
+}
+
 static void esp_gmf_thread_fun(void *pv)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)pv;
+    tsk->thread_handle = xTaskGetCurrentTaskHandle();
     tsk->_destroy = 0;
     while (tsk->_task_run) {
         while ((tsk->working == NULL) || (tsk->_running == 0)) {
@@ -270,11 +899,16 @@ static void esp_gmf_thread_fun(void *pv)
             continue;
         }
         // Loop jobs until done or error
-        process_func(tsk, tsk->ctx);
-        tsk->_running = 0;
+        if (tsk->executor) {
+            process_exec_func(tsk, tsk->ctx);
+        } else {
+            process_func(tsk, tsk->ctx);
+        }
+        esp_gmf_task_serve_call(tsk, true);
     }
 ESP_GMF_THREAD_EXIT:
     tsk->state = ESP_GMF_EVENT_STATE_NONE;
+    tsk->thread_handle = NULL;
     xSemaphoreGive(tsk->api_sync_sem);
     ESP_LOGD(TAG, "Thread destroyed! [%s,%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
     esp_gmf_oal_thread_delete(tsk->oal_thread);
@@ -294,10 +928,19 @@ esp_gmf_err_t esp_gmf_task_init(void *config, esp_gmf_task_handle_t *tsk_hd)
     ESP_GMF_MEM_CHECK(TAG, handle->wait_sem, goto _el_init_failed);
     handle->api_sync_sem = xSemaphoreCreateBinary();
     ESP_GMF_MEM_CHECK(TAG, handle->api_sync_sem, goto _el_init_failed);
+    handle->call_serial = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, handle->call_serial, goto _el_init_failed);
+    handle->call_lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, handle->call_lock, goto _el_init_failed);
+    handle->call_sem = xSemaphoreCreateBinary();
+    ESP_GMF_MEM_CHECK(TAG, handle->call_sem, goto _el_init_failed);
     esp_gmf_task_cfg_t *cfg = (esp_gmf_task_cfg_t *)config;
     handle->event_func = cfg->cb;
     handle->ctx = cfg->ctx;
+    handle->sched = cfg->sched;
     handle->api_sync_time = DEFAULT_TASK_OPT_MAX_TIME_MS;
+    int ret = esp_gmf_task_job_slab_create(handle, cfg->job_num > 0 ? cfg->job_num : DEFAULT_ESP_GMF_TASK_JOB_NUM);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _el_init_failed, "Failed to create job slab");
 
     char tag[ESP_GMF_TAG_MAX_LEN] = {0};
     if (cfg->name) {
@@ -307,7 +950,7 @@ esp_gmf_err_t esp_gmf_task_init(void *config, esp_gmf_task_handle_t *tsk_hd)
     }
 
     esp_gmf_obj_t *obj = (esp_gmf_obj_t *)handle;
-    int ret = esp_gmf_obj_set_config(obj, cfg, sizeof(*cfg));
+    ret = esp_gmf_obj_set_config(obj, cfg, sizeof(*cfg));
     ESP_GMF_RET_ON_ERROR(TAG, ret, goto _el_init_failed, "Failed set OBJ configuration");
     ret = esp_gmf_obj_set_tag(obj, tag);
     ESP_GMF_RET_ON_ERROR(TAG, ret, goto _el_init_failed, "Failed set OBJ tag");
@@ -328,6 +971,15 @@ esp_gmf_err_t esp_gmf_task_init(void *config, esp_gmf_task_handle_t *tsk_hd)
     } else {
         handle->thread.core = DEFAULT_ESP_GMF_TASK_CORE;
     }
+    handle->thread.worker_num = cfg->thread.worker_num;
+    if ((handle->thread.stack > 0) && (handle->thread.worker_num > 1)) {
+        if (handle->thread.worker_num > ESP_GMF_TASK_MAX_WORKER_NUM) {
+            ESP_LOGW(TAG, "Worker number %d exceeds the limit, use %d", handle->thread.worker_num, ESP_GMF_TASK_MAX_WORKER_NUM);
+            handle->thread.worker_num = ESP_GMF_TASK_MAX_WORKER_NUM;
+        }
+        ret = esp_gmf_task_executor_create(handle, handle->thread.worker_num);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, goto _el_init_failed, "Failed to create executor, [%s]", OBJ_GET_TAG(obj));
+    }
     handle->_task_run = true;
     if (handle->thread.stack > 0) {
         ret = esp_gmf_oal_thread_create(&handle->oal_thread, OBJ_GET_TAG(obj), esp_gmf_thread_fun, handle, handle->thread.stack,
@@ -373,29 +1025,130 @@ esp_gmf_err_t esp_gmf_task_deinit(esp_gmf_task_handle_t handle)
 }
 
 esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, esp_gmf_job_times_t times, void *ctx, bool done)
+{
+    return esp_gmf_task_register_ready_job_with_dep(handle, label, job, times, ctx, 0, done);
+}
+
+esp_gmf_err_t esp_gmf_task_register_ready_job_with_dep(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job,
+                                                       esp_gmf_job_times_t times, void *ctx, uint16_t dep_id, bool done)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
     esp_gmf_job_t *new_job = NULL;
-    new_job = esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_t));
+    new_job = esp_gmf_task_job_alloc(tsk, label);
     ESP_GMF_MEM_CHECK(TAG, new_job, return ESP_GMF_ERR_MEMORY_LACK;);
-    new_job->label = esp_gmf_oal_strdup(label == NULL ? "NULL" : label);
-    ESP_GMF_MEM_CHECK(TAG, new_job->label, { esp_gmf_oal_free(new_job); return ESP_GMF_ERR_MEMORY_LACK;});
     new_job->func = job;
     new_job->ctx = ctx;
     new_job->times = times;
+    new_job->dep_id = dep_id;
     if (tsk->working == NULL) {
         tsk->working = new_job;
     } else {
         esp_gmf_node_add_last((esp_gmf_node_t *)tsk->working, (esp_gmf_node_t *)new_job);
     }
-    ESP_LOGD(TAG, "Reg new job to task:%p, item:%p, label:%s, func:%p, ctx:%p cnt:%d", tsk, new_job, new_job->label, job, ctx, get_jobs_num(tsk->working));
+    ESP_LOGD(TAG, "Reg new job to task:%p, item:%p, label:%s, func:%p, ctx:%p, dep:%d, cnt:%d", tsk, new_job, new_job->label, job, ctx, dep_id, get_jobs_num(tsk->working));
     if (done) {
         xSemaphoreGive(tsk->block_sem);
     }
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_task_insert_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job,
+                                            esp_gmf_job_times_t times, void *ctx, void *before_ctx, bool done)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_job_t *pos = tsk->working;
+    while (pos && ((before_ctx == NULL) || (pos->ctx != before_ctx) || (pos->func == esp_gmf_task_retired_job))) {
+        pos = pos->next;
+    }
+    if (pos == NULL) {
+        return esp_gmf_task_register_ready_job(handle, label, job, times, ctx, done);
+    }
+    esp_gmf_job_t *new_job = esp_gmf_task_job_alloc(tsk, label);
+    ESP_GMF_MEM_CHECK(TAG, new_job, return ESP_GMF_ERR_MEMORY_LACK;);
+    new_job->func = job;
+    new_job->ctx = ctx;
+    new_job->times = times;
+    new_job->dep_id = pos->dep_id;
+    if (pos == tsk->working) {
+        new_job->next = pos;
+        pos->prev = new_job;
+        tsk->working = new_job;
+    } else {
+        esp_gmf_node_insert_after((esp_gmf_node_t *)pos->prev, (esp_gmf_node_t *)new_job);
+    }
+    ESP_LOGD(TAG, "Insert new job to task:%p, item:%p, label:%s, func:%p, ctx:%p, before:%p, cnt:%d", tsk, new_job, new_job->label, job, ctx,
+             before_ctx, get_jobs_num(tsk->working));
+    if (done) {
+        xSemaphoreGive(tsk->block_sem);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_retire_jobs(esp_gmf_task_handle_t handle, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_job_t *job = tsk->working;
+    while (job) {
+        if (job->ctx == ctx) {
+            ESP_LOGD(TAG, "Retire job, [tsk:%s-%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, ctx, job->label);
+            job->func = esp_gmf_task_retired_job;
+            job->ctx = NULL;
+            job->times = ESP_GMF_JOB_TIMES_ONCE;
+            memset(&job->timing, 0, sizeof(job->timing));
+        }
+        job = job->next;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_call(esp_gmf_task_handle_t handle, esp_gmf_task_call_func func, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, func, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    // A job or an event callback of the task is already between frames from the task point of view
+    if (esp_gmf_task_in_context(tsk)) {
+        return func(ctx);
+    }
+    int ret = ESP_GMF_ERR_OK;
+    esp_gmf_oal_mutex_lock(tsk->call_serial);
+    // Hold the task lock so that the task is neither started, paused, resumed nor stopped meanwhile
+    esp_gmf_oal_mutex_lock(tsk->lock);
+    esp_gmf_oal_mutex_lock(tsk->call_lock);
+    if ((tsk->_running == 0) || (tsk->state == ESP_GMF_EVENT_STATE_PAUSED)) {
+        ret = func(ctx);
+        esp_gmf_oal_mutex_unlock(tsk->call_lock);
+        esp_gmf_oal_mutex_unlock(tsk->lock);
+        esp_gmf_oal_mutex_unlock(tsk->call_serial);
+        return ret;
+    }
+    tsk->call_func = func;
+    tsk->call_ctx = ctx;
+    esp_gmf_oal_mutex_unlock(tsk->call_lock);
+    // Wait without the task lock, so that stop can drop the call when a job is stuck in IO
+    esp_gmf_oal_mutex_unlock(tsk->lock);
+    if (xSemaphoreTake(tsk->call_sem, tsk->api_sync_time) != pdPASS) {
+        esp_gmf_oal_mutex_lock(tsk->call_lock);
+        if (tsk->call_func) {
+            tsk->call_func = NULL;
+            ret = ESP_GMF_ERR_TIMEOUT;
+            ESP_LOGE(TAG, "Call timeout, [tsk:%s-%p, func:%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, func);
+        } else {
+            // Served or dropped right after the timeout, the semaphore is given already
+            xSemaphoreTake(tsk->call_sem, 0);
+            ret = tsk->call_ret;
+        }
+        esp_gmf_oal_mutex_unlock(tsk->call_lock);
+    } else {
+        ret = tsk->call_ret;
+    }
+    esp_gmf_oal_mutex_unlock(tsk->call_serial);
+    return ret;
+}
+
 esp_gmf_err_t esp_gmf_task_set_event_func(esp_gmf_task_handle_t handle, esp_gmf_event_cb cb, void *ctx)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -457,6 +1210,7 @@ esp_gmf_err_t esp_gmf_task_stop(esp_gmf_task_handle_t handle)
         return ESP_GMF_ERR_NOT_SUPPORT;
     }
     tsk->_stop = 1;
+    esp_gmf_task_cancel_call(tsk);
     if (tsk->state == ESP_GMF_EVENT_STATE_PAUSED) {
         esp_gmf_task_release_singal(tsk, portMAX_DELAY);
     }
@@ -548,3 +1302,66 @@ esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event
     }
     return ESP_GMF_ERR_INVALID_ARG;
 }
+
+static esp_gmf_err_t esp_gmf_task_apply_job_timing(void *ctx)
+{
+    esp_gmf_task_timing_update_t *update = (esp_gmf_task_timing_update_t *)ctx;
+    // The labels are interned, so the registered jobs are matched by address
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_job_t *job = update->tsk->working;
+    while (job) {
+        if (job->label == update->label) {
+            job->timing = update->timing;
+            esp_gmf_job_release(job, now);
+        }
+        job = job->next;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_set_job_timing(esp_gmf_task_handle_t handle, const char *label, const esp_gmf_job_timing_t *timing)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, label, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_task_job_slab_t *slab = (esp_gmf_task_job_slab_t *)tsk->job_slab;
+    esp_gmf_oal_mutex_lock(slab->lock);
+    esp_gmf_task_label_t *item = esp_gmf_task_intern_label(slab, label);
+    if (item == NULL) {
+        esp_gmf_oal_mutex_unlock(slab->lock);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    if (timing) {
+        item->timing = *timing;
+    } else {
+        memset(&item->timing, 0, sizeof(esp_gmf_job_timing_t));
+    }
+    esp_gmf_task_timing_update_t update = {
+        .tsk = tsk,
+        .label = item->str,
+        .timing = item->timing,
+    };
+    esp_gmf_oal_mutex_unlock(slab->lock);
+    ESP_LOGD(TAG, "Set job timing, [%s-%p, label:%s, period:%ld, deadline:%ld, budget:%ld]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, label,
+             (long)update.timing.period_us, (long)update.timing.deadline_us, (long)update.timing.budget_us);
+    // The task thread unlinks and frees the jobs without a lock, so walk them in the task context
+    return esp_gmf_task_call(tsk, esp_gmf_task_apply_job_timing, &update);
+}
+
+esp_gmf_err_t esp_gmf_task_get_job_stats(esp_gmf_task_handle_t handle, esp_gmf_task_job_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_task_job_slab_t *slab = (esp_gmf_task_job_slab_t *)tsk->job_slab;
+    esp_gmf_oal_mutex_lock(slab->lock);
+    stats->capacity = slab->capacity;
+    stats->in_use = slab->in_use;
+    stats->high_water = slab->high_water;
+    stats->label_num = slab->label_num;
+    stats->overflow = slab->overflow;
+    stats->miss_cnt = slab->miss_cnt;
+    stats->over_cnt = slab->over_cnt;
+    esp_gmf_oal_mutex_unlock(slab->lock);
+    return ESP_GMF_ERR_OK;
+}
@@ -0,0 +1,333 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_task.h"
+#include "esp_gmf_port.h"
+#include "esp_gmf_clock.h"
+
+#define CLOCK_FRAME_MS     (20)
+#define CLOCK_FRAME_SIZE   (CLOCK_FRAME_MS * 16 * sizeof(int16_t))  // 16 kHz mono
+#define CLOCK_RUN_MS       (10 * 60 * 1000)
+#define CLOCK_FRAMES       (CLOCK_RUN_MS / CLOCK_FRAME_MS)
+#define CLOCK_WINDOW_MS    (40)
+#define CLOCK_MASTER       (0)
+#define CLOCK_SLAVE        (1)
+#define CLOCK_FINISHED_BIT(id)  BIT(id)
+
+static const char *TAG = "TEST_ESP_GMF_CLOCK";
+
+/**
+ * Simulated time, each sink is a device that takes a fixed time to play a frame. The clock reads the time of the
+ * master device, and the two devices run in lock step so that ten minutes of media take seconds
+ */
+typedef struct {
+    SemaphoreHandle_t  wake[2];
+    volatile int64_t   dev_us[2];
+    volatile bool      done[2];
+} clock_vtime_t;
+
+typedef struct {
+    clock_vtime_t      *vt;
+    int                 id;
+    uint32_t            frame_us;
+    uint32_t            produced;
+    uint32_t            consumed;
+    EventGroupHandle_t  evt;
+} clock_stream_t;
+
+typedef struct {
+    const char  *name;
+    uint32_t     slave_frame_us;
+    bool         continuous;
+} clock_case_t;
+
+static void clock_vt_advance(clock_vtime_t *vt, int id, int64_t us)
+{
+    int other = !id;
+    vt->dev_us[id] += us;
+    xSemaphoreGive(vt->wake[other]);
+    // A device runs at most one frame ahead of the other one
+    while (!vt->done[other] && (vt->dev_us[id] > vt->dev_us[other] + CLOCK_FRAME_MS * 1000)) {
+        xSemaphoreTake(vt->wake[id], pdMS_TO_TICKS(10));
+    }
+}
+
+static int64_t clock_vt_now(void *ctx)
+{
+    clock_vtime_t *vt = (clock_vtime_t *)ctx;
+    return (vt->done[CLOCK_MASTER] ? vt->dev_us[CLOCK_SLAVE] : vt->dev_us[CLOCK_MASTER]) / 1000;
+}
+
+static void clock_vt_sleep(void *ctx, int64_t ms)
+{
+    // Only the slave is ever held, the time goes by on its device
+    clock_vt_advance((clock_vtime_t *)ctx, CLOCK_SLAVE, ms * 1000);
+}
+
+static esp_gmf_job_err_t clock_copy_open(void *self, void *para)
+{
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t clock_copy_process(void *self, void *para)
+{
+    esp_gmf_port_t *in_port = ESP_GMF_ELEMENT_GET(self)->in;
+    esp_gmf_port_t *out_port = ESP_GMF_ELEMENT_GET(self)->out;
+    esp_gmf_payload_t *in_load = NULL;
+    esp_gmf_payload_t *out_load = NULL;
+    int ret = esp_gmf_port_acquire_in(in_port, &in_load, CLOCK_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+    if (ret < 0) {
+        return ESP_GMF_JOB_ERR_FAIL;
+    }
+    ret = esp_gmf_port_acquire_out(out_port, &out_load, CLOCK_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+    if (ret < 0) {
+        esp_gmf_port_release_in(in_port, in_load, ESP_GMF_MAX_DELAY);
+        return ESP_GMF_JOB_ERR_FAIL;
+    }
+    if (out_load != in_load) {
+        memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+    }
+    out_load->valid_size = in_load->valid_size;
+    out_load->is_done = in_load->is_done;
+    out_load->pts = in_load->pts;
+    bool is_done = in_load->is_done;
+    esp_gmf_port_release_out(out_port, out_load, ESP_GMF_MAX_DELAY);
+    esp_gmf_port_release_in(in_port, in_load, ESP_GMF_MAX_DELAY);
+    return is_done ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t clock_copy_close(void *self, void *para)
+{
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_err_t clock_copy_delete(esp_gmf_obj_handle_t obj)
+{
+    esp_gmf_element_deinit(obj);
+    esp_gmf_oal_free(obj);
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_element_handle_t clock_copy_new(const char *tag)
+{
+    esp_gmf_element_t *copy = esp_gmf_oal_calloc(1, sizeof(esp_gmf_element_t));
+    TEST_ASSERT_NOT_NULL(copy);
+    esp_gmf_obj_set_tag((esp_gmf_obj_handle_t)copy, tag);
+    copy->base.del_obj = clock_copy_delete;
+    esp_gmf_element_cfg_t el_cfg = {
+        .in_attr.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE,
+        .out_attr.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE,
+        .in_attr.size = CLOCK_FRAME_SIZE,
+        .out_attr.size = CLOCK_FRAME_SIZE,
+    };
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_init(copy, &el_cfg));
+    copy->ops.open = clock_copy_open;
+    copy->ops.process = clock_copy_process;
+    copy->ops.close = clock_copy_close;
+    return copy;
+}
+
+static esp_gmf_err_io_t clock_src_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    clock_stream_t *st = (clock_stream_t *)handle;
+    memset(load->buf, 0, wanted_size);
+    load->pts = (uint64_t)st->produced * CLOCK_FRAME_MS;
+    load->valid_size = wanted_size;
+    st->produced++;
+    load->is_done = (st->produced >= CLOCK_FRAMES);
+    return load->valid_size;
+}
+
+static esp_gmf_err_io_t clock_src_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t clock_sink_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    return wanted_size;
+}
+
+static esp_gmf_err_io_t clock_sink_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    clock_stream_t *st = (clock_stream_t *)handle;
+    if (load->valid_size) {
+        st->consumed++;
+        clock_vt_advance(st->vt, st->id, st->frame_us);
+    }
+    if (load->is_done) {
+        st->vt->done[st->id] = true;
+        xSemaphoreGive(st->vt->wake[!st->id]);
+    }
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_t clock_pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
+{
+    clock_stream_t *st = (clock_stream_t *)ctx;
+    if ((event->type == ESP_GMF_EVT_TYPE_CHANGE_STATE)
+        && ((event->sub == ESP_GMF_EVENT_STATE_FINISHED)
+            || (event->sub == ESP_GMF_EVENT_STATE_STOPPED)
+            || (event->sub == ESP_GMF_EVENT_STATE_ERROR))) {
+        xEventGroupSetBits(st->evt, CLOCK_FINISHED_BIT(st->id));
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static void clock_pipeline_new(clock_stream_t *st, esp_gmf_pipeline_handle_t *pipe, esp_gmf_task_handle_t *task)
+{
+    esp_gmf_element_handle_t copy = clock_copy_new(st->id == CLOCK_MASTER ? "copy_m" : "copy_s");
+    esp_gmf_element_register_in_port(copy, NEW_ESP_GMF_PORT_IN_BYTE(clock_src_acquire, clock_src_release, NULL, st,
+                                                                     CLOCK_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_out_port(copy, NEW_ESP_GMF_PORT_OUT_BYTE(clock_sink_acquire, clock_sink_release, NULL, st,
+                                                                       CLOCK_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_create(pipe));
+    esp_gmf_pipeline_register_el(*pipe, copy);
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_init(&cfg, task);
+    TEST_ASSERT_NOT_NULL(*task);
+    esp_gmf_pipeline_bind_task(*pipe, *task);
+    esp_gmf_pipeline_set_event(*pipe, clock_pipeline_event, st);
+}
+
+static void clock_run_case(const clock_case_t *test_case, esp_gmf_clock_report_t *master_rpt, esp_gmf_clock_report_t *slave_rpt)
+{
+    clock_vtime_t vt = {0};
+    vt.wake[CLOCK_MASTER] = xSemaphoreCreateBinary();
+    vt.wake[CLOCK_SLAVE] = xSemaphoreCreateBinary();
+    EventGroupHandle_t evt = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(evt);
+    clock_stream_t streams[2] = {
+        {.vt = &vt, .id = CLOCK_MASTER, .frame_us = CLOCK_FRAME_MS * 1000, .evt = evt},
+        {.vt = &vt, .id = CLOCK_SLAVE, .frame_us = test_case->slave_frame_us, .evt = evt},
+    };
+    esp_gmf_clock_cfg_t clock_cfg = DEFAULT_ESP_GMF_CLOCK_CONFIG();
+    clock_cfg.master = ESP_GMF_CLOCK_MASTER_PIPELINE;
+    clock_cfg.sync_window_ms = CLOCK_WINDOW_MS;
+    clock_cfg.time_ops.now_ms = clock_vt_now;
+    clock_cfg.time_ops.sleep_ms = clock_vt_sleep;
+    clock_cfg.time_ops.ctx = &vt;
+    esp_gmf_clock_handle_t clock = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_clock_create(&clock_cfg, &clock));
+
+    esp_gmf_pipeline_handle_t pipes[2] = {NULL};
+    esp_gmf_task_handle_t tasks[2] = {NULL};
+    esp_gmf_clock_sync_cfg_t sync_cfg = {.role = ESP_GMF_CLOCK_ROLE_MASTER};
+    for (int i = 0; i < 2; i++) {
+        clock_pipeline_new(&streams[i], &pipes[i], &tasks[i]);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_clock(pipes[i], clock, &sync_cfg));
+        // The second pipeline follows the first one
+        sync_cfg.role = ESP_GMF_CLOCK_ROLE_SLAVE;
+        sync_cfg.continuous = test_case->continuous;
+    }
+    // The clock takes a single master
+    sync_cfg.role = ESP_GMF_CLOCK_ROLE_MASTER;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_pipeline_set_clock(pipes[CLOCK_SLAVE], clock, &sync_cfg));
+    int64_t media_time = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_READY, esp_gmf_clock_get_time(clock, &media_time));
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipes[i]));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipes[i]));
+    }
+    EventBits_t bits = xEventGroupWaitBits(evt, CLOCK_FINISHED_BIT(CLOCK_MASTER) | CLOCK_FINISHED_BIT(CLOCK_SLAVE),
+                                           pdTRUE, pdTRUE, pdMS_TO_TICKS(120000));
+    TEST_ASSERT_EQUAL(CLOCK_FINISHED_BIT(CLOCK_MASTER) | CLOCK_FINISHED_BIT(CLOCK_SLAVE), bits);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_clock_get_time(clock, &media_time));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_clock_report(pipes[CLOCK_MASTER], master_rpt));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_clock_report(pipes[CLOCK_SLAVE], slave_rpt));
+    ESP_LOGW(TAG, "%s, time:%lld ms, slave consumed:%ld, drift:%ld, max drift:%ld, max latency:%ld, "
+             "passed:%ld, waited:%ld, dropped:%ld, repeated:%ld", test_case->name, media_time, (long)streams[CLOCK_SLAVE].consumed,
+             (long)slave_rpt->drift_ms, (long)slave_rpt->max_drift_ms, (long)slave_rpt->max_latency_ms, (long)slave_rpt->passed,
+             (long)slave_rpt->waited, (long)slave_rpt->dropped, (long)slave_rpt->repeated);
+    // All the frames reach the master sink, the slave sink gets the ones not dropped plus the repeated ones
+    TEST_ASSERT_EQUAL(CLOCK_FRAMES, streams[CLOCK_MASTER].consumed);
+    TEST_ASSERT_EQUAL(CLOCK_FRAMES, streams[CLOCK_MASTER].produced);
+    TEST_ASSERT_EQUAL(CLOCK_FRAMES, streams[CLOCK_SLAVE].produced);
+    TEST_ASSERT_EQUAL(CLOCK_FRAMES - slave_rpt->dropped + slave_rpt->repeated, streams[CLOCK_SLAVE].consumed);
+    TEST_ASSERT_EQUAL(CLOCK_FRAMES, slave_rpt->passed + slave_rpt->waited + slave_rpt->dropped + slave_rpt->repeated);
+
+    // The slave detaches by hand, the master when its pipeline is destroyed
+    esp_gmf_clock_report_t report = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_clock(pipes[CLOCK_SLAVE], NULL, NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_get_clock_report(pipes[CLOCK_SLAVE], &report));
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(tasks[i]));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipes[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_clock_destroy(clock));
+    vEventGroupDelete(evt);
+    vSemaphoreDelete(vt.wake[CLOCK_MASTER]);
+    vSemaphoreDelete(vt.wake[CLOCK_SLAVE]);
+}
+
+TEST_CASE("Clock, two pipelines on mismatched rates stay in sync for ten minutes", "ESP_GMF_CLOCK")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    // The slave device is 1% slower or faster than the master one, free running it would drift by 6 seconds
+    const clock_case_t cases[] = {
+        {"Slow continuous slave", CLOCK_FRAME_MS * 1010, true},
+        {"Fast continuous slave", CLOCK_FRAME_MS * 990, true},
+        {"Fast held slave", CLOCK_FRAME_MS * 990, false},
+    };
+    for (int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        esp_gmf_clock_report_t master_rpt = {0};
+        esp_gmf_clock_report_t slave_rpt = {0};
+        clock_run_case(&cases[i], &master_rpt, &slave_rpt);
+        // The master drives the clock and is never corrected
+        TEST_ASSERT_EQUAL(CLOCK_FRAMES, master_rpt.passed);
+        TEST_ASSERT_EQUAL(0, master_rpt.dropped + master_rpt.repeated + master_rpt.waited);
+        TEST_ASSERT_EQUAL(0, master_rpt.max_drift_ms);
+        // The drift stays within the window, give or take the frame the devices may be apart
+        TEST_ASSERT_LESS_OR_EQUAL(CLOCK_WINDOW_MS + 2 * CLOCK_FRAME_MS, abs(slave_rpt.max_drift_ms));
+        TEST_ASSERT_LESS_OR_EQUAL(CLOCK_WINDOW_MS + 2 * CLOCK_FRAME_MS, abs(slave_rpt.max_latency_ms));
+        if (cases[i].slave_frame_us > CLOCK_FRAME_MS * 1000) {
+            TEST_ASSERT_GREATER_THAN(0, slave_rpt.dropped);
+            TEST_ASSERT_EQUAL(0, slave_rpt.repeated + slave_rpt.waited);
+        } else if (cases[i].continuous) {
+            // A repeat may overshoot by the frame the devices are apart, so a few drops are fine
+            TEST_ASSERT_GREATER_THAN(0, slave_rpt.repeated);
+            TEST_ASSERT_LESS_THAN(slave_rpt.repeated, slave_rpt.dropped);
+            TEST_ASSERT_EQUAL(0, slave_rpt.waited);
+        } else {
+            TEST_ASSERT_GREATER_THAN(0, slave_rpt.waited);
+            TEST_ASSERT_LESS_THAN(slave_rpt.waited, slave_rpt.dropped);
+            TEST_ASSERT_EQUAL(0, slave_rpt.repeated);
+        }
+    }
+    ESP_GMF_MEM_SHOW(TAG);
+}
@@ -27,6 +27,7 @@
 #include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_port.h"
 #include "esp_gmf_data_bus.h"
 #include "esp_gmf_new_databus.h"
@@ -131,3 +132,71 @@ TEST_CASE("Register and unregister port for GMF ELEMENT", "ESP_GMF_ELEMENT")
 
     ESP_GMF_MEM_SHOW(TAG);
 }
+
+#define STATS_BENCH_LOOP_NUM  (2000)
+#define STATS_BENCH_WORK_SIZE (1024)
+
+static esp_gmf_job_err_t stats_bench_process(void *self, void *para)
+{
+    // Roughly the cost of processing one small audio frame
+    static volatile int32_t frame[STATS_BENCH_WORK_SIZE];
+    for (int r = 0; r < 8; r++) {
+        for (int i = 0; i < STATS_BENCH_WORK_SIZE; i++) {
+            frame[i] = (frame[i] * 3 + i + r) >> 1;
+        }
+    }
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+TEST_CASE("Element statistics overhead", "ESP_GMF_ELEMENT")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    esp_gmf_element_t *el = esp_gmf_oal_calloc(1, sizeof(esp_gmf_element_t));
+    TEST_ASSERT_NOT_NULL(el);
+    esp_gmf_element_cfg_t el_cfg = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_init(el, &el_cfg));
+    el->ops.process = stats_bench_process;
+
+    // Warm up the cache before measuring
+    for (int i = 0; i < 10; i++) {
+        el->ops.process(el, NULL);
+    }
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    for (int i = 0; i < STATS_BENCH_LOOP_NUM; i++) {
+        el->ops.process(el, NULL);
+    }
+    int64_t raw_us = esp_gmf_oal_sys_get_time_us() - start;
+    esp_gmf_element_reset_stats(el);
+    start = esp_gmf_oal_sys_get_time_us();
+    for (int i = 0; i < STATS_BENCH_LOOP_NUM; i++) {
+        esp_gmf_element_process_running(el, NULL);
+    }
+    int64_t stats_us = esp_gmf_oal_sys_get_time_us() - start;
+
+    esp_gmf_element_stats_t stats = {0};
+    esp_gmf_err_t ret = esp_gmf_element_get_stats(el, &stats);
+#if ESP_GMF_ELEMENT_STATS_ENABLE
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, ret);
+    TEST_ASSERT_EQUAL(STATS_BENCH_LOOP_NUM, stats.call_cnt);
+    uint32_t hist_cnt = 0;
+    for (int i = 0; i < ESP_GMF_ELEMENT_STATS_BUCKET_NUM; i++) {
+        hist_cnt += stats.hist[i];
+    }
+    TEST_ASSERT_EQUAL(STATS_BENCH_LOOP_NUM, hist_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.p99_us, stats.p50_us);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.max_us, stats.p99_us);
+#else
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, ret);
+#endif  /* ESP_GMF_ELEMENT_STATS_ENABLE */
+    // In units of 0.01%, the noise may make it negative
+    int overhead = (int)((stats_us - raw_us) * 10000 / raw_us);
+    overhead = overhead < 0 ? 0 : overhead;
+    ESP_LOGW(TAG, "Process %d calls, raw:%lld us, with stats:%lld us, overhead:%d.%02d%%, p50:%ld us, p99:%ld us, max:%ld us",
+             STATS_BENCH_LOOP_NUM, raw_us, stats_us, overhead / 100, overhead % 100, (long)stats.p50_us, (long)stats.p99_us, (long)stats.max_us);
+    TEST_ASSERT_LESS_THAN(100, overhead);
+
+    esp_gmf_element_deinit(el);
+    esp_gmf_oal_free(el);
+    ESP_GMF_MEM_SHOW(TAG);
+}
@@ -30,6 +30,7 @@
 #include "esp_log.h"
 
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_fifo.h"
 #include "gmf_ut_common.h"
 
@@ -157,3 +158,43 @@ TEST_CASE("FIFO read and write on different task", "ESP_GMF_FIFO")
     esp_gmf_ut_teardown_sdmmc(card);
     vTaskDelay(10 / portTICK_PERIOD_MS);
 }
+
+TEST_CASE("FIFO per-operation cost over depth", "ESP_GMF_FIFO")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    const int depths[] = {4, 16, 64, 256, 1024};
+    const int loops = 10000;
+    int64_t cost_ns[sizeof(depths) / sizeof(depths[0])] = {0};
+    esp_gmf_data_bus_block_t blk = {0};
+    for (int i = 0; i < sizeof(depths) / sizeof(depths[0]); i++) {
+        esp_gmf_fifo_handle_t fifo = NULL;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_create(depths[i], 64, &fifo));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_prealloc(fifo));
+        uint32_t size = 0;
+        esp_gmf_fifo_get_total_size(fifo, &size);
+        TEST_ASSERT_EQUAL(depths[i] * 64, size);
+        // Keep the FIFO full, so both lists are walked at their longest if any operation is linear
+        for (int j = 0; j < depths[i] - 1; j++) {
+            TEST_ASSERT_EQUAL(64, esp_gmf_fifo_acquire_write(fifo, &blk, 64, 0));
+            blk.valid_size = 64;
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+        }
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        for (int j = 0; j < loops; j++) {
+            esp_gmf_fifo_acquire_write(fifo, &blk, 64, 0);
+            blk.valid_size = 64;
+            esp_gmf_fifo_release_write(fifo, &blk, 0);
+            esp_gmf_fifo_acquire_read(fifo, &blk, 64, 0);
+            esp_gmf_fifo_release_read(fifo, &blk, 0);
+        }
+        cost_ns[i] = (esp_gmf_oal_sys_get_time_us() - start) * 1000 / (loops * 4);
+        esp_gmf_fifo_get_filled_size(fifo, &size);
+        TEST_ASSERT_EQUAL((depths[i] - 1) * 64, size);
+        esp_gmf_fifo_get_free_size(fifo, &size);
+        TEST_ASSERT_EQUAL(64, size);
+        ESP_LOGI(TAG, "Depth %4d, %lld ns per operation", depths[i], cost_ns[i]);
+        esp_gmf_fifo_destroy(fifo);
+    }
+    // Allow some noise, a linear walk would be far beyond it at depth 1024
+    TEST_ASSERT_LESS_THAN(cost_ns[0] * 2 + 1000, cost_ns[sizeof(depths) / sizeof(depths[0]) - 1]);
+}
@@ -0,0 +1,188 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_pool.h"
+#include "esp_gmf_task.h"
+#include "esp_gmf_mem_gov.h"
+#include "gmf_fake_dec.h"
+
+#define MEM_GOV_TEST_PIPE_NUM (4)
+
+static const char *TAG = "TEST_ESP_GMF_MEM_GOV";
+
+static void mem_gov_items_init(esp_gmf_mem_gov_item_t *items, uint32_t pld_size, uint32_t pld_min, uint32_t blk_size, uint16_t depth, uint16_t min_depth)
+{
+    memset(items, 0, 2 * sizeof(esp_gmf_mem_gov_item_t));
+    items[0].name = "payload";
+    items[0].size = pld_size;
+    items[0].min_size = pld_min;
+    items[0].depth = 1;
+    items[1].name = "bus";
+    items[1].size = blk_size;
+    items[1].depth = depth;
+    items[1].min_depth = min_depth;
+}
+
+// The governor only does bookkeeping, so this case would run the same on a host build
+TEST_CASE("Memory governor admission and shrink under a fixed budget", "ESP_GMF_MEM_GOV")
+{
+    esp_log_level_set(TAG, ESP_LOG_INFO);
+    esp_gmf_mem_gov_handle_t gov = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_create(64 * 1024, &gov));
+    int owner[5] = {0};
+    esp_gmf_mem_gov_item_t items[2];
+    size_t size = 0;
+
+    // Two requests of 24 KB fit as they are
+    for (int i = 0; i < 2; i++) {
+        mem_gov_items_init(items, 8192, 2048, 4096, 4, 2);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_reserve(gov, &owner[i], items, 2));
+        TEST_ASSERT_EQUAL(8192, items[0].size);
+        TEST_ASSERT_EQUAL(4, items[1].depth);
+    }
+    // Only 16 KB left, the bus depth goes down first
+    mem_gov_items_init(items, 8192, 2048, 4096, 4, 2);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_reserve(gov, &owner[2], items, 2));
+    ESP_LOGI(TAG, "Owner 2, payload:%d, bus:%d x %d", (int)items[0].size, (int)items[1].size, items[1].depth);
+    TEST_ASSERT_EQUAL(8192, items[0].size);
+    TEST_ASSERT_EQUAL(2, items[1].depth);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_get_reserved(gov, &owner[2], &size));
+    TEST_ASSERT_EQUAL(16 * 1024, size);
+
+    // Nothing left, the request is refused and left untouched
+    mem_gov_items_init(items, 8192, 2048, 4096, 4, 2);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_MEMORY_LACK, esp_gmf_mem_gov_reserve(gov, &owner[3], items, 2));
+    TEST_ASSERT_EQUAL(8192, items[0].size);
+    TEST_ASSERT_EQUAL(4, items[1].depth);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_mem_gov_get_reserved(gov, &owner[3], &size));
+
+    // It is admitted once another owner leaves
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_release(gov, &owner[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_mem_gov_release(gov, &owner[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_reserve(gov, &owner[3], items, 2));
+    TEST_ASSERT_EQUAL(4, items[1].depth);
+
+    // A larger request of the same owner is refused and the previous reservation kept
+    mem_gov_items_init(items, 16384, 0, 4096, 4, 0);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_MEMORY_LACK, esp_gmf_mem_gov_reserve(gov, &owner[3], items, 2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_get_reserved(gov, &owner[3], &size));
+    TEST_ASSERT_EQUAL(24 * 1024, size);
+
+    // With 24 KB left, the depth reaches its minimum and then the payload is halved
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_release(gov, &owner[1]));
+    mem_gov_items_init(items, 32768, 4096, 1024, 8, 4);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_reserve(gov, &owner[4], items, 2));
+    ESP_LOGI(TAG, "Owner 4, payload:%d, bus:%d x %d", (int)items[0].size, (int)items[1].size, items[1].depth);
+    TEST_ASSERT_EQUAL(16384, items[0].size);
+    TEST_ASSERT_EQUAL(4, items[1].depth);
+
+    esp_gmf_mem_gov_info_t info = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_get_info(gov, &info));
+    ESP_LOGI(TAG, "Budget:%d, reserved:%d, peak:%d, granted:%d, shrunk:%d, refused:%d", (int)info.budget,
+             (int)info.reserved, (int)info.peak, (int)info.grant_cnt, (int)info.shrink_cnt, (int)info.refuse_cnt);
+    TEST_ASSERT_EQUAL(3, info.resv_num);
+    TEST_ASSERT_EQUAL(16 * 1024 + 24 * 1024 + 20 * 1024, info.reserved);
+    TEST_ASSERT_EQUAL(64 * 1024, info.peak);
+    TEST_ASSERT_EQUAL(3, info.grant_cnt);
+    TEST_ASSERT_EQUAL(2, info.shrink_cnt);
+    TEST_ASSERT_EQUAL(2, info.refuse_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_destroy(gov));
+}
+
+TEST_CASE("Memory governor checks pipelines before open", "ESP_GMF_MEM_GOV")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    const char *name[] = {"dec1", "dec2"};
+    for (int i = 0; i < sizeof(name) / sizeof(char *); i++) {
+        fake_dec_cfg_t dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+        dec_cfg.name = name[i];
+        esp_gmf_element_handle_t dec = NULL;
+        fake_dec_init(&dec_cfg, &dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, dec, NULL));
+    }
+    // Each pipeline wants 3 payloads of 5 KB, the budget holds 2 of them and a bit more
+    esp_gmf_mem_gov_handle_t gov = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_create(2 * 3 * FAKE_DEC_BUFFER_SIZE + 6 * 1024, &gov));
+
+    esp_gmf_pipeline_handle_t pipe[MEM_GOV_TEST_PIPE_NUM] = {NULL};
+    esp_gmf_task_handle_t task[MEM_GOV_TEST_PIPE_NUM] = {NULL};
+    for (int i = 0; i < MEM_GOV_TEST_PIPE_NUM; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, NULL, name, sizeof(name) / sizeof(char *), NULL, &pipe[i]));
+        esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+        esp_gmf_task_init(&cfg, &task[i]);
+        TEST_ASSERT_NOT_NULL(task[i]);
+        esp_gmf_pipeline_bind_task(pipe[i], task[i]);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_mem_gov(pipe[i], gov));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe[1]));
+
+    // The third pipeline declares how far its payloads can shrink
+    esp_gmf_element_t *head = ESP_GMF_ELEMENT_GET(pipe[2]->head_el);
+    esp_gmf_element_t *last = ESP_GMF_ELEMENT_GET(pipe[2]->last_el);
+    head->in_attr.min_size = 1024;
+    head->out_attr.min_size = 1024;
+    last->out_attr.min_size = 1024;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe[2]));
+    ESP_LOGI(TAG, "Shrunk pipeline, in:%d, %s out:%d, %s in:%d, out:%d", head->in_attr.size, OBJ_GET_TAG(head),
+             head->out_attr.size, OBJ_GET_TAG(last), last->in_attr.size, last->out_attr.size);
+    TEST_ASSERT_EQUAL(1280, head->in_attr.size);
+    TEST_ASSERT_EQUAL(1280, head->out_attr.size);
+    TEST_ASSERT_EQUAL(1280, last->in_attr.size);
+    TEST_ASSERT_EQUAL(2560, last->out_attr.size);
+
+    // The last one can not shrink, it is refused before any of its elements opens
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_MEMORY_LACK, esp_gmf_pipeline_loading_jobs(pipe[3]));
+    TEST_ASSERT_EQUAL(FAKE_DEC_BUFFER_SIZE, ESP_GMF_ELEMENT_GET(pipe[3]->head_el)->in_attr.size);
+    // Admitted once a running pipeline is gone
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(task[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe[3]));
+
+    esp_gmf_mem_gov_info_t info = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_get_info(gov, &info));
+    ESP_LOGI(TAG, "Budget:%d, reserved:%d, peak:%d, granted:%d, shrunk:%d, refused:%d", (int)info.budget,
+             (int)info.reserved, (int)info.peak, (int)info.grant_cnt, (int)info.shrink_cnt, (int)info.refuse_cnt);
+    TEST_ASSERT_EQUAL(3, info.grant_cnt);
+    TEST_ASSERT_EQUAL(1, info.shrink_cnt);
+    TEST_ASSERT_EQUAL(1, info.refuse_cnt);
+    for (int i = 1; i < MEM_GOV_TEST_PIPE_NUM; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(task[i]));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_get_info(gov, &info));
+    TEST_ASSERT_EQUAL(0, info.reserved);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_mem_gov_destroy(gov));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
@@ -27,6 +27,7 @@
 
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_method.h"
 #include "gmf_ut_common.h"
 #include "gmf_fake_dec.h"
@@ -306,3 +307,56 @@ TEST_CASE("Test structure description", "ESP_GMF_METHOD")
     esp_gmf_oal_free(buf);
     ESP_GMF_MEM_SHOW(TAG);
 }
+
+#define METHOD_BENCH_CALLS (100000)
+
+TEST_CASE("Method dispatch by name and by ID", "ESP_GMF_METHOD")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+
+    fake_dec_cfg_t cfg = DEFAULT_FAKE_DEC_CONFIG();
+    esp_gmf_obj_handle_t dec = NULL;
+    fake_dec_init(&cfg, &dec);
+    fake_dec_cast(&cfg, dec);
+    esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)dec;
+
+    // The last registered method is the worst case of the name lookup
+    esp_gmf_method_id_t id = ESP_GMF_METHOD_ID_INVALID;
+    esp_gmf_method_id_t id2 = ESP_GMF_METHOD_ID_INVALID;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_get_method_id(el, "get_filter", &id));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_get_method_id(el, "GET_FILTER", &id2));
+    TEST_ASSERT_EQUAL(id, id2);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_element_get_method_id(el, "get_filter_x", &id2));
+    TEST_ASSERT_EQUAL(ESP_GMF_METHOD_ID_INVALID, id2);
+
+    esp_gmf_method_t *method_head = NULL;
+    esp_gmf_method_t *method = NULL;
+    esp_gmf_element_get_method(el, &method_head);
+    esp_gmf_method_found(method_head, "get_filter", &method);
+    TEST_ASSERT_NOT_NULL(method);
+    size_t cnt = 0;
+    esp_gmf_args_desc_get_total_size(method->args_desc, &cnt);
+    uint8_t *buf = esp_gmf_oal_calloc(1, cnt);
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_element_exe_method_by_id(el, ESP_GMF_METHOD_ID_INVALID, buf, cnt));
+
+    esp_log_level_set("*", ESP_LOG_WARN);
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    for (int i = 0; i < METHOD_BENCH_CALLS; i++) {
+        esp_gmf_element_exe_method(el, "get_filter", buf, cnt);
+    }
+    int64_t name_us = esp_gmf_oal_sys_get_time_us() - start;
+    start = esp_gmf_oal_sys_get_time_us();
+    for (int i = 0; i < METHOD_BENCH_CALLS; i++) {
+        esp_gmf_element_exe_method_by_id(el, id, buf, cnt);
+    }
+    int64_t id_us = esp_gmf_oal_sys_get_time_us() - start;
+    ESP_LOGW(TAG, "Dispatch %d calls, by name:%lld us (%lld calls/s), by ID:%lld us (%lld calls/s)", METHOD_BENCH_CALLS,
+             name_us, METHOD_BENCH_CALLS * 1000000LL / (name_us + 1), id_us, METHOD_BENCH_CALLS * 1000000LL / (id_us + 1));
+    TEST_ASSERT_LESS_THAN(name_us, id_us);
+
+    esp_gmf_obj_delete(dec);
+    esp_gmf_oal_free(buf);
+    ESP_GMF_MEM_SHOW(TAG);
+}
@@ -0,0 +1,195 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_pool.h"
+#include "gmf_fake_io.h"
+#include "gmf_fake_dec.h"
+
+#define ARENA_TEST_CHUNK_SIZE (2048)
+#define ARENA_TEST_PIPE_LOOP  (500)
+#define ARENA_TEST_PIPE_WARM  (20)
+#define ARENA_TEST_TOLERANCE  (256)
+
+static const char *TAG = "TEST_ESP_GMF_OAL_MEM";
+
+static void arena_pool_register(esp_gmf_pool_handle_t pool)
+{
+    fake_io_cfg_t io_cfg = FAKE_IO_CFG_DEFAULT();
+    io_cfg.dir = ESP_GMF_IO_DIR_READER;
+    esp_gmf_io_handle_t io = NULL;
+    fake_io_init(&io_cfg, &io);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, io, NULL));
+    io_cfg.dir = ESP_GMF_IO_DIR_WRITER;
+    fake_io_init(&io_cfg, &io);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, io, NULL));
+
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    for (int i = 0; i < sizeof(name) / sizeof(char *); i++) {
+        fake_dec_cfg_t dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+        dec_cfg.name = name[i];
+        esp_gmf_element_handle_t dec = NULL;
+        fake_dec_init(&dec_cfg, &dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, dec, NULL));
+    }
+}
+
+TEST_CASE("Memory arena scope, accounting and release", "ESP_GMF_OAL_MEM")
+{
+    esp_gmf_oal_mem_arena_handle_t arena = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_oal_mem_arena_create(0, &arena));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_create(1024, &arena));
+    TEST_ASSERT_NOT_NULL(arena);
+
+    // Nothing goes to the arena out of its scope
+    void *heap = esp_gmf_oal_malloc(32);
+    TEST_ASSERT_NOT_NULL(heap);
+    esp_gmf_oal_mem_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_get_stats(arena, NULL, &stats));
+    TEST_ASSERT_EQUAL(0, stats.alloc_cnt);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_enter(arena, "dec"));
+    uint8_t *ctx = esp_gmf_oal_calloc(1, 100);
+    char *str = esp_gmf_oal_strdup("arena");
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_enter(arena, "io"));
+    // Larger than a chunk, it gets a chunk of its own
+    uint8_t *big = esp_gmf_oal_malloc_align(8, 3000);
+    TEST_ASSERT_NOT_NULL(ctx);
+    TEST_ASSERT_NOT_NULL(str);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)big & 7);
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(0, ctx[i]);
+    }
+    memset(big, 0x5A, 3000);
+    // Grown blocks move and keep their content
+    str = esp_gmf_oal_realloc(str, 64);
+    TEST_ASSERT_EQUAL_STRING("arena", str);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_leave(arena));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_get_stats(arena, NULL, &stats));
+    TEST_ASSERT_EQUAL(100 + 64 + 3000, stats.current);
+    TEST_ASSERT_EQUAL(3, stats.count);
+    TEST_ASSERT_EQUAL(4, stats.alloc_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(1024 + 3000, stats.reserved);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_get_stats(arena, "dec", &stats));
+    TEST_ASSERT_EQUAL(100, stats.current);
+    TEST_ASSERT_EQUAL(106, stats.peak);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_get_stats(arena, "io", &stats));
+    TEST_ASSERT_EQUAL(3064, stats.current);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_oal_mem_arena_get_stats(arena, "enc", &stats));
+    esp_gmf_oal_mem_arena_show(arena, TAG);
+
+    // Arena and heap blocks are freed by the same call
+    esp_gmf_oal_free(ctx);
+    esp_gmf_oal_free(str);
+    esp_gmf_oal_free(big);
+    esp_gmf_oal_free(heap);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_get_stats(arena, NULL, &stats));
+    TEST_ASSERT_EQUAL(0, stats.current);
+    TEST_ASSERT_EQUAL(0, stats.count);
+    // Only the chunk that serves the small blocks is kept
+    TEST_ASSERT_EQUAL(1024, stats.reserved);
+
+    // Blocks left in the arena are given back with it
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_enter(arena, NULL));
+    TEST_ASSERT_NOT_NULL(esp_gmf_oal_malloc(200));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_leave(arena));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_oal_mem_arena_destroy(arena));
+}
+
+TEST_CASE("Pipeline arena, create and destroy without leak or fragmentation", "ESP_GMF_OAL_MEM")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    arena_pool_register(pool);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_set_pipeline_arena(pool, ARENA_TEST_CHUNK_SIZE));
+    ESP_GMF_MEM_SHOW(TAG);
+
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    size_t warm_free = 0;
+    size_t warm_block = 0;
+    size_t min_block = SIZE_MAX;
+    for (int i = 0; i < ARENA_TEST_PIPE_LOOP; i++) {
+        esp_gmf_pipeline_handle_t pipe = NULL;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe));
+        TEST_ASSERT_NOT_NULL(pipe);
+        TEST_ASSERT_NOT_NULL(pipe->arena);
+
+        esp_gmf_oal_mem_stats_t total = {0};
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_mem_stats(pipe, NULL, &total));
+        TEST_ASSERT_GREATER_THAN(0, total.current);
+        size_t sum = 0;
+        const char *tag[] = {"dec1", "dec2", "dec3", "file"};
+        for (int j = 0; j < sizeof(tag) / sizeof(char *); j++) {
+            esp_gmf_oal_mem_stats_t stats = {0};
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_mem_stats(pipe, tag[j], &stats));
+            TEST_ASSERT_GREATER_THAN(0, stats.count);
+            sum += stats.current;
+        }
+        // The pipeline itself is accounted untagged
+        TEST_ASSERT_LESS_THAN(total.current, sum);
+        if (i == 0) {
+            esp_gmf_oal_mem_arena_show(pipe->arena, TAG);
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+
+        size_t block = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+        if (i == ARENA_TEST_PIPE_WARM) {
+            warm_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+            warm_block = block;
+        }
+        if ((i > ARENA_TEST_PIPE_WARM) && (block < min_block)) {
+            min_block = block;
+        }
+    }
+    size_t end_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    ESP_LOGW(TAG, "Free after warm up:%d, at end:%d, largest block after warm up:%d, lowest:%d",
+             (int)warm_free, (int)end_free, (int)warm_block, (int)min_block);
+    // No leak and the largest free block stays flat
+    TEST_ASSERT_INT_WITHIN(ARENA_TEST_TOLERANCE, warm_free, end_free);
+    TEST_ASSERT_GREATER_OR_EQUAL(warm_block - ARENA_TEST_TOLERANCE, min_block);
+
+    // A pipeline on the heap has no accounting
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_set_pipeline_arena(pool, 0));
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe));
+    TEST_ASSERT_NULL(pipe->arena);
+    esp_gmf_oal_mem_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_get_mem_stats(pipe, NULL, &stats));
+    esp_gmf_pipeline_destroy(pipe);
+
+    esp_gmf_pool_deinit(pool);
+    ESP_GMF_MEM_SHOW(TAG);
+}
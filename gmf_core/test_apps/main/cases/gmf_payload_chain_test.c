@@ -0,0 +1,222 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_pool.h"
+#include "esp_gmf_payload.h"
+#include "gmf_fake_dec.h"
+
+#define CHAIN_TEST_HDR_SIZE   (16)
+#define CHAIN_TEST_SEG_SIZE   (1024)
+#define CHAIN_TEST_SEG_NUM    (8)
+#define CHAIN_TEST_FRAME_SIZE (CHAIN_TEST_HDR_SIZE + CHAIN_TEST_SEG_SIZE * CHAIN_TEST_SEG_NUM)
+#define CHAIN_TEST_FRAME_NUM  (2000)
+
+typedef enum {
+    CHAIN_MODE_COPY,     /*!< The writer copies the segments into one buffer */
+    CHAIN_MODE_FLATTEN,  /*!< The writer chains the segments, the reader can't handle chains */
+    CHAIN_MODE_CHAIN,    /*!< The writer chains the segments, the reader walks the chain */
+} chain_test_mode_t;
+
+static const char *TAG = "TEST_ESP_GMF_PLD_CHAIN";
+
+static uint32_t chain_sum(esp_gmf_payload_t *load)
+{
+    uint32_t sum = 0;
+    for (; load; load = load->next) {
+        for (int i = 0; i < load->valid_size; i++) {
+            sum += load->buf[i];
+        }
+    }
+    return sum;
+}
+
+static void chain_build(esp_gmf_payload_t *head, esp_gmf_payload_t *segs, uint8_t *src, chain_test_mode_t mode)
+{
+    memset(head->buf, 0x5A, CHAIN_TEST_HDR_SIZE);
+    head->valid_size = CHAIN_TEST_HDR_SIZE;
+    head->next = NULL;
+    for (int i = 0; i < CHAIN_TEST_SEG_NUM; i++) {
+        if (mode == CHAIN_MODE_COPY) {
+            memcpy(head->buf + head->valid_size, src + i * CHAIN_TEST_SEG_SIZE, CHAIN_TEST_SEG_SIZE);
+            head->valid_size += CHAIN_TEST_SEG_SIZE;
+        } else {
+            segs[i].buf = src + i * CHAIN_TEST_SEG_SIZE;
+            segs[i].buf_length = CHAIN_TEST_SEG_SIZE;
+            segs[i].valid_size = CHAIN_TEST_SEG_SIZE;
+            esp_gmf_payload_chain_append(head, &segs[i]);
+        }
+    }
+}
+
+static void chain_new_pipeline(esp_gmf_pool_handle_t *pool, esp_gmf_pipeline_handle_t *pipe,
+                               esp_gmf_port_handle_t *out_port, esp_gmf_port_handle_t *in_port, esp_gmf_element_handle_t *reader)
+{
+    esp_gmf_pool_init(pool);
+    TEST_ASSERT_NOT_NULL(*pool);
+    fake_dec_cfg_t cfg = DEFAULT_FAKE_DEC_CONFIG();
+    cfg.in_buf_size = CHAIN_TEST_FRAME_SIZE;
+    cfg.out_buf_size = CHAIN_TEST_FRAME_SIZE;
+    const char *name[] = {"dec1", "dec2"};
+    for (int i = 0; i < 2; i++) {
+        esp_gmf_element_handle_t dec = NULL;
+        cfg.name = name[i];
+        fake_dec_init(&cfg, &dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(*pool, dec, NULL));
+    }
+    // Drive the link between the two elements directly, no IO and task are needed
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(*pool, NULL, name, 2, NULL, pipe));
+    esp_gmf_element_handle_t writer = NULL;
+    esp_gmf_pipeline_get_el_by_name(*pipe, "dec1", &writer);
+    esp_gmf_pipeline_get_el_by_name(*pipe, "dec2", reader);
+    TEST_ASSERT_NOT_NULL(writer);
+    TEST_ASSERT_NOT_NULL(*reader);
+    *out_port = ESP_GMF_ELEMENT_GET(writer)->out;
+    *in_port = ESP_GMF_ELEMENT_GET(*reader)->in;
+}
+
+TEST_CASE("Payload chain append, size and flatten", "ESP_GMF_PLD_CHAIN")
+{
+    ESP_GMF_MEM_SHOW(TAG);
+    uint8_t data[3][8];
+    esp_gmf_payload_t seg[3] = {0};
+    for (int i = 0; i < 3; i++) {
+        memset(data[i], i + 1, sizeof(data[i]));
+        seg[i].buf = data[i];
+        seg[i].buf_length = sizeof(data[i]);
+        seg[i].valid_size = sizeof(data[i]) - i;
+    }
+    seg[0].pts = 1234;
+    seg[2].is_done = true;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_payload_chain_append(&seg[0], &seg[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_chain_append(&seg[0], &seg[1]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_chain_append(&seg[0], &seg[2]));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_get_chain_size(&seg[0], &size));
+    TEST_ASSERT_EQUAL(8 + 7 + 6, size);
+
+    esp_gmf_payload_t *flat = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new(&flat));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_flatten(&seg[0], flat));
+    TEST_ASSERT_EQUAL(size, flat->valid_size);
+    TEST_ASSERT_EQUAL(1234, flat->pts);
+    TEST_ASSERT_TRUE(flat->is_done);
+    TEST_ASSERT_NULL(flat->next);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data[0], flat->buf, 8);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data[1], flat->buf + 8, 7);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data[2], flat->buf + 15, 6);
+    // The source chain is kept
+    TEST_ASSERT_EQUAL_PTR(&seg[1], seg[0].next);
+
+    // Flatten in place needs room in the head buffer
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_MEMORY_LACK, esp_gmf_payload_flatten(&seg[0], &seg[0]));
+    esp_gmf_payload_t head = {0};
+    uint8_t head_buf[32] = {0};
+    head.buf = head_buf;
+    head.buf_length = sizeof(head_buf);
+    head.valid_size = 2;
+    seg[0].next = NULL;
+    esp_gmf_payload_chain_append(&head, &seg[1]);
+    esp_gmf_payload_chain_append(&head, &seg[2]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_flatten(&head, &head));
+    TEST_ASSERT_EQUAL(2 + 7 + 6, head.valid_size);
+    TEST_ASSERT_NULL(head.next);
+    TEST_ASSERT_TRUE(head.is_done);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data[1], head.buf + 2, 7);
+    esp_gmf_payload_delete(flat);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Payload chain through element ports", "ESP_GMF_PLD_CHAIN")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    esp_gmf_port_handle_t out_port = NULL;
+    esp_gmf_port_handle_t in_port = NULL;
+    esp_gmf_element_handle_t reader = NULL;
+    chain_new_pipeline(&pool, &pipe, &out_port, &in_port, &reader);
+
+    uint8_t *src = esp_gmf_oal_malloc(CHAIN_TEST_SEG_SIZE * CHAIN_TEST_SEG_NUM);
+    TEST_ASSERT_NOT_NULL(src);
+    for (int i = 0; i < CHAIN_TEST_SEG_SIZE * CHAIN_TEST_SEG_NUM; i++) {
+        src[i] = (uint8_t)(i * 7);
+    }
+    esp_gmf_payload_t segs[CHAIN_TEST_SEG_NUM] = {0};
+    const char *mode_str[] = {"copy", "chain+flatten", "chain"};
+    int64_t cost_us[3] = {0};
+    uint32_t expect_sum = 0;
+    for (chain_test_mode_t mode = CHAIN_MODE_COPY; mode <= CHAIN_MODE_CHAIN; mode++) {
+        if (mode == CHAIN_MODE_CHAIN) {
+            ESP_GMF_ELEMENT_GET(reader)->in_attr.cap |= ESP_GMF_EL_PORT_CAP_CHAIN;
+        }
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        for (int i = 0; i < CHAIN_TEST_FRAME_NUM; i++) {
+            esp_gmf_payload_t *out_load = NULL;
+            TEST_ASSERT_GREATER_OR_EQUAL(CHAIN_TEST_FRAME_SIZE, esp_gmf_port_acquire_out(out_port, &out_load, CHAIN_TEST_FRAME_SIZE, 0));
+            chain_build(out_load, segs, src, mode);
+            esp_gmf_port_release_out(out_port, out_load, 0);
+
+            esp_gmf_payload_t *in_load = NULL;
+            TEST_ASSERT_EQUAL(CHAIN_TEST_FRAME_SIZE, esp_gmf_port_acquire_in(in_port, &in_load, CHAIN_TEST_FRAME_SIZE, 0));
+            if (mode == CHAIN_MODE_CHAIN) {
+                TEST_ASSERT_EQUAL_PTR(out_load, in_load);
+                TEST_ASSERT_NOT_NULL(in_load->next);
+            } else {
+                TEST_ASSERT_NULL(in_load->next);
+                TEST_ASSERT_EQUAL(CHAIN_TEST_FRAME_SIZE, in_load->valid_size);
+            }
+            uint32_t sum = chain_sum(in_load);
+            if (expect_sum == 0) {
+                expect_sum = sum;
+            }
+            TEST_ASSERT_EQUAL(expect_sum, sum);
+            esp_gmf_port_release_in(in_port, in_load, 0);
+        }
+        cost_us[mode] = esp_gmf_oal_sys_get_time_us() - start;
+        uint64_t bytes = (uint64_t)CHAIN_TEST_FRAME_SIZE * CHAIN_TEST_FRAME_NUM;
+        uint64_t copied = (mode == CHAIN_MODE_CHAIN) ? 0 : (uint64_t)CHAIN_TEST_SEG_SIZE * CHAIN_TEST_SEG_NUM * CHAIN_TEST_FRAME_NUM;
+        ESP_LOGW(TAG, "%-14s %d frames, %lld us, %lld KB/s through, %lld KB/s copied", mode_str[mode], CHAIN_TEST_FRAME_NUM, cost_us[mode],
+                 (int64_t)(bytes * 1000000 / 1024 / (cost_us[mode] + 1)), (int64_t)(copied * 1000000 / 1024 / (cost_us[mode] + 1)));
+    }
+    for (int i = 0; i < CHAIN_TEST_SEG_NUM; i++) {
+        segs[i].next = NULL;
+    }
+    // Walking the chain avoids the copy of the segments
+    TEST_ASSERT_LESS_THAN(cost_us[CHAIN_MODE_COPY], cost_us[CHAIN_MODE_CHAIN]);
+    TEST_ASSERT_LESS_THAN(cost_us[CHAIN_MODE_FLATTEN], cost_us[CHAIN_MODE_CHAIN]);
+
+    esp_gmf_oal_free(src);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
@@ -0,0 +1,198 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_payload.h"
+#include "esp_gmf_payload_pool.h"
+
+#define PLD_POOL_TEST_LOOP    (20000)
+#define PLD_POOL_TEST_PLD_NUM (3)
+
+static const char *TAG = "TEST_ESP_GMF_PLD_POOL";
+
+TEST_CASE("Payload pool get, put and fallback", "ESP_GMF_PLD_POOL")
+{
+    esp_gmf_payload_pool_cfg_t cfg = {
+        .classes = {
+            {.size = 100, .count = 2},
+            {.size = 1024, .count = 1},
+        },
+        .align = 16,
+    };
+    esp_gmf_payload_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(&cfg, &pool));
+    TEST_ASSERT_NOT_NULL(pool);
+
+    // Class sizes are rounded up to the alignment
+    uint8_t *buf[4] = {NULL};
+    uint32_t len[4] = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, 16, 64, &buf[0], &len[0]));
+    TEST_ASSERT_EQUAL(112, len[0]);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buf[0] & 15);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, 0, 112, &buf[1], &len[1]));
+    TEST_ASSERT_EQUAL(112, len[1]);
+    TEST_ASSERT_NOT_EQUAL(buf[0], buf[1]);
+    // The small class is used up, the next class that fits serves the request
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, 0, 64, &buf[2], &len[2]));
+    TEST_ASSERT_EQUAL(1024, len[2]);
+    // Nothing left, fall back to the heap
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, 0, 64, &buf[3], &len[3]));
+    TEST_ASSERT_EQUAL(64, len[3]);
+
+    esp_gmf_payload_pool_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pool, &stats));
+    TEST_ASSERT_EQUAL(3, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(3, stats.in_use);
+    TEST_ASSERT_EQUAL(3, stats.peak_use);
+    for (int i = 0; i < 4; i++) {
+        memset(buf[i], i, len[i]);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_put(pool, buf[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pool, &stats));
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+
+    // Too large and over aligned requests are served by the heap
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, 0, 2048, &buf[0], &len[0]));
+    TEST_ASSERT_EQUAL(2048, len[0]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, 64, 64, &buf[1], &len[1]));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buf[1] & 63);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pool, &stats));
+    TEST_ASSERT_EQUAL(3, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_put(pool, buf[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_put(pool, buf[1]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool));
+
+    // Class sizes must be ascending
+    esp_gmf_payload_pool_cfg_t bad_cfg = {
+        .classes = {
+            {.size = 1024, .count = 1},
+            {.size = 512, .count = 1},
+        },
+    };
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_payload_pool_create(&bad_cfg, &pool));
+    TEST_ASSERT_NULL(pool);
+}
+
+TEST_CASE("Payload realloc without steady-state heap allocation", "ESP_GMF_PLD_POOL")
+{
+    ESP_GMF_MEM_SHOW(TAG);
+    // Every class holds one buffer per payload, so no request can miss
+    esp_gmf_payload_pool_cfg_t cfg = ESP_GMF_PAYLOAD_POOL_CFG_DEFAULT();
+    for (int i = 0; cfg.classes[i].size; i++) {
+        cfg.classes[i].count = PLD_POOL_TEST_PLD_NUM;
+    }
+    esp_gmf_payload_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(&cfg, &pool));
+
+    // Emulate the ports of a pipeline, the payloads grow and shrink with the frame size and are recreated on restart
+    esp_gmf_payload_t *pld[PLD_POOL_TEST_PLD_NUM] = {NULL};
+    esp_gmf_payload_pool_stats_t warm = {0};
+    size_t free_size = 0;
+    uint32_t seed = 1;
+    for (int i = 0; i < PLD_POOL_TEST_LOOP; i++) {
+        for (int j = 0; j < PLD_POOL_TEST_PLD_NUM; j++) {
+            if (pld[j] == NULL) {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new(&pld[j]));
+                pld[j]->pool = pool;
+            }
+            seed = seed * 1103515245 + 12345;
+            uint32_t wanted = 1 + (seed >> 8) % 8192;
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_aligned_buf(pld[j], 16, wanted));
+            TEST_ASSERT_GREATER_OR_EQUAL(wanted, pld[j]->buf_length);
+            TEST_ASSERT_EQUAL(0, (uintptr_t)pld[j]->buf & 15);
+            memset(pld[j]->buf, j, wanted);
+            // Drop the buffer from time to time so that the payload grows again
+            if ((seed & 0x7) == 0) {
+                esp_gmf_payload_delete(pld[j]);
+                pld[j] = NULL;
+            }
+        }
+        if (i == 100) {
+            esp_gmf_payload_pool_get_stats(pool, &warm);
+            free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        }
+    }
+    size_t end_free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    for (int j = 0; j < PLD_POOL_TEST_PLD_NUM; j++) {
+        if (pld[j]) {
+            esp_gmf_payload_delete(pld[j]);
+        }
+    }
+    esp_gmf_payload_pool_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pool, &stats));
+    ESP_LOGI(TAG, "Payload pool, hit:%ld, miss:%ld, warm miss:%ld, peak:%ld, heap before:%d, after:%d",
+             stats.hit_cnt, stats.miss_cnt, warm.miss_cnt, stats.peak_use, (int)free_size, (int)end_free_size);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(warm.hit_cnt, stats.hit_cnt);
+    // Only the payload handles are recreated in the loop, which take and return the same heap block
+    TEST_ASSERT_GREATER_OR_EQUAL(free_size - PLD_POOL_TEST_PLD_NUM * sizeof(esp_gmf_payload_t) - 64, end_free_size);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Payload pool switch returns the buffer to its owner", "ESP_GMF_PLD_POOL")
+{
+    esp_gmf_payload_pool_cfg_t cfg = {
+        .classes = {
+            {.size = 1024, .count = 1},
+        },
+    };
+    esp_gmf_payload_pool_handle_t pool[2] = {NULL};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(&cfg, &pool[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(&cfg, &pool[1]));
+    esp_gmf_payload_pool_stats_t stats = {0};
+
+    esp_gmf_payload_t *pld = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new(&pld));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_set_pool(pld, pool[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_buf(pld, 512));
+    esp_gmf_payload_pool_get_stats(pool[0], &stats);
+    TEST_ASSERT_EQUAL(1, stats.in_use);
+
+    // The slab buffer goes back to the first pool, the next one comes from the second
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_set_pool(pld, pool[1]));
+    TEST_ASSERT_NULL(pld->buf);
+    esp_gmf_payload_pool_get_stats(pool[0], &stats);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_buf(pld, 512));
+    esp_gmf_payload_pool_get_stats(pool[1], &stats);
+    TEST_ASSERT_EQUAL(1, stats.in_use);
+
+    // Back to the heap, the slab buffer is not freed by it
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_set_pool(pld, NULL));
+    esp_gmf_payload_pool_get_stats(pool[1], &stats);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_buf(pld, 512));
+    TEST_ASSERT_NOT_NULL(pld->buf);
+    esp_gmf_payload_delete(pld);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool[1]));
+}
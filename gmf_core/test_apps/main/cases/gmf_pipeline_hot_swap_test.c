@@ -0,0 +1,413 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_task.h"
+#include "esp_gmf_port.h"
+#include "esp_gmf_io.h"
+#include "esp_gmf_oal_sys.h"
+
+#define SWAP_FRAME_SIZE    (256)
+#define SWAP_LOOP          (1000)
+#define SWAP_FINISHED_BIT  BIT(0)
+
+static const char *TAG = "TEST_ESP_GMF_HOT_SWAP";
+
+typedef struct {
+    esp_gmf_element_t  parent;
+    uint32_t           frames;
+} swap_copy_t;
+
+typedef struct {
+    volatile bool  stop;
+    uint32_t       produced;
+    uint32_t       consumed;
+    uint32_t       errors;
+} swap_stream_t;
+
+typedef struct {
+    esp_gmf_task_handle_t  task;
+    int                    cnt;
+} swap_job_cnt_t;
+
+typedef struct {
+    esp_gmf_io_t       base;
+    SemaphoreHandle_t  data_sem;
+    volatile bool      aborted;
+    int                reads;
+    int                seek_cnt;
+    uint64_t           seek_pos;
+} stall_io_t;
+
+static esp_gmf_job_err_t swap_copy_open(void *self, void *para)
+{
+    ((swap_copy_t *)self)->frames = 0;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t swap_copy_process(void *self, void *para)
+{
+    esp_gmf_port_t *in_port = ESP_GMF_ELEMENT_GET(self)->in;
+    esp_gmf_port_t *out_port = ESP_GMF_ELEMENT_GET(self)->out;
+    esp_gmf_payload_t *in_load = NULL;
+    esp_gmf_payload_t *out_load = NULL;
+    int ret = esp_gmf_port_acquire_in(in_port, &in_load, SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+    if (ret == ESP_GMF_IO_ABORT) {
+        // The read was aborted for a seek, nothing to pass on in this round
+        return ESP_GMF_JOB_ERR_OK;
+    }
+    if (ret < 0) {
+        return ESP_GMF_JOB_ERR_FAIL;
+    }
+    ret = esp_gmf_port_acquire_out(out_port, &out_load, SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+    if (ret < 0) {
+        esp_gmf_port_release_in(in_port, in_load, ESP_GMF_MAX_DELAY);
+        return ESP_GMF_JOB_ERR_FAIL;
+    }
+    if (out_load != in_load) {
+        memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+    }
+    out_load->valid_size = in_load->valid_size;
+    out_load->is_done = in_load->is_done;
+    bool is_done = in_load->is_done;
+    esp_gmf_port_release_out(out_port, out_load, ESP_GMF_MAX_DELAY);
+    esp_gmf_port_release_in(in_port, in_load, ESP_GMF_MAX_DELAY);
+    ((swap_copy_t *)self)->frames++;
+    return is_done ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t swap_copy_close(void *self, void *para)
+{
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_err_t swap_copy_delete(esp_gmf_obj_handle_t obj)
+{
+    esp_gmf_element_deinit(obj);
+    esp_gmf_oal_free(obj);
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_element_handle_t swap_copy_new(const char *tag)
+{
+    swap_copy_t *copy = esp_gmf_oal_calloc(1, sizeof(swap_copy_t));
+    TEST_ASSERT_NOT_NULL(copy);
+    esp_gmf_obj_set_tag((esp_gmf_obj_handle_t)copy, tag);
+    copy->parent.base.del_obj = swap_copy_delete;
+    esp_gmf_element_cfg_t el_cfg = {
+        .in_attr.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE,
+        .out_attr.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE,
+        .in_attr.size = SWAP_FRAME_SIZE,
+        .out_attr.size = SWAP_FRAME_SIZE,
+    };
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_init(copy, &el_cfg));
+    copy->parent.ops.open = swap_copy_open;
+    copy->parent.ops.process = swap_copy_process;
+    copy->parent.ops.close = swap_copy_close;
+    return copy;
+}
+
+static esp_gmf_err_io_t swap_src_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    // An endless ramp, one sample per step, until the test stops it
+    swap_stream_t *st = (swap_stream_t *)handle;
+    int16_t *pcm = (int16_t *)load->buf;
+    uint32_t n = wanted_size / sizeof(int16_t);
+    for (uint32_t i = 0; i < n; i++) {
+        pcm[i] = (int16_t)(st->produced + i);
+    }
+    st->produced += n;
+    load->valid_size = n * sizeof(int16_t);
+    load->is_done = st->stop;
+    return load->valid_size;
+}
+
+static esp_gmf_err_io_t swap_src_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t swap_sink_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    return wanted_size;
+}
+
+static esp_gmf_err_io_t swap_sink_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    swap_stream_t *st = (swap_stream_t *)handle;
+    const int16_t *pcm = (const int16_t *)load->buf;
+    for (int i = 0; i < load->valid_size / sizeof(int16_t); i++) {
+        if (pcm[i] != (int16_t)st->consumed) {
+            st->errors++;
+        }
+        st->consumed++;
+    }
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_t swap_pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
+{
+    if ((event->type == ESP_GMF_EVT_TYPE_CHANGE_STATE)
+        && ((event->sub == ESP_GMF_EVENT_STATE_FINISHED)
+            || (event->sub == ESP_GMF_EVENT_STATE_STOPPED)
+            || (event->sub == ESP_GMF_EVENT_STATE_ERROR))) {
+        xEventGroupSetBits((EventGroupHandle_t)ctx, SWAP_FINISHED_BIT);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t swap_count_jobs(void *ctx)
+{
+    // Runs in the task context, so the job list is steady
+    swap_job_cnt_t *job_cnt = (swap_job_cnt_t *)ctx;
+    job_cnt->cnt = 0;
+    for (esp_gmf_job_t *job = ((esp_gmf_task_t *)job_cnt->task)->working; job; job = job->next) {
+        job_cnt->cnt++;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+TEST_CASE("Pipeline hot swap, replace, insert and remove elements during a PCM stream", "ESP_GMF_PIPELINE")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    swap_stream_t stream = {0};
+    EventGroupHandle_t evt = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(evt);
+
+    // [src]->head->mid->tail->[sink]
+    esp_gmf_element_handle_t head = swap_copy_new("copy_h0");
+    esp_gmf_element_handle_t mid = swap_copy_new("copy_a");
+    esp_gmf_element_handle_t tail = swap_copy_new("copy_t");
+    esp_gmf_element_handle_t spare_head = swap_copy_new("copy_h1");
+    esp_gmf_element_handle_t spare_mid = swap_copy_new("copy_b");
+    esp_gmf_element_handle_t extra = swap_copy_new("copy_x");
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_create(&pipe));
+    esp_gmf_element_register_in_port(head, NEW_ESP_GMF_PORT_IN_BYTE(swap_src_acquire, swap_src_release, NULL, &stream,
+                                                                     SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_out_port(head, NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_in_port(mid, NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_out_port(mid, NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_in_port(tail, NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_out_port(tail, NEW_ESP_GMF_PORT_OUT_BYTE(swap_sink_acquire, swap_sink_release, NULL, &stream,
+                                                                       SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_pipeline_register_el(pipe, head);
+    esp_gmf_pipeline_register_el(pipe, mid);
+    esp_gmf_pipeline_register_el(pipe, tail);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_set_event(pipe, swap_pipeline_event, evt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+
+    // An element can't be linked twice, nor removed when it's not linked
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_insert_el(pipe, head, tail));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_remove_el(pipe, extra));
+
+    swap_job_cnt_t job_cnt = {.task = work_task};
+    int max_jobs = 0;
+    for (int i = 0; i < SWAP_LOOP; i++) {
+        esp_gmf_element_handle_t tmp = NULL;
+        switch (i % 6) {
+            case 0:
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_replace_el(pipe, mid, spare_mid));
+                tmp = mid;
+                mid = spare_mid;
+                spare_mid = tmp;
+                break;
+            case 1:
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_insert_el(pipe, pipe->head_el, extra));
+                break;
+            case 2:
+            case 4:
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_remove_el(pipe, extra));
+                break;
+            case 3:
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_insert_el(pipe, pipe->last_el, extra));
+                TEST_ASSERT_EQUAL_PTR(extra, pipe->last_el);
+                break;
+            case 5:
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_replace_el(pipe, head, spare_head));
+                TEST_ASSERT_EQUAL_PTR(spare_head, pipe->head_el);
+                tmp = head;
+                head = spare_head;
+                spare_head = tmp;
+                break;
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_call(work_task, swap_count_jobs, &job_cnt));
+        max_jobs = job_cnt.cnt > max_jobs ? job_cnt.cnt : max_jobs;
+    }
+    // Each edit waits for a round of jobs, so the stream has gone on meanwhile
+    TEST_ASSERT_GREATER_OR_EQUAL(SWAP_LOOP * SWAP_FRAME_SIZE / sizeof(int16_t), stream.produced);
+    // At most 4 elements with the open and process jobs of the new one and the retired ones not visited yet
+    TEST_ASSERT_LESS_OR_EQUAL(10, max_jobs);
+    // The loop ends with the extra element at the tail, take it out for the end of the stream
+    TEST_ASSERT_EQUAL_PTR(extra, pipe->last_el);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_remove_el(pipe, extra));
+    TEST_ASSERT_EQUAL_PTR(tail, pipe->last_el);
+    TEST_ASSERT_NULL(ESP_GMF_ELEMENT_GET(extra)->in);
+    TEST_ASSERT_NULL(ESP_GMF_ELEMENT_GET(extra)->out);
+    TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_INITIALIZED, ESP_GMF_ELEMENT_GET(spare_mid)->cur_state);
+    TEST_ASSERT_NULL(ESP_GMF_ELEMENT_GET(spare_mid)->in);
+
+    stream.stop = true;
+    EventBits_t bits = xEventGroupWaitBits(evt, SWAP_FINISHED_BIT, pdTRUE, pdFALSE, pdMS_TO_TICKS(5000));
+    TEST_ASSERT_TRUE(bits & SWAP_FINISHED_BIT);
+    ESP_LOGW(TAG, "Swapped %d times, samples produced:%ld, consumed:%ld, errors:%ld, max jobs:%d",
+             SWAP_LOOP, (long)stream.produced, (long)stream.consumed, (long)stream.errors, max_jobs);
+    // Copying elements hold no data between rounds, so not a single sample is lost or repeated
+    TEST_ASSERT_EQUAL(stream.produced, stream.consumed);
+    TEST_ASSERT_EQUAL(0, stream.errors);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    esp_gmf_obj_delete(spare_head);
+    esp_gmf_obj_delete(spare_mid);
+    esp_gmf_obj_delete(extra);
+    vEventGroupDelete(evt);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+static esp_gmf_err_io_t stall_io_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    // Stands for a network read that gets no data until the IO is aborted
+    stall_io_t *io = (stall_io_t *)handle;
+    if (io->aborted == false) {
+        io->reads++;
+        xSemaphoreTake(io->data_sem, portMAX_DELAY);
+    }
+    if (io->aborted) {
+        return ESP_GMF_IO_ABORT;
+    }
+    memset(load->buf, 0, wanted_size);
+    load->valid_size = wanted_size;
+    return wanted_size;
+}
+
+static esp_gmf_err_t stall_io_prev_close(esp_gmf_io_handle_t handle)
+{
+    stall_io_t *io = (stall_io_t *)handle;
+    io->aborted = true;
+    xSemaphoreGive(io->data_sem);
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t stall_io_seek(esp_gmf_io_handle_t handle, uint64_t pos)
+{
+    stall_io_t *io = (stall_io_t *)handle;
+    io->seek_pos = pos;
+    io->seek_cnt++;
+    // Drop the wake-up left by the abort, the next read stalls again
+    xSemaphoreTake(io->data_sem, 0);
+    io->aborted = false;
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t stall_io_prev_stop(void *handle)
+{
+    return stall_io_prev_close(handle);
+}
+
+TEST_CASE("Pipeline seek while the reader is blocked", "ESP_GMF_PIPELINE")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    swap_stream_t stream = {0};
+    stall_io_t io = {0};
+    io.data_sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(io.data_sem);
+    esp_gmf_io_init(&io, NULL);
+    io.base.seek = stall_io_seek;
+    io.base.prev_close = stall_io_prev_close;
+    EventGroupHandle_t evt = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(evt);
+
+    // [stall io]->copy->[sink]
+    esp_gmf_element_handle_t copy = swap_copy_new("copy_s");
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_create(&pipe));
+    esp_gmf_element_register_in_port(copy, NEW_ESP_GMF_PORT_IN_BYTE(stall_io_acquire, swap_src_release, NULL, &io,
+                                                                     SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_element_register_out_port(copy, NEW_ESP_GMF_PORT_OUT_BYTE(swap_sink_acquire, swap_sink_release, NULL, &stream,
+                                                                       SWAP_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+    esp_gmf_pipeline_register_el(pipe, copy);
+    esp_gmf_pipeline_set_io(pipe, &io, ESP_GMF_IO_DIR_READER);
+    esp_gmf_pipeline_set_prev_stop_cb(pipe, stall_io_prev_stop, &io);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_set_event(pipe, swap_pipeline_event, evt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    vTaskDelay(50 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(1, io.reads);
+
+    // The seek aborts the stalled read instead of waiting for data that never comes
+    for (int i = 1; i <= 3; i++) {
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_seek(pipe, i * 1000));
+        int seek_ms = (int)((esp_gmf_oal_sys_get_time_us() - start) / 1000);
+        ESP_LOGW(TAG, "Seek %d while the reader is blocked took %d ms", i, seek_ms);
+        TEST_ASSERT_LESS_THAN(500, seek_ms);
+        TEST_ASSERT_EQUAL(i, io.seek_cnt);
+        TEST_ASSERT_EQUAL(i * 1000, (int)io.seek_pos);
+        // The reader goes on from the new position and stalls again
+        vTaskDelay(20 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(i + 1, io.reads);
+    }
+    TEST_ASSERT_EQUAL(0, stream.consumed);
+
+    // The stop is not held off either, the previous stop callback aborts the read
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+    EventBits_t bits = xEventGroupWaitBits(evt, SWAP_FINISHED_BIT, pdTRUE, pdFALSE, pdMS_TO_TICKS(1000));
+    TEST_ASSERT_TRUE(bits & SWAP_FINISHED_BIT);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    // The IO lives on the stack, keep the pipeline off it
+    esp_gmf_pipeline_set_io(pipe, NULL, ESP_GMF_IO_DIR_READER);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    esp_gmf_io_deinit(&io);
+    vSemaphoreDelete(io.data_sem);
+    vEventGroupDelete(evt);
+    ESP_GMF_MEM_SHOW(TAG);
+}
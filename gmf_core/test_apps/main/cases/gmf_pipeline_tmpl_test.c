@@ -0,0 +1,279 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_pool.h"
+#include "esp_gmf_task.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_payload_pool.h"
+#include "esp_gmf_node.h"
+#include "esp_gmf_clock.h"
+#include "gmf_fake_io.h"
+#include "gmf_fake_dec.h"
+
+#define TMPL_BENCH_LOOP (200)
+
+static const char *TAG = "TEST_ESP_GMF_PIPE_TMPL";
+
+static esp_gmf_err_t tmpl_pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
+{
+    return ESP_GMF_ERR_OK;
+}
+
+static void tmpl_pool_register(esp_gmf_pool_handle_t pool)
+{
+    fake_io_cfg_t io_cfg = FAKE_IO_CFG_DEFAULT();
+    io_cfg.dir = ESP_GMF_IO_DIR_READER;
+    esp_gmf_io_handle_t io = NULL;
+    fake_io_init(&io_cfg, &io);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, io, NULL));
+    io_cfg.dir = ESP_GMF_IO_DIR_WRITER;
+    fake_io_init(&io_cfg, &io);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, io, NULL));
+
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    for (int i = 0; i < sizeof(name) / sizeof(char *); i++) {
+        fake_dec_cfg_t dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+        dec_cfg.name = name[i];
+        esp_gmf_element_handle_t dec = NULL;
+        fake_dec_init(&dec_cfg, &dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, dec, NULL));
+    }
+}
+
+TEST_CASE("Pipeline template, build, recycle and reuse", "ESP_GMF_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    tmpl_pool_register(pool);
+
+    esp_gmf_pool_tmpl_handle_t tmpl = NULL;
+    const char *bad_name[] = {"dec1", "dec9"};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pool_new_template(pool, "file", bad_name, 2, "file", 1, &tmpl));
+    TEST_ASSERT_NULL(tmpl);
+    char name_buf[3][8] = {"dec1", "dec2", "dec3"};
+    const char *name[] = {name_buf[0], name_buf[1], name_buf[2]};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_template(pool, "file", name, 3, "file", 1, &tmpl));
+    // The template keeps its own copy of the names
+    memset(name_buf, 0, sizeof(name_buf));
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &pipe));
+    TEST_ASSERT_NOT_NULL(pipe);
+    TEST_ASSERT_NOT_NULL(pipe->in);
+    TEST_ASSERT_NOT_NULL(pipe->out);
+    esp_gmf_element_handle_t el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec3", &el));
+    TEST_ASSERT_EQUAL_PTR(pipe->last_el, el);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, tmpl_pipeline_event, NULL);
+
+    // The recycled pipeline comes back detached and is handed out again
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_recycle(tmpl, pipe));
+    TEST_ASSERT_NULL(pipe->thread);
+    TEST_ASSERT_NULL(pipe->user_cb);
+    esp_gmf_pipeline_handle_t reused = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &reused));
+    TEST_ASSERT_EQUAL_PTR(pipe, reused);
+    esp_gmf_pipeline_handle_t pipe2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &pipe2));
+    TEST_ASSERT_NOT_EQUAL(pipe, pipe2);
+
+    esp_gmf_pool_tmpl_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_get_stats(tmpl, &stats));
+    TEST_ASSERT_EQUAL(2, stats.build_cnt);
+    TEST_ASSERT_EQUAL(1, stats.reuse_cnt);
+    TEST_ASSERT_EQUAL(0, stats.cached);
+
+    // Only one fits in the cache, the other one is destroyed
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_recycle(tmpl, reused));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_recycle(tmpl, pipe2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_get_stats(tmpl, &stats));
+    TEST_ASSERT_EQUAL(1, stats.cached);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_delete_template(tmpl));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Pipeline template, reuse after the payload pool of the last owner is destroyed", "ESP_GMF_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    tmpl_pool_register(pool);
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    esp_gmf_pool_tmpl_handle_t tmpl = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_template(pool, "file", name, 3, "file", 1, &tmpl));
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    esp_gmf_payload_pool_cfg_t pld_cfg = ESP_GMF_PAYLOAD_POOL_CFG_DEFAULT();
+    esp_gmf_payload_pool_handle_t pld_pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(&pld_cfg, &pld_pool));
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_payload_pool(pipe, pld_pool));
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+
+    // The recycled pipeline gives the pooled buffers back, so the pool can go before the pipeline is reused
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_recycle(tmpl, pipe));
+    TEST_ASSERT_NULL(pipe->payload_pool);
+    for (esp_gmf_element_handle_t el = pipe->head_el; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        TEST_ASSERT_NULL(ESP_GMF_ELEMENT_GET(el)->in->payload_pool);
+        TEST_ASSERT_NULL(ESP_GMF_ELEMENT_GET(el)->out->payload_pool);
+    }
+    esp_gmf_payload_pool_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pld_pool, &stats));
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pld_pool));
+
+    esp_gmf_pipeline_handle_t reused = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &reused));
+    TEST_ASSERT_EQUAL_PTR(pipe, reused);
+    esp_gmf_pipeline_bind_task(reused, work_task);
+    esp_gmf_pipeline_loading_jobs(reused);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(reused));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(reused));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(reused));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_delete_template(tmpl));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Pipeline template, recycle detaches the pipeline from its clock", "ESP_GMF_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    tmpl_pool_register(pool);
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    esp_gmf_pool_tmpl_handle_t tmpl = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_template(pool, "file", name, 3, "file", 1, &tmpl));
+
+    esp_gmf_clock_cfg_t clock_cfg = DEFAULT_ESP_GMF_CLOCK_CONFIG();
+    clock_cfg.master = ESP_GMF_CLOCK_MASTER_PIPELINE;
+    esp_gmf_clock_handle_t clock = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_clock_create(&clock_cfg, &clock));
+    esp_gmf_clock_sync_cfg_t sync_cfg = {.role = ESP_GMF_CLOCK_ROLE_MASTER};
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_clock(pipe, clock, &sync_cfg));
+    TEST_ASSERT_NOT_NULL(ESP_GMF_ELEMENT_GET(pipe->last_el)->out->clock_sync);
+
+    // The master seat is free again once the pipeline is recycled
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_recycle(tmpl, pipe));
+    TEST_ASSERT_NULL(pipe->clock_sync);
+    TEST_ASSERT_NULL(ESP_GMF_ELEMENT_GET(pipe->last_el)->out->clock_sync);
+    esp_gmf_clock_report_t report = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_get_clock_report(pipe, &report));
+    esp_gmf_pipeline_handle_t pipe2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_template_new_pipeline(tmpl, &pipe2));
+    TEST_ASSERT_EQUAL_PTR(pipe, pipe2);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_clock(pipe2, clock, &sync_cfg));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_clock(pipe2, NULL, NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_clock_destroy(clock));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_delete_template(tmpl));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Pipeline template, startup time of cold, template and recycled builds", "ESP_GMF_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    tmpl_pool_register(pool);
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    esp_gmf_pool_tmpl_handle_t tmpl = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_template(pool, "file", name, 3, "file", 0, &tmpl));
+    esp_gmf_pool_tmpl_handle_t cache_tmpl = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_template(pool, "file", name, 3, "file", 1, &cache_tmpl));
+
+    // Only the time to get a ready pipeline is counted, not the time to give it back
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    int64_t cost_us[3] = {0};
+    for (int i = 0; i < TMPL_BENCH_LOOP; i++) {
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        esp_gmf_pool_new_pipeline(pool, "file", name, 3, "file", &pipe);
+        cost_us[0] += esp_gmf_oal_sys_get_time_us() - start;
+        TEST_ASSERT_NOT_NULL(pipe);
+        esp_gmf_pipeline_destroy(pipe);
+        pipe = NULL;
+
+        start = esp_gmf_oal_sys_get_time_us();
+        esp_gmf_pool_template_new_pipeline(tmpl, &pipe);
+        cost_us[1] += esp_gmf_oal_sys_get_time_us() - start;
+        TEST_ASSERT_NOT_NULL(pipe);
+        esp_gmf_pool_template_recycle(tmpl, pipe);
+        pipe = NULL;
+
+        start = esp_gmf_oal_sys_get_time_us();
+        esp_gmf_pool_template_new_pipeline(cache_tmpl, &pipe);
+        cost_us[2] += esp_gmf_oal_sys_get_time_us() - start;
+        TEST_ASSERT_NOT_NULL(pipe);
+        esp_gmf_pool_template_recycle(cache_tmpl, pipe);
+        pipe = NULL;
+    }
+    ESP_LOGW(TAG, "Build %d pipelines of 3 elements, cold:%lld us, template:%lld us, recycled:%lld us (per build)",
+             TMPL_BENCH_LOOP, cost_us[0] / TMPL_BENCH_LOOP, cost_us[1] / TMPL_BENCH_LOOP, cost_us[2] / TMPL_BENCH_LOOP);
+    esp_gmf_pool_tmpl_stats_t stats = {0};
+    esp_gmf_pool_template_get_stats(cache_tmpl, &stats);
+    TEST_ASSERT_EQUAL(1, stats.build_cnt);
+    TEST_ASSERT_EQUAL(TMPL_BENCH_LOOP - 1, stats.reuse_cnt);
+    TEST_ASSERT_LESS_THAN(cost_us[0], cost_us[2]);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_delete_template(cache_tmpl));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_delete_template(tmpl));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
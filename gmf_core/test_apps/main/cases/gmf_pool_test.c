@@ -27,6 +27,7 @@
 #include "freertos/event_groups.h"
 
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 
 #include "esp_gmf_element.h"
 #include "esp_gmf_pipeline.h"
@@ -34,7 +35,9 @@
 #include "esp_gmf_data_bus.h"
 
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_new_databus.h"
+#include "esp_gmf_payload_pool.h"
 #include "gmf_fake_io.h"
 #include "gmf_fake_dec.h"
 #include "gmf_ut_common.h"
@@ -314,6 +317,53 @@ TEST_CASE("One Pipe, [FILE->dec->dec->dec->FILE]", "ELEMENT_POOL")
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
 }
 
+TEST_CASE("One Pipe on executor task, [FILE->dec->dec->dec->FILE]", "ELEMENT_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    // The pipeline jobs share one chain, so the helper workers stay idle and the order equals the single thread mode
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    cfg.thread.worker_num = 2;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    EventGroupHandle_t pipe_sync_evt = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(pipe_sync_evt);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _pipeline_event, pipe_sync_evt);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+    esp_gmf_pipeline_set_out_uri(pipe, "/sdcard/esp_gmf_ut_test_out.mp3");
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    vTaskDelay(300 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_pause(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_resume(pipe));
+    vTaskDelay(300 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+    EventBits_t bits = xEventGroupWaitBits(pipe_sync_evt, PIPELINE_BLOCK_BIT, pdTRUE, pdFALSE, 1000 / portTICK_PERIOD_MS);
+    TEST_ASSERT_TRUE(bits & PIPELINE_BLOCK_BIT);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    vEventGroupDelete(pipe_sync_evt);
+}
+
 TEST_CASE("One Pipe, [FILE->dec->FILE]", "ELEMENT_POOL")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
@@ -358,6 +408,63 @@ TEST_CASE("One Pipe, [FILE->dec->FILE]", "ELEMENT_POOL")
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
 }
 
+TEST_CASE("Element statistics of a running pipeline, [FILE->dec->FILE]", "ELEMENT_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+    esp_gmf_pipeline_set_out_uri(pipe, "/sdcard/esp_gmf_ut_test_out.mp3");
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    vTaskDelay(2000 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+
+    esp_gmf_element_handle_t dec_el = NULL;
+    esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &dec_el);
+    TEST_ASSERT_NOT_NULL(dec_el);
+    esp_gmf_element_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_get_stats(dec_el, &stats));
+    ESP_LOGI(TAG, "dec1 stats, calls:%ld, frames:%ld, in:%lld, out:%lld, p50:%ld us, p99:%ld us, max:%ld us", (long)stats.call_cnt,
+             (long)stats.frame_cnt, stats.in_bytes, stats.out_bytes, (long)stats.p50_us, (long)stats.p99_us, (long)stats.max_us);
+    TEST_ASSERT_GREATER_THAN(0, stats.call_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.frame_cnt);
+    TEST_ASSERT_TRUE(stats.in_bytes > 0);
+    TEST_ASSERT_TRUE(stats.out_bytes > 0);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.p99_us, stats.p50_us);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.max_us, stats.p99_us);
+
+    // Cleared counters start over
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_reset_stats(dec_el));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_get_stats(dec_el, &stats));
+    TEST_ASSERT_EQUAL(0, stats.call_cnt);
+    TEST_ASSERT_EQUAL(0, stats.frame_cnt);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
+
 TEST_CASE("IN-OUT Different payload, [FILE->dec->FILE]", "ELEMENT_PORT")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
@@ -611,3 +718,182 @@ TEST_CASE("Un-Shared port, Same payload, [FILE->dec->FILE]", "ELEMENT_PORT")
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
 }
+
+TEST_CASE("Restart pipeline without job heap allocation, [FILE->dec->FILE]", "ELEMENT_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_set_event(pipe, _pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+    esp_gmf_pipeline_set_out_uri(pipe, "/sdcard/esp_gmf_ut_test_out.mp3");
+
+    esp_gmf_task_job_stats_t warm = {0};
+    size_t free_size = 0;
+    for (int i = 0; i < 10000 + 2; i++) {
+        esp_gmf_pipeline_reset(pipe);
+        esp_gmf_pipeline_loading_jobs(pipe);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        // The first two loops intern the labels and warm up the elements
+        if (i == 1) {
+            esp_gmf_task_get_job_stats(work_task, &warm);
+            free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        }
+    }
+    esp_gmf_task_job_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_get_job_stats(work_task, &stats));
+    ESP_LOGW(TAG, "Job slab, cap:%d, in use:%d, high water:%d, labels:%d, overflow:%lu, heap before:%d, after:%d",
+             stats.capacity, stats.in_use, stats.high_water, stats.label_num, (unsigned long)stats.overflow,
+             (int)free_size, (int)heap_caps_get_free_size(MALLOC_CAP_8BIT));
+    TEST_ASSERT_EQUAL(0, stats.overflow);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(warm.label_num, stats.label_num);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.capacity, stats.high_water);
+    TEST_ASSERT_GREATER_OR_EQUAL(free_size, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Restart pipeline with shared payload pool, [FILE->dec->FILE]", "ELEMENT_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func(pool);
+
+    esp_gmf_payload_pool_cfg_t pld_cfg = ESP_GMF_PAYLOAD_POOL_CFG_DEFAULT();
+    esp_gmf_payload_pool_handle_t pld_pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(&pld_cfg, &pld_pool));
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_payload_pool(pipe, pld_pool));
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_set_event(pipe, _pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+    esp_gmf_pipeline_set_out_uri(pipe, "/sdcard/esp_gmf_ut_test_out.mp3");
+
+    esp_gmf_payload_pool_stats_t warm = {0};
+    size_t free_size = 0;
+    for (int i = 0; i < 1000 + 2; i++) {
+        esp_gmf_pipeline_reset(pipe);
+        esp_gmf_pipeline_loading_jobs(pipe);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        if (i == 1) {
+            esp_gmf_payload_pool_get_stats(pld_pool, &warm);
+            free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        }
+    }
+    esp_gmf_payload_pool_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pld_pool, &stats));
+    ESP_LOGW(TAG, "Payload pool, hit:%ld, miss:%ld, in use:%ld, peak:%ld, heap before:%d, after:%d",
+             stats.hit_cnt, stats.miss_cnt, stats.in_use, stats.peak_use,
+             (int)free_size, (int)heap_caps_get_free_size(MALLOC_CAP_8BIT));
+    TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(warm.miss_cnt, stats.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(free_size, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    // All the port payloads are returned on destroy
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pld_pool, &stats));
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pld_pool));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+#define POOL_BENCH_OBJ_NUM  (200)
+#define POOL_BENCH_PIPE_NUM (1000)
+
+static int64_t pool_bench_build(esp_gmf_pool_handle_t pool, const char *in, const char **name, int name_num, const char *out)
+{
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    for (int i = 0; i < POOL_BENCH_PIPE_NUM; i++) {
+        esp_gmf_pipeline_handle_t pipe = NULL;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, in, name, name_num, out, &pipe));
+        esp_gmf_pipeline_destroy(pipe);
+    }
+    return esp_gmf_oal_sys_get_time_us() - start;
+}
+
+TEST_CASE("Pipeline build time over registered objects", "ELEMENT_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    // Register 200 objects in total, most of them are elements and a few are IOs
+    char tag[16];
+    fake_io_cfg_t io_cfg = FAKE_IO_CFG_DEFAULT();
+    int obj_cnt = 0;
+    for (int i = 0; i < 10; i++, obj_cnt += 2) {
+        esp_gmf_io_handle_t io = NULL;
+        snprintf(tag, sizeof(tag), "io_%d", i);
+        io_cfg.dir = ESP_GMF_IO_DIR_READER;
+        fake_io_init(&io_cfg, &io);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, io, tag));
+        io_cfg.dir = ESP_GMF_IO_DIR_WRITER;
+        fake_io_init(&io_cfg, &io);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, io, tag));
+    }
+    fake_dec_cfg_t dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    for (int i = 0; obj_cnt < POOL_BENCH_OBJ_NUM; i++, obj_cnt++) {
+        esp_gmf_element_handle_t dec = NULL;
+        snprintf(tag, sizeof(tag), "dec_%d", i);
+        fake_dec_init(&dec_cfg, &dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, dec, tag));
+    }
+    // Lookups are case-insensitive
+    esp_gmf_element_handle_t el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_element(pool, "DEC_7", &el));
+    TEST_ASSERT_EQUAL_STRING("dec_7", OBJ_GET_TAG(el));
+    esp_gmf_obj_delete(el);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pool_new_element(pool, "dec_1000", &el));
+
+    const char *first[] = {"dec_0", "dec_1", "dec_2"};
+    const char *last[] = {"dec_177", "dec_178", "dec_179"};
+    int64_t first_us = pool_bench_build(pool, "io_0", first, 3, "io_0");
+    int64_t last_us = pool_bench_build(pool, "io_9", last, 3, "io_9");
+    ESP_LOGW(TAG, "Build %d pipelines from %d objects, first registered:%lld us, last registered:%lld us, avg:%lld us",
+             POOL_BENCH_PIPE_NUM, POOL_BENCH_OBJ_NUM, first_us, last_us, last_us / POOL_BENCH_PIPE_NUM);
+    // The lookup cost must not depend on the registration position
+    TEST_ASSERT_LESS_THAN(first_us * 5 / 4 + 1000, last_us);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
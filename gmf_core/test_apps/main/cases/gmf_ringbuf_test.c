@@ -29,6 +29,7 @@
 #include "esp_log.h"
 
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_ringbuffer.h"
 #include "gmf_ut_common.h"
 
@@ -37,6 +38,17 @@ static bool        is_done;
 static bool        read_run;
 static bool        write_run;
 
+#define RB_BENCH_TOTAL_SIZE (1024 * 1024)
+
+typedef struct {
+    esp_gmf_rb_handle_t  rb;
+    bool                 zero_copy;
+    uint32_t             chunk;
+    int                  err_cnt;
+    volatile bool        read_done;
+    volatile bool        write_done;
+} rb_bench_t;
+
 static const char *file_name  = "/sdcard/gmf_ut_test.mp3";
 static const char *file2_name = "/sdcard/gmf_ut_test_out.mp3";
 
@@ -153,3 +165,161 @@ TEST_CASE("Ringbuffer read and write on different task", "ESP_GMF_RINGBUF")
     esp_gmf_ut_teardown_sdmmc(card);
     vTaskDelay(10 / portTICK_PERIOD_MS);
 }
+
+static void zc_fill(esp_gmf_rb_handle_t rb, uint8_t *pattern, uint32_t len)
+{
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(len, esp_gmf_rb_acquire_write(rb, &blk, len, 0));
+    for (int i = 0; i < len; i++) {
+        blk.buf[i] = (*pattern)++;
+    }
+    blk.valid_size = len;
+    TEST_ASSERT_EQUAL(len, esp_gmf_rb_release_write(rb, &blk, 0));
+}
+
+static void zc_check(esp_gmf_rb_handle_t rb, uint8_t *pattern, uint32_t wanted, int expected)
+{
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(expected, esp_gmf_rb_acquire_read(rb, &blk, wanted, 0));
+    TEST_ASSERT_EQUAL(expected, blk.valid_size);
+    for (int i = 0; i < expected; i++) {
+        TEST_ASSERT_EQUAL_HEX8((*pattern)++, blk.buf[i]);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_release_read(rb, &blk, 0));
+}
+
+TEST_CASE("Ringbuffer zero-copy acquire across the wrap point", "ESP_GMF_RINGBUF")
+{
+    esp_gmf_rb_handle_t rb = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_rb_create_zero_copy(16, 4, 65, &rb));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_create_zero_copy(16, 4, 24, &rb));
+    uint8_t wr_pattern = 0;
+    uint8_t rd_pattern = 0;
+
+    // Requests larger than the chunk size are clamped
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(24, esp_gmf_rb_acquire_write(rb, &blk, 40, 0));
+    blk.valid_size = 0;
+    esp_gmf_rb_release_write(rb, &blk, 0);
+
+    zc_fill(rb, &wr_pattern, 24);
+    zc_fill(rb, &wr_pattern, 24);
+    zc_check(rb, &rd_pattern, 24, 24);
+    // The writable region crosses the end, it is folded back on release
+    zc_fill(rb, &wr_pattern, 24);
+    zc_check(rb, &rd_pattern, 24, 24);
+    // The readable region crosses the end, it is mirrored to stay contiguous
+    zc_check(rb, &rd_pattern, 24, 24);
+
+    // Partial data is handed out in multiple of 4 bytes until writing is done
+    zc_fill(rb, &wr_pattern, 6);
+    zc_check(rb, &rd_pattern, 8, 4);
+    esp_gmf_rb_done_write(rb);
+    blk.is_last = false;
+    TEST_ASSERT_EQUAL(2, esp_gmf_rb_acquire_read(rb, &blk, 8, 0));
+    TEST_ASSERT_TRUE(blk.is_last);
+    TEST_ASSERT_EQUAL_HEX8(rd_pattern++, blk.buf[0]);
+    TEST_ASSERT_EQUAL_HEX8(rd_pattern++, blk.buf[1]);
+    esp_gmf_rb_release_read(rb, &blk, 0);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_read(rb, &blk, 8, 0));
+
+    esp_gmf_rb_reset(rb);
+    esp_gmf_rb_abort(rb);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_rb_acquire_read(rb, &blk, 8, portMAX_DELAY));
+    esp_gmf_rb_destroy(rb);
+}
+
+static void rb_bench_write_task(void *param)
+{
+    rb_bench_t *b = (rb_bench_t *)param;
+    uint8_t *buf = b->zero_copy ? NULL : esp_gmf_oal_malloc(b->chunk);
+    uint8_t pattern = 0;
+    uint32_t sent = 0;
+    esp_gmf_data_bus_block_t blk = {0};
+    while (sent < RB_BENCH_TOTAL_SIZE) {
+        if (b->zero_copy == false) {
+            blk.buf = buf;
+            blk.buf_length = b->chunk;
+        }
+        int ret = esp_gmf_rb_acquire_write(b->rb, &blk, b->chunk, portMAX_DELAY);
+        if (ret != b->chunk || blk.buf == NULL) {
+            b->err_cnt++;
+            break;
+        }
+        for (int i = 0; i < b->chunk; i++) {
+            blk.buf[i] = pattern++;
+        }
+        blk.valid_size = b->chunk;
+        esp_gmf_rb_release_write(b->rb, &blk, portMAX_DELAY);
+        sent += b->chunk;
+    }
+    if (buf) {
+        esp_gmf_oal_free(buf);
+    }
+    b->write_done = true;
+    vTaskDelete(NULL);
+}
+
+static void rb_bench_read_task(void *param)
+{
+    rb_bench_t *b = (rb_bench_t *)param;
+    uint8_t *buf = b->zero_copy ? NULL : esp_gmf_oal_malloc(b->chunk);
+    uint8_t pattern = 0;
+    uint32_t received = 0;
+    esp_gmf_data_bus_block_t blk = {0};
+    while (received < RB_BENCH_TOTAL_SIZE) {
+        if (b->zero_copy == false) {
+            blk.buf = buf;
+            blk.buf_length = b->chunk;
+        }
+        int ret = esp_gmf_rb_acquire_read(b->rb, &blk, b->chunk, portMAX_DELAY);
+        if (ret <= 0) {
+            b->err_cnt++;
+            break;
+        }
+        for (int i = 0; i < blk.valid_size; i++) {
+            if (blk.buf[i] != pattern++) {
+                b->err_cnt++;
+            }
+        }
+        received += blk.valid_size;
+        esp_gmf_rb_release_read(b->rb, &blk, portMAX_DELAY);
+    }
+    if (buf) {
+        esp_gmf_oal_free(buf);
+    }
+    b->read_done = true;
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Ringbuffer copy and zero-copy throughput", "ESP_GMF_RINGBUF")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    const uint32_t chunks[] = {256, 1024, 4096};
+    for (int i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        int64_t speed[2] = {0};
+        for (int zc = 0; zc < 2; zc++) {
+            rb_bench_t b = {
+                .zero_copy = zc,
+                .chunk = chunks[i],
+            };
+            if (zc) {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_create_zero_copy(4096, 4, 4096, &b.rb));
+            } else {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_create(4096, 4, &b.rb));
+            }
+            int64_t start = esp_gmf_oal_sys_get_time_us();
+            xTaskCreatePinnedToCore(rb_bench_write_task, "rb_wr", 4096, &b, 5, NULL, 0);
+            xTaskCreatePinnedToCore(rb_bench_read_task, "rb_rd", 4096, &b, 5, NULL, portNUM_PROCESSORS > 1 ? 1 : 0);
+            while (!(b.read_done && b.write_done)) {
+                vTaskDelay(1);
+            }
+            int64_t elapsed = esp_gmf_oal_sys_get_time_us() - start;
+            TEST_ASSERT_EQUAL(0, b.err_cnt);
+            speed[zc] = (int64_t)RB_BENCH_TOTAL_SIZE * 1000000 / 1024 / (elapsed > 0 ? elapsed : 1);
+            esp_gmf_rb_destroy(b.rb);
+        }
+        // The copy mode moves every byte twice through the ring, the zero-copy mode only mirrors the wrapped part
+        ESP_LOGI(TAG, "Chunk %ld, copy: %lld KB/s, zero-copy: %lld KB/s", chunks[i], speed[0], speed[1]);
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_share.h"
+
+#define SHARE_TEST_BUF_SIZE (64)
+
+typedef struct {
+    int      cnt;
+    uint8_t *last;
+} share_test_release_t;
+
+static const char *TAG = "TEST_ESP_GMF_SHARE";
+
+static void share_test_released(uint8_t *buf, void *ctx)
+{
+    share_test_release_t *rel = (share_test_release_t *)ctx;
+    rel->cnt++;
+    rel->last = buf;
+}
+
+static void share_test_write(esp_gmf_share_handle_t share, uint8_t *buf, int len, bool is_last)
+{
+    esp_gmf_data_bus_block_t blk = {
+        .buf = buf,
+        .buf_length = len,
+        .valid_size = len,
+        .is_last = is_last,
+    };
+    TEST_ASSERT_EQUAL(len, esp_gmf_share_acquire_write(share, &blk, len, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_share_release_write(share, &blk, 0));
+}
+
+TEST_CASE("Share bus, pass the buffer by reference", "ESP_GMF_SHARE")
+{
+    ESP_GMF_MEM_SHOW(TAG);
+    uint8_t buf[2][SHARE_TEST_BUF_SIZE];
+    memset(buf[0], 0x11, SHARE_TEST_BUF_SIZE);
+    memset(buf[1], 0x22, SHARE_TEST_BUF_SIZE);
+    share_test_release_t rel = {0};
+    esp_gmf_share_handle_t share = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_share_create(0, 0, &share));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_create(2, 0, &share));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_set_release_cb(share, share_test_released, &rel));
+
+    // The writer must provide the buffer
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_share_acquire_write(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+
+    share_test_write(share, buf[0], SHARE_TEST_BUF_SIZE, false);
+    share_test_write(share, buf[1], SHARE_TEST_BUF_SIZE / 2, true);
+    // Both slots are in use, so the writer times out like a reader waiting on an empty bus
+    blk.buf = buf[0];
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_share_acquire_write(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+    uint32_t size = 0;
+    esp_gmf_share_get_filled_size(share, &size);
+    TEST_ASSERT_EQUAL(SHARE_TEST_BUF_SIZE + SHARE_TEST_BUF_SIZE / 2, size);
+
+    memset(&blk, 0, sizeof(blk));
+    TEST_ASSERT_EQUAL(SHARE_TEST_BUF_SIZE, esp_gmf_share_acquire_read(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+    TEST_ASSERT_EQUAL_PTR(buf[0], blk.buf);
+    TEST_ASSERT_EQUAL(0, rel.cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_share_release_read(share, &blk, 0));
+    TEST_ASSERT_EQUAL(1, rel.cnt);
+    TEST_ASSERT_EQUAL_PTR(buf[0], rel.last);
+
+    TEST_ASSERT_EQUAL(SHARE_TEST_BUF_SIZE / 2, esp_gmf_share_acquire_read(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+    TEST_ASSERT_EQUAL_PTR(buf[1], blk.buf);
+    TEST_ASSERT_TRUE(blk.is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_share_release_read(share, &blk, 0));
+    TEST_ASSERT_EQUAL(2, rel.cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_share_acquire_read(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+
+    // The references not read yet go back to the writer on reclaim, the one being read is kept
+    share_test_write(share, buf[0], SHARE_TEST_BUF_SIZE, false);
+    share_test_write(share, buf[1], SHARE_TEST_BUF_SIZE, false);
+    TEST_ASSERT_EQUAL(SHARE_TEST_BUF_SIZE, esp_gmf_share_acquire_read(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+    int dropped = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_reclaim(share, &dropped));
+    TEST_ASSERT_EQUAL(1, dropped);
+    TEST_ASSERT_EQUAL(3, rel.cnt);
+    TEST_ASSERT_EQUAL_PTR(buf[1], rel.last);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_share_release_read(share, &blk, 0));
+    TEST_ASSERT_EQUAL(4, rel.cnt);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_done_write(share));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_share_acquire_read(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+    TEST_ASSERT_TRUE(blk.is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_reset(share));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_abort(share));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_share_acquire_read(share, &blk, SHARE_TEST_BUF_SIZE, 0));
+
+    // Destroy hands the pending references back
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_reset(share));
+    share_test_write(share, buf[0], SHARE_TEST_BUF_SIZE, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_destroy(share));
+    TEST_ASSERT_EQUAL(5, rel.cnt);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Share bus, copy on write", "ESP_GMF_SHARE")
+{
+    ESP_GMF_MEM_SHOW(TAG);
+    uint8_t buf[SHARE_TEST_BUF_SIZE * 2];
+    memset(buf, 0x5A, sizeof(buf));
+    share_test_release_t rel = {0};
+    esp_gmf_share_handle_t share = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_create(1, SHARE_TEST_BUF_SIZE, &share));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_set_release_cb(share, share_test_released, &rel));
+
+    // The copy grows when the shared buffer is larger than the copy-on-write size
+    for (int len = SHARE_TEST_BUF_SIZE / 2; len <= sizeof(buf); len *= 2) {
+        share_test_write(share, buf, len, false);
+        esp_gmf_data_bus_block_t blk = {0};
+        TEST_ASSERT_EQUAL(len, esp_gmf_share_acquire_read(share, &blk, len, 0));
+        TEST_ASSERT_TRUE(blk.buf != buf);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(buf, blk.buf, len);
+        // The writer gets its buffer back before the reader is done
+        TEST_ASSERT_EQUAL_PTR(buf, rel.last);
+        memset(blk.buf, 0, len);
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_share_release_read(share, &blk, 0));
+        TEST_ASSERT_EQUAL(0x5A, buf[len - 1]);
+    }
+    TEST_ASSERT_EQUAL(3, rel.cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_share_destroy(share));
+    ESP_GMF_MEM_SHOW(TAG);
+}
@@ -0,0 +1,353 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_random.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_spsc_ring.h"
+#include "esp_gmf_new_databus.h"
+
+#define SPSC_TEST_TOTAL_SIZE   (256 * 1024)
+#define SPSC_TEST_CHUNK_MAX    (1500)
+#define BENCH_TOTAL_SIZE       (1024 * 1024)
+#define BENCH_BLOCK_CNT        (4)
+#define BENCH_READER_CORE      (portNUM_PROCESSORS > 1 ? 1 : 0)
+
+static const char *TAG = "TEST_ESP_GMF_SPSC";
+
+typedef struct {
+    esp_gmf_spsc_ring_handle_t  rb;
+    uint32_t                    total;      /*!< Bytes to be transferred */
+    uint32_t                    checked;    /*!< Bytes received and verified by the reader */
+    int                         err_cnt;    /*!< Unexpected return values and data mismatches */
+    volatile bool               read_done;
+    volatile bool               write_done;
+} spsc_test_t;
+
+typedef struct {
+    const char          *name;
+    esp_gmf_db_handle_t  db;
+    uint32_t             frame_size;
+    uint32_t             total;
+    int64_t              start_us;
+    int64_t              end_us;
+    int64_t              latency_sum;  /*!< Sum of the per frame latency in microseconds */
+    int64_t              latency_max;
+    uint32_t             frame_cnt;
+    int                  err_cnt;
+    volatile bool        read_done;
+    volatile bool        write_done;
+} bus_bench_t;
+
+static void spsc_writer_task(void *param)
+{
+    spsc_test_t *t = (spsc_test_t *)param;
+    uint8_t *buf = esp_gmf_oal_malloc(SPSC_TEST_CHUNK_MAX);
+    ESP_GMF_MEM_CHECK(TAG, buf, goto _writer_exit);
+    uint8_t pattern = 0;
+    uint32_t sent = 0;
+    esp_gmf_data_bus_block_t blk = {0};
+    while (sent < t->total) {
+        uint32_t len = 1 + esp_random() % SPSC_TEST_CHUNK_MAX;
+        if (len > t->total - sent) {
+            len = t->total - sent;
+        }
+        for (int i = 0; i < len; i++) {
+            buf[i] = pattern++;
+        }
+        blk.buf = buf;
+        blk.buf_length = SPSC_TEST_CHUNK_MAX;
+        blk.valid_size = len;
+        blk.is_last = (sent + len == t->total);
+        esp_gmf_spsc_ring_acquire_write(t->rb, &blk, len, portMAX_DELAY);
+        int ret = esp_gmf_spsc_ring_release_write(t->rb, &blk, portMAX_DELAY);
+        if (ret != len) {
+            ESP_LOGE(TAG, "Write returned %d, expected %ld", ret, len);
+            t->err_cnt++;
+            break;
+        }
+        sent += len;
+    }
+_writer_exit:
+    if (buf) {
+        esp_gmf_oal_free(buf);
+    }
+    t->write_done = true;
+    vTaskDelete(NULL);
+}
+
+static void spsc_reader_task(void *param)
+{
+    spsc_test_t *t = (spsc_test_t *)param;
+    uint8_t *buf = esp_gmf_oal_malloc(SPSC_TEST_CHUNK_MAX);
+    ESP_GMF_MEM_CHECK(TAG, buf, goto _reader_exit);
+    uint8_t pattern = 0;
+    esp_gmf_data_bus_block_t blk = {0};
+    while (1) {
+        blk.buf = buf;
+        blk.buf_length = SPSC_TEST_CHUNK_MAX;
+        int ret = esp_gmf_spsc_ring_acquire_read(t->rb, &blk, 1 + esp_random() % SPSC_TEST_CHUNK_MAX, portMAX_DELAY);
+        if (ret < 0) {
+            ESP_LOGE(TAG, "Read returned %d", ret);
+            t->err_cnt++;
+            break;
+        }
+        for (int i = 0; i < blk.valid_size; i++) {
+            if (buf[i] != pattern++) {
+                t->err_cnt++;
+            }
+        }
+        t->checked += blk.valid_size;
+        esp_gmf_spsc_ring_release_read(t->rb, &blk, 0);
+        if (blk.is_last) {
+            break;
+        }
+    }
+_reader_exit:
+    if (buf) {
+        esp_gmf_oal_free(buf);
+    }
+    t->read_done = true;
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("SPSC ring read and write on different task", "ESP_GMF_SPSC_RING")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    // Odd ring size to exercise the wrap around with unaligned positions
+    uint32_t sizes[][2] = {{1, 1021}, {512, 4}, {4096, 2}};
+    for (int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        spsc_test_t t = {
+            .total = SPSC_TEST_TOTAL_SIZE,
+        };
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_ring_create(sizes[i][0], sizes[i][1], &t.rb));
+        TEST_ASSERT_NOT_NULL(t.rb);
+        xTaskCreatePinnedToCore(spsc_writer_task, "spsc_wr", 4096, &t, 5, NULL, 0);
+        xTaskCreatePinnedToCore(spsc_reader_task, "spsc_rd", 4096, &t, 5, NULL, BENCH_READER_CORE);
+        while (!(t.read_done && t.write_done)) {
+            vTaskDelay(10 / portTICK_PERIOD_MS);
+        }
+        ESP_LOGI(TAG, "Ring %ld x %ld, checked %ld bytes, errors:%d", sizes[i][0], sizes[i][1], t.checked, t.err_cnt);
+        TEST_ASSERT_EQUAL(0, t.err_cnt);
+        TEST_ASSERT_EQUAL(SPSC_TEST_TOTAL_SIZE, t.checked);
+        esp_gmf_spsc_ring_destroy(t.rb);
+    }
+}
+
+TEST_CASE("SPSC ring abort, done and reset", "ESP_GMF_SPSC_RING")
+{
+    esp_gmf_spsc_ring_handle_t rb = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_ring_create(16, 4, &rb));
+    uint8_t buf[80] = {0};
+    uint32_t size = 0;
+    esp_gmf_data_bus_block_t blk = {.buf = buf, .buf_length = sizeof(buf), .valid_size = 64};
+
+    // Fill the ring and check that a full ring times out
+    TEST_ASSERT_EQUAL(64, esp_gmf_spsc_ring_release_write(rb, &blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_ring_bytes_filled(rb, &size));
+    TEST_ASSERT_EQUAL(64, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_ring_bytes_available(rb, &size));
+    TEST_ASSERT_EQUAL(0, size);
+    blk.valid_size = 4;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_spsc_ring_release_write(rb, &blk, 1));
+
+    // Partial reads are rounded down to multiple of 4 bytes until the writer is done
+    blk.valid_size = 0;
+    TEST_ASSERT_EQUAL(62, esp_gmf_spsc_ring_acquire_read(rb, &blk, 62, 0));
+    blk.valid_size = 3;
+    TEST_ASSERT_EQUAL(3, esp_gmf_spsc_ring_release_write(rb, &blk, 0));
+    TEST_ASSERT_EQUAL(4, esp_gmf_spsc_ring_acquire_read(rb, &blk, 8, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_spsc_ring_acquire_read(rb, &blk, 8, 1));
+    esp_gmf_spsc_ring_done_write(rb);
+    TEST_ASSERT_EQUAL(1, esp_gmf_spsc_ring_acquire_read(rb, &blk, 8, 0));
+    TEST_ASSERT_TRUE(blk.is_last);
+    blk.is_last = false;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_spsc_ring_acquire_read(rb, &blk, 8, 0));
+    TEST_ASSERT_TRUE(blk.is_last);
+
+    // Abort wakes up the blocked reader
+    esp_gmf_spsc_ring_reset(rb);
+    blk.is_last = false;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_ring_bytes_filled(rb, &size));
+    TEST_ASSERT_EQUAL(0, size);
+    esp_gmf_spsc_ring_abort(rb);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_spsc_ring_acquire_read(rb, &blk, 8, portMAX_DELAY));
+    TEST_ASSERT_FALSE(blk.is_last);
+    esp_gmf_spsc_ring_destroy(rb);
+}
+
+static void bench_writer_task(void *param)
+{
+    bus_bench_t *b = (bus_bench_t *)param;
+    uint8_t *buf = esp_gmf_oal_malloc(b->frame_size);
+    ESP_GMF_MEM_CHECK(TAG, buf, { b->err_cnt++; goto _bench_writer_exit; });
+    memset(buf, 0x5A, b->frame_size);
+    esp_gmf_data_bus_block_t blk = {0};
+    uint32_t sent = 0;
+    b->start_us = esp_gmf_oal_sys_get_time_us();
+    while (sent < b->total) {
+        // The copy based buses take data from the caller buffer, the others hand out their own one
+        blk.buf = buf;
+        blk.buf_length = b->frame_size;
+        int ret = esp_gmf_db_acquire_write(b->db, &blk, b->frame_size, portMAX_DELAY);
+        if (ret == ESP_GMF_IO_FAIL) {
+            // Pointer buffer is full, wait for the reader
+            vTaskDelay(1);
+            continue;
+        }
+        if (ret < 0) {
+            b->err_cnt++;
+            break;
+        }
+        int64_t now = esp_gmf_oal_sys_get_time_us();
+        memcpy(blk.buf, &now, sizeof(now));
+        blk.valid_size = b->frame_size;
+        ret = esp_gmf_db_release_write(b->db, &blk, portMAX_DELAY);
+        if (ret < 0) {
+            b->err_cnt++;
+            break;
+        }
+        sent += b->frame_size;
+    }
+_bench_writer_exit:
+    if (buf) {
+        esp_gmf_oal_free(buf);
+    }
+    b->write_done = true;
+    vTaskDelete(NULL);
+}
+
+static void bench_reader_task(void *param)
+{
+    bus_bench_t *b = (bus_bench_t *)param;
+    uint8_t *buf = esp_gmf_oal_malloc(b->frame_size);
+    ESP_GMF_MEM_CHECK(TAG, buf, { b->err_cnt++; goto _bench_reader_exit; });
+    esp_gmf_data_bus_block_t blk = {0};
+    uint32_t received = 0;
+    // Every bus hands out whole frames here, so the timestamp is always at the head of the block
+    while (received < b->total) {
+        blk.buf = buf;
+        blk.buf_length = b->frame_size;
+        int ret = esp_gmf_db_acquire_read(b->db, &blk, b->frame_size, portMAX_DELAY);
+        if (ret == ESP_GMF_IO_FAIL) {
+            // Pointer buffer is empty, wait for the writer
+            vTaskDelay(1);
+            continue;
+        }
+        if (ret < 0 || blk.valid_size != b->frame_size) {
+            ESP_LOGE(TAG, "%s, read returned %d, valid:%d", b->name, ret, blk.valid_size);
+            b->err_cnt++;
+            break;
+        }
+        int64_t stamp = 0;
+        memcpy(&stamp, blk.buf, sizeof(stamp));
+        int64_t latency = esp_gmf_oal_sys_get_time_us() - stamp;
+        b->latency_sum += latency;
+        if (latency > b->latency_max) {
+            b->latency_max = latency;
+        }
+        b->frame_cnt++;
+        received += blk.valid_size;
+        esp_gmf_db_release_read(b->db, &blk, portMAX_DELAY);
+    }
+    b->end_us = esp_gmf_oal_sys_get_time_us();
+_bench_reader_exit:
+    if (buf) {
+        esp_gmf_oal_free(buf);
+    }
+    b->read_done = true;
+    vTaskDelete(NULL);
+}
+
+static int bench_new_ringbuf(int frame_size, int cnt, esp_gmf_db_handle_t *h)
+{
+    return esp_gmf_db_new_ringbuf(frame_size, cnt, h);
+}
+
+static int bench_new_spsc_ring(int frame_size, int cnt, esp_gmf_db_handle_t *h)
+{
+    return esp_gmf_db_new_spsc_ring(frame_size, cnt, h);
+}
+
+static int bench_new_block(int frame_size, int cnt, esp_gmf_db_handle_t *h)
+{
+    return esp_gmf_db_new_block(frame_size, cnt, h);
+}
+
+static int bench_new_fifo(int frame_size, int cnt, esp_gmf_db_handle_t *h)
+{
+    return esp_gmf_db_new_fifo(cnt, frame_size, h);
+}
+
+static int bench_new_pbuf(int frame_size, int cnt, esp_gmf_db_handle_t *h)
+{
+    return esp_gmf_db_new_pbuf(cnt, frame_size, h);
+}
+
+TEST_CASE("Data bus throughput and latency benchmark", "ESP_GMF_SPSC_RING")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_log_level_set(TAG, ESP_LOG_INFO);
+    const struct {
+        const char *name;
+        int (*new_db)(int frame_size, int cnt, esp_gmf_db_handle_t *h);
+    } buses[] = {
+        {"ringbuf", bench_new_ringbuf},
+        {"spsc_ring", bench_new_spsc_ring},
+        {"block", bench_new_block},
+        {"fifo", bench_new_fifo},
+        {"pbuf", bench_new_pbuf},
+    };
+    const uint32_t frame_sizes[] = {64, 256, 1024, 4096, 16384};
+    ESP_LOGI(TAG, "%-10s %8s %10s %10s %10s", "bus", "frame", "KB/s", "avg_us", "max_us");
+    for (int f = 0; f < sizeof(frame_sizes) / sizeof(frame_sizes[0]); f++) {
+        for (int i = 0; i < sizeof(buses) / sizeof(buses[0]); i++) {
+            bus_bench_t b = {
+                .name = buses[i].name,
+                .frame_size = frame_sizes[f],
+                .total = BENCH_TOTAL_SIZE,
+            };
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, buses[i].new_db(frame_sizes[f], BENCH_BLOCK_CNT, &b.db));
+            xTaskCreatePinnedToCore(bench_writer_task, "bench_wr", 4096, &b, 5, NULL, 0);
+            xTaskCreatePinnedToCore(bench_reader_task, "bench_rd", 4096, &b, 5, NULL, BENCH_READER_CORE);
+            while (!(b.read_done && b.write_done)) {
+                vTaskDelay(10 / portTICK_PERIOD_MS);
+            }
+            TEST_ASSERT_EQUAL(0, b.err_cnt);
+            TEST_ASSERT_EQUAL(BENCH_TOTAL_SIZE / frame_sizes[f], b.frame_cnt);
+            int64_t elapsed = b.end_us - b.start_us;
+            ESP_LOGI(TAG, "%-10s %8ld %10lld %10lld %10lld", b.name, frame_sizes[f],
+                     elapsed > 0 ? (int64_t)BENCH_TOTAL_SIZE * 1000000 / 1024 / elapsed : 0,
+                     b.latency_sum / b.frame_cnt, b.latency_max);
+            esp_gmf_db_deinit(b.db);
+        }
+    }
+    esp_log_level_set("*", ESP_LOG_INFO);
+}
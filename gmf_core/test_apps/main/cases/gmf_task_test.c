@@ -22,14 +22,28 @@
  *
  */
 
+#include <string.h>
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_task.h"
 
 static const char *TAG = "TEST_ESP_GMF_TASK";
 
+#define EXEC_BENCH_CHANNEL_NUM (4)
+#define EXEC_BENCH_FRAME_NUM   (200)
+#define EXEC_BENCH_FRAME_SIZE  (256)
+
+typedef struct {
+    int32_t  frame[EXEC_BENCH_FRAME_SIZE];
+    int      decoded;
+    int      converted;
+    bool     order_err;
+} exec_bench_channel_t;
+
 static esp_gmf_job_err_t prepare1_return;
 static esp_gmf_job_err_t prepare2_return;
 static esp_gmf_job_err_t prepare3_return;
@@ -351,3 +365,298 @@ TEST_CASE("Return error after call STOP", "ESP_GMF_TASK")
     ESP_GMF_MEM_SHOW(TAG);
     cleanup2_return = 0;
 }
+
+static void exec_bench_frame_work(int32_t *frame)
+{
+    for (int r = 0; r < 16; r++) {
+        for (int i = 0; i < EXEC_BENCH_FRAME_SIZE; i++) {
+            frame[i] = (frame[i] * 3 + i + r) >> 1;
+        }
+    }
+}
+
+static esp_gmf_job_err_t exec_bench_decode(void *self, void *para)
+{
+    exec_bench_channel_t *ch = (exec_bench_channel_t *)self;
+    // The converter must consume the previous frame before a new one is decoded
+    if (ch->decoded != ch->converted) {
+        ch->order_err = true;
+    }
+    exec_bench_frame_work(ch->frame);
+    ch->decoded++;
+    return ch->decoded >= EXEC_BENCH_FRAME_NUM ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t exec_bench_convert(void *self, void *para)
+{
+    exec_bench_channel_t *ch = (exec_bench_channel_t *)self;
+    if (ch->converted + 1 != ch->decoded) {
+        ch->order_err = true;
+    }
+    exec_bench_frame_work(ch->frame);
+    ch->converted++;
+    return ch->converted >= EXEC_BENCH_FRAME_NUM ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_err_t exec_bench_evt(esp_gmf_event_pkt_t *evt, void *ctx)
+{
+    if ((evt->type == ESP_GMF_EVT_TYPE_LOADING_JOB) && (evt->sub == ESP_GMF_EVENT_STATE_FINISHED)) {
+        xSemaphoreGive((SemaphoreHandle_t)ctx);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static int exec_bench_run(uint8_t worker_num)
+{
+    exec_bench_channel_t *chs = esp_gmf_oal_calloc(EXEC_BENCH_CHANNEL_NUM, sizeof(exec_bench_channel_t));
+    TEST_ASSERT_NOT_NULL(chs);
+    SemaphoreHandle_t done_sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(done_sem);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.thread.worker_num = worker_num;
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, exec_bench_evt, done_sem);
+    // Each channel is a decoder followed by a converter, the channels are independent of each other
+    for (int i = 0; i < EXEC_BENCH_CHANNEL_NUM; i++) {
+        esp_gmf_task_register_ready_job_with_dep(hd, "dec", exec_bench_decode, ESP_GMF_JOB_TIMES_INFINITE, &chs[i], i, false);
+        esp_gmf_task_register_ready_job_with_dep(hd, "cvt", exec_bench_convert, ESP_GMF_JOB_TIMES_INFINITE, &chs[i], i, false);
+    }
+    int64_t start = esp_gmf_oal_sys_get_time_ms();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    TEST_ASSERT_EQUAL(pdPASS, xSemaphoreTake(done_sem, 20000 / portTICK_PERIOD_MS));
+    int64_t elapsed = esp_gmf_oal_sys_get_time_ms() - start;
+    for (int i = 0; i < EXEC_BENCH_CHANNEL_NUM; i++) {
+        TEST_ASSERT_FALSE(chs[i].order_err);
+        TEST_ASSERT_EQUAL(EXEC_BENCH_FRAME_NUM, chs[i].converted);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    vSemaphoreDelete(done_sem);
+    esp_gmf_oal_free(chs);
+    int fps = (int)(EXEC_BENCH_CHANNEL_NUM * EXEC_BENCH_FRAME_NUM * 1000 / (elapsed > 0 ? elapsed : 1));
+    ESP_LOGI(TAG, "Workers:%d, frames:%d, elapsed:%d ms, fps:%d", worker_num, EXEC_BENCH_CHANNEL_NUM * EXEC_BENCH_FRAME_NUM, (int)elapsed, fps);
+    return fps;
+}
+
+TEST_CASE("Executor FPS compare with single thread", "ESP_GMF_TASK")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    int single_fps = exec_bench_run(0);
+    int exec_fps = exec_bench_run(portNUM_PROCESSORS);
+    ESP_LOGW(TAG, "Single thread fps:%d, executor fps:%d, cores:%d", single_fps, exec_fps, portNUM_PROCESSORS);
+    if (portNUM_PROCESSORS > 1) {
+        // The channels are independent, so spreading them over the cores must pay off
+        TEST_ASSERT_GREATER_THAN(single_fps, exec_fps);
+    }
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Executor stopped by stop API", "ESP_GMF_TASK")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.thread.worker_num = 2;
+    esp_gmf_task_handle_t hd = NULL;
+    ESP_GMF_MEM_SHOW(TAG);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_evt, NULL);
+
+    esp_gmf_task_register_ready_job_with_dep(hd, NULL, prepare1, ESP_GMF_JOB_TIMES_ONCE, NULL, 1, false);
+    esp_gmf_task_register_ready_job_with_dep(hd, NULL, prepare2, ESP_GMF_JOB_TIMES_ONCE, NULL, 2, false);
+    esp_gmf_task_register_ready_job_with_dep(hd, NULL, prepare3, ESP_GMF_JOB_TIMES_ONCE, NULL, 3, false);
+
+    esp_gmf_task_register_ready_job_with_dep(hd, NULL, working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, 1, false);
+    esp_gmf_task_register_ready_job_with_dep(hd, NULL, working2, ESP_GMF_JOB_TIMES_INFINITE, NULL, 2, false);
+    esp_gmf_task_register_ready_job_with_dep(hd, NULL, working3, ESP_GMF_JOB_TIMES_INFINITE, NULL, 3, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pause(hd));
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_resume(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+#define SCHED_SINK_PERIOD_US (10000)
+#define SCHED_SINK_WORK_US   (1000)
+#define SCHED_BG_WORK_US     (6000)
+#define SCHED_BG_NUM         (3)
+
+static int sched_overrun_cnt;
+static int sched_bad_evt_cnt;
+
+static void sched_busy_wait(int64_t us)
+{
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    while (esp_gmf_oal_sys_get_time_us() - start < us) {
+    }
+}
+
+static esp_gmf_job_err_t sched_sink(void *self, void *para)
+{
+    // Simulate a sink which must write one frame every period to avoid underflow
+    sched_busy_wait(SCHED_SINK_WORK_US);
+    (*(int *)self)++;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t sched_background(void *self, void *para)
+{
+    sched_busy_wait(SCHED_BG_WORK_US);
+    (*(int *)self)++;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_err_t sched_evt(esp_gmf_event_pkt_t *evt, void *ctx)
+{
+    if (evt->type == ESP_GMF_EVT_TYPE_JOB_OVERRUN) {
+        // Runs on the task thread, so only record it and let the test thread assert
+        esp_gmf_job_overrun_t *info = (esp_gmf_job_overrun_t *)evt->payload;
+        if ((evt->payload_size != sizeof(esp_gmf_job_overrun_t)) || (info->label == NULL) || strcmp(info->label, "sink")) {
+            sched_bad_evt_cnt++;
+        }
+        sched_overrun_cnt++;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static uint32_t sched_run(esp_gmf_task_sched_t sched)
+{
+    int sink_cnt = 0;
+    int bg_cnt[SCHED_BG_NUM] = {0};
+    sched_overrun_cnt = 0;
+    sched_bad_evt_cnt = 0;
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.sched = sched;
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, sched_evt, NULL);
+    // The timing is kept by label, so it can be set before the job is registered
+    esp_gmf_job_timing_t timing = {
+        .period_us = SCHED_SINK_PERIOD_US,
+        .deadline_us = SCHED_SINK_PERIOD_US,
+        .budget_us = SCHED_SINK_WORK_US * 2,
+    };
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_job_timing(hd, "sink", &timing));
+    esp_gmf_task_register_ready_job(hd, "sink", sched_sink, ESP_GMF_JOB_TIMES_INFINITE, &sink_cnt, false);
+    for (int i = 0; i < SCHED_BG_NUM; i++) {
+        esp_gmf_task_register_ready_job(hd, "bg", sched_background, ESP_GMF_JOB_TIMES_INFINITE, &bg_cnt[i], false);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+
+    esp_gmf_task_job_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_get_job_stats(hd, &stats));
+    TEST_ASSERT_EQUAL(stats.miss_cnt + stats.over_cnt, sched_overrun_cnt);
+    TEST_ASSERT_EQUAL(0, sched_bad_evt_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    // The background jobs must not starve under any policy
+    for (int i = 0; i < SCHED_BG_NUM; i++) {
+        TEST_ASSERT_GREATER_THAN(0, bg_cnt[i]);
+    }
+    ESP_LOGI(TAG, "Sched:%s, sink runs:%d, bg runs:%d-%d-%d, miss:%ld, over:%ld", sched == ESP_GMF_TASK_SCHED_EDF ? "EDF" : "RR",
+             sink_cnt, bg_cnt[0], bg_cnt[1], bg_cnt[2], (long)stats.miss_cnt, (long)stats.over_cnt);
+    return stats.miss_cnt;
+}
+
+TEST_CASE("Deadline misses of periodic sink, RR vs EDF", "ESP_GMF_TASK")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    uint32_t rr_miss = sched_run(ESP_GMF_TASK_SCHED_RR);
+    uint32_t edf_miss = sched_run(ESP_GMF_TASK_SCHED_EDF);
+    ESP_LOGW(TAG, "Deadline misses, RR:%ld, EDF:%ld", (long)rr_miss, (long)edf_miss);
+    TEST_ASSERT_LESS_THAN(rr_miss, edf_miss);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+typedef struct {
+    esp_gmf_task_handle_t  tsk;
+    SemaphoreHandle_t      io_sem;
+    volatile bool          stall;
+    int                    served;
+    int                    job_calls;
+    esp_gmf_err_t          job_ret;
+} call_test_t;
+
+static esp_gmf_err_t call_count(void *ctx)
+{
+    ((call_test_t *)ctx)->served++;
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_job_err_t call_from_job(void *self, void *para)
+{
+    call_test_t *test = (call_test_t *)self;
+    // Runs in the task context, so it must neither wait for a round boundary nor deadlock
+    test->job_ret = esp_gmf_task_call(test->tsk, call_count, test);
+    test->job_calls++;
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t stalled_io(void *self, void *para)
+{
+    call_test_t *test = (call_test_t *)self;
+    // Stands for a read stuck on the network until the test releases it
+    if (test->stall) {
+        xSemaphoreTake(test->io_sem, portMAX_DELAY);
+    } else {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+TEST_CASE("Task call from a job and while a job is stalled", "ESP_GMF_TASK")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    call_test_t test = {0};
+    test.io_sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(test.io_sem);
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &test.tsk));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_timeout(test.tsk, 300));
+
+    // Call made by a job of the same task runs right away
+    esp_gmf_task_register_ready_job(test.tsk, NULL, call_from_job, ESP_GMF_JOB_TIMES_INFINITE, &test, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(test.tsk));
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(test.tsk));
+    TEST_ASSERT_GREATER_THAN(0, test.job_calls);
+    TEST_ASSERT_EQUAL(test.job_calls, test.served);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, test.job_ret);
+
+    // Call made while a job is stalled gives up after the task timeout and is never run later
+    test.served = 0;
+    test.stall = true;
+    esp_gmf_task_register_ready_job(test.tsk, NULL, stalled_io, ESP_GMF_JOB_TIMES_INFINITE, &test, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(test.tsk));
+    vTaskDelay(50 / portTICK_PERIOD_MS);
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_TIMEOUT, esp_gmf_task_call(test.tsk, call_count, &test));
+    int wait_ms = (int)((esp_gmf_oal_sys_get_time_us() - start) / 1000);
+    TEST_ASSERT_LESS_THAN(1000, wait_ms);
+    test.stall = false;
+    xSemaphoreGive(test.io_sem);
+    vTaskDelay(50 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(0, test.served);
+
+    // Once the read goes on the call is served between two rounds
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_call(test.tsk, call_count, &test));
+    TEST_ASSERT_EQUAL(1, test.served);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(test.tsk));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(test.tsk));
+    vSemaphoreDelete(test.io_sem);
+    ESP_GMF_MEM_SHOW(TAG);
+}
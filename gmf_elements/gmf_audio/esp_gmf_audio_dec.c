@@ -257,6 +257,31 @@ static esp_gmf_job_err_t esp_gmf_audio_dec_close(esp_gmf_audio_element_handle_t
     return ESP_GMF_ERR_OK;
 }
 
+static esp_gmf_err_t audio_dec_received_event_handler(esp_gmf_event_pkt_t *evt, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, evt, {return ESP_GMF_ERR_INVALID_ARG;});
+    ESP_GMF_NULL_CHECK(TAG, ctx, {return ESP_GMF_ERR_INVALID_ARG;});
+    if (evt->type != ESP_GMF_EVT_TYPE_DISCONTINUITY) {
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_audio_dec_t *audio_dec = (esp_gmf_audio_dec_t *)ctx;
+    // The input payload is only kept between two process calls while it has data left
+    if ((audio_dec->in_data.len > 0) && audio_dec->in_load) {
+        esp_gmf_port_release_in(ESP_GMF_ELEMENT_GET(ctx)->in, audio_dec->in_load, 0);
+    }
+    audio_dec->in_load = NULL;
+    audio_dec->in_data.len = 0;
+    // The simple decoder has no flush, renew it without closing the element to keep the sound info and PTS
+    if (audio_dec->dec_hd != NULL) {
+        esp_audio_simple_dec_close(audio_dec->dec_hd);
+        audio_dec->dec_hd = NULL;
+        esp_audio_simple_dec_open((esp_audio_simple_dec_cfg_t *)OBJ_GET_CFG(ctx), &audio_dec->dec_hd);
+        ESP_GMF_CHECK(TAG, audio_dec->dec_hd, {return ESP_GMF_ERR_FAIL;}, "Failed to renew simple decoder handle");
+    }
+    ESP_LOGD(TAG, "Discontinuity, el: %p, pos: %lld, pts: %lld", ctx, *(uint64_t *)evt->payload, audio_dec->pts);
+    return ESP_GMF_ERR_OK;
+}
+
 static esp_gmf_err_t esp_gmf_audio_dec_destroy(esp_gmf_audio_element_handle_t self)
 {
     ESP_GMF_NULL_CHECK(TAG, self, {return ESP_GMF_ERR_INVALID_ARG;});
@@ -311,5 +336,6 @@ esp_gmf_err_t esp_gmf_audio_dec_cast(esp_audio_simple_dec_cfg_t *config, esp_gmf
     audio_dec_el->base.ops.open = esp_gmf_audio_dec_open;
     audio_dec_el->base.ops.process = esp_gmf_audio_dec_process;
     audio_dec_el->base.ops.close = esp_gmf_audio_dec_close;
+    audio_dec_el->base.ops.event_receiver = audio_dec_received_event_handler;
     return ESP_GMF_ERR_OK;
 }
@@ -28,11 +28,42 @@
 #include <string.h>
 #include "errno.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
 #include "esp_gmf_io_file.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_thread.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_task.h"
 #include "fcntl.h"
 #include "esp_log.h"
 
+#define FILE_WB_WRITE_BIT   BIT(0)
+#define FILE_WB_SYNC_BIT    BIT(1)
+#define FILE_WB_IDLE_BIT    BIT(2)
+#define FILE_WB_SYNCED_BIT  BIT(3)
+#define FILE_WB_EXIT_BIT    BIT(4)
+#define FILE_WB_EXITED_BIT  BIT(5)
+
+/**
+ * @brief Write-behind state of a file writer
+ */
+typedef struct {
+    uint8_t              *buf[2];     /*!< The writer fills one buffer while the flush thread writes the other one */
+    uint8_t               fill;       /*!< Index of the buffer the writer fills */
+    uint32_t              fill_len;   /*!< Bytes in the buffer being filled */
+    uint32_t              out_len;    /*!< Bytes of the other buffer left to the flush thread, 0 if it is idle */
+    uint64_t              unsynced;   /*!< Bytes written to the file since the last sync */
+    int64_t               sync_time;  /*!< Time of the last sync in milliseconds */
+    uint32_t              sync_req;   /*!< Ticket of the last sync requested from the flush thread */
+    uint32_t              sync_done;  /*!< Ticket of the last sync done by the flush thread */
+    int                   err;        /*!< First error of a write or sync, sticky until close */
+    void                 *lock;       /*!< Lock of the buffers and the counters */
+    EventGroupHandle_t    evt;        /*!< Events between the writer and the flush thread */
+    esp_gmf_oal_thread_t  thread;     /*!< Flush thread, NULL if the writer writes by itself */
+} file_wb_t;
+
 /**
  * @brief File io context in GMF
  */
@@ -40,6 +71,7 @@ typedef struct {
     esp_gmf_io_t base;    /*!< The GMF file io handle */
     bool         is_open; /*!< The flag of whether opened */
     int          file;    /*!< The handle of file stream */
+    file_wb_t   *wb;      /*!< Write-behind state of a writer with cache, NULL to write through */
 } file_io_stream_t;
 
 static const char *TAG = "ESP_GMF_FILE";
@@ -63,6 +95,217 @@ static char *get_mount_path(char *uri)
     return skip_scheme;
 }
 
+static int file_write_all(int file, const uint8_t *data, uint32_t len)
+{
+    while (len > 0) {
+        int wlen = write(file, data, len);
+        if (wlen <= 0) {
+            ESP_LOGE(TAG, "The error is happened in writing data, error msg:%s", strerror(errno));
+            return ESP_GMF_IO_FAIL;
+        }
+        data += wlen;
+        len -= wlen;
+    }
+    return ESP_GMF_IO_OK;
+}
+
+static inline bool file_wb_sync_due(file_io_cfg_t *cfg, file_wb_t *wb, uint32_t pending)
+{
+    if (cfg->sync_bytes && (wb->unsynced + pending >= cfg->sync_bytes)) {
+        return true;
+    }
+    return cfg->sync_ms && (wb->unsynced + pending > 0)
+           && (esp_gmf_oal_sys_get_time_ms() - wb->sync_time >= cfg->sync_ms);
+}
+
+static int file_wb_sync_file(file_io_stream_t *file_io)
+{
+    int ret = fsync(file_io->file);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Failed to sync, error msg:%s", strerror(errno));
+        ret = ESP_GMF_IO_FAIL;
+    }
+    return ret;
+}
+
+static inline void file_wb_synced(file_wb_t *wb)
+{
+    wb->unsynced = 0;
+    wb->sync_time = esp_gmf_oal_sys_get_time_ms();
+}
+
+/* Write out the buffer being filled, the lock is held and there is no flush thread */
+static int file_wb_flush(file_io_stream_t *file_io, bool sync)
+{
+    file_wb_t *wb = file_io->wb;
+    int ret = ESP_GMF_IO_OK;
+    if (wb->fill_len) {
+        ret = file_write_all(file_io->file, wb->buf[wb->fill], wb->fill_len);
+        wb->unsynced += wb->fill_len;
+        wb->fill_len = 0;
+    }
+    if ((ret == ESP_GMF_IO_OK) && sync) {
+        ret = file_wb_sync_file(file_io);
+        file_wb_synced(wb);
+    }
+    if ((ret != ESP_GMF_IO_OK) && (wb->err == ESP_GMF_IO_OK)) {
+        wb->err = ret;
+    }
+    return ret;
+}
+
+static void file_wb_process(void *arg)
+{
+    file_io_stream_t *file_io = (file_io_stream_t *)arg;
+    file_wb_t *wb = file_io->wb;
+    file_io_cfg_t *cfg = (file_io_cfg_t *)OBJ_GET_CFG(file_io);
+    TickType_t period = cfg->sync_ms ? pdMS_TO_TICKS(cfg->sync_ms) : portMAX_DELAY;
+    bool quit = false;
+    ESP_LOGD(TAG, "Flush thread start, %p", file_io);
+    while (quit == false) {
+        EventBits_t bits = xEventGroupWaitBits(wb->evt, FILE_WB_WRITE_BIT | FILE_WB_SYNC_BIT | FILE_WB_EXIT_BIT,
+                                               pdTRUE, pdFALSE, period);
+        quit = bits & FILE_WB_EXIT_BIT;
+        // A sync covers everything released before it was asked, so the ticket is taken before looking at the buffers
+        bool drain = quit || (bits & FILE_WB_SYNC_BIT);
+        uint32_t ticket = 0;
+        uint32_t len = 0;
+        do {
+            esp_gmf_oal_mutex_lock(wb->lock);
+            ticket = wb->sync_req;
+            if (drain == false) {
+                drain = file_wb_sync_due(cfg, wb, wb->out_len + wb->fill_len);
+            }
+            if ((wb->out_len == 0) && drain && wb->fill_len) {
+                wb->out_len = wb->fill_len;
+                wb->fill_len = 0;
+                wb->fill ^= 1;
+            }
+            len = wb->out_len;
+            const uint8_t *data = wb->buf[wb->fill ^ 1];
+            esp_gmf_oal_mutex_unlock(wb->lock);
+            if (len) {
+                int ret = file_write_all(file_io->file, data, len);
+                esp_gmf_oal_mutex_lock(wb->lock);
+                wb->err = wb->err ? wb->err : ret;
+                wb->unsynced += len;
+                wb->out_len = 0;
+                esp_gmf_oal_mutex_unlock(wb->lock);
+                xEventGroupSetBits(wb->evt, FILE_WB_IDLE_BIT);
+            }
+        } while (drain && len);
+        if (drain) {
+            // Only this thread writes the file, so the sync runs without the lock and the writer keeps copying
+            int ret = file_wb_sync_file(file_io);
+            esp_gmf_oal_mutex_lock(wb->lock);
+            file_wb_synced(wb);
+            wb->err = wb->err ? wb->err : ret;
+            wb->sync_done = ticket;
+            esp_gmf_oal_mutex_unlock(wb->lock);
+            xEventGroupSetBits(wb->evt, FILE_WB_SYNCED_BIT);
+        }
+    }
+    ESP_LOGD(TAG, "Flush thread exit, %p", file_io);
+    esp_gmf_oal_thread_t thread = wb->thread;
+    xEventGroupSetBits(wb->evt, FILE_WB_EXITED_BIT);
+    esp_gmf_oal_thread_delete(thread);
+}
+
+static int file_wb_sync(file_io_stream_t *file_io)
+{
+    file_wb_t *wb = file_io->wb;
+    int ret = ESP_GMF_IO_OK;
+    if (wb->thread == NULL) {
+        esp_gmf_oal_mutex_lock(wb->lock);
+        ret = file_wb_flush(file_io, true);
+        esp_gmf_oal_mutex_unlock(wb->lock);
+        return ret;
+    }
+    esp_gmf_oal_mutex_lock(wb->lock);
+    uint32_t ticket = ++wb->sync_req;
+    esp_gmf_oal_mutex_unlock(wb->lock);
+    xEventGroupSetBits(wb->evt, FILE_WB_SYNC_BIT);
+    while (1) {
+        esp_gmf_oal_mutex_lock(wb->lock);
+        bool done = (int32_t)(wb->sync_done - ticket) >= 0;
+        ret = wb->err;
+        esp_gmf_oal_mutex_unlock(wb->lock);
+        if (done) {
+            break;
+        }
+        xEventGroupWaitBits(wb->evt, FILE_WB_SYNCED_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+    }
+    return ret;
+}
+
+static void file_wb_free(file_wb_t *wb)
+{
+    for (int i = 0; i < 2; i++) {
+        if (wb->buf[i]) {
+            esp_gmf_oal_free(wb->buf[i]);
+        }
+    }
+    if (wb->lock) {
+        esp_gmf_oal_mutex_destroy(wb->lock);
+    }
+    if (wb->evt) {
+        vEventGroupDelete(wb->evt);
+    }
+    esp_gmf_oal_free(wb);
+}
+
+static esp_gmf_err_t file_wb_open(file_io_stream_t *file_io)
+{
+    file_io_cfg_t *cfg = (file_io_cfg_t *)OBJ_GET_CFG(file_io);
+    file_wb_t *wb = esp_gmf_oal_calloc(1, sizeof(file_wb_t));
+    ESP_GMF_MEM_VERIFY(TAG, wb, return ESP_GMF_ERR_MEMORY_LACK, "write-behind state", sizeof(file_wb_t));
+    int buf_num = cfg->flush_task ? 2 : 1;
+    for (int i = 0; i < buf_num; i++) {
+        wb->buf[i] = esp_gmf_oal_malloc(cfg->cache_size);
+        ESP_GMF_MEM_VERIFY(TAG, wb->buf[i], {file_wb_free(wb); return ESP_GMF_ERR_MEMORY_LACK;},
+                           "write-behind buffer", cfg->cache_size);
+    }
+    wb->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, wb->lock, {file_wb_free(wb); return ESP_GMF_ERR_MEMORY_LACK;});
+    wb->sync_time = esp_gmf_oal_sys_get_time_ms();
+    file_io->wb = wb;
+    if (cfg->flush_task) {
+        wb->evt = xEventGroupCreate();
+        ESP_GMF_MEM_CHECK(TAG, wb->evt, {file_wb_free(wb); file_io->wb = NULL; return ESP_GMF_ERR_MEMORY_LACK;});
+        int stack = cfg->task_stack > 0 ? cfg->task_stack : DEFAULT_ESP_GMF_STACK_SIZE;
+        int prio = cfg->task_prio > 0 ? cfg->task_prio : DEFAULT_ESP_GMF_TASK_PRIO;
+        esp_gmf_err_t ret = esp_gmf_oal_thread_create(&wb->thread, "file_flush", file_wb_process, file_io, stack, prio,
+                                                      false, cfg->task_core);
+        if (ret != ESP_GMF_ERR_OK) {
+            ESP_LOGE(TAG, "Failed to create the flush thread, ret:%x", ret);
+            file_wb_free(wb);
+            file_io->wb = NULL;
+            return ret;
+        }
+    }
+    ESP_LOGI(TAG, "Write behind, cache:%d, sync bytes:%d, sync ms:%d, thread:%p", (int)cfg->cache_size,
+             (int)cfg->sync_bytes, (int)cfg->sync_ms, wb->thread);
+    return ESP_GMF_ERR_OK;
+}
+
+static int file_wb_close(file_io_stream_t *file_io)
+{
+    file_wb_t *wb = file_io->wb;
+    int ret = ESP_GMF_IO_OK;
+    if (wb->thread) {
+        // The flush thread drains and syncs on the way out
+        xEventGroupSetBits(wb->evt, FILE_WB_EXIT_BIT);
+        xEventGroupWaitBits(wb->evt, FILE_WB_EXITED_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+        ret = wb->err;
+    } else {
+        ret = file_wb_flush(file_io, true);
+        ret = wb->err ? wb->err : ret;
+    }
+    file_wb_free(wb);
+    file_io->wb = NULL;
+    return ret;
+}
+
 static esp_gmf_err_t _file_new(void *cfg, esp_gmf_obj_handle_t *io)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, {return ESP_GMF_ERR_INVALID_ARG;});
@@ -126,6 +369,13 @@ static esp_gmf_err_t _file_open(esp_gmf_io_handle_t io)
             ESP_LOGE(TAG, "Failed to open on write, path: %s, err: %s", path, strerror(errno));
             return ESP_GMF_ERR_FAIL;
         }
+        if (((file_io_cfg_t *)file_io->base.parent.cfg)->cache_size) {
+            esp_gmf_err_t ret = file_wb_open(file_io);
+            if (ret != ESP_GMF_ERR_OK) {
+                close(file_io->file);
+                return ret;
+            }
+        }
     } else {
         ESP_LOGE(TAG, "The type must be reader or writer");
         return ESP_GMF_ERR_FAIL;
@@ -161,6 +411,56 @@ static esp_gmf_err_io_t _file_release_read(esp_gmf_io_handle_t handle, void *pay
     return ESP_GMF_IO_OK;
 }
 
+static esp_gmf_err_io_t file_wb_write(file_io_stream_t *file_io, esp_gmf_payload_t *pload)
+{
+    file_wb_t *wb = file_io->wb;
+    file_io_cfg_t *cfg = (file_io_cfg_t *)OBJ_GET_CFG(file_io);
+    const uint8_t *data = pload->buf;
+    uint32_t left = pload->valid_size;
+    int ret = ESP_GMF_IO_OK;
+    esp_gmf_oal_mutex_lock(wb->lock);
+    while ((left > 0) && (wb->err == ESP_GMF_IO_OK)) {
+        uint32_t len = cfg->cache_size - wb->fill_len;
+        len = len < left ? len : left;
+        memcpy(wb->buf[wb->fill] + wb->fill_len, data, len);
+        wb->fill_len += len;
+        data += len;
+        left -= len;
+        if (wb->fill_len < cfg->cache_size) {
+            break;
+        }
+        if (wb->thread == NULL) {
+            file_wb_flush(file_io, false);
+            continue;
+        }
+        // Hand the full buffer over, waiting only if the flush thread still writes the other one
+        while (wb->out_len) {
+            esp_gmf_oal_mutex_unlock(wb->lock);
+            xEventGroupWaitBits(wb->evt, FILE_WB_IDLE_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+            esp_gmf_oal_mutex_lock(wb->lock);
+        }
+        wb->out_len = wb->fill_len;
+        wb->fill_len = 0;
+        wb->fill ^= 1;
+        xEventGroupSetBits(wb->evt, FILE_WB_WRITE_BIT);
+    }
+    bool sync = file_wb_sync_due(cfg, wb, wb->out_len + wb->fill_len);
+    if (sync && (wb->thread == NULL)) {
+        file_wb_flush(file_io, true);
+    }
+    ret = wb->err;
+    esp_gmf_oal_mutex_unlock(wb->lock);
+    if (sync && wb->thread) {
+        xEventGroupSetBits(wb->evt, FILE_WB_SYNC_BIT);
+    }
+    if (ret != ESP_GMF_IO_OK) {
+        return ret;
+    }
+    esp_gmf_io_update_pos((esp_gmf_io_handle_t)file_io, pload->valid_size);
+    ESP_LOGD(TAG, "Write behind len = %d, cached = %d", pload->valid_size, (int)wb->fill_len);
+    return ESP_GMF_IO_OK;
+}
+
 static esp_gmf_err_io_t _file_acquire_write(esp_gmf_io_handle_t handle, void *payload, uint32_t wanted_size, int block_ticks)
 {
     return wanted_size;
@@ -170,6 +470,9 @@ static esp_gmf_err_io_t _file_release_write(esp_gmf_io_handle_t handle, void *pa
 {
     file_io_stream_t *file_io = (file_io_stream_t *)handle;
     esp_gmf_payload_t *pload = (esp_gmf_payload_t *)payload;
+    if (file_io->wb) {
+        return file_wb_write(file_io, pload);
+    }
     int wlen = 0;
     wlen = write(file_io->file, pload->buf, pload->valid_size);
     fsync(file_io->file);
@@ -197,6 +500,9 @@ static esp_gmf_err_t _file_seek(esp_gmf_io_handle_t io, uint64_t seek_byte_pos)
                  info.size, seek_byte_pos);
         return ESP_GMF_ERR_OUT_OF_RANGE;
     }
+    if (file_io->wb && (file_wb_sync(file_io) != ESP_GMF_IO_OK)) {
+        return ESP_GMF_ERR_FAIL;
+    }
     if (lseek(file_io->file, seek_byte_pos, SEEK_SET) < 0) {
         ESP_LOGE(TAG, "Error seek file, error message: %s, line: %d", strerror(errno), __LINE__);
         return ESP_GMF_ERR_FAIL;
@@ -210,12 +516,16 @@ static esp_gmf_err_t _file_close(esp_gmf_io_handle_t io)
     esp_gmf_info_file_t info = {0};
     esp_gmf_io_get_info((esp_gmf_io_handle_t)file_io, &info);
     ESP_LOGI(TAG, "CLose, %p, pos = %d/%d", file_io, (int)info.pos, (int)info.size);
+    int ret = ESP_GMF_IO_OK;
+    if (file_io->wb) {
+        ret = file_wb_close(file_io);
+    }
     if (file_io->is_open) {
         close(file_io->file);
         file_io->is_open = false;
     }
     esp_gmf_io_set_pos((esp_gmf_io_handle_t)io, 0);
-    return ESP_GMF_ERR_OK;
+    return ret == ESP_GMF_IO_OK ? ESP_GMF_ERR_OK : ESP_GMF_ERR_FAIL;
 }
 
 static esp_gmf_err_t _file_delete(esp_gmf_io_handle_t io)
@@ -281,3 +591,18 @@ esp_gmf_err_t esp_gmf_io_file_cast(file_io_cfg_t *config, esp_gmf_io_handle_t ob
     }
     return ESP_GMF_ERR_OK;
 }
+
+esp_gmf_err_t esp_gmf_io_file_sync(esp_gmf_io_handle_t io)
+{
+    ESP_GMF_NULL_CHECK(TAG, io, {return ESP_GMF_ERR_INVALID_ARG;});
+    file_io_stream_t *file_io = (file_io_stream_t *)io;
+    if (((file_io_cfg_t *)OBJ_GET_CFG(file_io))->dir != ESP_GMF_IO_DIR_WRITER) {
+        ESP_LOGE(TAG, "Only a writer can be synced, %p", file_io);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    if (file_io->is_open == false) {
+        return ESP_GMF_ERR_OK;
+    }
+    int ret = file_io->wb ? file_wb_sync(file_io) : fsync(file_io->file);
+    return ret == 0 ? ESP_GMF_ERR_OK : ESP_GMF_ERR_FAIL;
+}
@@ -0,0 +1,743 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_http_client.h"
+#include "hls_playlist.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_io_hls.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_thread.h"
+#include "esp_gmf_oal_sys.h"
+
+#define HLS_IO_READ_SIZE       (2 * 1024)
+#define HLS_IO_HTTP_BUF_SIZE   (3 * 1024)
+#define HLS_IO_TIMEOUT_MS      (10 * 1000)
+#define HLS_IO_RETRY_TIMES     (3)
+#define HLS_IO_URL_SIZE        (512)
+#define HLS_IO_PLAYLIST_MAX    (64 * 1024)
+#define HLS_IO_LIVE_START      (3)
+#define HLS_IO_BW_MARGIN       (80)
+#define HLS_IO_DATA_BIT        BIT(0)
+#define HLS_IO_FREE_BIT        BIT(1)
+#define HLS_IO_QUIT_BIT        BIT(2)
+#define HLS_IO_EXIT_BIT        BIT(3)
+
+/**
+ * @brief Buffer of one prefetched segment
+ */
+typedef struct {
+    uint8_t   *buf;       /*!< Segment data */
+    uint32_t   cap;       /*!< Allocated size of `buf` */
+    uint32_t   len;       /*!< Bytes fetched so far */
+    uint64_t   seq;       /*!< Media sequence number of the segment */
+    bool       complete;  /*!< The segment is fully fetched */
+} hls_slot_t;
+
+/**
+ * @brief HLS io context in GMF
+ */
+typedef struct {
+    esp_gmf_io_t              base;        /*!< The GMF hls io handle */
+    bool                      is_open;     /*!< The flag of whether opened */
+    esp_gmf_db_handle_t       data_bus;    /*!< The data bus handle */
+    uint32_t                  chunk;       /*!< Bytes acquired from the data bus at a time */
+    esp_http_client_handle_t  client;      /*!< Keep-alive connection of the fetcher */
+    hls_playlist_t           *master;      /*!< Master playlist, NULL if the URI is a media playlist */
+    hls_playlist_t           *media;       /*!< Media playlist being followed */
+    const char               *media_uri;   /*!< URI of the media playlist, for the live reloads */
+    uint64_t                  next_seq;    /*!< Next segment to fetch */
+    hls_slot_t               *slots;       /*!< Segment buffers, used as a ring */
+    int                       slot_num;    /*!< Number of segment buffers */
+    int                       slot_head;   /*!< Slot being read */
+    int                       slot_cnt;    /*!< Slots holding a segment, from `slot_head` */
+    uint32_t                  read_off;    /*!< Bytes of the head slot handed to the data bus */
+    bool                      eos;         /*!< The fetcher reached the end of the playlist */
+    bool                      failed;      /*!< The fetcher stopped on an error */
+    bool                      quit;        /*!< The fetcher has to leave */
+    int64_t                   open_ms;     /*!< Time of the open, for the startup time */
+    esp_gmf_io_hls_stats_t    stats;       /*!< Statistics of the play */
+    void                     *lock;        /*!< Lock of the slots, the flags and the statistics */
+    EventGroupHandle_t        evt;         /*!< Events between the reader and the fetcher */
+    esp_gmf_oal_thread_t      thread;      /*!< Fetcher thread */
+} hls_stream_t;
+
+static const char *TAG = "ESP_GMF_HLS";
+
+static esp_gmf_err_t _hls_destroy(esp_gmf_io_handle_t self);
+
+static esp_gmf_err_t hls_request(hls_stream_t *hls, const char *uri, uint32_t from, int64_t *length)
+{
+    hls_io_cfg_t *cfg = (hls_io_cfg_t *)OBJ_GET_CFG(hls);
+    if (hls->client == NULL) {
+        esp_http_client_config_t http_cfg = {
+            .url = uri,
+            .timeout_ms = HLS_IO_TIMEOUT_MS,
+            .buffer_size = HLS_IO_HTTP_BUF_SIZE,
+            .buffer_size_tx = 1024,
+            .cert_pem = cfg->cert_pem,
+#ifdef CONFIG_MBEDTLS_CERTIFICATE_BUNDLE
+            .crt_bundle_attach = cfg->crt_bundle_attach,
+#endif /* CONFIG_MBEDTLS_CERTIFICATE_BUNDLE */
+        };
+        hls->client = esp_http_client_init(&http_cfg);
+        ESP_GMF_CHECK(TAG, hls->client, return ESP_GMF_ERR_MEMORY_LACK, "Failed to initialize http client");
+    } else {
+        // The connection is kept unless the host changes
+        esp_http_client_set_url(hls->client, uri);
+    }
+    if (from) {
+        char range_header[32];
+        snprintf(range_header, sizeof(range_header), "bytes=%lu-", (unsigned long)from);
+        esp_http_client_set_header(hls->client, "Range", range_header);
+    } else {
+        esp_http_client_delete_header(hls->client, "Range");
+    }
+    for (int i = 0; (i < HLS_IO_RETRY_TIMES) && (hls->quit == false); i++) {
+        if (esp_http_client_open(hls->client, 0) != ESP_OK) {
+            esp_http_client_close(hls->client);
+            continue;
+        }
+        int64_t len = esp_http_client_fetch_headers(hls->client);
+        int status_code = esp_http_client_get_status_code(hls->client);
+        if (status_code == 301 || status_code == 302) {
+            esp_http_client_flush_response(hls->client, NULL);
+            esp_http_client_set_redirection(hls->client);
+            continue;
+        }
+        if (status_code == (from ? 206 : 200)) {
+            *length = len;
+            return ESP_GMF_ERR_OK;
+        }
+        // A failed fetch of the headers usually means the server closed the idle connection
+        esp_http_client_close(hls->client);
+        if (len >= 0 && status_code > 0) {
+            ESP_LOGE(TAG, "Invalid HLS response, status code = %d, URI = %s", status_code, uri);
+            return ESP_GMF_ERR_FAIL;
+        }
+    }
+    return ESP_GMF_ERR_FAIL;
+}
+
+static void hls_request_done(hls_stream_t *hls, bool drained)
+{
+    // Keep the connection for the next request only if the response was read to its end
+    if ((drained == false) || (esp_http_client_is_complete_data_received(hls->client) == false)) {
+        esp_http_client_close(hls->client);
+    }
+}
+
+static esp_gmf_err_t hls_load_playlist(hls_stream_t *hls, const char *uri, hls_playlist_t **playlist)
+{
+    int64_t length = 0;
+    ESP_GMF_RET_ON_ERROR(TAG, hls_request(hls, uri, 0, &length), return ESP_GMF_ERR_FAIL,
+                         "Failed to request the playlist %s", uri);
+    if (length > HLS_IO_PLAYLIST_MAX) {
+        ESP_LOGE(TAG, "The playlist is too large, %lld bytes", length);
+        hls_request_done(hls, false);
+        return ESP_GMF_ERR_FAIL;
+    }
+    int cap = length > 0 ? (int)length : 1024;
+    int size = 0;
+    int rlen = 0;
+    char *text = esp_gmf_oal_malloc(cap);
+    ESP_GMF_MEM_VERIFY(TAG, text, {hls_request_done(hls, false); return ESP_GMF_ERR_MEMORY_LACK;}, "playlist", cap);
+    while ((length <= 0) || (size < length)) {
+        if (size == cap) {
+            char *grown = (cap < HLS_IO_PLAYLIST_MAX) ? esp_gmf_oal_realloc(text, cap * 2) : NULL;
+            if (grown == NULL) {
+                break;
+            }
+            text = grown;
+            cap *= 2;
+        }
+        rlen = esp_http_client_read(hls->client, text + size, cap - size);
+        if (rlen <= 0) {
+            break;
+        }
+        size += rlen;
+    }
+    bool drained = (length > 0) ? (size == length) : (rlen == 0);
+    hls_request_done(hls, drained);
+    // Relative URIs are resolved against the URL after the redirections
+    char url[HLS_IO_URL_SIZE];
+    if (esp_http_client_get_url(hls->client, url, sizeof(url)) != ESP_OK) {
+        snprintf(url, sizeof(url), "%s", uri);
+    }
+    int ret = drained ? hls_playlist_parse(url, text, size, playlist) : -1;
+    esp_gmf_oal_free(text);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Failed to load the playlist %s", uri);
+        return ESP_GMF_ERR_FAIL;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t hls_load_variant(hls_stream_t *hls, int variant)
+{
+    hls_playlist_t *media = NULL;
+    const char *uri = hls->master->variants[variant].uri;
+    ESP_GMF_RET_ON_ERROR(TAG, hls_load_playlist(hls, uri, &media), return ESP_GMF_ERR_FAIL, "Failed to load variant %d", variant);
+    if (media->is_master) {
+        ESP_LOGE(TAG, "The variant %d is not a media playlist", variant);
+        hls_playlist_free(media);
+        return ESP_GMF_ERR_FAIL;
+    }
+    hls_playlist_free(hls->media);
+    hls->media = media;
+    hls->media_uri = uri;
+    esp_gmf_oal_mutex_lock(hls->lock);
+    hls->stats.variant = variant;
+    esp_gmf_oal_mutex_unlock(hls->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+static void hls_select_variant(hls_stream_t *hls)
+{
+    esp_gmf_oal_mutex_lock(hls->lock);
+    uint64_t budget = (uint64_t)hls->stats.bandwidth * HLS_IO_BW_MARGIN / 100;
+    int cur = hls->stats.variant;
+    esp_gmf_oal_mutex_unlock(hls->lock);
+    // Highest variant fitting in the budget, the lowest one if none does
+    int pick = 0;
+    for (int i = 1; i < hls->master->variant_num; i++) {
+        if (hls->master->variants[i].bandwidth <= budget) {
+            pick = i;
+        }
+    }
+    if (pick == cur) {
+        return;
+    }
+    ESP_LOGI(TAG, "Switch from variant %d to %d at segment %llu, measured %lu bps", cur, pick,
+             hls->next_seq, (unsigned long)(budget * 100 / HLS_IO_BW_MARGIN));
+    if (hls_load_variant(hls, pick) != ESP_GMF_ERR_OK) {
+        ESP_LOGW(TAG, "Stay on variant %d", cur);
+    }
+}
+
+static esp_gmf_err_t hls_next_segment(hls_stream_t *hls, const hls_segment_t **segment)
+{
+    *segment = NULL;
+    while (hls->quit == false) {
+        hls_playlist_t *media = hls->media;
+        const hls_segment_t *seg = hls_playlist_find(media, hls->next_seq);
+        if (seg) {
+            *segment = seg;
+            return ESP_GMF_ERR_OK;
+        }
+        if (media->segment_num && (hls->next_seq < media->segments[0].seq)) {
+            ESP_LOGW(TAG, "Fell behind the live window, jump from segment %llu to %llu", hls->next_seq, media->segments[0].seq);
+            hls->next_seq = media->segments[0].seq;
+            continue;
+        }
+        if (media->ended) {
+            return ESP_GMF_ERR_OK;
+        }
+        // The next segment of the live playlist is not listed yet, reload it after half a target duration
+        uint32_t wait_ms = media->target_duration_ms > 0 ? media->target_duration_ms / 2 : 1000;
+        EventBits_t bits = xEventGroupWaitBits(hls->evt, HLS_IO_QUIT_BIT, pdFALSE, pdFALSE, pdMS_TO_TICKS(wait_ms));
+        if (bits & HLS_IO_QUIT_BIT) {
+            break;
+        }
+        hls_playlist_t *reload = NULL;
+        ESP_GMF_RET_ON_ERROR(TAG, hls_load_playlist(hls, hls->media_uri, &reload), return ESP_GMF_ERR_FAIL,
+                             "Failed to reload the live playlist");
+        hls_playlist_free(hls->media);
+        hls->media = reload;
+        esp_gmf_oal_mutex_lock(hls->lock);
+        hls->stats.refreshes++;
+        esp_gmf_oal_mutex_unlock(hls->lock);
+    }
+    return ESP_GMF_ERR_FAIL;
+}
+
+static esp_gmf_err_t hls_slot_reserve(hls_stream_t *hls, hls_slot_t *slot, uint32_t size)
+{
+    if (size <= slot->cap) {
+        return ESP_GMF_ERR_OK;
+    }
+    // The reader copies out of the buffer under the lock, so it can move here
+    esp_gmf_oal_mutex_lock(hls->lock);
+    uint8_t *buf = esp_gmf_oal_realloc(slot->buf, size);
+    if (buf) {
+        slot->buf = buf;
+        slot->cap = size;
+    }
+    esp_gmf_oal_mutex_unlock(hls->lock);
+    ESP_GMF_MEM_VERIFY(TAG, buf, return ESP_GMF_ERR_MEMORY_LACK, "segment", size);
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t hls_fetch_segment(hls_stream_t *hls, const hls_segment_t *seg, hls_slot_t *slot)
+{
+    int64_t start = esp_gmf_oal_sys_get_time_ms();
+    uint32_t from = slot->len;
+    int64_t length = 0;
+    // A retry goes on from the bytes the reader may already have
+    ESP_GMF_RET_ON_ERROR(TAG, hls_request(hls, seg->uri, from, &length), return ESP_GMF_ERR_FAIL,
+                         "Failed to request segment %llu", seg->seq);
+    if ((length > 0) && (hls_slot_reserve(hls, slot, from + length) != ESP_GMF_ERR_OK)) {
+        hls_request_done(hls, false);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    int rlen = 0;
+    while ((hls->quit == false) && ((length <= 0) || (slot->len < from + length))) {
+        if ((slot->len == slot->cap) && (hls_slot_reserve(hls, slot, slot->cap ? slot->cap * 2 : 4 * HLS_IO_READ_SIZE) != ESP_GMF_ERR_OK)) {
+            break;
+        }
+        // Read in small steps so that the reader can go on while the segment arrives
+        int want = slot->cap - slot->len;
+        rlen = esp_http_client_read(hls->client, (char *)slot->buf + slot->len, want > HLS_IO_READ_SIZE ? HLS_IO_READ_SIZE : want);
+        if (rlen <= 0) {
+            break;
+        }
+        esp_gmf_oal_mutex_lock(hls->lock);
+        slot->len += rlen;
+        esp_gmf_oal_mutex_unlock(hls->lock);
+        xEventGroupSetBits(hls->evt, HLS_IO_DATA_BIT);
+    }
+    bool drained = (length > 0) ? (slot->len == from + length) : (rlen == 0);
+    hls_request_done(hls, drained);
+    if (drained == false) {
+        return ESP_GMF_ERR_FAIL;
+    }
+    uint32_t elapsed = (uint32_t)(esp_gmf_oal_sys_get_time_ms() - start);
+    uint32_t sample = (uint32_t)((uint64_t)(slot->len - from) * 8000 / (elapsed > 0 ? elapsed : 1));
+    esp_gmf_oal_mutex_lock(hls->lock);
+    hls->stats.bandwidth = hls->stats.bandwidth ? (uint32_t)(((uint64_t)hls->stats.bandwidth * 7 + (uint64_t)sample * 3) / 10) : sample;
+    hls->stats.segments++;
+    slot->complete = true;
+    esp_gmf_oal_mutex_unlock(hls->lock);
+    xEventGroupSetBits(hls->evt, HLS_IO_DATA_BIT);
+    ESP_LOGD(TAG, "Segment %llu, %lu bytes in %lu ms", seg->seq, (unsigned long)slot->len, (unsigned long)elapsed);
+    return ESP_GMF_ERR_OK;
+}
+
+static void hls_fetch_process(void *arg)
+{
+    hls_stream_t *hls = (hls_stream_t *)arg;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    // Wait until the open has set the thread handle
+    xEventGroupWaitBits(hls->evt, HLS_IO_FREE_BIT | HLS_IO_QUIT_BIT, pdFALSE, pdFALSE, portMAX_DELAY);
+    while (1) {
+        xEventGroupClearBits(hls->evt, HLS_IO_FREE_BIT);
+        esp_gmf_oal_mutex_lock(hls->lock);
+        bool quit = hls->quit;
+        bool full = (hls->slot_cnt == hls->slot_num);
+        esp_gmf_oal_mutex_unlock(hls->lock);
+        if (quit) {
+            break;
+        }
+        if (full) {
+            xEventGroupWaitBits(hls->evt, HLS_IO_FREE_BIT | HLS_IO_QUIT_BIT, pdFALSE, pdFALSE, portMAX_DELAY);
+            continue;
+        }
+        const hls_segment_t *seg = NULL;
+        ret = hls_next_segment(hls, &seg);
+        if ((ret != ESP_GMF_ERR_OK) || (seg == NULL)) {
+            break;
+        }
+        esp_gmf_oal_mutex_lock(hls->lock);
+        hls_slot_t *slot = &hls->slots[(hls->slot_head + hls->slot_cnt) % hls->slot_num];
+        slot->seq = seg->seq;
+        slot->len = 0;
+        slot->complete = false;
+        hls->slot_cnt++;
+        esp_gmf_oal_mutex_unlock(hls->lock);
+        ret = ESP_GMF_ERR_FAIL;
+        for (int i = 0; (i < HLS_IO_RETRY_TIMES) && (ret != ESP_GMF_ERR_OK) && (hls->quit == false); i++) {
+            ret = hls_fetch_segment(hls, seg, slot);
+        }
+        if (ret != ESP_GMF_ERR_OK) {
+            break;
+        }
+        // Variants share the media sequence numbers, a switch takes effect at the next segment
+        hls->next_seq = seg->seq + 1;
+        if (hls->master) {
+            hls_select_variant(hls);
+        }
+    }
+    esp_gmf_oal_mutex_lock(hls->lock);
+    if (hls->quit == false) {
+        if (ret == ESP_GMF_ERR_OK) {
+            hls->eos = true;
+        } else {
+            ESP_LOGE(TAG, "Failed to fetch segment %llu", hls->next_seq);
+            hls->failed = true;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(hls->lock);
+    xEventGroupSetBits(hls->evt, HLS_IO_DATA_BIT);
+    if (hls->client) {
+        esp_http_client_cleanup(hls->client);
+        hls->client = NULL;
+    }
+    ESP_LOGD(TAG, "Fetcher exit");
+    esp_gmf_oal_thread_t thread = hls->thread;
+    xEventGroupSetBits(hls->evt, HLS_IO_EXIT_BIT);
+    esp_gmf_oal_thread_delete(thread);
+}
+
+static int hls_read(hls_stream_t *hls, uint8_t *buffer, int len)
+{
+    int rlen = 0;
+    bool waited = false;
+    esp_gmf_oal_mutex_lock(hls->lock);
+    while (hls->quit == false) {
+        if (hls->slot_cnt > 0) {
+            hls_slot_t *slot = &hls->slots[hls->slot_head];
+            if (slot->len > hls->read_off) {
+                rlen = slot->len - hls->read_off;
+                rlen = rlen > len ? len : rlen;
+                memcpy(buffer, slot->buf + hls->read_off, rlen);
+                hls->read_off += rlen;
+            }
+            if (slot->complete && (hls->read_off == slot->len)) {
+                hls->slot_head = (hls->slot_head + 1) % hls->slot_num;
+                hls->slot_cnt--;
+                hls->read_off = 0;
+                xEventGroupSetBits(hls->evt, HLS_IO_FREE_BIT);
+                if (rlen == 0) {
+                    continue;
+                }
+            }
+            if (rlen > 0) {
+                break;
+            }
+        } else if (hls->eos) {
+            break;
+        }
+        if (hls->failed) {
+            rlen = ESP_GMF_ERR_FAIL;
+            break;
+        }
+        // Waiting at the start of a segment once playing means the prefetch did not keep up
+        if ((waited == false) && (hls->read_off == 0) && hls->stats.startup_ms) {
+            hls->stats.stalls++;
+        }
+        waited = true;
+        xEventGroupClearBits(hls->evt, HLS_IO_DATA_BIT);
+        esp_gmf_oal_mutex_unlock(hls->lock);
+        xEventGroupWaitBits(hls->evt, HLS_IO_DATA_BIT | HLS_IO_QUIT_BIT, pdFALSE, pdFALSE, portMAX_DELAY);
+        esp_gmf_oal_mutex_lock(hls->lock);
+    }
+    if (hls->quit) {
+        rlen = ESP_GMF_ERR_FAIL;
+    } else if ((rlen > 0) && (hls->stats.startup_ms == 0)) {
+        int64_t startup = esp_gmf_oal_sys_get_time_ms() - hls->open_ms;
+        hls->stats.startup_ms = startup > 0 ? (uint32_t)startup : 1;
+    }
+    esp_gmf_oal_mutex_unlock(hls->lock);
+    return rlen;
+}
+
+static void hls_release(hls_stream_t *hls)
+{
+    if (hls->thread) {
+        esp_gmf_oal_mutex_lock(hls->lock);
+        hls->quit = true;
+        esp_gmf_oal_mutex_unlock(hls->lock);
+        xEventGroupSetBits(hls->evt, HLS_IO_QUIT_BIT);
+        xEventGroupWaitBits(hls->evt, HLS_IO_EXIT_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+        hls->thread = NULL;
+    }
+    if (hls->client) {
+        esp_http_client_cleanup(hls->client);
+        hls->client = NULL;
+    }
+    hls_playlist_free(hls->media);
+    hls_playlist_free(hls->master);
+    hls->media = NULL;
+    hls->master = NULL;
+    hls->media_uri = NULL;
+    if (hls->slots) {
+        for (int i = 0; i < hls->slot_num; i++) {
+            esp_gmf_oal_free(hls->slots[i].buf);
+        }
+        esp_gmf_oal_free(hls->slots);
+        hls->slots = NULL;
+    }
+    if (hls->lock) {
+        esp_gmf_oal_mutex_destroy(hls->lock);
+        hls->lock = NULL;
+    }
+    if (hls->evt) {
+        vEventGroupDelete(hls->evt);
+        hls->evt = NULL;
+    }
+}
+
+static esp_gmf_err_t _hls_new(void *cfg, esp_gmf_obj_handle_t *io)
+{
+    ESP_GMF_NULL_CHECK(TAG, cfg, {return ESP_GMF_ERR_INVALID_ARG;});
+    ESP_GMF_NULL_CHECK(TAG, io, {return ESP_GMF_ERR_INVALID_ARG;});
+    *io = NULL;
+    esp_gmf_obj_handle_t new_io = NULL;
+    hls_io_cfg_t *config = (hls_io_cfg_t *)cfg;
+    int ret = esp_gmf_io_hls_init(config, &new_io);
+    if (ret != ESP_GMF_ERR_OK) {
+        return ret;
+    }
+    ret = esp_gmf_io_hls_cast(config, new_io);
+    if (ret != ESP_GMF_ERR_OK) {
+        _hls_destroy(new_io);
+        return ret;
+    }
+    *io = new_io;
+    return ret;
+}
+
+static esp_gmf_err_t _hls_open(esp_gmf_io_handle_t self)
+{
+    hls_stream_t *hls = (hls_stream_t *)self;
+    if (hls->is_open) {
+        ESP_LOGW(TAG, "The HLS already opened");
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_info_file_t info = {0};
+    esp_gmf_io_get_info(self, &info);
+    const char *uri = info.uri;
+    ESP_GMF_NULL_CHECK(TAG, uri, return ESP_GMF_ERR_FAIL);
+    hls_io_cfg_t *cfg = (hls_io_cfg_t *)OBJ_GET_CFG(hls);
+    ESP_LOGI(TAG, "HLS Open, URI = %s", uri);
+
+    hls->open_ms = esp_gmf_oal_sys_get_time_ms();
+    memset(&hls->stats, 0, sizeof(hls->stats));
+    hls->stats.variant = -1;
+    hls->quit = false;
+    hls->eos = false;
+    hls->failed = false;
+    hls->slot_head = 0;
+    hls->slot_cnt = 0;
+    hls->read_off = 0;
+    int prefetch = cfg->prefetch_segments < 0 ? 0 : cfg->prefetch_segments;
+    hls->slot_num = (prefetch > HLS_IO_PREFETCH_MAX ? HLS_IO_PREFETCH_MAX : prefetch) + 1;
+    hls->slots = esp_gmf_oal_calloc(hls->slot_num, sizeof(hls_slot_t));
+    hls->lock = esp_gmf_oal_mutex_create();
+    hls->evt = xEventGroupCreate();
+    esp_gmf_err_t ret = ESP_GMF_ERR_MEMORY_LACK;
+    ESP_GMF_CHECK(TAG, hls->slots && hls->lock && hls->evt, goto _hls_fail, "Failed to allocate the HLS context");
+
+    hls_playlist_t *playlist = NULL;
+    ret = hls_load_playlist(hls, uri, &playlist);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _hls_fail, "Failed to load %s", uri);
+    if (playlist->is_master) {
+        hls->master = playlist;
+        ret = hls_load_variant(hls, 0);
+        ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto _hls_fail, "Failed to load the lowest variant");
+    } else {
+        hls->media = playlist;
+        hls->media_uri = uri;
+    }
+    hls_playlist_t *media = hls->media;
+    hls->next_seq = media->segment_num ? media->segments[0].seq : 0;
+    if ((media->ended == false) && (media->segment_num > HLS_IO_LIVE_START)) {
+        hls->next_seq = media->segments[media->segment_num - HLS_IO_LIVE_START].seq;
+    }
+    ESP_LOGI(TAG, "%s playlist, %d variants, %d segments, start at segment %llu", media->ended ? "VOD" : "Live",
+             hls->master ? hls->master->variant_num : 0, media->segment_num, hls->next_seq);
+    ret = esp_gmf_oal_thread_create(&hls->thread, "hls_fetch", hls_fetch_process, hls,
+                                    cfg->task_stack > 0 ? cfg->task_stack : HLS_IO_TASK_STACK,
+                                    cfg->task_prio, cfg->stack_in_ext, cfg->task_core);
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto _hls_fail, "Failed to create the fetcher");
+    xEventGroupSetBits(hls->evt, HLS_IO_FREE_BIT);
+    hls->is_open = true;
+    return ESP_GMF_ERR_OK;
+_hls_fail:
+    hls_release(hls);
+    return ret;
+}
+
+static esp_gmf_err_t _hls_prev_close(esp_gmf_io_handle_t self)
+{
+    hls_stream_t *hls = (hls_stream_t *)self;
+    esp_gmf_db_abort(hls->data_bus);
+    if (hls->lock) {
+        esp_gmf_oal_mutex_lock(hls->lock);
+        hls->quit = true;
+        esp_gmf_oal_mutex_unlock(hls->lock);
+        xEventGroupSetBits(hls->evt, HLS_IO_QUIT_BIT);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t _hls_close(esp_gmf_io_handle_t self)
+{
+    hls_stream_t *hls = (hls_stream_t *)self;
+    ESP_LOGD(TAG, "_hls_close");
+    hls_release(hls);
+    hls->is_open = false;
+    return ESP_GMF_ERR_OK;
+}
+
+static int _hls_process(esp_gmf_io_handle_t self, void *params)
+{
+    hls_stream_t *hls = (hls_stream_t *)self;
+    esp_gmf_data_bus_block_t blk = {0};
+    int ret = esp_gmf_db_acquire_write(hls->data_bus, &blk, hls->chunk, portMAX_DELAY);
+    if (ret < 0) {
+        // Aborted by a close, nothing to read into
+        return ret == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_FAIL;
+    }
+    int r_size = hls_read(hls, blk.buf, blk.buf_length);
+    ESP_LOGD(TAG, "Read: %d, len: %d", r_size, blk.buf_length);
+    if (r_size > 0) {
+        blk.valid_size = r_size;
+        esp_gmf_io_update_pos(self, r_size);
+        esp_gmf_db_release_write(hls->data_bus, &blk, portMAX_DELAY);
+        return ESP_GMF_JOB_ERR_OK;
+    }
+    if (r_size == 0) {
+        blk.valid_size = 0;
+        esp_gmf_db_done_write(hls->data_bus);
+        esp_gmf_db_release_write(hls->data_bus, &blk, portMAX_DELAY);
+        return ESP_GMF_JOB_ERR_DONE;
+    }
+    if (hls->quit) {
+        return ESP_GMF_JOB_ERR_DONE;
+    }
+    esp_gmf_db_abort(hls->data_bus);
+    return ESP_GMF_JOB_ERR_FAIL;
+}
+
+static esp_gmf_err_t _hls_seek(esp_gmf_io_handle_t handle, uint64_t pos)
+{
+    ESP_LOGE(TAG, "The HLS IO does not support seek, pos %llu", pos);
+    return ESP_GMF_ERR_NOT_SUPPORT;
+}
+
+static esp_gmf_err_t _hls_destroy(esp_gmf_io_handle_t self)
+{
+    if (self != NULL) {
+        hls_stream_t *hls = (hls_stream_t *)self;
+        ESP_LOGD(TAG, "%s-%p", __FUNCTION__, hls);
+        hls_release(hls);
+        if (hls->data_bus) {
+            esp_gmf_db_deinit(hls->data_bus);
+        }
+        esp_gmf_oal_free(OBJ_GET_CFG(hls));
+        esp_gmf_io_deinit(hls);
+        esp_gmf_oal_free(hls);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_io_t _hls_acquire_read(esp_gmf_io_handle_t handle, void *payload, uint32_t wanted_size, int block_ticks)
+{
+    hls_stream_t *hls = (hls_stream_t *)handle;
+    return esp_gmf_db_acquire_read(hls->data_bus, payload, wanted_size, block_ticks);
+}
+
+static esp_gmf_err_io_t _hls_release_read(esp_gmf_io_handle_t handle, void *payload, int block_ticks)
+{
+    hls_stream_t *hls = (hls_stream_t *)handle;
+    return esp_gmf_db_release_read(hls->data_bus, payload, block_ticks);
+}
+
+esp_gmf_err_t esp_gmf_io_hls_get_stats(esp_gmf_io_handle_t io, esp_gmf_io_hls_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, io, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    hls_stream_t *hls = (hls_stream_t *)io;
+    if (hls->lock) {
+        esp_gmf_oal_mutex_lock(hls->lock);
+    }
+    *stats = hls->stats;
+    if (hls->lock) {
+        esp_gmf_oal_mutex_unlock(hls->lock);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_io_hls_init(hls_io_cfg_t *config, esp_gmf_io_handle_t *io)
+{
+    ESP_GMF_NULL_CHECK(TAG, config, {return ESP_GMF_ERR_INVALID_ARG;});
+    ESP_GMF_NULL_CHECK(TAG, io, {return ESP_GMF_ERR_INVALID_ARG;});
+    *io = NULL;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    hls_stream_t *hls = esp_gmf_oal_calloc(1, sizeof(hls_stream_t));
+    ESP_GMF_MEM_VERIFY(TAG, hls, return ESP_GMF_ERR_MEMORY_LACK,
+                       "hls stream", sizeof(hls_stream_t));
+    esp_gmf_obj_t *obj = (esp_gmf_obj_t *)hls;
+    obj->new_obj = _hls_new;
+    obj->del_obj = _hls_destroy;
+    hls_io_cfg_t *cfg = esp_gmf_oal_calloc(1, sizeof(*config));
+    ESP_GMF_MEM_VERIFY(TAG, cfg, {ret = ESP_GMF_ERR_MEMORY_LACK; goto HLS_FAIL;},
+                       "hls stream configuration", sizeof(*config));
+    memcpy(cfg, config, sizeof(*config));
+    esp_gmf_obj_set_config(obj, cfg, sizeof(*config));
+    ret = esp_gmf_obj_set_tag(obj, "hls");
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto HLS_FAIL, "Failed to set obj tag");
+    hls->base.dir = ESP_GMF_IO_DIR_READER;
+    hls->base.type = ESP_GMF_IO_TYPE_BLOCK;
+    hls->stats.variant = -1;
+    *io = obj;
+    ESP_LOGD(TAG, "Initialization, %s-%p", OBJ_GET_TAG(hls), hls);
+    return ESP_GMF_ERR_OK;
+HLS_FAIL:
+    esp_gmf_obj_delete(obj);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_io_hls_cast(hls_io_cfg_t *config, esp_gmf_io_handle_t obj)
+{
+    ESP_GMF_NULL_CHECK(TAG, obj, {return ESP_GMF_ERR_INVALID_ARG;});
+    ESP_GMF_NULL_CHECK(TAG, config, {return ESP_GMF_ERR_INVALID_ARG;});
+    hls_stream_t *hls = (hls_stream_t *)obj;
+    hls->base.open = _hls_open;
+    hls->base.process = _hls_process;
+    hls->base.seek = _hls_seek;
+    hls->base.prev_close = _hls_prev_close;
+    hls->base.close = _hls_close;
+    hls->base.acquire_read = _hls_acquire_read;
+    hls->base.release_read = _hls_release_read;
+    int ret = esp_gmf_db_new_block(1, config->out_buf_size, &hls->data_bus);
+    if (ret != ESP_GMF_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to create the download buffer, sz: %d, %s-%p", config->out_buf_size, OBJ_GET_TAG(hls), hls);
+        return ret;
+    }
+    // A block data bus can not hand out more than its size at once
+    hls->chunk = config->out_buf_size / 2;
+    if (hls->chunk > HLS_IO_READ_SIZE) {
+        hls->chunk = HLS_IO_READ_SIZE;
+    } else if (hls->chunk == 0) {
+        hls->chunk = config->out_buf_size;
+    }
+    esp_gmf_data_bus_type_t db_type = 0;
+    esp_gmf_db_get_type(hls->data_bus, &db_type);
+    hls->base.type = db_type;
+    esp_gmf_io_cfg_t io_cfg = {
+        .thread.stack = config->task_stack,
+        .thread.prio = config->task_prio,
+        .thread.core = config->task_core,
+        .thread.stack_in_ext = config->stack_in_ext,
+    };
+    return esp_gmf_io_init(&hls->base, &io_cfg);
+}
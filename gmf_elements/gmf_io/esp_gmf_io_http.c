@@ -27,18 +27,75 @@
 #include "esp_log.h"
 #include "esp_http_client.h"
 #include "gzip_miniz.h"
+#include "http_cache.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
 #include "esp_gmf_new_databus.h"
 #include "esp_gmf_io_http.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_thread.h"
+#include "esp_gmf_oal_sys.h"
 
 #define HTTP_STREAM_BUFFER_SIZE (3 * 1024)
 #define HTTP_MAX_CONNECT_TIMES  (5)
+#define HTTP_RANGE_URL_SIZE     (512)
+#define HTTP_RANGE_TIMEOUT_MS   (10 * 1000)
+#define HTTP_RANGE_READY_BIT    BIT(16)
+#define HTTP_RANGE_FREE_BIT(i)  BIT(i)
+#define HTTP_RANGE_EXIT_BIT(i)  BIT(8 + (i))
+#define HTTP_SEEK_SKIP_SIZE     (16 * 1024)
+#define HTTP_SEEK_DRAIN_SIZE    (16 * 1024)
+#define HTTP_ADAPT_CHUNK_MIN    (512)
+#define HTTP_ADAPT_CHUNK_ALIGN  (512)
+#define HTTP_ADAPT_CHUNK_MS     (40)
+#define HTTP_ADAPT_WINDOW_MS    (100)
+#define HTTP_ADAPT_JITTER_K     (4)
+#define HTTP_ADAPT_FILL_BIT     BIT(0)
+
+struct http_range;
+
+/**
+ * @brief Range worker, fetches one segment at a time into its own buffer
+ */
+typedef struct {
+    struct http_range        *range;   /*!< The range download it works for */
+    int                       id;      /*!< Index of the worker */
+    esp_gmf_oal_thread_t      thread;  /*!< Worker thread */
+    esp_http_client_handle_t  client;  /*!< Connection of the worker */
+    uint8_t                  *buf;     /*!< Segment buffer */
+    int32_t                   seg;     /*!< Segment in the buffer, -1 if the buffer is free */
+    uint32_t                  len;     /*!< Bytes of the segment fetched so far */
+    bool                      ready;   /*!< The segment is complete */
+} http_range_worker_t;
+
+/**
+ * @brief Parallel range download state
+ */
+typedef struct http_range {
+    http_io_cfg_t       *cfg;         /*!< Configuration of the http io */
+    http_range_worker_t *workers;     /*!< Workers */
+    int                  worker_num;  /*!< Number of workers */
+    uint32_t             seg_size;    /*!< Size of a segment */
+    uint64_t             start;       /*!< Byte position of segment 0 */
+    uint64_t             size;        /*!< Total size of the content */
+    int32_t              seg_num;     /*!< Number of segments from `start` */
+    int32_t              next_seg;    /*!< Next segment to be claimed by a worker */
+    int32_t              want_seg;    /*!< Segment the reader hands to the data bus */
+    uint32_t             want_off;    /*!< Bytes of `want_seg` already handed */
+    uint32_t             main_left;   /*!< Bytes of segment 0 left to read on the opening connection */
+    bool                 failed;      /*!< A range request failed, fall back to a single connection */
+    bool                 quit;        /*!< The workers have to leave */
+    char                 url[HTTP_RANGE_URL_SIZE];  /*!< URL after the redirections */
+    void                *lock;        /*!< Lock of the state above */
+    EventGroupHandle_t   evt;         /*!< Events between the reader and the workers */
+} http_range_t;
 
 /**
  * @brief Http io context in GMF
  */
-typedef struct http_io {
+typedef struct {
     esp_gmf_io_t             base;          /*!< The GMF http io handle */
     bool                     is_open;       /*!< The flag of whether opened */
     esp_http_client_handle_t client;        /*!< The http client handle */
@@ -48,6 +105,30 @@ typedef struct http_io {
     gzip_miniz_handle_t      gzip;          /*!< GZIP instance */
     esp_gmf_db_handle_t      data_bus;      /*!< The data bus handle */
     int                      codec_fmt;     /*!< The format of codec */
+    bool                     accept_ranges; /*!< The server accepts byte ranges */
+    bool                     range_off;     /*!< Parallel ranges failed once, stay on a single connection */
+    http_range_t            *range;         /*!< Parallel range download, NULL on a single connection */
+    char                     etag[HTTP_CACHE_VALIDATOR_SIZE];           /*!< ETag of the last response */
+    char                     last_modified[HTTP_CACHE_VALIDATOR_SIZE];  /*!< Last-Modified of the last response */
+    http_cache_meta_t        cache_meta;    /*!< Meta data of the cache entry looked up for the request */
+    bool                     cache_lookup;  /*!< The request is conditional on `cache_meta` */
+    http_cache_entry_t       cache;         /*!< Validated or filling cache entry of the URI, NULL if not cached */
+    bool                     resp_open;     /*!< A response is being received on `client` */
+    bool                     keep_url;      /*!< Reopen on the current URL of `client`, the one after the redirections */
+    uint8_t                 *seek_buf;      /*!< Copy of the last bytes handed to the data bus, see `seek_buf_size` */
+    uint32_t                 seek_buf_size; /*!< Size of `seek_buf` */
+    uint32_t                 seek_buf_len;  /*!< Valid bytes of `seek_buf`, the last one is at the current position */
+    uint32_t                 seek_buf_head; /*!< Write index of `seek_buf` */
+    uint32_t                 seek_replay;   /*!< Last bytes of `seek_buf` to hand over again before reading on */
+    esp_gmf_io_http_stats_t  stats;         /*!< Statistics and state of the adaptive sizing */
+    bool                     playing;       /*!< Opened since the last close, the statistics are kept across seeks */
+    uint32_t                 jitter_us;     /*!< Deviation of the chunk read time from the one expected at the throughput */
+    uint32_t                 win_bytes;     /*!< Bytes read in the current throughput window */
+    int64_t                  win_us;        /*!< Read time of the current throughput window */
+    EventGroupHandle_t       adapt_evt;     /*!< Signals the target fill to a rebuffering reader, NULL if not adaptive */
+    volatile bool            rebuffering;   /*!< The reader waits for the target fill */
+    volatile bool            eos;           /*!< The whole stream is in the data bus or the reading failed */
+    bool                     started;       /*!< Data was read since the open or the last seek */
 } http_stream_t;
 
 static const char *TAG = "ESP_GMF_HTTP";
@@ -66,6 +147,15 @@ static esp_gmf_err_t _http_event_handle(esp_http_client_event_t *evt)
     if (evt->event_id != HTTP_EVENT_ON_HEADER) {
         return ESP_GMF_ERR_OK;
     }
+    if ((strcasecmp(evt->header_key, "Accept-Ranges") == 0) && (strcasecmp(evt->header_value, "bytes") == 0)) {
+        http->accept_ranges = true;
+    }
+    if (strcasecmp(evt->header_key, "ETag") == 0) {
+        snprintf(http->etag, sizeof(http->etag), "%s", evt->header_value);
+    }
+    if (strcasecmp(evt->header_key, "Last-Modified") == 0) {
+        snprintf(http->last_modified, sizeof(http->last_modified), "%s", evt->header_value);
+    }
     if (strcasecmp(evt->header_key, "Content-Encoding") == 0) {
         http->gzip_encoding = true;
         if (strcasecmp(evt->header_value, "gzip") == 0) {
@@ -110,6 +200,420 @@ static int _http_read_data(http_stream_t *http, char *buffer, int len)
     return gzip_miniz_read(http->gzip, (uint8_t *)buffer, len);
 }
 
+static esp_gmf_err_t http_range_fetch(http_range_t *range, http_range_worker_t *worker, int32_t seg)
+{
+    uint64_t from = range->start + (uint64_t)seg * range->seg_size;
+    uint32_t len = range->seg_size;
+    if (from + len > range->size) {
+        len = range->size - from;
+    }
+    if (worker->client == NULL) {
+        esp_http_client_config_t http_cfg = {
+            .url = range->url,
+            .timeout_ms = HTTP_RANGE_TIMEOUT_MS,
+            .buffer_size = HTTP_STREAM_BUFFER_SIZE,
+            .buffer_size_tx = 1024,
+            .cert_pem = range->cfg->cert_pem,
+#ifdef CONFIG_MBEDTLS_CERTIFICATE_BUNDLE
+            .crt_bundle_attach = range->cfg->crt_bundle_attach,
+#endif /* CONFIG_MBEDTLS_CERTIFICATE_BUNDLE */
+        };
+        worker->client = esp_http_client_init(&http_cfg);
+        ESP_GMF_CHECK(TAG, worker->client, return ESP_GMF_ERR_MEMORY_LACK, "Failed to initialize range client");
+    }
+    char range_header[48];
+    snprintf(range_header, sizeof(range_header), "bytes=%llu-%llu", from, from + len - 1);
+    esp_http_client_set_header(worker->client, "Range", range_header);
+    if (esp_http_client_open(worker->client, 0) != ESP_OK) {
+        return ESP_GMF_ERR_FAIL;
+    }
+    esp_gmf_err_t ret = ESP_GMF_ERR_FAIL;
+    esp_http_client_fetch_headers(worker->client);
+    int status_code = esp_http_client_get_status_code(worker->client);
+    if (status_code == 206) {
+        worker->len = 0;
+        while ((worker->len < len) && (range->quit == false)) {
+            int rlen = esp_http_client_read(worker->client, (char *)worker->buf + worker->len, len - worker->len);
+            if (rlen <= 0) {
+                break;
+            }
+            worker->len += rlen;
+        }
+        ret = (worker->len == len) ? ESP_GMF_ERR_OK : ESP_GMF_ERR_FAIL;
+    } else {
+        ESP_LOGW(TAG, "Range %s got status code %d", range_header, status_code);
+    }
+    esp_http_client_close(worker->client);
+    return ret;
+}
+
+static void http_range_process(void *arg)
+{
+    http_range_worker_t *worker = (http_range_worker_t *)arg;
+    http_range_t *range = worker->range;
+    while (1) {
+        xEventGroupWaitBits(range->evt, HTTP_RANGE_FREE_BIT(worker->id), pdTRUE, pdFALSE, portMAX_DELAY);
+        esp_gmf_oal_mutex_lock(range->lock);
+        if (range->quit || range->failed || (range->next_seg >= range->seg_num)) {
+            esp_gmf_oal_mutex_unlock(range->lock);
+            break;
+        }
+        if (worker->seg >= 0) {
+            esp_gmf_oal_mutex_unlock(range->lock);
+            continue;
+        }
+        int32_t seg = range->next_seg++;
+        worker->seg = seg;
+        worker->ready = false;
+        esp_gmf_oal_mutex_unlock(range->lock);
+
+        esp_gmf_err_t ret = ESP_GMF_ERR_FAIL;
+        for (int i = 0; (i < HTTP_MAX_CONNECT_TIMES) && (ret != ESP_GMF_ERR_OK) && (range->quit == false); i++) {
+            ret = http_range_fetch(range, worker, seg);
+        }
+        esp_gmf_oal_mutex_lock(range->lock);
+        if (ret == ESP_GMF_ERR_OK) {
+            worker->ready = true;
+        } else if (range->quit == false) {
+            ESP_LOGW(TAG, "Failed to fetch range segment %d", (int)seg);
+            range->failed = true;
+        }
+        esp_gmf_oal_mutex_unlock(range->lock);
+        xEventGroupSetBits(range->evt, HTTP_RANGE_READY_BIT);
+        if (ret != ESP_GMF_ERR_OK) {
+            break;
+        }
+    }
+    if (worker->client) {
+        esp_http_client_cleanup(worker->client);
+        worker->client = NULL;
+    }
+    ESP_LOGD(TAG, "Range worker %d exit", worker->id);
+    esp_gmf_oal_thread_t thread = worker->thread;
+    xEventGroupSetBits(range->evt, HTTP_RANGE_EXIT_BIT(worker->id));
+    esp_gmf_oal_thread_delete(thread);
+}
+
+static void http_range_stop(http_stream_t *http)
+{
+    http_range_t *range = http->range;
+    if (range == NULL) {
+        return;
+    }
+    esp_gmf_oal_mutex_lock(range->lock);
+    range->quit = true;
+    esp_gmf_oal_mutex_unlock(range->lock);
+    EventBits_t free_bits = HTTP_RANGE_READY_BIT;
+    EventBits_t exit_bits = 0;
+    for (int i = 0; i < range->worker_num; i++) {
+        free_bits |= HTTP_RANGE_FREE_BIT(i);
+        if (range->workers[i].thread) {
+            exit_bits |= HTTP_RANGE_EXIT_BIT(i);
+        }
+    }
+    xEventGroupSetBits(range->evt, free_bits);
+    if (exit_bits) {
+        xEventGroupWaitBits(range->evt, exit_bits, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    for (int i = 0; i < range->worker_num; i++) {
+        esp_gmf_oal_free(range->workers[i].buf);
+    }
+    esp_gmf_oal_mutex_destroy(range->lock);
+    vEventGroupDelete(range->evt);
+    esp_gmf_oal_free(range);
+    http->range = NULL;
+}
+
+static esp_gmf_err_t http_range_start(http_stream_t *http, http_io_cfg_t *cfg, uint64_t pos, uint64_t size)
+{
+    int worker_num = cfg->range_workers > HTTP_STREAM_RANGE_WORKER_MAX ? HTTP_STREAM_RANGE_WORKER_MAX : cfg->range_workers;
+    http_range_t *range = esp_gmf_oal_calloc(1, sizeof(http_range_t) + worker_num * sizeof(http_range_worker_t));
+    ESP_GMF_MEM_VERIFY(TAG, range, return ESP_GMF_ERR_MEMORY_LACK, "http range", sizeof(http_range_t));
+    range->cfg = cfg;
+    range->workers = (http_range_worker_t *)(range + 1);
+    range->worker_num = worker_num;
+    range->seg_size = cfg->range_seg_size > 0 ? cfg->range_seg_size : HTTP_STREAM_RANGE_SEG_SIZE;
+    range->start = pos;
+    range->size = size;
+    range->seg_num = (size - pos + range->seg_size - 1) / range->seg_size;
+    range->next_seg = 1;
+    range->want_seg = 1;
+    range->main_left = range->seg_size;
+    range->lock = esp_gmf_oal_mutex_create();
+    range->evt = xEventGroupCreate();
+    if ((range->lock == NULL) || (range->evt == NULL)
+        || (esp_http_client_get_url(http->client, range->url, sizeof(range->url)) != ESP_OK)) {
+        ESP_LOGE(TAG, "Failed to prepare the range download");
+        if (range->lock) {
+            esp_gmf_oal_mutex_destroy(range->lock);
+        }
+        if (range->evt) {
+            vEventGroupDelete(range->evt);
+        }
+        esp_gmf_oal_free(range);
+        return ESP_GMF_ERR_FAIL;
+    }
+    http->range = range;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    for (int i = 0; i < worker_num; i++) {
+        range->workers[i].range = range;
+        range->workers[i].id = i;
+        range->workers[i].seg = -1;
+        range->workers[i].buf = esp_gmf_oal_malloc(range->seg_size);
+        ESP_GMF_MEM_VERIFY(TAG, range->workers[i].buf, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _range_fail;},
+                           "range segment", range->seg_size);
+    }
+    for (int i = 0; i < worker_num; i++) {
+        ret = esp_gmf_oal_thread_create(&range->workers[i].thread, "http_range", http_range_process, &range->workers[i],
+                                        cfg->task_stack > 0 ? cfg->task_stack : HTTP_STREAM_TASK_STACK,
+                                        cfg->task_prio, cfg->stack_in_ext, cfg->task_core);
+        ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto _range_fail, "Failed to create range worker");
+    }
+    // Let the workers go only once all the thread handles are set, a worker reads its own handle to exit
+    for (int i = 0; i < worker_num; i++) {
+        xEventGroupSetBits(range->evt, HTTP_RANGE_FREE_BIT(i));
+    }
+    ESP_LOGI(TAG, "Range download from %llu, %d workers, %d segments of %d bytes",
+             pos, worker_num, (int)range->seg_num, (int)range->seg_size);
+    return ESP_GMF_ERR_OK;
+_range_fail:
+    http_range_stop(http);
+    return ret;
+}
+
+static void http_client_close(http_stream_t *http)
+{
+    http->is_open = false;
+    http->resp_open = false;
+    http_range_stop(http);
+    if (http->gzip) {
+        gzip_miniz_deinit(http->gzip);
+        http->gzip = NULL;
+    }
+    if (http->client) {
+        esp_http_client_close(http->client);
+        esp_http_client_cleanup(http->client);
+        http->client = NULL;
+    }
+}
+
+/**
+ * @brief  Make the client ready for a new request without cleaning it up, the rest of a short response is read off
+ *         so that the request goes on the same keep-alive connection, otherwise only the connection is closed
+ */
+static void http_client_rewind(http_stream_t *http, uint64_t left)
+{
+    http->is_open = false;
+    http_range_stop(http);
+    if (http->client && http->resp_open) {
+        int flushed = 0;
+        if ((left > HTTP_SEEK_DRAIN_SIZE) || (esp_http_client_flush_response(http->client, &flushed) != ESP_OK)
+            || (esp_http_client_is_complete_data_received(http->client) == false)) {
+            esp_http_client_close(http->client);
+        } else {
+            ESP_LOGD(TAG, "Keep the connection, %d bytes read off", flushed);
+        }
+    }
+    http->resp_open = false;
+}
+
+static void http_seek_buf_put(http_stream_t *http, const uint8_t *data, uint32_t len)
+{
+    uint32_t size = http->seek_buf_size;
+    if (http->seek_buf == NULL) {
+        return;
+    }
+    if (len >= size) {
+        memcpy(http->seek_buf, data + len - size, size);
+        http->seek_buf_head = 0;
+        http->seek_buf_len = size;
+        return;
+    }
+    uint32_t first = size - http->seek_buf_head;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(http->seek_buf + http->seek_buf_head, data, first);
+    memcpy(http->seek_buf, data + first, len - first);
+    http->seek_buf_head = (http->seek_buf_head + len) % size;
+    http->seek_buf_len = (http->seek_buf_len + len > size) ? size : http->seek_buf_len + len;
+}
+
+static int http_seek_buf_read(esp_gmf_io_handle_t self, uint8_t *buffer, int len)
+{
+    http_stream_t *http = (http_stream_t *)self;
+    uint32_t rlen = http->seek_replay < len ? http->seek_replay : len;
+    uint32_t start = (http->seek_buf_head + http->seek_buf_size - http->seek_replay) % http->seek_buf_size;
+    uint32_t first = http->seek_buf_size - start;
+    if (first > rlen) {
+        first = rlen;
+    }
+    memcpy(buffer, http->seek_buf + start, first);
+    memcpy(buffer + first, http->seek_buf, rlen - first);
+    http->seek_replay -= rlen;
+    esp_gmf_io_update_pos(self, rlen);
+    return rlen;
+}
+
+/**
+ * @brief  Update the throughput and jitter with a chunk read from the network in `us`, and size the next chunk and
+ *         the target fill from them when adaptive: a chunk holds `HTTP_ADAPT_CHUNK_MS` of data, so fast links are
+ *         read with less overhead and slow ones still hand data over often, and the target fill covers
+ *         `HTTP_ADAPT_JITTER_K` times the jitter
+ */
+static void http_adapt_update(http_stream_t *http, http_io_cfg_t *cfg, uint32_t bytes, int64_t us)
+{
+    esp_gmf_io_http_stats_t *stats = &http->stats;
+    stats->chunks++;
+    if (stats->throughput) {
+        int64_t dev = us - (int64_t)bytes * 1000000 / stats->throughput;
+        dev = dev < 0 ? -dev : dev;
+        // Rises fast on a stall and decays slowly, so the buffer stays deep for a while after it
+        if (dev > http->jitter_us) {
+            http->jitter_us += (uint32_t)((dev - http->jitter_us) / 4);
+        } else {
+            http->jitter_us -= (uint32_t)((http->jitter_us - dev) / 32);
+        }
+        stats->jitter_ms = http->jitter_us / 1000;
+    }
+    http->win_bytes += bytes;
+    http->win_us += us;
+    if (http->win_us >= HTTP_ADAPT_WINDOW_MS * 1000) {
+        uint32_t rate = (uint32_t)((uint64_t)http->win_bytes * 1000000 / http->win_us);
+        stats->throughput = stats->throughput ? (uint32_t)(((uint64_t)stats->throughput * 3 + rate) / 4) : rate;
+        http->win_bytes = 0;
+        http->win_us = 0;
+    }
+    if ((http->adapt_evt == NULL) || (stats->throughput == 0)) {
+        return;
+    }
+    uint32_t chunk_min = cfg->chunk_min_size ? cfg->chunk_min_size : HTTP_ADAPT_CHUNK_MIN;
+    uint32_t chunk_max = cfg->chunk_max_size < stats->buf_size / 2 ? cfg->chunk_max_size : stats->buf_size / 2;
+    uint32_t chunk = (uint32_t)((uint64_t)stats->throughput * HTTP_ADAPT_CHUNK_MS / 1000) & ~(HTTP_ADAPT_CHUNK_ALIGN - 1);
+    chunk = chunk < chunk_min ? chunk_min : chunk;
+    stats->chunk_size = chunk > chunk_max ? chunk_max : chunk;
+    // The target stays reachable with a chunk being written
+    uint32_t fill_max = cfg->fill_max_size ? cfg->fill_max_size : stats->buf_size * 3 / 4;
+    fill_max = fill_max < stats->buf_size - stats->chunk_size ? fill_max : stats->buf_size - stats->chunk_size;
+    uint64_t fill = (uint64_t)stats->throughput * HTTP_ADAPT_JITTER_K * http->jitter_us / 1000000 + stats->chunk_size;
+    fill = fill < cfg->fill_min_size ? cfg->fill_min_size : fill;
+    stats->target_fill = fill > fill_max ? fill_max : (uint32_t)fill;
+}
+
+/**
+ * @brief  Wake the reader waiting for the target fill, on the end of the stream or an abort whatever the fill
+ */
+static void http_adapt_notify(http_stream_t *http, bool force)
+{
+    if ((http->adapt_evt == NULL) || (http->rebuffering == false)) {
+        return;
+    }
+    uint32_t filled = 0;
+    esp_gmf_db_get_filled_size(http->data_bus, &filled);
+    if (force || (filled >= http->stats.target_fill)) {
+        xEventGroupSetBits(http->adapt_evt, HTTP_ADAPT_FILL_BIT);
+    }
+}
+
+/**
+ * @brief  Count an underrun when the reader finds the data bus empty, and when adaptive hold the read until the
+ *         target fill after an underrun, an open or a seek
+ */
+static void http_adapt_wait(http_stream_t *http, int block_ticks)
+{
+    uint32_t filled = 0;
+    esp_gmf_db_get_filled_size(http->data_bus, &filled);
+    if ((filled == 0) && (http->eos == false) && http->started) {
+        http->stats.underruns++;
+        http->rebuffering = (http->adapt_evt != NULL);
+    }
+    http->started = true;
+    if (http->rebuffering == false) {
+        return;
+    }
+    xEventGroupClearBits(http->adapt_evt, HTTP_ADAPT_FILL_BIT);
+    esp_gmf_db_get_filled_size(http->data_bus, &filled);
+    if ((filled < http->stats.target_fill) && (http->eos == false)) {
+        xEventGroupWaitBits(http->adapt_evt, HTTP_ADAPT_FILL_BIT, pdTRUE, pdTRUE, block_ticks);
+    }
+    http->rebuffering = false;
+}
+
+/**
+ * @brief  Hold the first read after an open or a seek until the target fill when adaptive
+ */
+static void http_adapt_restart(http_stream_t *http)
+{
+    http->started = false;
+    http->eos = false;
+    http->rebuffering = (http->adapt_evt != NULL);
+}
+
+static inline void http_cache_get_cfg(http_io_cfg_t *cfg, http_cache_cfg_t *cache_cfg)
+{
+    cache_cfg->dir = cfg->cache_dir;
+    cache_cfg->max_size = cfg->cache_max_size > 0 ? cfg->cache_max_size : HTTP_STREAM_CACHE_MAX_SIZE;
+}
+
+static void http_cache_request(http_stream_t *http, http_io_cfg_t *cfg, const char *uri)
+{
+    esp_http_client_delete_header(http->client, "If-None-Match");
+    esp_http_client_delete_header(http->client, "If-Modified-Since");
+    http->cache_lookup = false;
+    if ((cfg->cache_dir == NULL) || (cfg->event_handle != NULL) || http->cache) {
+        return;
+    }
+    http_cache_cfg_t cache_cfg = {0};
+    http_cache_get_cfg(cfg, &cache_cfg);
+    if (http_cache_lookup(&cache_cfg, uri, &http->cache_meta) != 0) {
+        return;
+    }
+    http->cache_lookup = true;
+    if (http->cache_meta.etag[0]) {
+        esp_http_client_set_header(http->client, "If-None-Match", http->cache_meta.etag);
+    }
+    if (http->cache_meta.last_modified[0]) {
+        esp_http_client_set_header(http->client, "If-Modified-Since", http->cache_meta.last_modified);
+    }
+}
+
+/**
+ * @brief  Check the response against the looked up entry, return true if the entry is validated and the network
+ *         connection is closed, otherwise start a fill when the response can be cached
+ */
+static bool http_cache_response(http_stream_t *http, http_io_cfg_t *cfg, const char *uri, int status_code, uint64_t pos, uint64_t size)
+{
+    http_cache_cfg_t cache_cfg = {0};
+    http_cache_get_cfg(cfg, &cache_cfg);
+    if (http->cache_lookup) {
+        http->cache_lookup = false;
+        bool same = (status_code == 304);
+        if ((status_code == 200) || (status_code == 206)) {
+            same = http->etag[0] ? (strcmp(http->etag, http->cache_meta.etag) == 0)
+                                 : (http->last_modified[0] && (strcmp(http->last_modified, http->cache_meta.last_modified) == 0));
+        }
+        if (same) {
+            http->cache = http_cache_entry_open(&cache_cfg, uri, &http->cache_meta, false);
+        }
+        if (http->cache) {
+            ESP_LOGI(TAG, "Cache hit, %llu/%llu bytes on disk", http_cache_entry_filled(http->cache), http->cache_meta.size);
+            esp_gmf_io_set_size((esp_gmf_io_handle_t)http, http->cache_meta.size);
+            http_client_close(http);
+            return true;
+        }
+        ESP_LOGI(TAG, "Cache entry of %s is stale", uri);
+        http_cache_remove(&cache_cfg, uri);
+    }
+    if ((status_code == 200) && (pos == 0) && (size > 0) && (http->gzip_encoding == false)
+        && (http->etag[0] || http->last_modified[0]) && (cfg->event_handle == NULL)) {
+        http_cache_meta_t meta = {.size = size};
+        memcpy(meta.etag, http->etag, sizeof(meta.etag));
+        memcpy(meta.last_modified, http->last_modified, sizeof(meta.last_modified));
+        http->cache = http_cache_entry_open(&cache_cfg, uri, &meta, true);
+    }
+    return false;
+}
+
 static esp_gmf_err_t _http_new(void *cfg, esp_gmf_obj_handle_t *io)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, {return ESP_GMF_ERR_INVALID_ARG;});
@@ -149,13 +653,37 @@ static esp_gmf_err_t _http_open(esp_gmf_io_handle_t self)
     }
     char *hls_type = strrchr(uri, '/');
     if (hls_type && strstr(hls_type, ".m3u")) {
-        ESP_LOGE(TAG, "The HTTP stream does not support HTTP Live Streaming. URI:%s", uri);
+        ESP_LOGE(TAG, "The HTTP stream does not support HTTP Live Streaming, use the HLS IO instead. URI:%s", uri);
         return ESP_GMF_ERR_FAIL;
     }
+    if (http->cache && (info.pos < http_cache_entry_filled(http->cache))) {
+        ESP_LOGI(TAG, "HTTP Open from cache at %llu, URI = %s", info.pos, uri);
+        return ESP_GMF_ERR_OK;
+    }
 
     esp_gmf_io_get_info((esp_gmf_io_handle_t)http, &info);
     http_io_cfg_t *http_io_cfg = (http_io_cfg_t *)OBJ_GET_CFG(http);
     ESP_LOGI(TAG, "HTTP Open, URI = %s", uri);
+    if (http->playing == false) {
+        http->playing = true;
+        memset(&http->stats, 0, sizeof(http->stats));
+        http->stats.buf_size = http_io_cfg->out_buf_size;
+        http->stats.chunk_size = HTTP_STREAM_BUFFER_SIZE;
+        if (http->adapt_evt) {
+            http->stats.chunk_size = HTTP_STREAM_BUFFER_SIZE < http_io_cfg->chunk_max_size ? HTTP_STREAM_BUFFER_SIZE : http_io_cfg->chunk_max_size;
+            uint32_t fill_max = http->stats.buf_size - http->stats.chunk_size;
+            http->stats.target_fill = http_io_cfg->fill_min_size < fill_max ? http_io_cfg->fill_min_size : fill_max;
+        }
+        http->jitter_us = 0;
+        http->win_bytes = 0;
+        http->win_us = 0;
+        http_adapt_restart(http);
+    }
+    if ((http_io_cfg->dir == ESP_GMF_IO_DIR_READER) && (http_io_cfg->seek_buf_size > 0) && (http->seek_buf == NULL)) {
+        http->seek_buf_size = http_io_cfg->seek_buf_size;
+        http->seek_buf = esp_gmf_oal_malloc(http->seek_buf_size);
+        ESP_GMF_MEM_VERIFY(TAG, http->seek_buf, ESP_LOGW(TAG, "Go on without the seek buffer"), "seek buffer", (int)http->seek_buf_size);
+    }
     if (http->client == NULL) {
         esp_http_client_config_t http_cfg = {
             .url = uri,
@@ -171,9 +699,10 @@ static esp_gmf_err_t _http_open(esp_gmf_io_handle_t self)
         };
         http->client = esp_http_client_init(&http_cfg);
         ESP_GMF_CHECK(TAG, http->client, return ESP_GMF_ERR_MEMORY_LACK, "Failed to initialize http client");
-    } else {
+    } else if (http->keep_url == false) {
         esp_http_client_set_url(http->client, uri);
     }
+    http->keep_url = false;
 
     if (info.pos) {
         char rang_header[32];
@@ -198,7 +727,13 @@ static esp_gmf_err_t _http_open(esp_gmf_io_handle_t self)
 
     char *buffer = NULL;
     int post_len = esp_http_client_get_post_field(http->client, &buffer);
+    if (post_len <= 0) {
+        http_cache_request(http, http_io_cfg, uri);
+    }
 _stream_redirect:
+    http->accept_ranges = false;
+    http->etag[0] = '\0';
+    http->last_modified[0] = '\0';
     if (http->gzip_encoding) {
         gzip_miniz_deinit(http->gzip);
         http->gzip = NULL;
@@ -208,6 +743,7 @@ _stream_redirect:
         ESP_LOGE(TAG, "Failed to open http stream");
         return err;
     }
+    http->resp_open = true;
 
     int wrlen = dispatch_hook(self, HTTP_STREAM_ON_REQUEST, buffer, post_len);
     if (wrlen < 0) {
@@ -241,12 +777,29 @@ _stream_redirect:
         esp_http_client_set_redirection(http->client);
         goto _stream_redirect;
     }
+    if (http_io_cfg->cache_dir && (http->cache == NULL) && (post_len <= 0)
+        && http_cache_response(http, http_io_cfg, uri, status_code, info.pos, info.size)) {
+        // Validated, go back to the network only if the position is past the stored bytes
+        return (info.pos < http_cache_entry_filled(http->cache)) ? ESP_GMF_ERR_OK : _http_open(self);
+    }
+    if (status_code == 304) {
+        // The entry could not be used, it is removed so the next request is a plain one
+        http_client_close(http);
+        return _http_open(self);
+    }
     if (status_code != 200
         && (esp_http_client_get_status_code(http->client) != 206)) {
         ESP_LOGE(TAG, "Invalid HTTP stream, status code = %d", status_code);
         return ESP_GMF_ERR_FAIL;
     }
     esp_gmf_io_set_size(self, info.size);
+    if ((http_io_cfg->range_workers > 1) && http->accept_ranges && (http->gzip_encoding == false)
+        && (http_io_cfg->event_handle == NULL) && (http->range_off == false) && (info.size > 0)
+        && (info.size - info.pos > (http_io_cfg->range_seg_size > 0 ? http_io_cfg->range_seg_size : HTTP_STREAM_RANGE_SEG_SIZE))) {
+        if (http_range_start(http, http_io_cfg, info.pos, info.size) != ESP_GMF_ERR_OK) {
+            ESP_LOGW(TAG, "Go on with a single connection");
+        }
+    }
     return ESP_GMF_ERR_OK;
 }
 
@@ -254,6 +807,14 @@ static esp_gmf_err_t _http_prev_close(esp_gmf_io_handle_t self)
 {
     http_stream_t *http = (http_stream_t *)self;
     esp_gmf_db_abort(http->data_bus);
+    http_range_t *range = http->range;
+    if (range) {
+        esp_gmf_oal_mutex_lock(range->lock);
+        range->quit = true;
+        esp_gmf_oal_mutex_unlock(range->lock);
+        xEventGroupSetBits(range->evt, HTTP_RANGE_READY_BIT);
+    }
+    http_adapt_notify(http, true);
     return ESP_GMF_ERR_OK;
 }
 
@@ -274,15 +835,16 @@ static esp_gmf_err_t _http_close(esp_gmf_io_handle_t self)
             break;
         }
     }
-    if (http->gzip) {
-        gzip_miniz_deinit(http->gzip);
-        http->gzip = NULL;
-    }
-    if (http->client) {
-        esp_http_client_close(http->client);
-        esp_http_client_cleanup(http->client);
-        http->client = NULL;
+    http_client_close(http);
+    if (http->cache) {
+        http_cache_entry_close(http->cache);
+        http->cache = NULL;
     }
+    http->seek_buf_len = 0;
+    http->seek_buf_head = 0;
+    http->seek_replay = 0;
+    http->keep_url = false;
+    http->playing = false;
     return ESP_GMF_ERR_OK;
 }
 
@@ -292,7 +854,7 @@ static esp_gmf_err_t _http_reconnect(esp_gmf_io_handle_t self)
     ESP_GMF_NULL_CHECK(TAG, self, return ESP_GMF_ERR_FAIL);
     esp_gmf_info_file_t info = {0};
     err |= esp_gmf_io_get_info((esp_gmf_io_handle_t)self, &info);
-    err |= _http_close(self);
+    http_client_close((http_stream_t *)self);
     err |= esp_gmf_io_update_pos(self, info.pos);
     err |= _http_open(self);
     return err;
@@ -323,6 +885,112 @@ static int _http_read(esp_gmf_io_handle_t self, char *buffer, int len, TickType_
     return rlen;
 }
 
+static int http_range_read(esp_gmf_io_handle_t self, char *buffer, int len)
+{
+    http_stream_t *http = (http_stream_t *)self;
+    http_range_t *range = http->range;
+    if (range->main_left > 0) {
+        int rlen = _http_read(self, buffer, len < range->main_left ? len : range->main_left, portMAX_DELAY, NULL);
+        if ((rlen > 0) && (http->_errno == 0)) {
+            range->main_left -= rlen;
+            if (range->main_left == 0) {
+                esp_http_client_close(http->client);
+            }
+        }
+        return rlen;
+    }
+    http_range_worker_t *worker = NULL;
+    while (1) {
+        esp_gmf_oal_mutex_lock(range->lock);
+        if (range->quit) {
+            esp_gmf_oal_mutex_unlock(range->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        if (range->want_seg >= range->seg_num) {
+            esp_gmf_oal_mutex_unlock(range->lock);
+            return 0;
+        }
+        for (int i = 0; i < range->worker_num; i++) {
+            if ((range->workers[i].seg == range->want_seg) && range->workers[i].ready) {
+                worker = &range->workers[i];
+                break;
+            }
+        }
+        bool failed = range->failed;
+        esp_gmf_oal_mutex_unlock(range->lock);
+        if (worker || failed) {
+            break;
+        }
+        xEventGroupWaitBits(range->evt, HTTP_RANGE_READY_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+    }
+    if (worker == NULL) {
+        ESP_LOGW(TAG, "Range download failed, go on with a single connection");
+        http->range_off = true;
+        http_client_close(http);
+        if (_http_open(self) != ESP_GMF_ERR_OK) {
+            return ESP_GMF_IO_FAIL;
+        }
+        return _http_read(self, buffer, len, portMAX_DELAY, NULL);
+    }
+    uint32_t rlen = worker->len - range->want_off;
+    if (rlen > len) {
+        rlen = len;
+    }
+    memcpy(buffer, worker->buf + range->want_off, rlen);
+    range->want_off += rlen;
+    if (range->want_off >= worker->len) {
+        esp_gmf_oal_mutex_lock(range->lock);
+        worker->seg = -1;
+        worker->ready = false;
+        range->want_seg++;
+        range->want_off = 0;
+        esp_gmf_oal_mutex_unlock(range->lock);
+        xEventGroupSetBits(range->evt, HTTP_RANGE_FREE_BIT(worker->id));
+    }
+    esp_gmf_io_update_pos(self, rlen);
+    return rlen;
+}
+
+static int http_stream_read(esp_gmf_io_handle_t self, char *buffer, int len)
+{
+    http_stream_t *http = (http_stream_t *)self;
+    if (http->cache == NULL) {
+        return http->range ? http_range_read(self, buffer, len) : _http_read(self, buffer, len, portMAX_DELAY, NULL);
+    }
+    esp_gmf_info_file_t info = {0};
+    esp_gmf_io_get_info(self, &info);
+    if (info.pos < http_cache_entry_filled(http->cache)) {
+        int rlen = http_cache_entry_read(http->cache, info.pos, (uint8_t *)buffer, len);
+        if (rlen <= 0) {
+            ESP_LOGE(TAG, "Failed to read the cache at %llu", info.pos);
+            return ESP_GMF_IO_FAIL;
+        }
+        esp_gmf_io_update_pos(self, rlen);
+        return rlen;
+    }
+    if ((info.size > 0) && (info.pos >= info.size)) {
+        return 0;
+    }
+    if ((http->resp_open == false) && (http->range == NULL)) {
+        // Past the stored bytes of a validated entry, go on from the network and keep filling
+        http->is_open = false;
+        if (_http_open(self) != ESP_GMF_ERR_OK) {
+            return ESP_GMF_IO_FAIL;
+        }
+    }
+    int rlen = http->range ? http_range_read(self, buffer, len) : _http_read(self, buffer, len, portMAX_DELAY, NULL);
+    if ((rlen > 0) && (http->_errno == 0) && http->cache
+        && (http_cache_entry_write(http->cache, info.pos, (uint8_t *)buffer, rlen) < 0)) {
+        ESP_LOGW(TAG, "Stop caching %s", info.uri);
+        http_cache_cfg_t cache_cfg = {0};
+        http_cache_get_cfg((http_io_cfg_t *)OBJ_GET_CFG(http), &cache_cfg);
+        http_cache_entry_close(http->cache);
+        http->cache = NULL;
+        http_cache_remove(&cache_cfg, info.uri);
+    }
+    return rlen;
+}
+
 static int _http_write(esp_gmf_io_handle_t self, char *buffer, int len, TickType_t ticks_to_wait, void *context)
 {
     http_stream_t *http = (http_stream_t *)self;
@@ -350,8 +1018,18 @@ static int _http_process(esp_gmf_io_handle_t self, void *params)
     http->is_open = true;
     http_io_cfg_t *http_io_cfg = (http_io_cfg_t *)OBJ_GET_CFG(http);
     if (http_io_cfg->dir == ESP_GMF_IO_DIR_READER) {
-        esp_gmf_db_acquire_write(http->data_bus, &blk, HTTP_STREAM_BUFFER_SIZE, portMAX_DELAY);
-        r_size = _http_read(self, (char *)blk.buf, blk.buf_length, portMAX_DELAY, NULL);
+        r_size = esp_gmf_db_acquire_write(http->data_bus, &blk, http->stats.chunk_size, portMAX_DELAY);
+        if (r_size < 0) {
+            // Aborted by a close or a seek, nothing to read into
+            return r_size == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_FAIL;
+        }
+        // Bytes handed over again after a seek back are not copied to the seek buffer twice
+        bool replay = http->seek_replay > 0;
+        int64_t start_us = esp_gmf_oal_sys_get_time_us();
+        r_size = replay ? http_seek_buf_read(self, blk.buf, blk.buf_length) : http_stream_read(self, (char *)blk.buf, blk.buf_length);
+        if ((r_size > 0) && (replay == false)) {
+            http_adapt_update(http, http_io_cfg, r_size, esp_gmf_oal_sys_get_time_us() - start_us);
+        }
         blk.valid_size = r_size;
         ESP_LOGD(TAG, "Read: %d, len: %d", r_size, blk.buf_length);
         if (r_size > 0) {
@@ -372,16 +1050,24 @@ static int _http_process(esp_gmf_io_handle_t self, void *params)
             } else {
                 http->connect_times = 0;
                 if (http_io_cfg->dir == ESP_GMF_IO_DIR_READER) {
+                    if (replay == false) {
+                        http_seek_buf_put(http, blk.buf, r_size);
+                    }
                     esp_gmf_db_release_write(http->data_bus, &blk, portMAX_DELAY);
+                    http_adapt_notify(http, false);
                 }
             }
         } else if (r_size == 0) {
             esp_gmf_db_done_write(http->data_bus);
             esp_gmf_db_release_write(http->data_bus, &blk, portMAX_DELAY);
+            http->eos = true;
+            http_adapt_notify(http, true);
             w_size = ESP_GMF_JOB_ERR_DONE;
         } else {
             w_size = r_size;
             esp_gmf_db_abort(http->data_bus);
+            http->eos = true;
+            http_adapt_notify(http, true);
         }
     } else {
         r_size = esp_gmf_db_acquire_read(http->data_bus, &blk, HTTP_STREAM_BUFFER_SIZE, portMAX_DELAY);
@@ -406,6 +1092,10 @@ static esp_gmf_err_t _http_destroy(esp_gmf_io_handle_t self)
         if (http->data_bus) {
             esp_gmf_db_deinit(http->data_bus);
         }
+        esp_gmf_oal_free(http->seek_buf);
+        if (http->adapt_evt) {
+            vEventGroupDelete(http->adapt_evt);
+        }
         esp_gmf_oal_free(OBJ_GET_CFG(http));
         esp_gmf_io_deinit(http);
         esp_gmf_oal_free(http);
@@ -423,19 +1113,58 @@ static esp_gmf_err_t _http_seek(esp_gmf_io_handle_t handle, uint64_t pos)
         return ESP_GMF_ERR_OUT_OF_RANGE;
     }
     ESP_LOGD(TAG, "HTTP Seek to: %lld, %p", pos, http);
-    _http_close(handle);
-
-    esp_gmf_io_set_pos(http, pos);
     esp_gmf_db_reset(http->data_bus);
-    _http_open(handle);
-
-    return ESP_GMF_ERR_OK;
+    http_adapt_restart(http);
+    // Position of the connection, ahead of the IO one while bytes of the seek buffer are handed over again
+    uint64_t cur = info.pos + http->seek_replay;
+    http->seek_replay = 0;
+    if ((http->range == NULL) && (pos <= cur) && (cur - pos <= http->seek_buf_len)) {
+        // Among the last bytes handed to the data bus, hand them over again and go on with the response after them
+        http->seek_replay = cur - pos;
+        esp_gmf_io_set_pos(http, pos);
+        return ESP_GMF_ERR_OK;
+    }
+    if (http->resp_open && (http->range == NULL) && (http->cache == NULL) && (pos > cur) && (pos - cur <= HTTP_SEEK_SKIP_SIZE)) {
+        // Close ahead, read up to the target on the open response rather than sending a new request
+        char skip[256];
+        while (cur < pos) {
+            int rlen = _http_read_data(http, skip, pos - cur > sizeof(skip) ? sizeof(skip) : (int)(pos - cur));
+            if (rlen <= 0) {
+                break;
+            }
+            http_seek_buf_put(http, (uint8_t *)skip, rlen);
+            cur += rlen;
+        }
+        if (cur == pos) {
+            esp_gmf_io_set_pos(http, pos);
+            return ESP_GMF_ERR_OK;
+        }
+    }
+    http->seek_buf_len = 0;
+    uint64_t left = UINT64_MAX;
+    if ((http->range == NULL) && (http->gzip_encoding == false) && (info.size > 0)) {
+        left = info.size > cur ? info.size - cur : 0;
+    }
+    http_client_rewind(http, left);
+    esp_gmf_io_set_pos(http, pos);
+    http->keep_url = true;
+    esp_gmf_err_t ret = _http_open(handle);
+    if ((ret != ESP_GMF_ERR_OK) && http->client) {
+        // The server may have closed the kept connection meanwhile
+        ESP_LOGW(TAG, "Reopen at %llu on a new connection", pos);
+        http_client_rewind(http, UINT64_MAX);
+        esp_http_client_close(http->client);
+        http->keep_url = true;
+        ret = _http_open(handle);
+    }
+    return ret;
 }
 
 static esp_gmf_err_io_t _http_acquire_read(esp_gmf_io_handle_t handle, void *payload, uint32_t wanted_size, int block_ticks)
 {
     http_stream_t *http = (http_stream_t *)handle;
     esp_gmf_data_bus_block_t *blk = (esp_gmf_data_bus_block_t *)payload;
+    http_adapt_wait(http, block_ticks);
     int rlen = esp_gmf_db_acquire_read(http->data_bus, payload, wanted_size, block_ticks);
     ESP_LOGD(TAG, "acq_rd: %ld, vld: %d, done: %d, %p, %d", wanted_size, blk->valid_size, blk->is_last, blk->buf, blk->buf_length);
     return rlen;
@@ -474,6 +1203,20 @@ esp_gmf_err_t esp_gmf_io_http_reset(esp_gmf_io_handle_t el)
     esp_gmf_io_set_pos(el, 0);
     esp_gmf_io_set_size(el, 0);
     http->is_open = false;
+    http->range_off = false;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_io_http_get_stats(esp_gmf_io_handle_t io, esp_gmf_io_http_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, io, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    http_stream_t *http = (http_stream_t *)io;
+    *stats = http->stats;
+    stats->filled = 0;
+    if (http->data_bus) {
+        esp_gmf_db_get_filled_size(http->data_bus, &stats->filled);
+    }
     return ESP_GMF_ERR_OK;
 }
 
@@ -539,6 +1282,10 @@ esp_gmf_err_t esp_gmf_io_http_cast(http_io_cfg_t *config, esp_gmf_io_handle_t ob
         ESP_LOGE(TAG, "Failed to create the download buffer, sz: %d, %s-%p", config->out_buf_size, OBJ_GET_TAG(http), http);
         return ret;
     }
+    if ((config->dir == ESP_GMF_IO_DIR_READER) && (config->chunk_max_size > 0) && (http->adapt_evt == NULL)) {
+        http->adapt_evt = xEventGroupCreate();
+        ESP_GMF_CHECK(TAG, http->adapt_evt, return ESP_GMF_ERR_MEMORY_LACK, "Failed to create the adaptive sizing event");
+    }
     esp_gmf_data_bus_type_t db_type = 0;
     esp_gmf_db_get_type(http->data_bus, &db_type);
     http->base.type = db_type;
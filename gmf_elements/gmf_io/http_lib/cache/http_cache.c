@@ -0,0 +1,381 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "esp_log.h"
+#include "http_cache.h"
+
+#define TAG                    "HTTP_CACHE"
+#define HTTP_CACHE_MAGIC       "HCv1"
+#define HTTP_CACHE_PATH_SIZE   (128)
+#define HTTP_CACHE_LINE_SIZE   (512)
+#define HTTP_CACHE_META_STEP   (64 * 1024)
+#define HTTP_CACHE_NAME_LEN    (8)
+
+typedef struct {
+    char               data_path[HTTP_CACHE_PATH_SIZE];
+    char               meta_path[HTTP_CACHE_PATH_SIZE];
+    char              *url;
+    http_cache_meta_t  meta;
+    uint32_t           seq;
+    FILE              *fp;
+    uint64_t           fp_pos;
+    bool               fp_wr;
+    uint64_t           saved;
+} http_cache_entry_impl_t;
+
+static void http_cache_name(const char *url, char name[HTTP_CACHE_NAME_LEN + 1])
+{
+    // FNV-1a, the URL is stored in the meta file to tell collisions apart
+    uint32_t hash = 2166136261u;
+    for (const uint8_t *p = (const uint8_t *)url; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    snprintf(name, HTTP_CACHE_NAME_LEN + 1, "%08" PRIx32, hash);
+}
+
+static void http_cache_path(const char *dir, const char *name, const char *ext, char *path)
+{
+    snprintf(path, HTTP_CACHE_PATH_SIZE, "%s/%s.%s", dir, name, ext);
+}
+
+static void http_cache_strip(char *line)
+{
+    size_t len = strlen(line);
+    while (len && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+        line[--len] = '\0';
+    }
+}
+
+static int http_cache_read_meta(const char *path, char *url, http_cache_meta_t *meta, uint32_t *seq)
+{
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    char line[HTTP_CACHE_LINE_SIZE];
+    int ret = -1;
+    unsigned long long size = 0, filled = 0;
+    unsigned long use = 0;
+    if (fgets(line, sizeof(line), fp) == NULL || strncmp(line, HTTP_CACHE_MAGIC, strlen(HTTP_CACHE_MAGIC))) {
+        goto _meta_exit;
+    }
+    if (fgets(line, sizeof(line), fp) == NULL) {
+        goto _meta_exit;
+    }
+    http_cache_strip(line);
+    if (url) {
+        snprintf(url, HTTP_CACHE_LINE_SIZE, "%s", line);
+    }
+    if (fgets(meta->etag, sizeof(meta->etag), fp) == NULL
+        || fgets(meta->last_modified, sizeof(meta->last_modified), fp) == NULL
+        || fgets(line, sizeof(line), fp) == NULL
+        || sscanf(line, "%llu %llu %lu", &size, &filled, &use) != 3) {
+        goto _meta_exit;
+    }
+    http_cache_strip(meta->etag);
+    http_cache_strip(meta->last_modified);
+    meta->size = size;
+    meta->filled = filled > size ? size : filled;
+    *seq = use;
+    ret = 0;
+_meta_exit:
+    fclose(fp);
+    return ret;
+}
+
+static int http_cache_write_meta(http_cache_entry_impl_t *entry)
+{
+    // Write aside then swap, an interrupted update leaves the previous meta file in place
+    char tmp_path[HTTP_CACHE_PATH_SIZE];
+    snprintf(tmp_path, sizeof(tmp_path), "%.*s.tmp", (int)(strlen(entry->meta_path) - 4), entry->meta_path);
+    FILE *fp = fopen(tmp_path, "w");
+    if (fp == NULL) {
+        ESP_LOGE(TAG, "Failed to open %s, errno %d", tmp_path, errno);
+        return -1;
+    }
+    fprintf(fp, "%s\n%s\n%s\n%s\n%llu %llu %lu\n", HTTP_CACHE_MAGIC, entry->url, entry->meta.etag, entry->meta.last_modified,
+            (unsigned long long)entry->meta.size, (unsigned long long)entry->meta.filled, (unsigned long)entry->seq);
+    fflush(fp);
+    fsync(fileno(fp));
+    fclose(fp);
+    remove(entry->meta_path);
+    if (rename(tmp_path, entry->meta_path) != 0) {
+        ESP_LOGE(TAG, "Failed to save %s, errno %d", entry->meta_path, errno);
+        return -1;
+    }
+    entry->saved = entry->meta.filled;
+    return 0;
+}
+
+static void http_cache_remove_name(const char *dir, const char *name)
+{
+    char path[HTTP_CACHE_PATH_SIZE];
+    http_cache_path(dir, name, "met", path);
+    remove(path);
+    http_cache_path(dir, name, "dat", path);
+    remove(path);
+}
+
+/**
+ * @brief  Walk the meta files, sum the reserved sizes except for `skip`, find the highest use sequence and the
+ *         least recently used entry
+ */
+static int http_cache_scan(const char *dir, const char *skip, uint64_t *total, uint32_t *max_seq, char *oldest)
+{
+    DIR *d = opendir(dir);
+    if (d == NULL) {
+        return -1;
+    }
+    uint32_t min_seq = UINT32_MAX;
+    *total = 0;
+    *max_seq = 0;
+    oldest[0] = '\0';
+    struct dirent *ent = NULL;
+    while ((ent = readdir(d)) != NULL) {
+        const char *dot = strrchr(ent->d_name, '.');
+        if (dot == NULL || (dot - ent->d_name) != HTTP_CACHE_NAME_LEN || strcasecmp(dot, ".met")) {
+            continue;
+        }
+        char name[HTTP_CACHE_NAME_LEN + 1];
+        snprintf(name, sizeof(name), "%.*s", HTTP_CACHE_NAME_LEN, ent->d_name);
+        char path[HTTP_CACHE_PATH_SIZE];
+        http_cache_path(dir, name, "met", path);
+        http_cache_meta_t meta = {0};
+        uint32_t seq = 0;
+        if (http_cache_read_meta(path, NULL, &meta, &seq) != 0) {
+            continue;
+        }
+        if (seq > *max_seq) {
+            *max_seq = seq;
+        }
+        if (skip && strcasecmp(name, skip) == 0) {
+            continue;
+        }
+        *total += meta.size;
+        if (seq < min_seq) {
+            min_seq = seq;
+            strcpy(oldest, name);
+        }
+    }
+    closedir(d);
+    return 0;
+}
+
+int http_cache_lookup(const http_cache_cfg_t *cfg, const char *url, http_cache_meta_t *meta)
+{
+    if (cfg == NULL || cfg->dir == NULL || url == NULL || meta == NULL) {
+        return -1;
+    }
+    char name[HTTP_CACHE_NAME_LEN + 1];
+    char path[HTTP_CACHE_PATH_SIZE];
+    http_cache_name(url, name);
+    http_cache_path(cfg->dir, name, "met", path);
+    char *stored = malloc(HTTP_CACHE_LINE_SIZE);
+    if (stored == NULL) {
+        return -1;
+    }
+    uint32_t seq = 0;
+    int ret = http_cache_read_meta(path, stored, meta, &seq);
+    if (ret == 0 && strcmp(stored, url)) {
+        ret = -1;
+    }
+    free(stored);
+    return ret;
+}
+
+http_cache_entry_t http_cache_entry_open(const http_cache_cfg_t *cfg, const char *url, const http_cache_meta_t *meta, bool create)
+{
+    if (cfg == NULL || cfg->dir == NULL || url == NULL || meta == NULL || strlen(url) >= HTTP_CACHE_LINE_SIZE) {
+        return NULL;
+    }
+    if (create && meta->size > cfg->max_size) {
+        ESP_LOGW(TAG, "Content of %llu bytes does not fit the cache of %llu bytes", meta->size, cfg->max_size);
+        return NULL;
+    }
+    mkdir(cfg->dir, 0775);
+    char name[HTTP_CACHE_NAME_LEN + 1];
+    http_cache_name(url, name);
+    uint64_t total = 0;
+    uint32_t max_seq = 0;
+    char oldest[HTTP_CACHE_NAME_LEN + 1];
+    if (http_cache_scan(cfg->dir, name, &total, &max_seq, oldest) != 0) {
+        ESP_LOGE(TAG, "Failed to scan %s", cfg->dir);
+        return NULL;
+    }
+    while (create && (total + meta->size > cfg->max_size) && oldest[0]) {
+        ESP_LOGI(TAG, "Evict %s to fit %llu bytes", oldest, meta->size);
+        http_cache_remove_name(cfg->dir, oldest);
+        if (http_cache_scan(cfg->dir, name, &total, &max_seq, oldest) != 0) {
+            return NULL;
+        }
+    }
+    http_cache_entry_impl_t *entry = calloc(1, sizeof(http_cache_entry_impl_t));
+    if (entry == NULL) {
+        return NULL;
+    }
+    entry->url = strdup(url);
+    if (entry->url == NULL) {
+        free(entry);
+        return NULL;
+    }
+    http_cache_path(cfg->dir, name, "dat", entry->data_path);
+    http_cache_path(cfg->dir, name, "met", entry->meta_path);
+    entry->meta = *meta;
+    entry->seq = max_seq + 1;
+    if (create) {
+        entry->meta.filled = 0;
+        entry->fp = fopen(entry->data_path, "w+b");
+    } else {
+        entry->fp = fopen(entry->data_path, "r+b");
+        struct stat st = {0};
+        // A fill interrupted before its data reached the disk only keeps what the data file really holds
+        if (entry->fp && stat(entry->data_path, &st) == 0 && (uint64_t)st.st_size < entry->meta.filled) {
+            entry->meta.filled = st.st_size;
+        }
+    }
+    if (entry->fp == NULL || http_cache_write_meta(entry) != 0) {
+        ESP_LOGE(TAG, "Failed to open entry %s, errno %d", entry->data_path, errno);
+        if (entry->fp) {
+            fclose(entry->fp);
+        }
+        http_cache_remove_name(cfg->dir, name);
+        free(entry->url);
+        free(entry);
+        return NULL;
+    }
+    ESP_LOGI(TAG, "Open %s, %llu/%llu bytes cached", entry->data_path, entry->meta.filled, entry->meta.size);
+    return entry;
+}
+
+int http_cache_entry_read(http_cache_entry_t handle, uint64_t pos, uint8_t *buf, int len)
+{
+    http_cache_entry_impl_t *entry = (http_cache_entry_impl_t *)handle;
+    if (entry == NULL || buf == NULL || len < 0) {
+        return -1;
+    }
+    if (pos >= entry->meta.filled) {
+        return 0;
+    }
+    if (len > entry->meta.filled - pos) {
+        len = entry->meta.filled - pos;
+    }
+    // The stream must be repositioned when it switches between reading and writing
+    if (entry->fp_pos != pos || entry->fp_wr) {
+        if (fseek(entry->fp, pos, SEEK_SET) != 0) {
+            return -1;
+        }
+        entry->fp_pos = pos;
+        entry->fp_wr = false;
+    }
+    int rlen = fread(buf, 1, len, entry->fp);
+    if (rlen <= 0) {
+        entry->fp_pos = UINT64_MAX;
+        return -1;
+    }
+    entry->fp_pos += rlen;
+    return rlen;
+}
+
+int http_cache_entry_write(http_cache_entry_t handle, uint64_t pos, const uint8_t *buf, int len)
+{
+    http_cache_entry_impl_t *entry = (http_cache_entry_impl_t *)handle;
+    if (entry == NULL || buf == NULL || len < 0) {
+        return -1;
+    }
+    if (pos != entry->meta.filled || pos >= entry->meta.size) {
+        return 0;
+    }
+    if (len > entry->meta.size - pos) {
+        len = entry->meta.size - pos;
+    }
+    if (entry->fp_pos != pos || entry->fp_wr == false) {
+        if (fseek(entry->fp, pos, SEEK_SET) != 0) {
+            return -1;
+        }
+        entry->fp_pos = pos;
+        entry->fp_wr = true;
+    }
+    int wlen = fwrite(buf, 1, len, entry->fp);
+    if (wlen != len) {
+        ESP_LOGE(TAG, "Failed to write %s, errno %d", entry->data_path, errno);
+        entry->fp_pos = UINT64_MAX;
+        return -1;
+    }
+    entry->fp_pos += wlen;
+    entry->meta.filled += wlen;
+    // Save the progress now and then, so an aborted fill is resumed from there
+    if (entry->meta.filled == entry->meta.size || entry->meta.filled - entry->saved >= HTTP_CACHE_META_STEP) {
+        fflush(entry->fp);
+        fsync(fileno(entry->fp));
+        http_cache_write_meta(entry);
+    }
+    return wlen;
+}
+
+uint64_t http_cache_entry_filled(http_cache_entry_t handle)
+{
+    http_cache_entry_impl_t *entry = (http_cache_entry_impl_t *)handle;
+    return entry ? entry->meta.filled : 0;
+}
+
+int http_cache_entry_close(http_cache_entry_t handle)
+{
+    http_cache_entry_impl_t *entry = (http_cache_entry_impl_t *)handle;
+    if (entry == NULL) {
+        return -1;
+    }
+    int ret = 0;
+    fflush(entry->fp);
+    fsync(fileno(entry->fp));
+    if (entry->meta.filled != entry->saved) {
+        ret = http_cache_write_meta(entry);
+    }
+    fclose(entry->fp);
+    ESP_LOGI(TAG, "Close %s, %llu/%llu bytes cached", entry->data_path, entry->meta.filled, entry->meta.size);
+    free(entry->url);
+    free(entry);
+    return ret;
+}
+
+int http_cache_remove(const http_cache_cfg_t *cfg, const char *url)
+{
+    if (cfg == NULL || cfg->dir == NULL || url == NULL) {
+        return -1;
+    }
+    char name[HTTP_CACHE_NAME_LEN + 1];
+    http_cache_name(url, name);
+    http_cache_remove_name(cfg->dir, name);
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef _HTTP_CACHE_H_
+#define _HTTP_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HTTP_CACHE_VALIDATOR_SIZE (64)
+
+/**
+ * @brief On-disk response cache, every entry is a data file holding the content from byte 0 and a meta file
+ *        holding the URL, the validators, the filled length and a use sequence for the LRU eviction
+ */
+typedef struct {
+    const char *dir;       /*!< Directory of the cache, created if missing */
+    uint64_t    max_size;  /*!< Size cap of all the entries, the least recently used ones are evicted */
+} http_cache_cfg_t;
+
+/**
+ * @brief Meta data of a cache entry
+ */
+typedef struct {
+    char      etag[HTTP_CACHE_VALIDATOR_SIZE];           /*!< ETag of the response, empty if none */
+    char      last_modified[HTTP_CACHE_VALIDATOR_SIZE];  /*!< Last-Modified of the response, empty if none */
+    uint64_t  size;                                      /*!< Total size of the content */
+    uint64_t  filled;                                    /*!< Bytes stored on disk from byte 0 */
+} http_cache_meta_t;
+
+/**
+ * @brief Handle for an opened cache entry
+ */
+typedef void *http_cache_entry_t;
+
+/**
+ * @brief         Look up the entry of a URL
+ * @param         cfg: Cache configuration
+ * @param         url: URL of the content
+ * @param         meta: Meta data of the entry when found
+ * @return        0: Found
+ *                -1: Not found or unreadable
+ */
+int http_cache_lookup(const http_cache_cfg_t *cfg, const char *url, http_cache_meta_t *meta);
+
+/**
+ * @brief         Open the entry of a URL and mark it as the most recently used one
+ * @param         cfg: Cache configuration
+ * @param         url: URL of the content
+ * @param         meta: Meta data of the entry, `filled` is ignored on creation
+ * @param         create: Create an empty entry, evicting other ones to fit `meta->size` under the cap
+ * @return        NULL: The entry can not be opened or does not fit the cap
+ *                Others: Handle of the entry
+ */
+http_cache_entry_t http_cache_entry_open(const http_cache_cfg_t *cfg, const char *url, const http_cache_meta_t *meta, bool create);
+
+/**
+ * @brief         Read stored content of an entry
+ * @param         entry: Handle of the entry
+ * @param         pos: Byte position of the content
+ * @param         buf: Buffer to read into
+ * @param         len: Size of the buffer
+ * @return        >= 0: Bytes read, 0 if `pos` is not stored yet
+ *                -1: Read error
+ */
+int http_cache_entry_read(http_cache_entry_t entry, uint64_t pos, uint8_t *buf, int len);
+
+/**
+ * @brief         Append content to an entry, data not starting right at the filled length is ignored
+ * @param         entry: Handle of the entry
+ * @param         pos: Byte position of the data in the content
+ * @param         buf: Data to write
+ * @param         len: Size of the data
+ * @return        >= 0: Bytes stored
+ *                -1: Write error
+ */
+int http_cache_entry_write(http_cache_entry_t entry, uint64_t pos, const uint8_t *buf, int len);
+
+/**
+ * @brief         Get the bytes stored on disk from byte 0
+ * @param         entry: Handle of the entry
+ * @return        Filled length of the entry
+ */
+uint64_t http_cache_entry_filled(http_cache_entry_t entry);
+
+/**
+ * @brief         Save the filled length and close the entry
+ * @param         entry: Handle of the entry
+ * @return        0: On success
+ *                -1: Failed to save the meta data
+ */
+int http_cache_entry_close(http_cache_entry_t entry);
+
+/**
+ * @brief         Remove the entry of a URL
+ * @param         cfg: Cache configuration
+ * @param         url: URL of the content
+ * @return        0: On success
+ *                -1: Wrong input parameter
+ */
+int http_cache_remove(const http_cache_cfg_t *cfg, const char *url);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "hls_playlist.h"
+
+#define TAG  "HLS_PLAYLIST"
+
+#define HLS_TAG_MATCH(line, tag)  (strncmp(line, tag, sizeof(tag) - 1) == 0)
+
+typedef struct {
+    hls_playlist_t  *pl;
+    int              variant_cap;
+    int              segment_cap;
+    uint64_t         seq;
+    uint32_t         pending_duration_ms;
+    uint32_t         pending_bandwidth;
+    bool             pending_segment;
+    bool             pending_variant;
+} hls_parser_t;
+
+static char *hls_resolve_uri(const char *base, const char *uri)
+{
+    if (strstr(uri, "://")) {
+        return strdup(uri);
+    }
+    int base_len = 0;
+    if (uri[0] == '/') {
+        // Host relative, keep "scheme://host[:port]"
+        const char *host = strstr(base, "://");
+        const char *path = host ? strchr(host + 3, '/') : NULL;
+        base_len = path ? path - base : strlen(base);
+    } else {
+        // Directory relative, drop the query and the last path component
+        const char *query = strchr(base, '?');
+        int end = query ? query - base : strlen(base);
+        while (end > 0 && base[end - 1] != '/') {
+            end--;
+        }
+        base_len = end;
+    }
+    int len = base_len + strlen(uri) + 1;
+    char *out = malloc(len);
+    if (out) {
+        snprintf(out, len, "%.*s%s", base_len, base, uri);
+    }
+    return out;
+}
+
+static uint32_t hls_parse_ms(const char *s)
+{
+    // Decimal seconds without relying on float formatting
+    uint32_t sec = strtoul(s, (char **)&s, 10);
+    uint32_t ms = 0;
+    if (*s == '.') {
+        int scale = 100;
+        for (s++; *s >= '0' && *s <= '9'; s++) {
+            ms += (*s - '0') * scale;
+            scale /= 10;
+        }
+    }
+    return sec * 1000 + ms;
+}
+
+static const char *hls_find_attr(const char *attrs, const char *name)
+{
+    int name_len = strlen(name);
+    const char *p = attrs;
+    while ((p = strstr(p, name)) != NULL) {
+        if ((p == attrs || p[-1] == ',' || p[-1] == ':') && p[name_len] == '=') {
+            return p + name_len + 1;
+        }
+        p += name_len;
+    }
+    return NULL;
+}
+
+static int hls_add_uri(hls_parser_t *parser, const char *base, const char *line)
+{
+    hls_playlist_t *pl = parser->pl;
+    char *uri = hls_resolve_uri(base, line);
+    if (uri == NULL) {
+        return -1;
+    }
+    if (parser->pending_variant) {
+        if (pl->variant_num == parser->variant_cap) {
+            int cap = parser->variant_cap ? parser->variant_cap * 2 : 4;
+            hls_variant_t *variants = realloc(pl->variants, cap * sizeof(hls_variant_t));
+            if (variants == NULL) {
+                free(uri);
+                return -1;
+            }
+            pl->variants = variants;
+            parser->variant_cap = cap;
+        }
+        pl->variants[pl->variant_num].uri = uri;
+        pl->variants[pl->variant_num].bandwidth = parser->pending_bandwidth;
+        pl->variant_num++;
+        parser->pending_variant = false;
+        return 0;
+    }
+    if (pl->segment_num == parser->segment_cap) {
+        int cap = parser->segment_cap ? parser->segment_cap * 2 : 8;
+        hls_segment_t *segments = realloc(pl->segments, cap * sizeof(hls_segment_t));
+        if (segments == NULL) {
+            free(uri);
+            return -1;
+        }
+        pl->segments = segments;
+        parser->segment_cap = cap;
+    }
+    pl->segments[pl->segment_num].uri = uri;
+    pl->segments[pl->segment_num].duration_ms = parser->pending_duration_ms;
+    pl->segments[pl->segment_num].seq = parser->seq++;
+    pl->segment_num++;
+    parser->pending_segment = false;
+    return 0;
+}
+
+static int hls_parse_line(hls_parser_t *parser, const char *base, const char *line)
+{
+    hls_playlist_t *pl = parser->pl;
+    if (line[0] == '\0') {
+        return 0;
+    }
+    if (line[0] != '#') {
+        if (parser->pending_variant || parser->pending_segment) {
+            return hls_add_uri(parser, base, line);
+        }
+        ESP_LOGW(TAG, "Ignore URI without tag, %s", line);
+        return 0;
+    }
+    if (HLS_TAG_MATCH(line, "#EXT-X-STREAM-INF:")) {
+        const char *bw = hls_find_attr(line + strlen("#EXT-X-STREAM-INF:"), "BANDWIDTH");
+        parser->pending_bandwidth = bw ? strtoul(bw, NULL, 10) : 0;
+        parser->pending_variant = true;
+        pl->is_master = true;
+    } else if (HLS_TAG_MATCH(line, "#EXTINF:")) {
+        parser->pending_duration_ms = hls_parse_ms(line + strlen("#EXTINF:"));
+        parser->pending_segment = true;
+    } else if (HLS_TAG_MATCH(line, "#EXT-X-TARGETDURATION:")) {
+        pl->target_duration_ms = hls_parse_ms(line + strlen("#EXT-X-TARGETDURATION:"));
+    } else if (HLS_TAG_MATCH(line, "#EXT-X-MEDIA-SEQUENCE:")) {
+        parser->seq = strtoull(line + strlen("#EXT-X-MEDIA-SEQUENCE:"), NULL, 10);
+    } else if (HLS_TAG_MATCH(line, "#EXT-X-ENDLIST")) {
+        pl->ended = true;
+    } else if (HLS_TAG_MATCH(line, "#EXT-X-KEY:")) {
+        const char *method = hls_find_attr(line + strlen("#EXT-X-KEY:"), "METHOD");
+        if (method && strncmp(method, "NONE", 4) != 0) {
+            ESP_LOGE(TAG, "Encrypted segments are not supported, %s", line);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int hls_variant_cmp(const void *a, const void *b)
+{
+    const hls_variant_t *va = a;
+    const hls_variant_t *vb = b;
+    return (va->bandwidth > vb->bandwidth) - (va->bandwidth < vb->bandwidth);
+}
+
+int hls_playlist_parse(const char *base_uri, const char *text, int len, hls_playlist_t **playlist)
+{
+    if (base_uri == NULL || text == NULL || playlist == NULL) {
+        return -1;
+    }
+    // Skip the UTF-8 BOM if present
+    if (len >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+        text += 3;
+        len -= 3;
+    }
+    if (len < 7 || strncmp(text, "#EXTM3U", 7) != 0) {
+        ESP_LOGE(TAG, "Not a playlist");
+        return -1;
+    }
+    hls_parser_t parser = {0};
+    parser.pl = calloc(1, sizeof(hls_playlist_t));
+    char *line = malloc(len + 1);
+    if (parser.pl == NULL || line == NULL) {
+        free(parser.pl);
+        free(line);
+        return -1;
+    }
+    int ret = 0;
+    int pos = 0;
+    while (pos < len && ret == 0) {
+        int start = pos;
+        while (pos < len && text[pos] != '\n') {
+            pos++;
+        }
+        int end = pos++;
+        while (end > start && (text[end - 1] == '\r' || text[end - 1] == ' ' || text[end - 1] == '\t')) {
+            end--;
+        }
+        while (start < end && (text[start] == ' ' || text[start] == '\t')) {
+            start++;
+        }
+        memcpy(line, text + start, end - start);
+        line[end - start] = '\0';
+        ret = hls_parse_line(&parser, base_uri, line);
+    }
+    free(line);
+    hls_playlist_t *pl = parser.pl;
+    if (ret == 0 && pl->variant_num == 0 && pl->segment_num == 0 && pl->ended == false) {
+        ESP_LOGE(TAG, "Playlist has neither variant nor segment");
+        ret = -1;
+    }
+    if (ret != 0) {
+        hls_playlist_free(pl);
+        return -1;
+    }
+    if (pl->variant_num > 1) {
+        qsort(pl->variants, pl->variant_num, sizeof(hls_variant_t), hls_variant_cmp);
+    }
+    if (pl->target_duration_ms == 0) {
+        for (int i = 0; i < pl->segment_num; i++) {
+            if (pl->segments[i].duration_ms > pl->target_duration_ms) {
+                pl->target_duration_ms = pl->segments[i].duration_ms;
+            }
+        }
+    }
+    *playlist = pl;
+    return 0;
+}
+
+const hls_segment_t *hls_playlist_find(const hls_playlist_t *playlist, uint64_t seq)
+{
+    if (playlist == NULL || playlist->segment_num == 0) {
+        return NULL;
+    }
+    uint64_t first = playlist->segments[0].seq;
+    if (seq < first || seq - first >= (uint64_t)playlist->segment_num) {
+        return NULL;
+    }
+    return &playlist->segments[seq - first];
+}
+
+void hls_playlist_free(hls_playlist_t *playlist)
+{
+    if (playlist == NULL) {
+        return;
+    }
+    for (int i = 0; i < playlist->variant_num; i++) {
+        free(playlist->variants[i].uri);
+    }
+    for (int i = 0; i < playlist->segment_num; i++) {
+        free(playlist->segments[i].uri);
+    }
+    free(playlist->variants);
+    free(playlist->segments);
+    free(playlist);
+}
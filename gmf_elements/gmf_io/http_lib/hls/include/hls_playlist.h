@@ -0,0 +1,95 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef _HLS_PLAYLIST_H_
+#define _HLS_PLAYLIST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Variant stream of a master playlist
+ */
+typedef struct {
+    char      *uri;        /*!< Absolute URI of the media playlist */
+    uint32_t   bandwidth;  /*!< Peak bandwidth in bits per second */
+} hls_variant_t;
+
+/**
+ * @brief Media segment of a media playlist
+ */
+typedef struct {
+    char      *uri;          /*!< Absolute URI of the segment */
+    uint32_t   duration_ms;  /*!< Duration of the segment */
+    uint64_t   seq;          /*!< Media sequence number */
+} hls_segment_t;
+
+/**
+ * @brief Parsed playlist, either a master one with variants or a media one with segments
+ */
+typedef struct {
+    bool            is_master;           /*!< Master playlist */
+    hls_variant_t  *variants;            /*!< Variants sorted by bandwidth, lowest first */
+    int             variant_num;         /*!< Number of variants */
+    hls_segment_t  *segments;            /*!< Segments in playback order */
+    int             segment_num;         /*!< Number of segments */
+    uint32_t        target_duration_ms;  /*!< Target duration of the segments */
+    bool            ended;               /*!< No more segment will be added, VOD or ended live stream */
+} hls_playlist_t;
+
+/**
+ * @brief         Parse a playlist
+ * @param         base_uri: URI the playlist was loaded from, relative URIs are resolved against it
+ * @param         text: Playlist text, not necessarily null-terminated
+ * @param         len: Length of the text
+ * @param         playlist: Parsed playlist, to be freed with `hls_playlist_free`
+ * @return        0: On success
+ *                -1: Not a playlist, unsupported content or no memory
+ */
+int hls_playlist_parse(const char *base_uri, const char *text, int len, hls_playlist_t **playlist);
+
+/**
+ * @brief         Find a segment by its media sequence number
+ * @param         playlist: Media playlist
+ * @param         seq: Media sequence number
+ * @return        NULL: Not in the playlist
+ *                Others: The segment
+ */
+const hls_segment_t *hls_playlist_find(const hls_playlist_t *playlist, uint64_t seq);
+
+/**
+ * @brief         Free a parsed playlist
+ * @param         playlist: Parsed playlist
+ */
+void hls_playlist_free(hls_playlist_t *playlist);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -32,15 +32,35 @@ extern "C" {
 
 /**
  * @brief  File IO configurations, if any entry is zero then the configuration will be set to default values
+ *
+ *         A writer without `cache_size` writes and syncs every payload to the storage as it comes. With `cache_size`
+ *         set, the payloads are coalesced in a write-behind buffer that goes to the file when full, and the file is
+ *         synced once `sync_bytes` were written or `sync_ms` passed since the last sync. With both of them zero it is
+ *         only synced on close and on `esp_gmf_io_file_sync`. With `flush_task` the buffer is written and synced by a
+ *         background thread while the writer fills a second buffer, so a write only waits when both are full
  */
 typedef struct {
-    int         dir;  /*!< IO direction, reader or writer */
-    const char *name; /*!< Name for this instance */
+    int         dir;         /*!< IO direction, reader or writer */
+    const char *name;        /*!< Name for this instance */
+    uint32_t    cache_size;  /*!< Size of the write-behind buffer of a writer, 0 to write through */
+    uint32_t    sync_bytes;  /*!< Sync after this many bytes since the last sync, 0 for no sync by size */
+    uint32_t    sync_ms;     /*!< Sync after this many milliseconds since the last sync, 0 for no sync by time */
+    bool        flush_task;  /*!< Write and sync the buffer from a background thread */
+    int         task_stack;  /*!< Stack size of the flush thread, 0 for the default */
+    int         task_prio;   /*!< Priority of the flush thread, 0 for the default */
+    int         task_core;   /*!< CPU core of the flush thread */
 } file_io_cfg_t;
 
-#define FILE_IO_CFG_DEFAULT() {   \
-    .dir  = ESP_GMF_IO_DIR_NONE,  \
-    .name = NULL,                 \
+#define FILE_IO_CFG_DEFAULT() {         \
+    .dir        = ESP_GMF_IO_DIR_NONE,  \
+    .name       = NULL,                 \
+    .cache_size = 0,                    \
+    .sync_bytes = 0,                    \
+    .sync_ms    = 0,                    \
+    .flush_task = false,                \
+    .task_stack = 0,                    \
+    .task_prio  = 0,                    \
+    .task_core  = 0,                    \
 }
 
 /**
@@ -69,6 +89,21 @@ esp_gmf_err_t esp_gmf_io_file_init(file_io_cfg_t *config, esp_gmf_io_handle_t *i
  */
 esp_gmf_err_t esp_gmf_io_file_cast(file_io_cfg_t *config, esp_gmf_io_handle_t obj);
 
+/**
+ * @brief  Write the buffered data of a file writer to the storage and wait until it is synced
+ *
+ *         It is a durability point for the callers of a write-behind writer, e.g. at the end of a recorded segment. On a
+ *         writer without cache or not opened it only syncs what is already written
+ *
+ * @param[in]  io  File IO handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument or the IO is not a writer
+ *       - ESP_GMF_ERR_FAIL         Writing or syncing the file failed
+ */
+esp_gmf_err_t esp_gmf_io_file_sync(esp_gmf_io_handle_t io);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
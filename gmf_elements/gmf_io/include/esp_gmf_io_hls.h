@@ -0,0 +1,127 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "esp_gmf_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#define HLS_IO_TASK_STACK         (6 * 1024)
+#define HLS_IO_TASK_CORE          (0)
+#define HLS_IO_TASK_PRIO          (10)
+#define HLS_IO_RINGBUFFER_SIZE    (20 * 1024)
+#define HLS_IO_PREFETCH_SEGMENTS  (2)
+#define HLS_IO_PREFETCH_MAX       (8)
+
+/**
+ * @brief  HLS IO configurations
+ */
+typedef struct {
+    int          task_stack;                     /*!< Task stack size, used by the reader and the fetcher */
+    int          task_core;                      /*!< Task running in core (0 or 1) */
+    int          task_prio;                      /*!< Task priority (based on freeRTOS priority) */
+    bool         stack_in_ext;                   /*!< Try to allocate stack in external memory */
+    int          out_buf_size;                   /*!< Size of output buffer */
+    int          prefetch_segments;              /*!< Segments downloaded ahead of the one being read, up to `HLS_IO_PREFETCH_MAX` */
+    const char  *cert_pem;                       /*!< SSL server certification, PEM format as string, if the client requires to verify server */
+    esp_err_t (*crt_bundle_attach)(void *conf);  /*!< Function pointer to esp_crt_bundle_attach. Enables the use of certification
+                                                      bundle for server verification, must be enabled in menuconfig */
+} hls_io_cfg_t;
+
+#define HLS_IO_CFG_DEFAULT() {                         \
+    .task_stack        = HLS_IO_TASK_STACK,            \
+    .task_core         = HLS_IO_TASK_CORE,             \
+    .task_prio         = HLS_IO_TASK_PRIO,             \
+    .stack_in_ext      = true,                         \
+    .out_buf_size      = HLS_IO_RINGBUFFER_SIZE,       \
+    .prefetch_segments = HLS_IO_PREFETCH_SEGMENTS,     \
+    .cert_pem          = NULL,                         \
+    .crt_bundle_attach = NULL,                         \
+}
+
+/**
+ * @brief  HLS IO statistics of the current or last play
+ */
+typedef struct {
+    uint32_t  startup_ms;  /*!< From open to the first byte handed to the data bus */
+    uint32_t  stalls;      /*!< Segment boundaries reached before the next segment had any data */
+    uint32_t  segments;    /*!< Segments downloaded */
+    uint32_t  bandwidth;   /*!< Measured bandwidth in bits per second */
+    int       variant;     /*!< Index of the variant being downloaded, lowest bandwidth first, -1 for a media playlist */
+    uint32_t  refreshes;   /*!< Reloads of a live media playlist */
+} esp_gmf_io_hls_stats_t;
+
+/**
+ * @brief  Initialize the HLS (HTTP Live Streaming) reader IO with the specified configuration
+ *
+ *         The URI is a master or a media playlist. Segments are fetched by a dedicated thread on one keep-alive
+ *         connection, in order, into `prefetch_segments` + 1 segment buffers, and the IO thread hands them to the
+ *         data bus back to back, so reaching the end of a segment does not wait for the next request as long as the
+ *         network keeps up. With a master playlist, the download starts on the lowest variant, and after each segment
+ *         the highest variant fitting in 80 % of the measured bandwidth is selected, switching at the next segment.
+ *         A live playlist, one without `#EXT-X-ENDLIST`, starts three segments from its end and is reloaded when the
+ *         next segment is not listed yet. Encrypted segments and seeking are not supported
+ *
+ * @param[in]   config  Pointer to an `hls_io_cfg_t` structure containing the configuration
+ * @param[out]  io      Pointer to a `esp_gmf_io_handle_t` where the initialized I/O object
+ *                      handle will be stored
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Initialization successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument(s)
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory for initialization
+ */
+esp_gmf_err_t esp_gmf_io_hls_init(hls_io_cfg_t *config, esp_gmf_io_handle_t *io);
+
+/**
+ * @brief  Cast or update the configuration of an HLS IO
+ *
+ * @param[in]  config  Pointer to an `hls_io_cfg_t` structure containing the new configuration
+ * @param[in]  obj     Handle to the existing HLS IO
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Configuration update successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument(s)
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory for configuration update
+ */
+esp_gmf_err_t esp_gmf_io_hls_cast(hls_io_cfg_t *config, esp_gmf_io_handle_t obj);
+
+/**
+ * @brief  Get the statistics of an HLS IO
+ *
+ * @param[in]   io     Handle of the HLS IO
+ * @param[out]  stats  Statistics of the current or last play
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument(s)
+ */
+esp_gmf_err_t esp_gmf_io_hls_get_stats(esp_gmf_io_handle_t io, esp_gmf_io_hls_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -30,10 +30,13 @@
 extern "C" {
 #endif /* __cplusplus */
 
-#define HTTP_STREAM_TASK_STACK      (6 * 1024)
-#define HTTP_STREAM_TASK_CORE       (0)
-#define HTTP_STREAM_TASK_PRIO       (10)
-#define HTTP_STREAM_RINGBUFFER_SIZE (20 * 1024)
+#define HTTP_STREAM_TASK_STACK       (6 * 1024)
+#define HTTP_STREAM_TASK_CORE        (0)
+#define HTTP_STREAM_TASK_PRIO        (10)
+#define HTTP_STREAM_RINGBUFFER_SIZE  (20 * 1024)
+#define HTTP_STREAM_RANGE_SEG_SIZE   (32 * 1024)
+#define HTTP_STREAM_RANGE_WORKER_MAX (8)
+#define HTTP_STREAM_CACHE_MAX_SIZE   (4 * 1024 * 1024)
 
 /**
  * @brief  HTTP Stream hook type
@@ -84,6 +87,19 @@ typedef struct {
     const char            *cert_pem;            /*!< SSL server certification, PEM format as string, if the client requires to verify server */
     esp_err_t (*crt_bundle_attach)(void *conf); /*!< Function pointer to esp_crt_bundle_attach. Enables the use of certification
                                                 bundle for server verification, must be enabled in menuconfig */
+    int                    range_workers;       /*!< Number of parallel range connections of a reader, up to `HTTP_STREAM_RANGE_WORKER_MAX`,
+                                                     0 or 1 for a single connection, see `esp_gmf_io_http_init` */
+    int                    range_seg_size;      /*!< Bytes fetched by one range request, 0 for `HTTP_STREAM_RANGE_SEG_SIZE` */
+    const char            *cache_dir;           /*!< Directory of the on-disk response cache of a reader, NULL to disable,
+                                                     the file system must be mounted before open */
+    uint32_t               cache_max_size;      /*!< Size cap of the cache directory, 0 for `HTTP_STREAM_CACHE_MAX_SIZE` */
+    uint32_t               seek_buf_size;       /*!< Bytes last handed to the data bus kept by a reader to serve seeks without a request,
+                                                     0 to disable */
+    uint32_t               chunk_min_size;      /*!< Lower bound of the adaptive read chunk of a reader, 0 for 512 bytes */
+    uint32_t               chunk_max_size;      /*!< Upper bound of the adaptive read chunk, up to half of `out_buf_size`,
+                                                     0 to read fixed chunks of 3 KB without adaptive sizing */
+    uint32_t               fill_min_size;       /*!< Lower bound of the adaptive target fill of the data bus */
+    uint32_t               fill_max_size;       /*!< Upper bound of the adaptive target fill, 0 for 3/4 of `out_buf_size` */
 } http_io_cfg_t;
 
 #define HTTP_STREAM_CFG_DEFAULT() {                    \
@@ -97,11 +113,61 @@ typedef struct {
     .user_data         = NULL,                         \
     .cert_pem          = NULL,                         \
     .crt_bundle_attach = NULL,                         \
+    .range_workers     = 0,                            \
+    .range_seg_size    = 0,                            \
+    .cache_dir         = NULL,                         \
+    .cache_max_size    = 0,                            \
+    .seek_buf_size     = 0,                            \
+    .chunk_min_size    = 0,                            \
+    .chunk_max_size    = 0,                            \
+    .fill_min_size     = 0,                            \
+    .fill_max_size     = 0,                            \
 }
 
+/**
+ * @brief  HTTP IO statistics of the current or last play of a reader
+ */
+typedef struct {
+    uint32_t  buf_size;     /*!< Size of the data bus */
+    uint32_t  filled;       /*!< Bytes in the data bus */
+    uint32_t  target_fill;  /*!< Fill waited for after an open, a seek or an underrun, 0 if not adaptive */
+    uint32_t  chunk_size;   /*!< Bytes of the current read chunk */
+    uint32_t  throughput;   /*!< Measured throughput in bytes per second */
+    uint32_t  jitter_ms;    /*!< Measured deviation of the chunk read time from the one expected at `throughput` */
+    uint32_t  underruns;    /*!< Reads that found the data bus empty before the end of the stream */
+    uint32_t  chunks;       /*!< Chunks read from the network */
+} esp_gmf_io_http_stats_t;
+
 /**
  * @brief  Initialize the HTTP stream I/O element with the specified configuration
  *
+ *         With `range_workers` above 1, a reader whose server answers with `Accept-Ranges: bytes` and a known length
+ *         reads the first segment on the opening connection and fetches the following ones with that many range
+ *         requests in parallel, each one into its own segment buffer, which are handed to the data bus in order. It
+ *         helps on links where one TCP window limits the throughput. The mode is not used for compressed content or
+ *         with an `event_handle`, and if a range request fails the reader goes on with a single connection from the
+ *         current position
+ *
+ *         With `cache_dir` set, a reader keeps the responses carrying an `ETag` or a `Last-Modified` on disk, keyed
+ *         by the URL. The content is stored as the stream is read, and the stored part of an aborted or seeked away
+ *         fill is resumed by a range request on the next play. A later open of the same URL sends a conditional
+ *         request, and when the server confirms the validators the reads and seeks are served from disk, the network
+ *         being used again only past the stored bytes. Changed content replaces the entry, and the least recently
+ *         used entries are evicted to keep the directory under `cache_max_size`. Like the range mode, the cache is
+ *         not used with an `event_handle`
+ *
+ *         A reader keeps its HTTP client across seeks. A seek to one of the last `seek_buf_size` bytes handed to the
+ *         data bus is served from a copy of them, and a short seek ahead of the current position reads up to the
+ *         target on the open response. Other seeks send a new range request, on the same keep-alive connection when
+ *         the rest of the current response is short enough to be read off, otherwise on a new connection
+ *
+ *         With `chunk_max_size` set, a reader sizes its reads from the measured throughput, each chunk holding about
+ *         40 ms of data within `chunk_min_size` and `chunk_max_size`, so that fast links take fewer reads and slow
+ *         ones still hand data over often. It also sets a target fill of the data bus from the throughput and the
+ *         jitter of the chunk arrivals, within `fill_min_size` and `fill_max_size`, and after an open, a seek or an
+ *         underrun the read of the data bus waits for that fill, to ride out the next stalls of a jittery link. The
+ *         fill levels are given by `esp_gmf_io_http_get_stats`
+ *
  * @param[in]   config  Pointer to an `http_io_cfg_t` structure containing the configuration
  *                      settings for the HTTP I/O element
  * @param[out]  io      Pointer to a `esp_gmf_io_handle_t` where the initialized I/O object
@@ -128,6 +194,18 @@ esp_gmf_err_t esp_gmf_io_http_init(http_io_cfg_t *config, esp_gmf_io_handle_t *i
  */
 esp_gmf_err_t esp_gmf_io_http_cast(http_io_cfg_t *config, esp_gmf_io_handle_t obj);
 
+/**
+ * @brief  Get the statistics and the fill levels of an HTTP reader, for a UI or telemetry
+ *
+ * @param[in]   io     Handle of the HTTP IO
+ * @param[out]  stats  Statistics of the current or last play
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument(s)
+ */
+esp_gmf_err_t esp_gmf_io_http_get_stats(esp_gmf_io_handle_t io, esp_gmf_io_http_stats_t *stats);
+
 /**
  * @brief  Reset http information.
  *
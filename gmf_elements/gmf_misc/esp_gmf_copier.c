@@ -23,22 +23,72 @@
  */
 
 #include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_element.h"
 #include "esp_gmf_err.h"
+#include "esp_gmf_new_databus.h"
 #include "esp_gmf_copier.h"
 
+#define COPIER_SHARE_MAX_PORT (32)
+
 /**
  * @brief Copier context in GMF
  */
 typedef struct esp_gmf_copier {
-    struct esp_gmf_element parent;   /*!< The GMF copier handle */
-    uint8_t                copy_num; /*!< The output stream number */
+    struct esp_gmf_element parent;      /*!< The GMF copier handle */
+    uint8_t                copy_num;    /*!< The output stream number */
+    uint32_t               share_mask;  /*!< Bit per output port index, set when the port takes the input payload by reference */
+    SemaphoreHandle_t      ref_sem;     /*!< Given each time a consumer releases the shared input payload */
 } esp_gmf_copier_t;
 
 static const char *TAG = "ESP_GMF_COPIER";
 
+static void copier_share_released(uint8_t *buf, void *ctx)
+{
+    esp_gmf_copier_t *copier = (esp_gmf_copier_t *)ctx;
+    xSemaphoreGive(copier->ref_sem);
+}
+
+static inline bool copier_port_is_db(esp_gmf_port_t *out)
+{
+    // Only the ports to other pipelines carry a data bus, the link to the next element has a reader
+    return (out->reader == NULL) && (out->type == ESP_GMF_PORT_TYPE_BLOCK)
+           && (out->ops.acquire == (port_acquire)esp_gmf_db_acquire_write) && out->ctx;
+}
+
+static esp_gmf_err_io_t copier_wait_shared(esp_gmf_copier_t *copier, int ref_num)
+{
+    // The input payload goes back to its owner only after all the consumers released it
+    esp_gmf_port_t *out = ESP_GMF_ELEMENT_GET(copier)->out;
+    int idx = 0;
+    while (ref_num > 0 && out) {
+        if ((copier->share_mask & (1UL << idx)) == 0) {
+            out = out->next;
+            idx++;
+            continue;
+        }
+        if (xSemaphoreTake(copier->ref_sem, out->wait_ticks) == pdTRUE) {
+            ref_num--;
+            continue;
+        }
+        // The consumer stalls, drop the references it did not start to read
+        int dropped = 0;
+        esp_gmf_db_share_reclaim(out->ctx, &dropped);
+        if (dropped) {
+            ESP_LOGW(TAG, "Dropped %d shared payload of the stalled consumer, idx: %d", dropped, idx);
+        }
+        out = out->next;
+        idx++;
+    }
+    while (ref_num-- > 0) {
+        xSemaphoreTake(copier->ref_sem, portMAX_DELAY);
+    }
+    return ESP_GMF_IO_OK;
+}
+
 static esp_gmf_err_t esp_gmf_copier_new(void *cfg, esp_gmf_obj_handle_t *handle)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, {return ESP_GMF_ERR_INVALID_ARG;});
@@ -61,33 +111,53 @@ static esp_gmf_err_t esp_gmf_copier_new(void *cfg, esp_gmf_obj_handle_t *handle)
 
 static esp_gmf_job_err_t esp_gmf_copier_open(esp_gmf_element_handle_t self, void *para)
 {
-    ESP_LOGD(TAG, "%s", __func__);
+    esp_gmf_copier_t *copier = (esp_gmf_copier_t *)self;
+    if (copier->ref_sem == NULL) {
+        copier->ref_sem = xSemaphoreCreateCounting(COPIER_SHARE_MAX_PORT, 0);
+        ESP_GMF_MEM_CHECK(TAG, copier->ref_sem, return ESP_GMF_JOB_ERR_FAIL);
+    }
+    copier->share_mask = 0;
+    esp_gmf_port_t *out = ESP_GMF_ELEMENT_GET(self)->out;
+    for (int idx = 0; out && idx < COPIER_SHARE_MAX_PORT; idx++, out = out->next) {
+        if (copier_port_is_db(out) && (esp_gmf_db_share_set_release_cb(out->ctx, copier_share_released, copier) == ESP_GMF_ERR_OK)) {
+            copier->share_mask |= (1UL << idx);
+        }
+    }
+    ESP_LOGD(TAG, "%s, share mask: %lx", __func__, copier->share_mask);
     return ESP_GMF_ERR_OK;
 }
 
 static esp_gmf_job_err_t esp_gmf_copier_process(esp_gmf_element_handle_t self, void *para)
 {
     esp_gmf_element_handle_t hd = (esp_gmf_element_handle_t)self;
+    esp_gmf_copier_t *copier = (esp_gmf_copier_t *)self;
     esp_gmf_port_t *in = ESP_GMF_ELEMENT_GET(hd)->in;
     esp_gmf_port_t *out = ESP_GMF_ELEMENT_GET(hd)->out;
     esp_gmf_payload_t *in_load = NULL;
     esp_gmf_payload_t *out_load = NULL;
     int out_len = -1;
     int idx = 0;
+    int ref_num = 0;
     esp_gmf_err_io_t ret = esp_gmf_port_acquire_in(in, &in_load, in->user_buf_len, ESP_GMF_MAX_DELAY);
     ESP_GMF_PORT_ACQUIRE_IN_CHECK(TAG, ret, out_len, {goto __copy_release;});
     while (out) {
         out_load = NULL;
-        if (out != ESP_GMF_ELEMENT_GET(hd)->out) {
+        bool is_shared = (copier->share_mask & (1UL << idx)) != 0;
+        if (out->reader || is_shared || (out->type == ESP_GMF_PORT_TYPE_BYTE)) {
+            // The next element and the share bus take the input payload by reference,
+            // a byte port copies it by itself on release, so there is no need for an extra copy here
+            out_load = in_load;
             ret = esp_gmf_port_acquire_out(out, &out_load, in_load->buf_length, 0);
             ESP_GMF_PORT_ACQUIRE_OUT_CHECK(TAG, ret, out_len, {goto __copy_release;});
-            esp_gmf_payload_copy_data(in_load, out_load);
         } else {
-            out_load = in_load;
             ret = esp_gmf_port_acquire_out(out, &out_load, in_load->buf_length, 0);
             ESP_GMF_PORT_ACQUIRE_OUT_CHECK(TAG, ret, out_len, {goto __copy_release;});
+            esp_gmf_payload_copy_data(in_load, out_load);
         }
         ret = esp_gmf_port_release_out(out, out_load, out->wait_ticks);
+        if (is_shared && (ret >= ESP_GMF_IO_OK)) {
+            ref_num++;
+        }
         if (ret < ESP_GMF_IO_OK) {
             if (ret == ESP_GMF_IO_FAIL) {
                 ESP_LOGE(TAG, "Failed to release out, idx: %d, ret: %d.", idx, ret);
@@ -111,6 +181,9 @@ static esp_gmf_job_err_t esp_gmf_copier_process(esp_gmf_element_handle_t self, v
         out_len = ESP_GMF_JOB_ERR_DONE;
     }
 __copy_release:
+    if (ref_num > 0) {
+        copier_wait_shared(copier, ref_num);
+    }
     if (in_load != NULL) {
         ret = esp_gmf_port_release_in(in, in_load, 0);
         ESP_GMF_PORT_RELEASE_IN_CHECK(TAG, ret, out_len, NULL);
@@ -128,6 +201,11 @@ static esp_gmf_err_t esp_gmf_copier_destroy(esp_gmf_element_handle_t self)
 {
     if (self != NULL) {
         ESP_LOGD(TAG, "Destroyed");
+        esp_gmf_copier_t *copier = (esp_gmf_copier_t *)self;
+        if (copier->ref_sem) {
+            vSemaphoreDelete(copier->ref_sem);
+            copier->ref_sem = NULL;
+        }
         esp_gmf_element_deinit(self);
         esp_gmf_oal_free(self);
     }
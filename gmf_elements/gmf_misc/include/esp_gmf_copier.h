@@ -40,6 +40,10 @@ typedef struct {
 /**
  * @brief  Initializes the GMF copier using copier configuration.
  *
+ * @note  The output ports backed by a share bus (see `esp_gmf_db_new_share`) read the input payload by reference,
+ *        the copier gives the input back to its owner once every consumer released it. Byte ports copy the input
+ *        payload by themselves, the other block ports get a copy of it
+ *
  * @param[in]   config  Pointer to the copier configuration
  * @param[out]  handle  Pointer to the copier handle to be initialized
  *
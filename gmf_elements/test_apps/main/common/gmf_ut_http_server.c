@@ -0,0 +1,412 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+#include "esp_netif.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_sys.h"
+#include "gmf_ut_http_server.h"
+
+#define HTTP_SRV_REQ_SIZE    (1024)
+#define HTTP_SRV_CHUNK_SIZE  (1436)
+#define HTTP_SRV_POLL_MS     (100)
+#define HTTP_SRV_TASK_STACK  (4096)
+#define HTTP_SRV_TASK_PRIO   (6)
+
+static const char *TAG = "UT_HTTP_SRV";
+
+typedef struct {
+    gmf_ut_http_server_cfg_t    cfg;
+    int                         listen_fd;
+    volatile bool               quit;
+    volatile int                tasks;
+    void                       *lock;
+    gmf_ut_http_server_stats_t  stats;
+    int64_t                     start_ms;
+} http_srv_t;
+
+typedef struct {
+    http_srv_t  *srv;
+    int          fd;
+} http_srv_conn_t;
+
+static int http_srv_recv_header(http_srv_t *srv, int fd, char *req, int size)
+{
+    int len = 0;
+    while (!srv->quit && len < size - 1) {
+        int ret = recv(fd, req + len, size - 1 - len, 0);
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            continue;
+        }
+        if (ret <= 0) {
+            return -1;
+        }
+        len += ret;
+        req[len] = '\0';
+        if (strstr(req, "\r\n\r\n")) {
+            return len;
+        }
+    }
+    return -1;
+}
+
+static int http_srv_send_all(http_srv_t *srv, int fd, const void *data, int len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (len > 0 && !srv->quit) {
+        int ret = send(fd, p, len, 0);
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            continue;
+        }
+        if (ret <= 0) {
+            return -1;
+        }
+        p += ret;
+        len -= ret;
+    }
+    return len == 0 ? 0 : -1;
+}
+
+/**
+ * @brief  Time, from the server start, at which a link following the rate trace has carried `bytes` more from `from_ms`
+ */
+static int64_t http_srv_trace_due(const gmf_ut_http_server_cfg_t *cfg, int64_t from_ms, uint32_t bytes)
+{
+    int64_t t = from_ms;
+    // In bytes per second times milliseconds
+    uint64_t left = (uint64_t)bytes * 1000;
+    while (left > 0) {
+        int64_t step = t / cfg->rate_trace_step_ms;
+        uint32_t rate = cfg->rate_trace[step % cfg->rate_trace_num];
+        int64_t step_end = (step + 1) * cfg->rate_trace_step_ms;
+        uint64_t cap = (uint64_t)rate * (step_end - t);
+        if (cap >= left) {
+            t += (left + rate - 1) / rate;
+            break;
+        }
+        left -= cap;
+        t = step_end;
+    }
+    return t;
+}
+
+static const char *http_srv_header(const char *req, const char *key)
+{
+    const char *line = strstr(req, "\r\n");
+    size_t key_len = strlen(key);
+    while (line && line[2] != '\r') {
+        line += 2;
+        if (strncasecmp(line, key, key_len) == 0 && line[key_len] == ':') {
+            line += key_len + 1;
+            while (*line == ' ') {
+                line++;
+            }
+            return line;
+        }
+        line = strstr(line, "\r\n");
+    }
+    return NULL;
+}
+
+static int http_srv_serve(http_srv_t *srv, int fd, char *req, uint8_t *chunk, bool *keep_alive)
+{
+    char method[8] = {0};
+    char path[128] = {0};
+    if (sscanf(req, "%7s %127s", method, path) != 2) {
+        return -1;
+    }
+    bool head = strcmp(method, "HEAD") == 0;
+    const char *conn = http_srv_header(req, "Connection");
+    *keep_alive = !(conn && strncasecmp(conn, "close", 5) == 0);
+    const char *range = http_srv_header(req, "Range");
+    uint64_t from = 0;
+    int64_t to = -1;
+    bool has_range = false;
+    if (range && srv->cfg.accept_ranges && strncmp(range, "bytes=", 6) == 0) {
+        char *end = NULL;
+        from = strtoull(range + 6, &end, 10);
+        if (end && *end == '-' && end[1] >= '0' && end[1] <= '9') {
+            to = strtoll(end + 1, NULL, 10);
+        }
+        has_range = true;
+    }
+    esp_gmf_oal_mutex_lock(srv->lock);
+    srv->stats.requests++;
+    srv->stats.range_requests += has_range;
+    esp_gmf_oal_mutex_unlock(srv->lock);
+
+    int body_len = 0;
+    char *dyn = srv->cfg.get_body ? srv->cfg.get_body(path, &body_len, srv->cfg.ctx) : NULL;
+    int64_t size = dyn ? body_len : (srv->cfg.get_size ? srv->cfg.get_size(path, srv->cfg.ctx) : -1);
+    const char *none_match = http_srv_header(req, "If-None-Match");
+    const char *modified_since = http_srv_header(req, "If-Modified-Since");
+    int status = 200;
+    if (size < 0) {
+        status = 404;
+    } else if ((none_match && srv->cfg.etag && strncmp(none_match, srv->cfg.etag, strlen(srv->cfg.etag)) == 0)
+               || (!none_match && modified_since && srv->cfg.last_modified
+                   && strncmp(modified_since, srv->cfg.last_modified, strlen(srv->cfg.last_modified)) == 0)) {
+        status = 304;
+    } else if (has_range && srv->cfg.fail_closed_ranges && to >= 0) {
+        status = 500;
+    } else if (has_range) {
+        if (to < 0 || to >= size) {
+            to = size - 1;
+        }
+        status = (int64_t)from < size ? 206 : 416;
+    } else {
+        to = size - 1;
+    }
+    uint64_t body = (status == 200 || status == 206) ? (uint64_t)(to - (int64_t)from + 1) : 0;
+    if (srv->cfg.latency_ms) {
+        vTaskDelay(pdMS_TO_TICKS(srv->cfg.latency_ms));
+    }
+    char header[384];
+    int hlen = snprintf(header, sizeof(header), "HTTP/1.1 %d %s\r\n%s", status, status < 400 ? "OK" : "Error",
+                        srv->cfg.accept_ranges ? "Accept-Ranges: bytes\r\n" : "");
+    if (status == 304) {
+        esp_gmf_oal_mutex_lock(srv->lock);
+        srv->stats.not_modified++;
+        esp_gmf_oal_mutex_unlock(srv->lock);
+    } else {
+        hlen += snprintf(header + hlen, sizeof(header) - hlen, "Content-Length: %llu\r\n", body);
+    }
+    if (srv->cfg.etag) {
+        hlen += snprintf(header + hlen, sizeof(header) - hlen, "ETag: %s\r\n", srv->cfg.etag);
+    }
+    if (srv->cfg.last_modified) {
+        hlen += snprintf(header + hlen, sizeof(header) - hlen, "Last-Modified: %s\r\n", srv->cfg.last_modified);
+    }
+    if (status == 206) {
+        hlen += snprintf(header + hlen, sizeof(header) - hlen, "Content-Range: bytes %llu-%lld/%lld\r\n", from, to, size);
+    }
+    hlen += snprintf(header + hlen, sizeof(header) - hlen, "Connection: %s\r\n\r\n", *keep_alive ? "keep-alive" : "close");
+    if (http_srv_send_all(srv, fd, header, hlen) != 0) {
+        free(dyn);
+        return -1;
+    }
+    if (head) {
+        free(dyn);
+        return 0;
+    }
+    int64_t start = esp_gmf_oal_sys_get_time_ms();
+    int64_t link_ms = start - srv->start_ms;
+    uint64_t sent = 0;
+    while (sent < body && !srv->quit) {
+        int n = body - sent > HTTP_SRV_CHUNK_SIZE ? HTTP_SRV_CHUNK_SIZE : (int)(body - sent);
+        if (dyn) {
+            memcpy(chunk, dyn + from + sent, n);
+        } else {
+            n = srv->cfg.read(path, from + sent, chunk, n, srv->cfg.ctx);
+        }
+        if (n <= 0 || http_srv_send_all(srv, fd, chunk, n) != 0) {
+            break;
+        }
+        sent += n;
+        esp_gmf_oal_mutex_lock(srv->lock);
+        srv->stats.bytes += n;
+        esp_gmf_oal_mutex_unlock(srv->lock);
+        if (srv->cfg.rate_trace) {
+            link_ms = http_srv_trace_due(&srv->cfg, link_ms, n);
+            int64_t now = esp_gmf_oal_sys_get_time_ms() - srv->start_ms;
+            if (link_ms > now) {
+                vTaskDelay(pdMS_TO_TICKS(link_ms - now));
+            }
+        } else if (srv->cfg.conn_rate) {
+            int64_t due = start + (int64_t)(sent * 1000 / srv->cfg.conn_rate);
+            int64_t now = esp_gmf_oal_sys_get_time_ms();
+            if (due > now) {
+                vTaskDelay(pdMS_TO_TICKS(due - now));
+            }
+        }
+    }
+    free(dyn);
+    return sent == body ? 0 : -1;
+}
+
+static void http_srv_conn_task(void *arg)
+{
+    http_srv_conn_t *conn = (http_srv_conn_t *)arg;
+    http_srv_t *srv = conn->srv;
+    char *req = esp_gmf_oal_malloc(HTTP_SRV_REQ_SIZE);
+    uint8_t *chunk = esp_gmf_oal_malloc(HTTP_SRV_CHUNK_SIZE);
+    bool keep_alive = true;
+    bool first = true;
+    while (req && chunk && keep_alive && !srv->quit) {
+        if (http_srv_recv_header(srv, conn->fd, req, HTTP_SRV_REQ_SIZE) < 0) {
+            break;
+        }
+        if (first && srv->cfg.connect_latency_ms) {
+            vTaskDelay(pdMS_TO_TICKS(srv->cfg.connect_latency_ms));
+        }
+        first = false;
+        if (http_srv_serve(srv, conn->fd, req, chunk, &keep_alive) != 0) {
+            break;
+        }
+    }
+    shutdown(conn->fd, SHUT_RDWR);
+    close(conn->fd);
+    esp_gmf_oal_free(req);
+    esp_gmf_oal_free(chunk);
+    esp_gmf_oal_free(conn);
+    esp_gmf_oal_mutex_lock(srv->lock);
+    srv->tasks--;
+    esp_gmf_oal_mutex_unlock(srv->lock);
+    vTaskDelete(NULL);
+}
+
+static void http_srv_accept_task(void *arg)
+{
+    http_srv_t *srv = (http_srv_t *)arg;
+    while (!srv->quit) {
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(srv->listen_fd, &fds);
+        struct timeval tv = {.tv_sec = 0, .tv_usec = HTTP_SRV_POLL_MS * 1000};
+        if (select(srv->listen_fd + 1, &fds, NULL, NULL, &tv) <= 0) {
+            continue;
+        }
+        int fd = accept(srv->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            continue;
+        }
+        struct timeval rcv = {.tv_sec = 0, .tv_usec = HTTP_SRV_POLL_MS * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &rcv, sizeof(rcv));
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        http_srv_conn_t *conn = esp_gmf_oal_calloc(1, sizeof(http_srv_conn_t));
+        if (conn == NULL) {
+            close(fd);
+            continue;
+        }
+        conn->srv = srv;
+        conn->fd = fd;
+        esp_gmf_oal_mutex_lock(srv->lock);
+        srv->tasks++;
+        srv->stats.connections++;
+        esp_gmf_oal_mutex_unlock(srv->lock);
+        if (xTaskCreate(http_srv_conn_task, "ut_http_conn", HTTP_SRV_TASK_STACK, conn, HTTP_SRV_TASK_PRIO, NULL) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create connection task");
+            close(fd);
+            esp_gmf_oal_free(conn);
+            esp_gmf_oal_mutex_lock(srv->lock);
+            srv->tasks--;
+            esp_gmf_oal_mutex_unlock(srv->lock);
+        }
+    }
+    close(srv->listen_fd);
+    esp_gmf_oal_mutex_lock(srv->lock);
+    srv->tasks--;
+    esp_gmf_oal_mutex_unlock(srv->lock);
+    vTaskDelete(NULL);
+}
+
+esp_err_t gmf_ut_http_server_start(const gmf_ut_http_server_cfg_t *cfg, gmf_ut_http_server_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL || (cfg->read == NULL && cfg->get_body == NULL)
+        || (cfg->rate_trace && (cfg->rate_trace_num <= 0 || cfg->rate_trace_step_ms == 0))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_netif_init();
+    http_srv_t *srv = esp_gmf_oal_calloc(1, sizeof(http_srv_t));
+    if (srv == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    srv->cfg = *cfg;
+    srv->start_ms = esp_gmf_oal_sys_get_time_ms();
+    if (srv->cfg.port == 0) {
+        srv->cfg.port = GMF_UT_HTTP_SERVER_PORT;
+    }
+    srv->lock = esp_gmf_oal_mutex_create();
+    srv->listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (srv->lock == NULL || srv->listen_fd < 0) {
+        goto _srv_fail;
+    }
+    int one = 1;
+    setsockopt(srv->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(srv->cfg.port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    if (bind(srv->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(srv->listen_fd, 8) != 0) {
+        ESP_LOGE(TAG, "Failed to listen on port %d, errno %d", srv->cfg.port, errno);
+        goto _srv_fail;
+    }
+    srv->tasks = 1;
+    if (xTaskCreate(http_srv_accept_task, "ut_http_srv", HTTP_SRV_TASK_STACK, srv, HTTP_SRV_TASK_PRIO, NULL) != pdPASS) {
+        goto _srv_fail;
+    }
+    *handle = srv;
+    return ESP_OK;
+_srv_fail:
+    if (srv->listen_fd >= 0) {
+        close(srv->listen_fd);
+    }
+    if (srv->lock) {
+        esp_gmf_oal_mutex_destroy(srv->lock);
+    }
+    esp_gmf_oal_free(srv);
+    return ESP_FAIL;
+}
+
+void gmf_ut_http_server_get_stats(gmf_ut_http_server_handle_t handle, gmf_ut_http_server_stats_t *stats)
+{
+    http_srv_t *srv = (http_srv_t *)handle;
+    esp_gmf_oal_mutex_lock(srv->lock);
+    *stats = srv->stats;
+    esp_gmf_oal_mutex_unlock(srv->lock);
+}
+
+void gmf_ut_http_server_reset_stats(gmf_ut_http_server_handle_t handle)
+{
+    http_srv_t *srv = (http_srv_t *)handle;
+    esp_gmf_oal_mutex_lock(srv->lock);
+    memset(&srv->stats, 0, sizeof(srv->stats));
+    esp_gmf_oal_mutex_unlock(srv->lock);
+}
+
+esp_err_t gmf_ut_http_server_stop(gmf_ut_http_server_handle_t handle)
+{
+    http_srv_t *srv = (http_srv_t *)handle;
+    if (srv == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    srv->quit = true;
+    while (srv->tasks > 0) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    esp_gmf_oal_mutex_destroy(srv->lock);
+    esp_gmf_oal_free(srv);
+    return ESP_OK;
+}
@@ -0,0 +1,104 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Minimal HTTP/1.1 server on the loopback interface, it serves GET and HEAD requests with keep-alive
+ *         byte ranges and validators, and paces every connection to simulate a link limited per TCP connection
+ */
+typedef void *gmf_ut_http_server_handle_t;
+
+/**
+ * @brief  Get the size of the content of a path, return a negative value if not found
+ */
+typedef int64_t (*gmf_ut_http_size_cb_t)(const char *path, void *ctx);
+
+/**
+ * @brief  Fill `len` bytes of the content of a path from `pos`, return the filled bytes
+ */
+typedef int (*gmf_ut_http_read_cb_t)(const char *path, uint64_t pos, uint8_t *buf, int len, void *ctx);
+
+/**
+ * @brief  Build the whole content of a path at request time, for content changing over time like a live playlist,
+ *         return a buffer from `malloc` freed by the server, or NULL to serve the path by `get_size` and `read`
+ */
+typedef char *(*gmf_ut_http_body_cb_t)(const char *path, int *len, void *ctx);
+
+/**
+ * @brief  Loopback HTTP server configuration
+ */
+typedef struct {
+    uint16_t               port;                /*!< Listening port */
+    uint32_t               latency_ms;          /*!< Delay before answering each request */
+    uint32_t               connect_latency_ms;  /*!< Extra delay before the first answer of a connection, as a TCP and TLS handshake */
+    uint32_t               conn_rate;           /*!< Bytes per second of each connection, 0 for unlimited */
+    const uint32_t        *rate_trace;          /*!< Recorded bytes per second of a link, one entry per `rate_trace_step_ms`, replayed
+                                                     in a loop from the server start in place of `conn_rate`, 0 for a stall,
+                                                     NULL to disable */
+    int                    rate_trace_num;      /*!< Entries of `rate_trace`, at least one of them not 0 */
+    uint32_t               rate_trace_step_ms;  /*!< Duration of each entry of `rate_trace` */
+    bool                   accept_ranges;       /*!< Answer with `Accept-Ranges: bytes` and serve ranges */
+    bool                   fail_closed_ranges;  /*!< Answer 500 to ranges with an end, open ranges are still served */
+    const char            *etag;                /*!< ETag of the content, quoted, NULL for none */
+    const char            *last_modified;       /*!< Last-Modified of the content, NULL for none */
+    gmf_ut_http_size_cb_t  get_size;            /*!< Content size callback */
+    gmf_ut_http_read_cb_t  read;                /*!< Content read callback */
+    gmf_ut_http_body_cb_t  get_body;            /*!< Generated content callback, optional */
+    void                  *ctx;                 /*!< Context of the callbacks */
+} gmf_ut_http_server_cfg_t;
+
+/**
+ * @brief  Counters of the loopback HTTP server
+ */
+typedef struct {
+    uint32_t  requests;        /*!< Requests served */
+    uint32_t  range_requests;  /*!< Requests with a Range header */
+    uint32_t  not_modified;    /*!< Requests answered with 304 */
+    uint32_t  connections;     /*!< Accepted connections */
+    uint64_t  bytes;           /*!< Body bytes sent */
+} gmf_ut_http_server_stats_t;
+
+#define GMF_UT_HTTP_SERVER_PORT (8080)
+
+esp_err_t gmf_ut_http_server_start(const gmf_ut_http_server_cfg_t *cfg, gmf_ut_http_server_handle_t *handle);
+
+void gmf_ut_http_server_get_stats(gmf_ut_http_server_handle_t handle, gmf_ut_http_server_stats_t *stats);
+
+void gmf_ut_http_server_reset_stats(gmf_ut_http_server_handle_t handle);
+
+esp_err_t gmf_ut_http_server_stop(gmf_ut_http_server_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -32,6 +32,7 @@
 #include "esp_gmf_pool.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_oal_thread.h"
+#include "esp_gmf_oal_sys.h"
 
 #include "esp_gmf_audio_dec.h"
 #include "esp_audio_dec_default.h"
@@ -54,6 +55,20 @@ static const char *file_name1 = "/sdcard/test_2.wav";
 #define PIPELINE_BLOCK_BIT  BIT(0)
 #define PIPELINE_BLOCK_BIT2 BIT(1)
 #define PIPELINE_BLOCK_BIT3 BIT(2)
+#define SEEK_FIRST_AUDIO_BIT BIT(3)
+
+#define SEEK_BENCH_LOOP 5
+
+/**
+ * @brief  Sink of the seek benchmark, it stamps the first audio frame once armed
+ */
+typedef struct {
+    EventGroupHandle_t  evt;       /*!< Event group to signal the first audio frame */
+    volatile bool       armed;     /*!< Whether to stamp the next audio frame */
+    int64_t             first_us;  /*!< Time of the first audio frame since armed */
+    uint64_t            first_pts; /*!< PTS of the first audio frame since armed */
+    uint64_t            last_pts;  /*!< PTS of the latest audio frame */
+} seek_sink_t;
 
 static esp_err_t _pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
 {
@@ -103,6 +118,28 @@ static esp_err_t _pipeline_event3(esp_gmf_event_pkt_t *event, void *ctx)
     return 0;
 }
 
+static esp_gmf_err_io_t seek_sink_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    return wanted_size;
+}
+
+static esp_gmf_err_io_t seek_sink_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    seek_sink_t *sink = (seek_sink_t *)handle;
+    if (load->valid_size > 0) {
+        if (sink->armed) {
+            sink->armed = false;
+            sink->first_us = esp_gmf_oal_sys_get_time_us();
+            sink->first_pts = load->pts;
+            xEventGroupSetBits(sink->evt, SEEK_FIRST_AUDIO_BIT);
+        }
+        sink->last_pts = load->pts;
+    }
+    // Keep the decoder near real time pace like a codec device does
+    vTaskDelay(1);
+    return load->valid_size;
+}
+
 TEST_CASE("Create and destroy pipeline", "ESP_GMF_POOL")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
@@ -1195,6 +1232,107 @@ TEST_CASE("Recording file play, multiple file with One Pipe, [FILE->dec->resampl
     ESP_GMF_MEM_SHOW(TAG);
 }
 
+TEST_CASE("Seek, running seek versus stop-seek-run latency on File", "ESP_GMF_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    void *sdcard = NULL;
+    esp_gmf_setup_periph_sdmmc(&sdcard);
+
+    EventGroupHandle_t pipe_sync_evt = xEventGroupCreate();
+    ESP_GMF_NULL_CHECK(TAG, pipe_sync_evt, return);
+#ifdef MEDIA_LIB_MEM_TEST
+    media_lib_add_default_adapter();
+#endif /* MEDIA_LIB_MEM_TEST */
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_audio_codecs(pool);
+    pool_register_io(pool);
+
+    // [FILE]->dec->[sink]
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"aud_simp_dec"};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), NULL, &pipe));
+    TEST_ASSERT_NOT_NULL(pipe);
+    seek_sink_t sink = {.evt = pipe_sync_evt};
+    esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BYTE(seek_sink_acquire, seek_sink_release, NULL, &sink,
+                                                               ESP_GMF_PORT_PAYLOAD_LEN_DEFAULT, portMAX_DELAY);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reg_el_port(pipe, "aud_simp_dec", ESP_GMF_IO_DIR_WRITER, out_port));
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_bind_task(pipe, work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_event(pipe, _pipeline_event, pipe_sync_evt));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_in_uri(pipe, file_name));
+    esp_gmf_element_handle_t dec_el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "aud_simp_dec", &dec_el));
+    esp_gmf_audio_helper_reconfig_dec_by_uri(file_name, OBJ_GET_CFG(dec_el));
+
+    sink.armed = true;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    TEST_ASSERT_NOT_EQUAL(0, xEventGroupWaitBits(pipe_sync_evt, SEEK_FIRST_AUDIO_BIT, pdTRUE, pdFALSE, 5000 / portTICK_RATE_MS) & SEEK_FIRST_AUDIO_BIT);
+    esp_gmf_io_handle_t in_io = NULL;
+    uint64_t total = 0;
+    esp_gmf_pipeline_get_in(pipe, &in_io);
+    esp_gmf_io_get_size(in_io, &total);
+    TEST_ASSERT_GREATER_THAN(0, total);
+
+    int64_t running_us = 0;
+    for (int i = 0; i < SEEK_BENCH_LOOP; i++) {
+        vTaskDelay(300 / portTICK_RATE_MS);
+        uint64_t pos = total * ((i * 3) % 8 + 1) / 10;
+        uint64_t pts_before = sink.last_pts;
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_seek(pipe, pos));
+        // The seek is done once it returns, so everything stamped from now on is decoded from the new position
+        sink.armed = true;
+        TEST_ASSERT_NOT_EQUAL(0, xEventGroupWaitBits(pipe_sync_evt, SEEK_FIRST_AUDIO_BIT, pdTRUE, pdFALSE, 5000 / portTICK_RATE_MS) & SEEK_FIRST_AUDIO_BIT);
+        running_us += sink.first_us - start;
+        // The decoder is not reopened, the timeline carries on from where it was
+        TEST_ASSERT_GREATER_THAN(pts_before, sink.first_pts);
+    }
+
+    int64_t stop_run_us = 0;
+    for (int i = 0; i < SEEK_BENCH_LOOP; i++) {
+        vTaskDelay(300 / portTICK_RATE_MS);
+        uint64_t pos = total * ((i * 3) % 8 + 1) / 10;
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        xEventGroupClearBits(pipe_sync_evt, PIPELINE_BLOCK_BIT);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        xEventGroupWaitBits(pipe_sync_evt, PIPELINE_BLOCK_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+        // The in IO is closed by the stop, the new position is applied when it's opened again
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_set_pos(in_io, pos));
+        sink.armed = true;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        TEST_ASSERT_NOT_EQUAL(0, xEventGroupWaitBits(pipe_sync_evt, SEEK_FIRST_AUDIO_BIT, pdTRUE, pdFALSE, 5000 / portTICK_RATE_MS) & SEEK_FIRST_AUDIO_BIT);
+        stop_run_us += sink.first_us - start;
+    }
+    ESP_LOGW(TAG, "Seek to first audio, running seek: %lld us, stop-seek-run: %lld us, average of %d",
+             running_us / SEEK_BENCH_LOOP, stop_run_us / SEEK_BENCH_LOOP, SEEK_BENCH_LOOP);
+    TEST_ASSERT_LESS_THAN(stop_run_us, running_us);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    pool_unregister_audio_codecs();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    vEventGroupDelete(pipe_sync_evt);
+#ifdef MEDIA_LIB_MEM_TEST
+    media_lib_stop_mem_trace();
+#endif /* MEDIA_LIB_MEM_TEST */
+    esp_gmf_teardown_periph_sdmmc(sdcard);
+    vTaskDelay(1000 / portTICK_RATE_MS);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
 #if 0
 
 TEST_CASE("Seek, seek to any position on File", "ESP_GMF_POOL")
@@ -0,0 +1,205 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+#include "esp_gmf_element.h"
+#include "esp_gmf_port.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_data_bus.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_copier.h"
+
+#define COPIER_TEST_FRAME_SIZE (4096)
+#define COPIER_TEST_FRAME_NUM  (500)
+#define COPIER_TEST_MAX_OUT    (8)
+
+typedef enum {
+    COPIER_TEST_RINGBUF,  /*!< Every output copies the data into and out of its own ring buffer */
+    COPIER_TEST_SHARE,    /*!< Every output reads the input payload by reference */
+    COPIER_TEST_COW,      /*!< Every output modifies the data in place through a copy-on-write share bus */
+} copier_test_mode_t;
+
+typedef struct {
+    uint8_t *buf;
+    int      frame_cnt;
+} copier_test_src_t;
+
+typedef struct {
+    esp_gmf_db_handle_t  db;
+    uint8_t             *buf;
+    bool                 modify;
+    uint32_t             sum;
+    SemaphoreHandle_t    done;
+} copier_test_sink_t;
+
+static const char *TAG = "COPIER_ELEMENT_TEST";
+
+static uint32_t copier_test_sum(uint8_t *buf, int len)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < len; i++) {
+        sum += buf[i];
+    }
+    return sum;
+}
+
+static esp_gmf_err_io_t copier_test_src_acquire(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    copier_test_src_t *src = (copier_test_src_t *)handle;
+    load->buf = src->buf;
+    load->buf_length = COPIER_TEST_FRAME_SIZE;
+    load->valid_size = COPIER_TEST_FRAME_SIZE;
+    load->is_done = (++src->frame_cnt >= COPIER_TEST_FRAME_NUM);
+    return load->valid_size;
+}
+
+static esp_gmf_err_io_t copier_test_src_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static void copier_test_sink_task(void *param)
+{
+    copier_test_sink_t *sink = (copier_test_sink_t *)param;
+    esp_gmf_data_bus_block_t blk = {0};
+    while (1) {
+        blk.buf = sink->buf;
+        blk.buf_length = COPIER_TEST_FRAME_SIZE;
+        blk.is_last = false;
+        int ret = esp_gmf_db_acquire_read(sink->db, &blk, COPIER_TEST_FRAME_SIZE, portMAX_DELAY);
+        if (ret < 0) {
+            break;
+        }
+        if (ret > 0) {
+            sink->sum += copier_test_sum(blk.buf, ret);
+            if (sink->modify) {
+                memset(blk.buf, 0, ret);
+            }
+        }
+        esp_gmf_db_release_read(sink->db, &blk, 0);
+        if (blk.is_last) {
+            break;
+        }
+    }
+    xSemaphoreGive(sink->done);
+    vTaskDelete(NULL);
+}
+
+static void copier_test_run(copier_test_mode_t mode, int out_num, uint8_t *src_buf, uint32_t expect_sum)
+{
+    esp_gmf_copier_cfg_t cfg = {
+        .copy_num = out_num,
+    };
+    esp_gmf_element_handle_t copier = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_copier_init(&cfg, &copier));
+    copier_test_src_t src = {
+        .buf = src_buf,
+    };
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BLOCK(copier_test_src_acquire, copier_test_src_release, NULL, &src,
+                                                              COPIER_TEST_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_register_in_port(copier, in_port));
+
+    copier_test_sink_t sink[COPIER_TEST_MAX_OUT] = {0};
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(COPIER_TEST_MAX_OUT, 0);
+    TEST_ASSERT_NOT_NULL(done);
+    for (int i = 0; i < out_num; i++) {
+        esp_gmf_port_handle_t out_port = NULL;
+        if (mode == COPIER_TEST_RINGBUF) {
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(2, COPIER_TEST_FRAME_SIZE, &sink[i].db));
+            out_port = NEW_ESP_GMF_PORT_OUT_BYTE(esp_gmf_db_acquire_write, esp_gmf_db_release_write, esp_gmf_db_deinit, sink[i].db,
+                                                 COPIER_TEST_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+            sink[i].buf = esp_gmf_oal_malloc(COPIER_TEST_FRAME_SIZE);
+            TEST_ASSERT_NOT_NULL(sink[i].buf);
+        } else {
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_share(1, mode == COPIER_TEST_COW ? COPIER_TEST_FRAME_SIZE : 0, &sink[i].db));
+            out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(esp_gmf_db_acquire_write, esp_gmf_db_release_write, esp_gmf_db_deinit, sink[i].db,
+                                                  COPIER_TEST_FRAME_SIZE, ESP_GMF_MAX_DELAY);
+            sink[i].modify = (mode == COPIER_TEST_COW);
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_register_out_port(copier, out_port));
+        sink[i].done = done;
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(copier_test_sink_task, "copier_sink", 4096, &sink[i], 5, NULL));
+    }
+
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    int64_t process_us = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_open(copier, NULL));
+    esp_gmf_job_err_t ret = ESP_GMF_JOB_ERR_OK;
+    do {
+        int64_t t = esp_gmf_oal_sys_get_time_us();
+        ret = esp_gmf_element_process_running(copier, NULL);
+        process_us += esp_gmf_oal_sys_get_time_us() - t;
+    } while (ret >= 0 && ret != ESP_GMF_JOB_ERR_DONE);
+    TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_DONE, ret);
+    for (int i = 0; i < out_num; i++) {
+        esp_gmf_db_done_write(sink[i].db);
+    }
+    for (int i = 0; i < out_num; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, portMAX_DELAY));
+    }
+    int64_t cost_us = esp_gmf_oal_sys_get_time_us() - start;
+
+    uint64_t bytes = (uint64_t)COPIER_TEST_FRAME_SIZE * COPIER_TEST_FRAME_NUM * out_num;
+    // The ring buffer copies once on write and once on read, the copy-on-write share bus copies on read only
+    uint64_t copied = (mode == COPIER_TEST_RINGBUF) ? bytes * 2 : (mode == COPIER_TEST_COW) ? bytes : 0;
+    const char *mode_str[] = {"ringbuf", "share", "share+cow"};
+    ESP_LOGW(TAG, "%-9s out:%d, total %lld us, copier %lld us, %lld KB/s delivered, %lld KB copied", mode_str[mode], out_num,
+             cost_us, process_us, (int64_t)(bytes * 1000000 / 1024 / (cost_us + 1)), (int64_t)(copied / 1024));
+    for (int i = 0; i < out_num; i++) {
+        TEST_ASSERT_EQUAL(expect_sum, sink[i].sum);
+        if (sink[i].buf) {
+            esp_gmf_oal_free(sink[i].buf);
+        }
+    }
+    // The shared input must be left untouched by the consumers
+    TEST_ASSERT_EQUAL(expect_sum, copier_test_sum(src_buf, COPIER_TEST_FRAME_SIZE) * COPIER_TEST_FRAME_NUM);
+    vSemaphoreDelete(done);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_obj_delete(copier));
+}
+
+TEST_CASE("Copier, fan out to 1 to 8 outputs by copy and by reference", "ESP_GMF_COPIER")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    uint8_t *src_buf = esp_gmf_oal_malloc(COPIER_TEST_FRAME_SIZE);
+    TEST_ASSERT_NOT_NULL(src_buf);
+    for (int i = 0; i < COPIER_TEST_FRAME_SIZE; i++) {
+        src_buf[i] = (uint8_t)(i * 13 + 1);
+    }
+    uint32_t expect_sum = copier_test_sum(src_buf, COPIER_TEST_FRAME_SIZE) * COPIER_TEST_FRAME_NUM;
+    for (int out_num = 1; out_num <= COPIER_TEST_MAX_OUT; out_num++) {
+        copier_test_run(COPIER_TEST_RINGBUF, out_num, src_buf, expect_sum);
+        copier_test_run(COPIER_TEST_SHARE, out_num, src_buf, expect_sum);
+        copier_test_run(COPIER_TEST_COW, out_num, src_buf, expect_sum);
+    }
+    esp_gmf_oal_free(src_buf);
+    ESP_GMF_MEM_SHOW(TAG);
+}
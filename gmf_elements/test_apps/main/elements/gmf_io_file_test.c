@@ -0,0 +1,192 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_io.h"
+#include "esp_gmf_io_file.h"
+#include "esp_gmf_setup_peripheral.h"
+
+#define FILE_BENCH_URI          "/sdcard/esp_gmf_wb.bin"
+#define FILE_BENCH_TOTAL        (1024 * 1024)
+#define FILE_BENCH_FRAME_SIZE   (512)
+#define FILE_BENCH_FRAMES       (FILE_BENCH_TOTAL / FILE_BENCH_FRAME_SIZE)
+#define FILE_BENCH_CACHE_SIZE   (16 * 1024)
+#define FILE_BENCH_PACE_FRAMES  (8)
+#define FILE_BENCH_PACE_MS      (20)
+#define FILE_BENCH_PACED_MAX_US (5000)
+
+static const char *TAG = "FILE_IO_TEST";
+
+typedef struct {
+    const char  *name;
+    uint32_t     cache_size;
+    uint32_t     sync_bytes;
+    uint32_t     sync_ms;
+    bool         flush_task;
+    bool         paced;
+} file_bench_policy_t;
+
+typedef struct {
+    uint32_t  kbps;
+    uint32_t  p99_us;
+    uint32_t  max_us;
+} file_bench_result_t;
+
+static inline uint8_t file_bench_byte(uint32_t pos)
+{
+    return (uint8_t)((pos * 7) ^ (pos >> 9));
+}
+
+static int file_bench_cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : (x > y);
+}
+
+static void file_bench_verify(void)
+{
+    FILE *f = fopen(FILE_BENCH_URI, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint8_t *buf = esp_gmf_oal_malloc(FILE_BENCH_FRAME_SIZE);
+    TEST_ASSERT_NOT_NULL(buf);
+    uint32_t pos = 0;
+    size_t rlen = 0;
+    while ((rlen = fread(buf, 1, FILE_BENCH_FRAME_SIZE, f)) > 0) {
+        for (size_t i = 0; i < rlen; i++, pos++) {
+            if (buf[i] != file_bench_byte(pos)) {
+                TEST_FAIL_MESSAGE("File content mismatch");
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL(FILE_BENCH_TOTAL, pos);
+    esp_gmf_oal_free(buf);
+    fclose(f);
+}
+
+static void file_bench_run(const file_bench_policy_t *policy, uint32_t *lat, file_bench_result_t *res)
+{
+    file_io_cfg_t cfg = FILE_IO_CFG_DEFAULT();
+    cfg.dir = ESP_GMF_IO_DIR_WRITER;
+    cfg.cache_size = policy->cache_size;
+    cfg.sync_bytes = policy->sync_bytes;
+    cfg.sync_ms = policy->sync_ms;
+    cfg.flush_task = policy->flush_task;
+    esp_gmf_io_handle_t io = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_file_init(&cfg, &io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_file_cast(&cfg, io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_set_uri(io, FILE_BENCH_URI));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_open(io));
+
+    uint8_t *buf = esp_gmf_oal_malloc(FILE_BENCH_FRAME_SIZE);
+    TEST_ASSERT_NOT_NULL(buf);
+    esp_gmf_payload_t load = {.buf = buf, .buf_length = FILE_BENCH_FRAME_SIZE};
+    uint32_t pos = 0;
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    for (int i = 0; i < FILE_BENCH_FRAMES; i++) {
+        for (int j = 0; j < FILE_BENCH_FRAME_SIZE; j++) {
+            buf[j] = file_bench_byte(pos + j);
+        }
+        pos += FILE_BENCH_FRAME_SIZE;
+        int64_t t0 = esp_gmf_oal_sys_get_time_us();
+        TEST_ASSERT_GREATER_OR_EQUAL(0, esp_gmf_io_acquire_write(io, &load, FILE_BENCH_FRAME_SIZE, ESP_GMF_MAX_DELAY));
+        load.valid_size = FILE_BENCH_FRAME_SIZE;
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_io_release_write(io, &load, ESP_GMF_MAX_DELAY));
+        lat[i] = (uint32_t)(esp_gmf_oal_sys_get_time_us() - t0);
+        if (policy->paced && ((i + 1) % FILE_BENCH_PACE_FRAMES == 0)) {
+            // Slower than the storage, as a recorder is, so a buffer is always free when the writer needs it
+            vTaskDelay(pdMS_TO_TICKS(FILE_BENCH_PACE_MS));
+        }
+        if (i == FILE_BENCH_FRAMES / 2) {
+            // A durability point puts everything written so far on the storage
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_file_sync(io));
+            struct stat st = {0};
+            TEST_ASSERT_EQUAL(0, stat(FILE_BENCH_URI, &st));
+            TEST_ASSERT_EQUAL(pos, st.st_size);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_close(io));
+    int64_t elapsed = esp_gmf_oal_sys_get_time_us() - start;
+    esp_gmf_oal_free(buf);
+    esp_gmf_obj_delete(io);
+
+    qsort(lat, FILE_BENCH_FRAMES, sizeof(uint32_t), file_bench_cmp);
+    res->kbps = (uint32_t)((int64_t)FILE_BENCH_TOTAL * 1000000 / 1024 / (elapsed > 0 ? elapsed : 1));
+    res->p99_us = lat[FILE_BENCH_FRAMES * 99 / 100];
+    res->max_us = lat[FILE_BENCH_FRAMES - 1];
+    ESP_LOGW(TAG, "%-24s %6ld KB/s, write p99:%6ld us, max:%7ld us", policy->name, (long)res->kbps, (long)res->p99_us,
+             (long)res->max_us);
+    file_bench_verify();
+}
+
+TEST_CASE("File IO, write behind throughput and tail latency per flush policy", "FILE_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    void *sdcard = NULL;
+    esp_gmf_setup_periph_sdmmc(&sdcard);
+    TEST_ASSERT_NOT_NULL(sdcard);
+
+    const file_bench_policy_t policies[] = {
+        {"Write through", 0, 0, 0, false},
+        {"Sync on close", FILE_BENCH_CACHE_SIZE, 0, 0, false},
+        {"Sync every 64 KB", FILE_BENCH_CACHE_SIZE, 64 * 1024, 0, false},
+        {"Sync every 500 ms", FILE_BENCH_CACHE_SIZE, 0, 500, false},
+        {"Thread, every 64 KB", FILE_BENCH_CACHE_SIZE, 64 * 1024, 0, true},
+        {"Thread, every 500 ms", FILE_BENCH_CACHE_SIZE, 0, 500, true},
+        {"Thread paced, every 100 ms", FILE_BENCH_CACHE_SIZE, 0, 100, true, true},
+    };
+    uint32_t *lat = esp_gmf_oal_malloc(FILE_BENCH_FRAMES * sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(lat);
+    file_bench_result_t results[sizeof(policies) / sizeof(policies[0])] = {0};
+    for (int i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        file_bench_run(&policies[i], lat, &results[i]);
+    }
+    // Coalescing beats a sync per write, the paced run is bound by the pace instead
+    for (int i = 1; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (policies[i].paced == false) {
+            TEST_ASSERT_GREATER_THAN(results[0].kbps, results[i].kbps);
+        }
+    }
+    // With a free buffer at hand a write only copies, the syncs of the flush thread must not stall it
+    for (int i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (policies[i].paced) {
+            TEST_ASSERT_LESS_THAN(FILE_BENCH_PACED_MAX_US, results[i].max_us);
+        }
+    }
+    esp_gmf_oal_free(lat);
+    remove(FILE_BENCH_URI);
+    esp_gmf_teardown_periph_sdmmc(sdcard);
+    ESP_GMF_MEM_SHOW(TAG);
+}
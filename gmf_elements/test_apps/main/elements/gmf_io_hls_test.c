@@ -0,0 +1,377 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_io.h"
+#include "esp_gmf_io_hls.h"
+#include "gmf_ut_http_server.h"
+
+#define HLS_TEST_HOST          "http://127.0.0.1:8080"
+#define HLS_TEST_SEG_MS        (500)
+#define HLS_TEST_SEG_NUM       (8)
+#define HLS_TEST_HDR_SIZE      (16)
+#define HLS_TEST_BUF_SIZE      (2 * 1024)
+#define HLS_TEST_READ_SIZE     (1024)
+#define HLS_TEST_STALL_MS      (50)
+#define HLS_TEST_LIVE_WINDOW   (6)
+#define HLS_TEST_LIVE_VARIANT  (1)
+
+static const char *TAG = "HLS_IO_TEST";
+
+/* Variants of the generated stream, lowest bandwidth first */
+static const uint32_t hls_test_bps[] = {32000, 128000, 512000};
+
+/**
+ * @brief  Content served by the stand-in server
+ */
+typedef struct {
+    int      seg_num;     /*!< Segments of a VOD media playlist */
+    int64_t  live_start;  /*!< Time the live stream started, 0 for VOD */
+} hls_test_ctx_t;
+
+/**
+ * @brief  One play of a playlist, paced in real time when `rate` is set
+ */
+typedef struct {
+    const char  *uri;
+    int          prefetch;
+    uint32_t     rate;     /*!< Bytes per second the consumer plays, 0 to read as fast as possible */
+    uint32_t     play_ms;  /*!< Stop after this much playback, 0 to play to the end */
+} hls_test_play_t;
+
+typedef struct {
+    uint32_t  startup_ms;  /*!< From open to the first data */
+    uint32_t  stalls;      /*!< Data arrived more than `HLS_TEST_STALL_MS` after it was due */
+    uint32_t  segments;    /*!< Complete segments read */
+    int64_t   first_seq;
+    int64_t   last_seq;
+    int       variant;     /*!< Variant of the last segment */
+} hls_test_result_t;
+
+/**
+ * @brief  Checker of the segment stream, each segment starts with a header of "HLSG", variant, sequence and size
+ */
+typedef struct {
+    uint8_t   hdr[HLS_TEST_HDR_SIZE];
+    uint32_t  seq;
+    uint32_t  size;
+    uint32_t  off;
+} hls_test_parser_t;
+
+static inline uint32_t hls_test_seg_size(int variant)
+{
+    return hls_test_bps[variant] / 8 * HLS_TEST_SEG_MS / 1000;
+}
+
+static inline uint8_t hls_test_byte(uint32_t seq, uint32_t off)
+{
+    return (uint8_t)((off * 13) ^ (off >> 7) ^ seq);
+}
+
+static void hls_test_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static uint32_t hls_test_get_u32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static int hls_test_parse_segment(const char *path, int *variant, uint32_t *seq)
+{
+    return sscanf(path, "/v%d/%lu.ts", variant, (unsigned long *)seq) == 2
+           && *variant >= 0 && *variant < sizeof(hls_test_bps) / sizeof(hls_test_bps[0]) ? 0 : -1;
+}
+
+static char *hls_test_get_body(const char *path, int *len, void *ctx)
+{
+    hls_test_ctx_t *test = (hls_test_ctx_t *)ctx;
+    int size = 2048;
+    char *text = malloc(size);
+    if (text == NULL) {
+        return NULL;
+    }
+    int n = 0;
+    int variant = 0;
+    if (strcmp(path, "/master.m3u8") == 0) {
+        n = snprintf(text, size, "#EXTM3U\n");
+        for (int i = 0; i < sizeof(hls_test_bps) / sizeof(hls_test_bps[0]); i++) {
+            n += snprintf(text + n, size - n, "#EXT-X-STREAM-INF:BANDWIDTH=%lu,CODECS=\"mp4a.40.2\"\nv%d/index.m3u8\n",
+                          (unsigned long)hls_test_bps[i], i);
+        }
+    } else if (strcmp(path, "/live.m3u8") == 0) {
+        // Sliding window, a new segment is listed every segment duration
+        int avail = HLS_TEST_LIVE_WINDOW + (int)((esp_gmf_oal_sys_get_time_ms() - test->live_start) / HLS_TEST_SEG_MS);
+        int first = avail - HLS_TEST_LIVE_WINDOW;
+        n = snprintf(text, size, "#EXTM3U\n#EXT-X-VERSION:3\n#EXT-X-TARGETDURATION:1\n#EXT-X-MEDIA-SEQUENCE:%d\n", first);
+        for (int i = first; i < avail; i++) {
+            n += snprintf(text + n, size - n, "#EXTINF:0.%03d,\n/v%d/%d.ts\n", HLS_TEST_SEG_MS, HLS_TEST_LIVE_VARIANT, i);
+        }
+    } else if (sscanf(path, "/v%d/index.m3u8", &variant) == 1) {
+        n = snprintf(text, size, "#EXTM3U\r\n#EXT-X-VERSION:3\r\n#EXT-X-TARGETDURATION:1\r\n#EXT-X-MEDIA-SEQUENCE:0\r\n");
+        for (int i = 0; i < test->seg_num; i++) {
+            n += snprintf(text + n, size - n, "#EXTINF:0.%03d,\r\n%d.ts\r\n", HLS_TEST_SEG_MS, i);
+        }
+        n += snprintf(text + n, size - n, "#EXT-X-ENDLIST\r\n");
+    } else {
+        free(text);
+        return NULL;
+    }
+    *len = n;
+    return text;
+}
+
+static int64_t hls_test_get_size(const char *path, void *ctx)
+{
+    int variant = 0;
+    uint32_t seq = 0;
+    if (hls_test_parse_segment(path, &variant, &seq) != 0) {
+        return -1;
+    }
+    return hls_test_seg_size(variant);
+}
+
+static int hls_test_read(const char *path, uint64_t pos, uint8_t *buf, int len, void *ctx)
+{
+    int variant = 0;
+    uint32_t seq = 0;
+    if (hls_test_parse_segment(path, &variant, &seq) != 0) {
+        return -1;
+    }
+    uint8_t hdr[HLS_TEST_HDR_SIZE] = {'H', 'L', 'S', 'G'};
+    hls_test_put_u32(hdr + 4, variant);
+    hls_test_put_u32(hdr + 8, seq);
+    hls_test_put_u32(hdr + 12, hls_test_seg_size(variant));
+    for (int i = 0; i < len; i++) {
+        uint32_t off = pos + i;
+        buf[i] = off < HLS_TEST_HDR_SIZE ? hdr[off] : hls_test_byte(seq, off);
+    }
+    return len;
+}
+
+static void hls_test_check(hls_test_parser_t *parser, const uint8_t *data, int len, hls_test_result_t *res)
+{
+    for (int i = 0; i < len; i++) {
+        if (parser->off < HLS_TEST_HDR_SIZE) {
+            parser->hdr[parser->off++] = data[i];
+            if (parser->off < HLS_TEST_HDR_SIZE) {
+                continue;
+            }
+            TEST_ASSERT_EQUAL_MEMORY("HLSG", parser->hdr, 4);
+            res->variant = hls_test_get_u32(parser->hdr + 4);
+            parser->seq = hls_test_get_u32(parser->hdr + 8);
+            parser->size = hls_test_get_u32(parser->hdr + 12);
+            if (res->first_seq < 0) {
+                res->first_seq = parser->seq;
+            } else if (parser->seq != res->last_seq + 1) {
+                ESP_LOGE(TAG, "Segment %lu after %lld", (unsigned long)parser->seq, res->last_seq);
+                TEST_FAIL_MESSAGE("HLS segments out of order");
+            }
+            continue;
+        }
+        if (data[i] != hls_test_byte(parser->seq, parser->off)) {
+            ESP_LOGE(TAG, "Mismatch in segment %lu at %lu", (unsigned long)parser->seq, (unsigned long)parser->off);
+            TEST_FAIL_MESSAGE("HLS content mismatch");
+        }
+        if (++parser->off == parser->size) {
+            res->last_seq = parser->seq;
+            res->segments++;
+            parser->off = 0;
+        }
+    }
+}
+
+static void hls_test_play(const hls_test_play_t *play, hls_test_result_t *res, esp_gmf_io_hls_stats_t *stats)
+{
+    hls_io_cfg_t cfg = HLS_IO_CFG_DEFAULT();
+    cfg.out_buf_size = HLS_TEST_BUF_SIZE;
+    cfg.prefetch_segments = play->prefetch;
+    esp_gmf_io_handle_t io = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_hls_init(&cfg, &io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_hls_cast(&cfg, io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_set_uri(io, play->uri));
+
+    memset(res, 0, sizeof(hls_test_result_t));
+    res->first_seq = -1;
+    res->last_seq = -1;
+    hls_test_parser_t parser = {0};
+    int64_t start = esp_gmf_oal_sys_get_time_ms();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_open(io));
+    // Playback clock, the byte `n` is due at `base + n / rate`
+    int64_t base = 0;
+    uint64_t played = 0;
+    bool is_done = false;
+    while (is_done == false) {
+        esp_gmf_payload_t load = {0};
+        int ret = esp_gmf_io_acquire_read(io, &load, HLS_TEST_READ_SIZE, ESP_GMF_MAX_DELAY);
+        TEST_ASSERT_GREATER_OR_EQUAL(0, ret);
+        int64_t now = esp_gmf_oal_sys_get_time_ms();
+        if (load.valid_size && (base == 0)) {
+            base = now;
+            res->startup_ms = (uint32_t)(now - start);
+        } else if (load.valid_size && play->rate) {
+            int64_t due = base + (int64_t)(played * 1000 / play->rate);
+            if (now > due + HLS_TEST_STALL_MS) {
+                ESP_LOGW(TAG, "Stall of %lld ms in segment %lu", now - due, (unsigned long)parser.seq);
+                res->stalls++;
+                base += now - due;
+            }
+        }
+        hls_test_check(&parser, load.buf, load.valid_size, res);
+        played += load.valid_size;
+        is_done = load.is_done;
+        esp_gmf_io_release_read(io, &load, ESP_GMF_MAX_DELAY);
+        if (play->rate && base) {
+            // Hold until the data just read is played out
+            int64_t due = base + (int64_t)(played * 1000 / play->rate);
+            now = esp_gmf_oal_sys_get_time_ms();
+            if (due > now) {
+                vTaskDelay(pdMS_TO_TICKS(due - now));
+            }
+        }
+        if (play->play_ms && base && (esp_gmf_oal_sys_get_time_ms() - base >= play->play_ms)) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_hls_get_stats(io, stats));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_close(io));
+    esp_gmf_obj_delete(io);
+    ESP_LOGW(TAG, "%s, prefetch %d: startup %ld ms, %ld stalls, segments %lld-%lld, variant %d", play->uri, play->prefetch,
+             (long)res->startup_ms, (long)res->stalls, res->first_seq, res->last_seq, res->variant);
+    ESP_LOGW(TAG, "IO: startup %ld ms, %ld stalls, %ld segments, %ld bps, variant %d, %ld refreshes", (long)stats->startup_ms,
+             (long)stats->stalls, (long)stats->segments, (long)stats->bandwidth, stats->variant, (long)stats->refreshes);
+}
+
+static void hls_test_server_start(uint32_t latency_ms, uint32_t conn_rate, hls_test_ctx_t *ctx, gmf_ut_http_server_handle_t *srv)
+{
+    gmf_ut_http_server_cfg_t cfg = {
+        .port = GMF_UT_HTTP_SERVER_PORT,
+        .latency_ms = latency_ms,
+        .conn_rate = conn_rate,
+        .get_size = hls_test_get_size,
+        .read = hls_test_read,
+        .get_body = hls_test_get_body,
+        .ctx = ctx,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_start(&cfg, srv));
+}
+
+TEST_CASE("HLS IO, segment prefetch stalls and startup time", "HLS_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    hls_test_ctx_t ctx = {.seg_num = HLS_TEST_SEG_NUM};
+    gmf_ut_http_server_handle_t srv = NULL;
+    // Every request waits 300 ms, more than the data bus holds, the link itself is fast
+    hls_test_server_start(300, 128 * 1024, &ctx, &srv);
+    hls_test_play_t play = {
+        .uri = HLS_TEST_HOST "/v1/index.m3u8",
+        .rate = hls_test_bps[1] / 8,
+    };
+    hls_test_result_t res = {0};
+    esp_gmf_io_hls_stats_t stats = {0};
+
+    // Without prefetch each segment boundary waits for a request
+    play.prefetch = 0;
+    hls_test_play(&play, &res, &stats);
+    TEST_ASSERT_EQUAL(HLS_TEST_SEG_NUM, res.segments);
+    TEST_ASSERT_GREATER_THAN(0, res.stalls);
+    TEST_ASSERT_GREATER_THAN(0, stats.stalls);
+
+    // Prefetched segments are ready when the previous one ends
+    play.prefetch = 2;
+    hls_test_play(&play, &res, &stats);
+    TEST_ASSERT_EQUAL(HLS_TEST_SEG_NUM, res.segments);
+    TEST_ASSERT_EQUAL(HLS_TEST_SEG_NUM, stats.segments);
+    TEST_ASSERT_EQUAL(0, res.stalls);
+    TEST_ASSERT_EQUAL(0, stats.stalls);
+    TEST_ASSERT_GREATER_THAN(0, stats.startup_ms);
+    TEST_ASSERT_EQUAL(-1, stats.variant);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("HLS IO, variant selection by measured bandwidth", "HLS_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    hls_test_ctx_t ctx = {.seg_num = 2 * HLS_TEST_SEG_NUM};
+    gmf_ut_http_server_handle_t srv = NULL;
+    // 256 kbps link, only the middle variant fits in the margin
+    hls_test_server_start(20, 32 * 1024, &ctx, &srv);
+    hls_test_play_t play = {
+        .uri = HLS_TEST_HOST "/master.m3u8",
+        .prefetch = 2,
+    };
+    hls_test_result_t res = {0};
+    esp_gmf_io_hls_stats_t stats = {0};
+    hls_test_play(&play, &res, &stats);
+    TEST_ASSERT_EQUAL(2 * HLS_TEST_SEG_NUM, res.segments);
+    TEST_ASSERT_EQUAL(0, res.first_seq);
+    TEST_ASSERT_EQUAL(1, res.variant);
+    TEST_ASSERT_EQUAL(1, stats.variant);
+    // The variants are selected within 80 % of the measured bandwidth
+    TEST_ASSERT_GREATER_OR_EQUAL(hls_test_bps[1] * 100 / 80, stats.bandwidth);
+    TEST_ASSERT_LESS_THAN(hls_test_bps[2] * 100 / 80, stats.bandwidth);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("HLS IO, live playlist refresh", "HLS_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    hls_test_ctx_t ctx = {.live_start = esp_gmf_oal_sys_get_time_ms()};
+    gmf_ut_http_server_handle_t srv = NULL;
+    hls_test_server_start(50, 128 * 1024, &ctx, &srv);
+    hls_test_play_t play = {
+        .uri = HLS_TEST_HOST "/live.m3u8",
+        .prefetch = 2,
+        .rate = hls_test_bps[HLS_TEST_LIVE_VARIANT] / 8,
+        .play_ms = 5000,
+    };
+    hls_test_result_t res = {0};
+    esp_gmf_io_hls_stats_t stats = {0};
+    hls_test_play(&play, &res, &stats);
+    // The play starts three segments from the live edge and follows the new segments without gaps
+    TEST_ASSERT_EQUAL(HLS_TEST_LIVE_WINDOW - 3, res.first_seq);
+    TEST_ASSERT_GREATER_OR_EQUAL(play.play_ms / HLS_TEST_SEG_MS - 1, res.segments);
+    TEST_ASSERT_EQUAL(0, res.stalls);
+    TEST_ASSERT_GREATER_OR_EQUAL(3, stats.refreshes);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    ESP_GMF_MEM_SHOW(TAG);
+}
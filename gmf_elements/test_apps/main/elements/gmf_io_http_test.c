@@ -0,0 +1,537 @@
+/*
+ * ESPRESSIF MIT License
+ *
+ * Copyright (c) 2025 <ESPRESSIF SYSTEMS (SHANGHAI) CO., LTD>
+ *
+ * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
+ * it is free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <string.h>
+#include <stdio.h>
+#include <dirent.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_io.h"
+#include "esp_gmf_io_http.h"
+#include "esp_gmf_setup_peripheral.h"
+#include "gmf_ut_http_server.h"
+
+#define HTTP_TEST_HOST       "http://127.0.0.1:8080"
+#define HTTP_TEST_URI        HTTP_TEST_HOST "/range.bin"
+#define HTTP_TEST_SIZE       (512 * 1024)
+#define HTTP_TEST_CONN_RATE  (128 * 1024)
+#define HTTP_TEST_LATENCY    (20)
+#define HTTP_TEST_SEG_SIZE   (32 * 1024)
+#define HTTP_TEST_CACHE_DIR  "/sdcard/hcache"
+#define HTTP_TEST_CONNECT_LATENCY  (100)
+#define HTTP_TEST_SEEK_BUF_SIZE    (32 * 1024)
+#define HTTP_TEST_TRACE_STEP_MS    (100)
+#define HTTP_TEST_PLAY_RATE        (96 * 1024)
+
+static const char *TAG = "HTTP_IO_TEST";
+
+/**
+ * @brief  Throughput of a mobile link in KB/s, one entry per 100 ms, recorded on a drive with handovers
+ */
+static const uint32_t http_test_trace_kbps[] = {
+    40, 0, 0, 60, 180, 220, 260, 240, 90, 30,
+    0, 0, 0, 0, 120, 310, 330, 300, 280, 160,
+    60, 50, 40, 70, 200, 260, 280, 270, 250, 240,
+    20, 0, 0, 80, 150, 190, 230, 260, 300, 320,
+    90, 50, 60, 40, 0, 0, 140, 280, 300, 290,
+};
+
+/**
+ * @brief  One play of a URI, optionally stopped early or seeked once
+ */
+typedef struct {
+    const char  *uri;
+    uint8_t      salt;           /*!< Content version served by the server */
+    int          range_workers;
+    const char  *cache_dir;
+    uint32_t     cache_max_size;
+    uint32_t     stop_at;        /*!< Close after this many bytes, 0 to play to the end */
+    uint32_t     seek_from;      /*!< Seek once this many bytes are read, 0 for no seek */
+    uint32_t     seek_to;
+} http_test_play_t;
+
+typedef struct {
+    uint32_t  ttfb_ms;   /*!< From open to the first data */
+    uint32_t  total_ms;  /*!< From open to the end of the play */
+    uint32_t  bytes;     /*!< Bytes read by the play */
+} http_test_result_t;
+
+static inline uint8_t http_test_byte(uint64_t pos, uint8_t salt)
+{
+    return (uint8_t)((pos * 7) ^ (pos >> 9) ^ salt);
+}
+
+static int64_t http_test_get_size(const char *path, void *ctx)
+{
+    return HTTP_TEST_SIZE;
+}
+
+static int http_test_read(const char *path, uint64_t pos, uint8_t *buf, int len, void *ctx)
+{
+    uint8_t salt = ctx ? *(uint8_t *)ctx : 0;
+    for (int i = 0; i < len; i++) {
+        buf[i] = http_test_byte(pos + i, salt);
+    }
+    return len;
+}
+
+static void http_test_clear_cache(void)
+{
+    DIR *dir = opendir(HTTP_TEST_CACHE_DIR);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent *ent = NULL;
+    char path[300];
+    while ((ent = readdir(dir)) != NULL) {
+        snprintf(path, sizeof(path), "%s/%s", HTTP_TEST_CACHE_DIR, ent->d_name);
+        remove(path);
+    }
+    closedir(dir);
+}
+
+static void http_test_play(const http_test_play_t *play, http_test_result_t *res)
+{
+    http_io_cfg_t cfg = HTTP_STREAM_CFG_DEFAULT();
+    cfg.dir = ESP_GMF_IO_DIR_READER;
+    cfg.range_workers = play->range_workers;
+    cfg.range_seg_size = HTTP_TEST_SEG_SIZE;
+    cfg.cache_dir = play->cache_dir;
+    cfg.cache_max_size = play->cache_max_size;
+    esp_gmf_io_handle_t io = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_init(&cfg, &io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_cast(&cfg, io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_set_uri(io, play->uri));
+
+    memset(res, 0, sizeof(http_test_result_t));
+    int64_t start = esp_gmf_oal_sys_get_time_ms();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_open(io));
+    uint64_t pos = 0;
+    bool is_done = false;
+    bool seeked = false;
+    while (is_done == false) {
+        esp_gmf_payload_t load = {0};
+        int ret = esp_gmf_io_acquire_read(io, &load, 4096, ESP_GMF_MAX_DELAY);
+        TEST_ASSERT_GREATER_OR_EQUAL(0, ret);
+        if ((res->ttfb_ms == 0) && load.valid_size) {
+            res->ttfb_ms = (uint32_t)(esp_gmf_oal_sys_get_time_ms() - start);
+        }
+        for (int i = 0; i < load.valid_size; i++, pos++) {
+            if (load.buf[i] != http_test_byte(pos, play->salt)) {
+                ESP_LOGE(TAG, "Mismatch at %llu", pos);
+                TEST_FAIL_MESSAGE("HTTP content mismatch");
+            }
+        }
+        res->bytes += load.valid_size;
+        is_done = load.is_done;
+        esp_gmf_io_release_read(io, &load, ESP_GMF_MAX_DELAY);
+        if (play->stop_at && (res->bytes >= play->stop_at)) {
+            break;
+        }
+        if (play->seek_from && (seeked == false) && (res->bytes >= play->seek_from)) {
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_seek(io, play->seek_to));
+            pos = play->seek_to;
+            seeked = true;
+        }
+    }
+    res->total_ms = (uint32_t)(esp_gmf_oal_sys_get_time_ms() - start);
+    if ((play->stop_at == 0) && (play->seek_from == 0)) {
+        TEST_ASSERT_EQUAL(HTTP_TEST_SIZE, pos);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_close(io));
+    esp_gmf_obj_delete(io);
+}
+
+static uint32_t http_test_download(int workers)
+{
+    http_test_play_t play = {.uri = HTTP_TEST_URI, .range_workers = workers};
+    http_test_result_t res = {0};
+    http_test_play(&play, &res);
+    uint32_t kbps = (uint32_t)((int64_t)HTTP_TEST_SIZE * 1000 / 1024 / (res.total_ms > 0 ? res.total_ms : 1));
+    ESP_LOGW(TAG, "%d range workers, %6ld KB/s, %ld ms", workers, (long)kbps, (long)res.total_ms);
+    return kbps;
+}
+
+static void http_test_server_start(bool accept_ranges, bool fail_closed_ranges, const char *etag, uint8_t *salt,
+                                   gmf_ut_http_server_handle_t *srv)
+{
+    gmf_ut_http_server_cfg_t cfg = {
+        .port = GMF_UT_HTTP_SERVER_PORT,
+        .latency_ms = HTTP_TEST_LATENCY,
+        .conn_rate = HTTP_TEST_CONN_RATE,
+        .accept_ranges = accept_ranges,
+        .fail_closed_ranges = fail_closed_ranges,
+        .etag = etag,
+        .get_size = http_test_get_size,
+        .read = http_test_read,
+        .ctx = salt,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_start(&cfg, srv));
+}
+
+/**
+ * @brief  Read up to `len` bytes at `pos` and check them, return the time from `start` to the first data
+ */
+static uint32_t http_test_read_at(esp_gmf_io_handle_t io, uint64_t *pos, uint32_t len, int64_t start)
+{
+    uint32_t first_ms = 0;
+    uint32_t bytes = 0;
+    bool is_done = false;
+    while ((is_done == false) && (bytes < len)) {
+        esp_gmf_payload_t load = {0};
+        TEST_ASSERT_GREATER_OR_EQUAL(0, esp_gmf_io_acquire_read(io, &load, 4096, ESP_GMF_MAX_DELAY));
+        if ((first_ms == 0) && load.valid_size) {
+            first_ms = (uint32_t)(esp_gmf_oal_sys_get_time_ms() - start);
+        }
+        for (int i = 0; i < load.valid_size; i++, (*pos)++) {
+            if (load.buf[i] != http_test_byte(*pos, 0)) {
+                ESP_LOGE(TAG, "Mismatch at %llu", *pos);
+                TEST_FAIL_MESSAGE("HTTP content mismatch");
+            }
+        }
+        bytes += load.valid_size;
+        is_done = load.is_done;
+        esp_gmf_io_release_read(io, &load, ESP_GMF_MAX_DELAY);
+    }
+    return first_ms;
+}
+
+/**
+ * @brief  Seek and read a little, return the seek to data latency and the server work it took
+ */
+static uint32_t http_test_seek(esp_gmf_io_handle_t io, gmf_ut_http_server_handle_t srv, uint64_t *pos, uint64_t to,
+                               gmf_ut_http_server_stats_t *stats)
+{
+    gmf_ut_http_server_reset_stats(srv);
+    int64_t start = esp_gmf_oal_sys_get_time_ms();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_seek(io, to));
+    *pos = to;
+    uint32_t ms = http_test_read_at(io, pos, 4096, start);
+    gmf_ut_http_server_get_stats(srv, stats);
+    ESP_LOGW(TAG, "Seek to %llu, %ld ms to data, requests: %ld, connections: %ld", to, (long)ms,
+             (long)stats->requests, (long)stats->connections);
+    return ms;
+}
+
+/**
+ * @brief  Idle time of all cores in run time stats clock periods
+ */
+static configRUN_TIME_COUNTER_TYPE http_test_idle_time(void)
+{
+    UBaseType_t num = uxTaskGetNumberOfTasks() + 4;
+    TaskStatus_t *tasks = esp_gmf_oal_calloc(num, sizeof(TaskStatus_t));
+    TEST_ASSERT_NOT_NULL(tasks);
+    num = uxTaskGetSystemState(tasks, num, NULL);
+    configRUN_TIME_COUNTER_TYPE idle = 0;
+    for (int i = 0; i < num; i++) {
+        if (strncmp(tasks[i].pcTaskName, "IDLE", 4) == 0) {
+            idle += tasks[i].ulRunTimeCounter;
+        }
+    }
+    esp_gmf_oal_free(tasks);
+    return idle;
+}
+
+/**
+ * @brief  Play the whole content against the replayed trace at `HTTP_TEST_PLAY_RATE`, as a decoder would, and
+ *         return the CPU time of the system per byte in nanoseconds
+ */
+static uint32_t http_test_trace_play(http_io_cfg_t *cfg, esp_gmf_io_http_stats_t *stats)
+{
+    uint32_t trace[sizeof(http_test_trace_kbps) / sizeof(http_test_trace_kbps[0])];
+    for (int i = 0; i < sizeof(trace) / sizeof(trace[0]); i++) {
+        trace[i] = http_test_trace_kbps[i] * 1024;
+    }
+    gmf_ut_http_server_cfg_t srv_cfg = {
+        .port = GMF_UT_HTTP_SERVER_PORT,
+        .latency_ms = HTTP_TEST_LATENCY,
+        .rate_trace = trace,
+        .rate_trace_num = sizeof(trace) / sizeof(trace[0]),
+        .rate_trace_step_ms = HTTP_TEST_TRACE_STEP_MS,
+        .get_size = http_test_get_size,
+        .read = http_test_read,
+    };
+    gmf_ut_http_server_handle_t srv = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_start(&srv_cfg, &srv));
+    esp_gmf_io_handle_t io = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_init(cfg, &io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_cast(cfg, io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_set_uri(io, HTTP_TEST_URI));
+
+    configRUN_TIME_COUNTER_TYPE idle = http_test_idle_time();
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_open(io));
+    uint64_t pos = 0;
+    int64_t play_ms = esp_gmf_oal_sys_get_time_ms();
+    while (pos < HTTP_TEST_SIZE) {
+        uint64_t from = pos;
+        http_test_read_at(io, &pos, 2048, play_ms);
+        TEST_ASSERT_GREATER_THAN(from, pos);
+        // Consume in real time from the first data on, a late read does not catch up
+        int64_t now = esp_gmf_oal_sys_get_time_ms();
+        int64_t due = play_ms + (int64_t)pos * 1000 / HTTP_TEST_PLAY_RATE;
+        if (due > now) {
+            vTaskDelay(pdMS_TO_TICKS(due - now));
+        } else {
+            play_ms += now - due;
+        }
+    }
+    uint64_t busy_us = (uint64_t)(esp_gmf_oal_sys_get_time_us() - start) * portNUM_PROCESSORS - (http_test_idle_time() - idle);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_get_stats(io, stats));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_close(io));
+    esp_gmf_obj_delete(io);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    uint32_t ns_per_byte = (uint32_t)(busy_us * 1000 / HTTP_TEST_SIZE);
+    ESP_LOGW(TAG, "Underruns: %ld, chunks: %ld, last chunk: %ld, target fill: %ld/%ld, throughput: %ld B/s, "
+             "jitter: %ld ms, CPU: %ld ns/byte", (long)stats->underruns, (long)stats->chunks, (long)stats->chunk_size,
+             (long)stats->target_fill, (long)stats->buf_size, (long)stats->throughput, (long)stats->jitter_ms,
+             (long)ns_per_byte);
+    return ns_per_byte;
+}
+
+TEST_CASE("HTTP IO, parallel range download throughput", "HTTP_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    gmf_ut_http_server_handle_t srv = NULL;
+    http_test_server_start(true, false, NULL, NULL, &srv);
+
+    const int workers[] = {1, 2, 4};
+    uint32_t kbps[sizeof(workers) / sizeof(workers[0])] = {0};
+    for (int i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        gmf_ut_http_server_reset_stats(srv);
+        kbps[i] = http_test_download(workers[i]);
+        gmf_ut_http_server_stats_t stats = {0};
+        gmf_ut_http_server_get_stats(srv, &stats);
+        ESP_LOGW(TAG, "Requests: %ld, with range: %ld, connections: %ld", (long)stats.requests,
+                 (long)stats.range_requests, (long)stats.connections);
+        if (workers[i] > 1) {
+            // The first segment comes from the opening request, each following one from a range request
+            TEST_ASSERT_EQUAL(HTTP_TEST_SIZE / HTTP_TEST_SEG_SIZE, stats.requests);
+        }
+    }
+    // Each connection is paced, so the throughput scales with the number of connections
+    TEST_ASSERT_GREATER_THAN(kbps[0] * 3 / 2, kbps[2]);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("HTTP IO, range download falls back to a single connection", "HTTP_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    gmf_ut_http_server_handle_t srv = NULL;
+    gmf_ut_http_server_stats_t stats = {0};
+
+    // No `Accept-Ranges`, the whole content comes from one request
+    http_test_server_start(false, false, NULL, NULL, &srv);
+    http_test_download(4);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+
+    // Range requests fail, the reader reopens at the current position and the data stays in order
+    http_test_server_start(true, true, NULL, NULL, &srv);
+    http_test_download(4);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_GREATER_THAN(1, stats.requests);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("HTTP IO, on-disk cache time to first byte and partial fills", "HTTP_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    void *sdcard = NULL;
+    esp_gmf_setup_periph_sdmmc(&sdcard);
+    TEST_ASSERT_NOT_NULL(sdcard);
+    http_test_clear_cache();
+    uint8_t salt = 0;
+    gmf_ut_http_server_handle_t srv = NULL;
+    gmf_ut_http_server_stats_t stats = {0};
+    http_test_result_t cold = {0};
+    http_test_result_t warm = {0};
+    http_test_result_t res = {0};
+    http_test_play_t play = {
+        .uri = HTTP_TEST_HOST "/tone.bin",
+        .cache_dir = HTTP_TEST_CACHE_DIR,
+        .cache_max_size = HTTP_TEST_SIZE * 5 / 2,
+    };
+    http_test_server_start(true, false, "\"v0\"", &salt, &srv);
+
+    // Cold play fills the cache, the warm one only revalidates it
+    http_test_play(&play, &cold);
+    gmf_ut_http_server_reset_stats(srv);
+    http_test_play(&play, &warm);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    ESP_LOGW(TAG, "Cold: first byte %ld ms, play %ld ms", (long)cold.ttfb_ms, (long)cold.total_ms);
+    ESP_LOGW(TAG, "Warm: first byte %ld ms, play %ld ms", (long)warm.ttfb_ms, (long)warm.total_ms);
+    TEST_ASSERT_EQUAL(1, stats.not_modified);
+    TEST_ASSERT_EQUAL(0, stats.bytes);
+    TEST_ASSERT_LESS_THAN(cold.total_ms / 2, warm.total_ms);
+
+    // Aborted fill, the next play serves the stored part and resumes the rest with a range request
+    play.uri = HTTP_TEST_HOST "/jingle.bin";
+    play.stop_at = HTTP_TEST_SIZE / 4;
+    http_test_play(&play, &res);
+    play.stop_at = 0;
+    gmf_ut_http_server_reset_stats(srv);
+    http_test_play(&play, &res);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_EQUAL(1, stats.range_requests);
+    TEST_ASSERT_LESS_THAN(HTTP_TEST_SIZE, stats.bytes);
+    gmf_ut_http_server_reset_stats(srv);
+    http_test_play(&play, &res);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_EQUAL(0, stats.bytes);
+
+    // Seek away during a fill, the stored part stays contiguous and replays correctly
+    play.uri = HTTP_TEST_HOST "/intro.bin";
+    play.seek_from = 64 * 1024;
+    play.seek_to = HTTP_TEST_SIZE / 2;
+    http_test_play(&play, &res);
+    play.seek_from = 0;
+    play.seek_to = 0;
+    http_test_play(&play, &res);
+    TEST_ASSERT_EQUAL(HTTP_TEST_SIZE, res.bytes);
+
+    // Three entries do not fit the cap, the least recently used one is evicted
+    gmf_ut_http_server_reset_stats(srv);
+    play.uri = HTTP_TEST_HOST "/jingle.bin";
+    http_test_play(&play, &res);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_EQUAL(0, stats.bytes);
+    play.uri = HTTP_TEST_HOST "/tone.bin";
+    gmf_ut_http_server_reset_stats(srv);
+    http_test_play(&play, &res);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_EQUAL(HTTP_TEST_SIZE, stats.bytes);
+
+    // Changed content on the server replaces the entry
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    salt = 0x5a;
+    http_test_server_start(true, false, "\"v1\"", &salt, &srv);
+    play.salt = salt;
+    http_test_play(&play, &res);
+    gmf_ut_http_server_reset_stats(srv);
+    http_test_play(&play, &res);
+    gmf_ut_http_server_get_stats(srv, &stats);
+    TEST_ASSERT_EQUAL(1, stats.not_modified);
+    TEST_ASSERT_EQUAL(0, stats.bytes);
+
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    http_test_clear_cache();
+    esp_gmf_teardown_periph_sdmmc(sdcard);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("HTTP IO, seek to data latency on a kept connection", "HTTP_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    gmf_ut_http_server_cfg_t srv_cfg = {
+        .port = GMF_UT_HTTP_SERVER_PORT,
+        .latency_ms = HTTP_TEST_LATENCY,
+        .connect_latency_ms = HTTP_TEST_CONNECT_LATENCY,
+        .conn_rate = 1024 * 1024,
+        .accept_ranges = true,
+        .get_size = http_test_get_size,
+        .read = http_test_read,
+    };
+    gmf_ut_http_server_handle_t srv = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_start(&srv_cfg, &srv));
+    http_io_cfg_t cfg = HTTP_STREAM_CFG_DEFAULT();
+    cfg.dir = ESP_GMF_IO_DIR_READER;
+    cfg.seek_buf_size = HTTP_TEST_SEEK_BUF_SIZE;
+    esp_gmf_io_handle_t io = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_init(&cfg, &io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_http_cast(&cfg, io));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_set_uri(io, HTTP_TEST_URI));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_open(io));
+    uint64_t pos = 0;
+    gmf_ut_http_server_stats_t stats = {0};
+    http_test_read_at(io, &pos, 64 * 1024, esp_gmf_oal_sys_get_time_ms());
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    // Back into the bytes already handed over, served from the seek buffer
+    http_test_seek(io, srv, &pos, pos - 8 * 1024, &stats);
+    TEST_ASSERT_EQUAL(0, stats.requests);
+
+    // Short forward seek, read through on the open response
+    http_test_seek(io, srv, &pos, pos + 30 * 1024, &stats);
+    TEST_ASSERT_EQUAL(0, stats.requests);
+
+    // Response complete, the range request goes on the same connection
+    http_test_read_at(io, &pos, HTTP_TEST_SIZE, esp_gmf_oal_sys_get_time_ms());
+    TEST_ASSERT_EQUAL(HTTP_TEST_SIZE, pos);
+    uint32_t kept_ms = http_test_seek(io, srv, &pos, 0, &stats);
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(0, stats.connections);
+    TEST_ASSERT_LESS_THAN(HTTP_TEST_CONNECT_LATENCY, kept_ms);
+
+    // Far seek with most of the response left, only the connection is replaced
+    uint32_t new_ms = http_test_seek(io, srv, &pos, HTTP_TEST_SIZE / 2, &stats);
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(1, stats.connections);
+    TEST_ASSERT_GREATER_OR_EQUAL(HTTP_TEST_CONNECT_LATENCY, new_ms);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_io_close(io));
+    esp_gmf_obj_delete(io);
+    TEST_ASSERT_EQUAL(ESP_OK, gmf_ut_http_server_stop(srv));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("HTTP IO, adaptive chunk and fill sizing on a replayed link trace", "HTTP_IO")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    ESP_GMF_MEM_SHOW(TAG);
+    http_io_cfg_t cfg = HTTP_STREAM_CFG_DEFAULT();
+    cfg.dir = ESP_GMF_IO_DIR_READER;
+    cfg.out_buf_size = 64 * 1024;
+    esp_gmf_io_http_stats_t fixed = {0};
+    esp_gmf_io_http_stats_t adaptive = {0};
+
+    ESP_LOGW(TAG, "Fixed chunks");
+    uint32_t fixed_cpu = http_test_trace_play(&cfg, &fixed);
+    ESP_LOGW(TAG, "Adaptive sizing");
+    cfg.chunk_min_size = 1024;
+    cfg.chunk_max_size = 16 * 1024;
+    cfg.fill_min_size = 8 * 1024;
+    uint32_t adaptive_cpu = http_test_trace_play(&cfg, &adaptive);
+    ESP_LOGW(TAG, "Underruns %ld -> %ld, CPU %ld -> %ld ns/byte", (long)fixed.underruns, (long)adaptive.underruns,
+             (long)fixed_cpu, (long)adaptive_cpu);
+
+    // The stalls are ridden out by the target fill, and the fast parts take fewer reads
+    TEST_ASSERT_EQUAL(0, fixed.target_fill);
+    TEST_ASSERT_GREATER_OR_EQUAL(cfg.fill_min_size, adaptive.target_fill);
+    TEST_ASSERT_LESS_THAN(fixed.underruns, adaptive.underruns);
+    TEST_ASSERT_LESS_THAN(fixed.chunks, adaptive.chunks);
+    ESP_GMF_MEM_SHOW(TAG);
+}